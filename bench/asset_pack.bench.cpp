@@ -0,0 +1,106 @@
+#include <SDL.h>
+#include <fcntl.h>
+#include <fmt/core.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "context.hpp"
+#include "sdl/asset_pack.hpp"
+#include "sdl/surface.hpp"
+#include "sdl/texture.hpp"
+#include "sdl/types.hpp"
+#include "sdl/window.hpp"
+
+constexpr WindowOptions BENCH_WINDOW_OPTIONS{
+	.title = "asset pack benchmark",
+	.x = SDL_WINDOWPOS_UNDEFINED,
+	.y = SDL_WINDOWPOS_UNDEFINED,
+	.w = 640,
+	.h = 480,
+	.offscreen = true,
+};
+
+// A level's worth of sprites
+constexpr auto N_IMAGES = 512;
+constexpr auto IMAGE_SIZE = 128;
+
+// Drop a file from the page cache, so the next read has to go to disk
+static auto evict(const std::filesystem::path &path) -> void {
+	auto fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) return;
+	fdatasync(fd);
+	posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+	close(fd);
+}
+
+int main() {
+	Context ctx{BENCH_WINDOW_OPTIONS};
+	auto &window = ctx.get_window();
+
+	auto directory = std::filesystem::temp_directory_path() / "cege_asset_bench";
+	std::filesystem::create_directories(directory);
+
+	// Half of each image is flat and half is noise, like a sprite on a transparent background
+	std::vector<std::filesystem::path> paths{};
+	AssetPackWriter writer{};
+	std::uint32_t seed = 1;
+	for (auto i = 0; i < N_IMAGES; i++) {
+		Surface image{IMAGE_SIZE, IMAGE_SIZE};
+		for (auto y = IMAGE_SIZE / 2; y < IMAGE_SIZE; y++) {
+			for (auto x = 0; x < IMAGE_SIZE; x++) {
+				seed = seed * 1664525 + 1013904223;
+				image.set_pixel(x, y, {static_cast<Uint8>(seed >> 24), static_cast<Uint8>(seed >> 16), static_cast<Uint8>(i), 0xff});
+			}
+		}
+
+		auto &path = paths.emplace_back(directory / fmt::format("sprite_{}.png", i));
+		image.save_png(path);
+		writer.add_image(path.string(), image);
+	}
+
+	std::vector<std::pair<std::string, std::filesystem::path>> packs{{"pack", directory / "assets.pack"}};
+	writer.write(packs[0].second);
+#ifdef CEGE_LZ4
+	packs.emplace_back("pack (lz4)", directory / "assets_lz4.pack");
+	writer.write(packs[1].second, AssetCompression::lz4);
+#endif
+
+	std::vector<Texture> textures{};
+	textures.reserve(N_IMAGES);
+	auto load_loose = [&] {
+		textures.clear();
+		for (auto &path : paths)
+			textures.push_back(window.load_image(path));
+	};
+
+	fmt::print("{:>12} {:>12} {:>12} {:>12}\n", "source", "cold ms", "warm ms", "size KiB");
+
+	for (auto &path : paths)
+		evict(path);
+	auto loose_cold_ms = time_ms(load_loose);
+	auto loose_warm_ms = time_ms(load_loose);
+	std::uintmax_t loose_size = 0;
+	for (auto &path : paths)
+		loose_size += std::filesystem::exists(path) ? std::filesystem::file_size(path) : 0;
+	fmt::print("{:>12} {:>12.3f} {:>12.3f} {:>12}\n", "loose", loose_cold_ms, loose_warm_ms, loose_size / 1024);
+
+	for (auto &[name, pack_path] : packs) {
+		auto load_pack = [&] {
+			textures.clear();
+			AssetPack pack{pack_path};
+			for (auto &path : paths)
+				textures.push_back(window.load_image(pack, path.string()));
+		};
+
+		evict(pack_path);
+		auto cold_ms = time_ms(load_pack);
+		auto warm_ms = time_ms(load_pack);
+		fmt::print("{:>12} {:>12.3f} {:>12.3f} {:>12}\n", name, cold_ms, warm_ms, std::filesystem::file_size(pack_path) / 1024);
+	}
+
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <chrono>
+#include <utility>
+
+/// @brief Time how long a function takes to run.
+/// @tparam F The function type.
+/// @param f The function to run.
+/// @return The elapsed time in milliseconds.
+template <typename F>
+auto time_ms(F &&f) -> double {
+	auto start = std::chrono::steady_clock::now();
+	std::forward<F>(f)();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
@@ -0,0 +1,76 @@
+#include <fmt/core.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "engine/camera.hpp"
+#include "engine/spatial_index.hpp"
+#include "engine/transform.hpp"
+
+constexpr auto WORLD_SIZE = 20'000.0f;
+constexpr auto N_FRAMES = 100;
+
+int main() {
+	Scene scene{};
+	Camera camera{.position = {0.0f, 0.0f}, .size = {1280.0f, 720.0f}};
+
+	// Sprites are scattered so that roughly 5% of them are on screen
+	auto visible_area = camera.size.x * camera.size.y / 0.05f;
+	auto visible_side = std::sqrt(visible_area);
+	std::mt19937 rng{42};
+	std::uniform_real_distribution<float> coordinate{-visible_side / 2.0f, visible_side / 2.0f};
+	std::uniform_real_distribution<float> far_coordinate{-WORLD_SIZE, WORLD_SIZE};
+
+	std::vector<std::shared_ptr<Entity>> sprites{};
+	for (auto i = 0; i < MAX_ENTITIES; i++) {
+		auto sprite = scene.create_entity();
+		sprite->create_component<GlobalTransform>(Vector2{coordinate(rng), coordinate(rng)}, Vector2{32.0f, 32.0f});
+		sprites.push_back(std::move(sprite));
+	}
+
+	SpatialIndex index{};
+	auto build_ms = time_ms([&] { index.update(scene); });
+
+	std::vector<EntityId> visible{};
+	auto brute_force_ms = 0.0;
+	auto indexed_ms = 0.0;
+	size_t n_visible = 0;
+
+	for (auto frame = 0; frame < N_FRAMES; frame++) {
+		auto view = camera.get_bounds();
+
+		brute_force_ms += time_ms([&] {
+			visible.clear();
+			for (auto &sprite : sprites)
+				if (sprite->read_component<GlobalTransform>().get_bounds().intersects(view))
+					visible.push_back(sprite->get_id());
+		});
+		n_visible = visible.size();
+
+		indexed_ms += time_ms([&] {
+			visible.clear();
+			index.query(view, visible);
+		});
+	}
+
+	// A few sprites move each frame, including some that jump across the world
+	auto update_ms = 0.0;
+	std::uniform_int_distribution<size_t> pick{0, sprites.size() - 1};
+	for (auto frame = 0; frame < N_FRAMES; frame++) {
+		scene.advance_tick();
+		for (size_t i = 0; i < sprites.size() / 100; i++) {
+			auto &position = sprites[pick(rng)]->get_component_raw<GlobalTransform>().position;
+			position = i % 10 == 0 ? Vector2{far_coordinate(rng), far_coordinate(rng)} : position + Vector2{4.0f, 4.0f};
+		}
+		update_ms += time_ms([&] { index.update(scene); });
+	}
+
+	fmt::print("{:>8} {:>8} {:>10} {:>12} {:>10} {:>10}\n", "sprites", "visible", "build", "brute force", "indexed", "1% moved");
+	fmt::print("{:>8} {:>8} {:>10.3f} {:>12.3f} {:>10.3f} {:>10.3f}\n", sprites.size(), n_visible, build_ms, brute_force_ms / N_FRAMES, indexed_ms / N_FRAMES, update_ms / N_FRAMES);
+}
@@ -0,0 +1,55 @@
+#include <fmt/core.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+
+struct Body {
+	float x = 0.0f, y = 0.0f;
+	float vx = 1.0f, vy = 1.0f;
+};
+
+constexpr auto N_TICKS = 200;
+constexpr auto CHANGE_PERCENTS = {1, 2, 5, 10};
+
+int main() {
+	fmt::print("{:>8} {:>12} {:>12} {:>12} {:>12}\n", "changed", "delta bytes", "full bytes", "encode ms", "apply ms");
+
+	for (auto percent : CHANGE_PERCENTS) {
+		Scene scene{};
+		std::vector<std::shared_ptr<Entity>> entities{};
+		for (auto i = 0; i < MAX_ENTITIES; i++) {
+			entities.emplace_back(scene.create_entity());
+			entities.back()->create_component<Body>();
+		}
+
+		std::mt19937 rng{1234};
+		std::uniform_int_distribution<size_t> pick{0, entities.size() - 1};
+		auto n_changed = entities.size() * percent / 100;
+
+		auto baseline = scene.create_snapshot();
+		size_t delta_bytes = 0;
+		double encode_ms = 0.0;
+		double apply_ms = 0.0;
+
+		for (auto tick = 0; tick < N_TICKS; tick++) {
+			for (size_t i = 0; i < n_changed; i++) {
+				auto &body = entities[pick(rng)]->get_component_raw<Body>();
+				body.x += body.vx;
+				body.y += body.vy;
+			}
+
+			Delta delta{};
+			encode_ms += time_ms([&] { delta = scene.create_delta(baseline); });
+			apply_ms += time_ms([&] { baseline.apply_delta(delta); });
+			delta_bytes += delta.data.size();
+		}
+
+		fmt::print("{:>7}% {:>12} {:>12} {:>12.4f} {:>12.4f}\n", percent, delta_bytes / N_TICKS, MAX_ENTITIES * sizeof(Body), encode_ms / N_TICKS, apply_ms / N_TICKS);
+	}
+}
@@ -0,0 +1,68 @@
+#include <SDL.h>
+#include <fmt/core.h>
+
+#include "bench.hpp"
+#include "context.hpp"
+#include "sdl/render_target.hpp"
+#include "sdl/types.hpp"
+#include "sdl/window.hpp"
+
+constexpr WindowOptions BENCH_WINDOW_OPTIONS{
+	.title = "fill rate benchmark",
+	.x = SDL_WINDOWPOS_UNDEFINED,
+	.y = SDL_WINDOWPOS_UNDEFINED,
+	.w = 1280,
+	.h = 720,
+	.offscreen = true,
+};
+
+constexpr auto TILE_SIZE = 32;
+constexpr auto N_FRAMES = 50;
+
+int main() {
+	Context ctx{BENCH_WINDOW_OPTIONS};
+	auto &window = ctx.get_window();
+	auto width = BENCH_WINDOW_OPTIONS.w;
+	auto height = BENCH_WINDOW_OPTIONS.h;
+
+	auto tile = window.create_render_target(TILE_SIZE, TILE_SIZE);
+	window.set_target(&tile);
+	window.set_clear_color(0x40, 0x80, 0x40);
+	window.clear();
+
+	auto draw_tiles = [&] {
+		for (auto y = 0; y < height; y += TILE_SIZE) {
+			for (auto x = 0; x < width; x += TILE_SIZE) {
+				SDL_Rect dstrect{x, y, TILE_SIZE, TILE_SIZE};
+				window.render(tile.get_texture(), nullptr, &dstrect);
+			}
+		}
+	};
+
+	// The whole background is drawn once, then copied as a single texture
+	auto background = window.create_render_target(width, height);
+	window.set_target(&background);
+	draw_tiles();
+	window.set_target(nullptr);
+
+	auto n_tiles = (width / TILE_SIZE) * (height / TILE_SIZE);
+	auto tiles_ms = time_ms([&] {
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			window.clear();
+			draw_tiles();
+			window.present();
+		}
+	}) / N_FRAMES;
+
+	auto cached_ms = time_ms([&] {
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			window.clear();
+			window.render(background.get_texture());
+			window.present();
+		}
+	}) / N_FRAMES;
+
+	auto megapixels = width * height / 1'000'000.0;
+	fmt::print("{:>10} {:>12} {:>12} {:>12} {:>12}\n", "draws", "tiles ms", "tiles Mpx/s", "cached ms", "cached Mpx/s");
+	fmt::print("{:>10} {:>12.3f} {:>12.1f} {:>12.3f} {:>12.1f}\n", n_tiles, tiles_ms, megapixels / tiles_ms * 1000.0, cached_ms, megapixels / cached_ms * 1000.0);
+}
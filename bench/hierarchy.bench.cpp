@@ -0,0 +1,77 @@
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "engine/transform.hpp"
+#include "engine/transform_propagation.hpp"
+#include "util/thread_pool.hpp"
+
+constexpr auto TARGET_NODES = 100'000;
+constexpr auto NODES_PER_TREE = 100;
+constexpr auto BRANCHING = 4;
+constexpr auto N_FRAMES = 100;
+
+auto run(ThreadPool *pool) -> void {
+	auto n_nodes = std::min(TARGET_NODES, MAX_ENTITIES);
+
+	Scene scene{};
+	auto &propagation = scene.create_system<TransformPropagation, Transform, GlobalTransform>();
+
+	std::vector<std::shared_ptr<Entity>> nodes{};
+	std::vector<std::shared_ptr<Entity>> roots{};
+	for (auto i = 0; i < n_nodes; i++) {
+		auto node = scene.create_entity();
+		node->create_component<Transform>(Vector2{1.0f, 1.0f});
+		node->create_component<GlobalTransform>();
+
+		auto index_in_tree = i % NODES_PER_TREE;
+		if (index_in_tree == 0)
+			roots.push_back(node);
+		else
+			node->create_component<Parent>(nodes[i - index_in_tree + (index_in_tree - 1) / BRANCHING]->get_id());
+
+		nodes.push_back(std::move(node));
+	}
+
+	auto rebuild_ms = time_ms([&] { propagation.update(scene, pool); });
+
+	auto frame_ms = [&](auto &targets, size_t n_moved) {
+		std::mt19937 rng{42};
+		std::uniform_int_distribution<size_t> pick{0, targets.size() - 1};
+		auto total = 0.0;
+
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			scene.advance_tick();
+			for (size_t i = 0; i < n_moved; i++) {
+				auto index = n_moved == targets.size() ? i : pick(rng);
+				targets[index]->template get_component_raw<Transform>().position.x += 1.0f;
+			}
+			total += time_ms([&] { propagation.update(scene, pool); });
+		}
+
+		return total / N_FRAMES;
+	};
+
+	auto idle_ms = frame_ms(roots, 0);
+	auto roots_ms = frame_ms(roots, roots.size() / 100 + 1);
+	auto all_roots_ms = frame_ms(roots, roots.size());
+	auto leaves_ms = frame_ms(nodes, nodes.size() / 100);
+
+	fmt::print("{:>8} {:>8} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f}\n", n_nodes, pool ? pool->get_thread_count() : 1, rebuild_ms, idle_ms, roots_ms, all_roots_ms, leaves_ms);
+}
+
+int main() {
+	fmt::print("{:>8} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10}\n", "nodes", "threads", "rebuild", "idle", "1% roots", "all roots", "1% nodes");
+
+	run(nullptr);
+
+	ThreadPool pool{};
+	run(&pool);
+}
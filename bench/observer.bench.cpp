@@ -0,0 +1,55 @@
+#include <fmt/core.h>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+
+constexpr auto N_ENTITIES = MAX_ENTITIES / 2;
+constexpr auto N_FRAMES = 100;
+
+struct Marker {
+	float x = 0.0f, y = 0.0f;
+};
+
+// Every frame, every entity loses its marker and gets a new one, like short-lived status effects
+static auto churn(bool observed) -> double {
+	Scene scene{};
+	size_t n_seen = 0;
+	if (observed) {
+		auto count = [&](Scene &, std::span<const EntityId> ids) { n_seen += ids.size(); };
+		scene.observe<OnAdd<Marker>>(count);
+		scene.observe<OnRemove<Marker>>(count);
+	}
+
+	std::vector<std::shared_ptr<Entity>> entities{};
+	for (auto i = 0; i < N_ENTITIES; i++)
+		entities.push_back(scene.create_entity());
+
+	auto total_ms = time_ms([&] {
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			for (auto &entity : entities)
+				entity->create_component<Marker>();
+			for (auto &entity : entities)
+				entity->remove_component<Marker>();
+			scene.flush_events();
+			scene.advance_tick();
+		}
+	});
+
+	if (observed && n_seen != static_cast<size_t>(N_ENTITIES) * 2 * N_FRAMES)
+		fmt::print("Observers missed events: {}\n", n_seen);
+	return total_ms / N_FRAMES;
+}
+
+int main() {
+	fmt::print("{:>12} {:>12} {:>12}\n", "observers", "frame ms", "ns/event");
+	for (auto observed : {false, true}) {
+		auto frame_ms = churn(observed);
+		fmt::print("{:>12} {:>12.3f} {:>12.1f}\n", observed ? "2" : "0", frame_ms, frame_ms * 1e6 / (N_ENTITIES * 2));
+	}
+}
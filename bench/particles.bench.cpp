@@ -0,0 +1,93 @@
+#include <SDL.h>
+#include <fmt/core.h>
+
+#include <memory>
+#include <vector>
+
+#include "bench.hpp"
+#include "context.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "engine/camera.hpp"
+#include "engine/particles.hpp"
+#include "engine/transform.hpp"
+#include "sdl/render_list.hpp"
+#include "sdl/types.hpp"
+#include "sdl/window.hpp"
+
+constexpr WindowOptions BENCH_WINDOW_OPTIONS{
+	.title = "particle benchmark",
+	.x = SDL_WINDOWPOS_UNDEFINED,
+	.y = SDL_WINDOWPOS_UNDEFINED,
+	.w = 1280,
+	.h = 720,
+	.offscreen = true,
+};
+
+// 100 emitters spawning 1000 particles per second each, which live for a second
+constexpr auto N_EMITTERS = 100;
+constexpr auto RATE = 1000.0f;
+constexpr auto LIFETIME = 1.0f;
+constexpr auto N_WARMUP_FRAMES = 60;
+constexpr auto N_FRAMES = 120;
+constexpr auto DT = 1.0f / 60.0f;
+
+int main() {
+	Context ctx{BENCH_WINDOW_OPTIONS};
+	auto &window = ctx.get_window();
+	auto scene = ctx.create_scene();
+	scene.create_resource<Camera>(Vector2{0.0f, 0.0f}, Vector2{BENCH_WINDOW_OPTIONS.w, BENCH_WINDOW_OPTIONS.h});
+	auto &particle_system = scene.create_system<ParticleSystem, GlobalTransform, ParticleEmitter>();
+
+	std::vector<std::shared_ptr<Entity>> emitters{};
+	for (auto i = 0; i < N_EMITTERS; i++) {
+		auto &entity = emitters.emplace_back(scene.create_entity());
+		Vector2 position{static_cast<float>(i % 10) * 128.0f + 64.0f, static_cast<float>(i / 10) * 72.0f};
+		entity->create_component<GlobalTransform>(position);
+
+		auto &emitter = entity->create_component<ParticleEmitter>();
+		emitter.settings.rate = RATE;
+		emitter.settings.lifetime = LIFETIME;
+		emitter.settings.acceleration = {0.0f, -100.0f};
+		emitter.settings.capacity = static_cast<size_t>(RATE * LIFETIME) + 16;
+		emitter.seed = static_cast<std::uint32_t>(i + 1);
+	}
+
+	for (auto frame = 0; frame < N_WARMUP_FRAMES; frame++)
+		particle_system.update(scene, DT);
+
+	auto live = [&] {
+		size_t n = 0;
+		for (auto &entity : emitters)
+			n += entity->read_component<ParticleEmitter>().particles.size();
+		return n;
+	};
+
+	RenderList list{};
+	size_t n_updated = 0, n_drawn = 0;
+	double update_ms = 0.0, record_ms = 0.0, draw_ms = 0.0;
+	for (auto frame = 0; frame < N_FRAMES; frame++) {
+		n_updated += live();
+		update_ms += time_ms([&] { particle_system.update(scene, DT); });
+		n_drawn += live();
+
+		list.clear();
+		record_ms += time_ms([&] { particle_system.render(list, scene); });
+		// SDL batches draw calls until the frame is presented, so presenting is part of drawing
+		draw_ms += time_ms([&] {
+			window.render(list);
+			window.present();
+		});
+	}
+
+	fmt::print("{:>10} {:>12} {:>12} {:>12} {:>16} {:>16}\n", "particles", "update ms", "record ms", "draw ms", "updated per ms", "drawn per ms");
+	fmt::print(
+		"{:>10} {:>12.3f} {:>12.3f} {:>12.3f} {:>16.0f} {:>16.0f}\n",
+		n_drawn / N_FRAMES,
+		update_ms / N_FRAMES,
+		record_ms / N_FRAMES,
+		draw_ms / N_FRAMES,
+		static_cast<double>(n_updated) / update_ms,
+		static_cast<double>(n_drawn) / (record_ms + draw_ms)
+	);
+}
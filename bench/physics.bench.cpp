@@ -0,0 +1,81 @@
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "engine/physics.hpp"
+#include "engine/transform.hpp"
+
+// Set the `max_entities` build option to 131072 to run the largest size
+constexpr int TARGET_BODIES[] = {10'000, 100'000};
+constexpr auto BODY_SIZE = 8.0f;
+constexpr auto STACK_HEIGHT = 10;
+constexpr auto N_STEPS = 60;
+constexpr auto N_SETTLE_STEPS = 600;
+
+auto run(Scene &scene, PhysicsSystem &physics, int steps) -> void {
+	for (auto i = 0; i < steps; i++) {
+		physics.step(scene);
+		scene.advance_tick();
+	}
+}
+
+int main() {
+	fmt::print("{:>8} {:>14} {:>8} {:>14} {:>8}\n", "bodies", "falling ms", "awake", "settled ms", "awake");
+
+	for (auto target : TARGET_BODIES) {
+		// One entity is the floor
+		auto n_bodies = std::min(target, MAX_ENTITIES - 1);
+		auto n_stacks = (n_bodies + STACK_HEIGHT - 1) / STACK_HEIGHT;
+
+		Scene scene{};
+		auto &physics = scene.create_system<PhysicsSystem, Transform, RigidBody, Velocity>();
+		PhysicsSettings settings{};
+		settings.cell_size = BODY_SIZE * 2.0f;
+		physics.set_settings(settings);
+
+		std::vector<std::shared_ptr<Entity>> entities{};
+		entities.reserve(n_bodies + 1);
+
+		auto floor_width = static_cast<float>(n_stacks) * BODY_SIZE * 2.0f;
+		auto &floor = entities.emplace_back(scene.create_entity());
+		floor->create_component<Transform>(Vector2{0.0f, -BODY_SIZE}, Vector2{floor_width, BODY_SIZE});
+		floor->create_component<RigidBody>(0.0f);
+		floor->create_component<Velocity>();
+
+		// Stacks of boxes dropped from slightly different heights, so they land at different times
+		for (auto i = 0; i < n_bodies; i++) {
+			auto stack = i / STACK_HEIGHT;
+			auto level = i % STACK_HEIGHT;
+			auto x = static_cast<float>(stack) * BODY_SIZE * 2.0f;
+			auto y = static_cast<float>(level) * BODY_SIZE * 1.5f + static_cast<float>(stack % 7) * BODY_SIZE;
+
+			auto &entity = entities.emplace_back(scene.create_entity());
+			entity->create_component<Transform>(Vector2{x, y}, Vector2{BODY_SIZE, BODY_SIZE});
+			entity->create_component<RigidBody>();
+			entity->create_component<Velocity>();
+		}
+
+		auto falling_ms = time_ms([&] { run(scene, physics, N_STEPS); });
+		auto falling_awake = physics.get_stats().awake_bodies;
+
+		run(scene, physics, N_SETTLE_STEPS);
+
+		auto settled_ms = time_ms([&] { run(scene, physics, N_STEPS); });
+		auto settled_awake = physics.get_stats().awake_bodies;
+
+		fmt::print(
+			"{:>8} {:>14.3f} {:>8} {:>14.3f} {:>8}\n",
+			n_bodies,
+			falling_ms / N_STEPS,
+			falling_awake,
+			settled_ms / N_STEPS,
+			settled_awake
+		);
+	}
+}
@@ -0,0 +1,83 @@
+#include <fmt/core.h>
+
+#include <memory>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/prefab.hpp"
+#include "ecs/scene.hpp"
+#include "engine/physics.hpp"
+#include "engine/transform.hpp"
+#include "engine/transform_propagation.hpp"
+
+// Every entity gets the same components as the demo's player
+constexpr auto N_ENTITIES = MAX_ENTITIES;
+constexpr auto N_RUNS = 10;
+
+struct Player {
+	float speed = 200.0f;
+};
+
+struct Health {
+	int value = 100;
+};
+
+class PlayerSystem : public System {};
+class HealthSystem : public System {};
+class RenderSystem : public System {};
+
+// A scene with a typical set of systems, since each one is checked whenever an entity's components change
+static auto create_scene() -> std::unique_ptr<Scene> {
+	auto scene = std::make_unique<Scene>();
+	scene->create_system<TransformPropagation, Transform, GlobalTransform>();
+	scene->create_system<PhysicsSystem, Transform, RigidBody, Velocity>();
+	scene->create_system<PlayerSystem, Velocity, Player>();
+	scene->create_system<HealthSystem, Health>();
+	scene->create_system<RenderSystem, GlobalTransform>();
+	return scene;
+}
+
+// Scenes never reuse entity IDs, so every run gets a new scene, which isn't timed
+template <typename F>
+static auto run(F &&create) -> double {
+	auto total = 0.0;
+	for (auto i = 0; i < N_RUNS; i++) {
+		auto scene = create_scene();
+		std::vector<std::shared_ptr<Entity>> entities{};
+		entities.reserve(N_ENTITIES);
+		total += time_ms([&] { create(*scene, entities); });
+	}
+	return total / N_RUNS;
+}
+
+int main() {
+	Prefab player{};
+	player.add<Transform>().add<GlobalTransform>().add<Player>().add<Health>().add<RigidBody>().add<Velocity>();
+
+	auto chained_ms = run([](Scene &scene, std::vector<std::shared_ptr<Entity>> &entities) {
+		for (auto i = 0; i < N_ENTITIES; i++) {
+			auto &entity = entities.emplace_back(scene.create_entity());
+			entity->create_component<Transform>();
+			entity->create_component<GlobalTransform>();
+			entity->create_component<Player>();
+			entity->create_component<Health>();
+			entity->create_component<RigidBody>();
+			entity->create_component<Velocity>();
+		}
+	});
+	auto single_ms = run([&](Scene &scene, std::vector<std::shared_ptr<Entity>> &entities) {
+		for (auto i = 0; i < N_ENTITIES; i++)
+			entities.push_back(scene.instantiate(player));
+	});
+	auto bulk_ms = run([&](Scene &scene, std::vector<std::shared_ptr<Entity>> &entities) {
+		entities = scene.instantiate(player, N_ENTITIES);
+	});
+
+	fmt::print("{:>24} {:>10} {:>10}\n", "method", "ms", "speedup");
+	fmt::print("{:>24} {:>10.3f} {:>10.2f}\n", "create_component chain", chained_ms, 1.0);
+	fmt::print("{:>24} {:>10.3f} {:>10.2f}\n", "instantiate each", single_ms, chained_ms / single_ms);
+	fmt::print("{:>24} {:>10.3f} {:>10.2f}\n", "instantiate batch", bulk_ms, chained_ms / bulk_ms);
+	fmt::print("{} entities with {} components\n", N_ENTITIES, player.size());
+}
@@ -0,0 +1,107 @@
+#include <SDL.h>
+#include <fmt/core.h>
+
+#include <chrono>
+
+#include "bench.hpp"
+#include "context.hpp"
+#include "sdl/render_list.hpp"
+#include "sdl/render_thread.hpp"
+#include "sdl/surface.hpp"
+#include "sdl/texture.hpp"
+#include "sdl/types.hpp"
+#include "sdl/window.hpp"
+
+constexpr WindowOptions BENCH_WINDOW_OPTIONS{
+	.title = "render thread benchmark",
+	.x = SDL_WINDOWPOS_UNDEFINED,
+	.y = SDL_WINDOWPOS_UNDEFINED,
+	.w = 640,
+	.h = 480,
+	.window_flags = SDL_WINDOW_HIDDEN,
+	.renderer_flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC,
+};
+
+constexpr auto N_FRAMES = 120;
+constexpr auto N_SPRITES = 1000;
+constexpr auto SPRITE_SIZE = 32;
+constexpr auto SIMULATE_MS = {0.0, 4.0, 8.0, 12.0};
+
+// Stands in for a frame of game logic
+auto simulate(double ms) -> void {
+	auto end = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(ms);
+	while (std::chrono::steady_clock::now() < end) {}
+}
+
+// A sprite with an alpha gradient, so every copy is sampled and blended like a real one
+auto create_sprite() -> Surface {
+	Surface sprite{SPRITE_SIZE, SPRITE_SIZE};
+	for (auto y = 0; y < SPRITE_SIZE; y++) {
+		for (auto x = 0; x < SPRITE_SIZE; x++) {
+			auto value = static_cast<Uint8>((x + y) * 255 / (SPRITE_SIZE * 2 - 2));
+			sprite.set_pixel(x, y, {value, 0x40, static_cast<Uint8>(0xff - value), value});
+		}
+	}
+	return sprite;
+}
+
+// Textures belong to the renderer they were created with, so each renderer gets its own copy of the sprite
+auto upload(const Surface &sprite, SDL_Renderer *renderer) -> Texture {
+	return Texture{SDL_CreateTextureFromSurface(renderer, *sprite)};
+}
+
+auto record(RenderList &list, const Texture &texture, int frame) -> void {
+	list.set_clear_color(0xaa, 0xaa, 0xaa);
+	for (auto i = 0; i < N_SPRITES; i++) {
+		SDL_Rect dstrect{(i * 7 + frame) % 640, (i * 13) % 480, 16, 16};
+		list.render(texture, nullptr, &dstrect);
+	}
+}
+
+int main() {
+	Context ctx{BENCH_WINDOW_OPTIONS};
+	auto &window = ctx.get_window();
+	auto sprite = create_sprite();
+	auto texture = upload(sprite, window.get_renderer());
+
+	fmt::print("{:>10} {:>10} {:>10} {:>12} {:>10} {:>10} {:>12}\n", "simulate", "sync fps", "sync ms", "sync latency", "async fps", "async ms", "async latency");
+
+	for (auto simulate_ms : SIMULATE_MS) {
+		RenderList list{};
+		auto sync_latency_ms = 0.0;
+		auto sync_ms = time_ms([&] {
+			for (auto frame = 0; frame < N_FRAMES; frame++) {
+				simulate(simulate_ms);
+				list.clear();
+				record(list, texture, frame);
+				sync_latency_ms += time_ms([&] {
+					window.render(list);
+					window.present();
+				});
+			}
+		});
+
+		// The render thread creates its own renderer, on a window that never had one
+		auto async_options = BENCH_WINDOW_OPTIONS;
+		async_options.render_thread = true;
+		Window async_window{async_options};
+
+		RenderStats stats{};
+		auto async_ms = time_ms([&] {
+			RenderThread render_thread{async_window};
+			Texture async_texture{};
+			render_thread.invoke([&](SDL_Renderer *renderer) { async_texture = upload(sprite, renderer); });
+
+			for (auto frame = 0; frame < N_FRAMES; frame++) {
+				simulate(simulate_ms);
+				record(render_thread.begin_frame(), async_texture, frame);
+				render_thread.submit();
+			}
+			render_thread.flush();
+			stats = render_thread.get_stats();
+			render_thread.invoke([&](SDL_Renderer *) { async_texture = Texture{}; });
+		});
+
+		fmt::print("{:>10.1f} {:>10.1f} {:>10.3f} {:>12.3f} {:>10.1f} {:>10.3f} {:>12.3f}\n", simulate_ms, N_FRAMES / sync_ms * 1000.0, sync_ms / N_FRAMES, sync_latency_ms / N_FRAMES, N_FRAMES / async_ms * 1000.0, async_ms / N_FRAMES, stats.mean_latency_ms);
+	}
+}
@@ -0,0 +1,41 @@
+#include <fmt/core.h>
+
+#include "bench.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "engine/time.hpp"
+
+constexpr auto N_ACCESSES = 10'000'000;
+
+int main() {
+	Scene scene{};
+
+	// The old way of storing a singleton: a component on a dummy entity
+	auto singleton = scene.create_entity();
+	singleton->create_component<DeltaTime>(1.0f);
+	scene.create_resource<DeltaTime>(1.0f);
+
+	auto total = 0.0f;
+	auto component_ms = time_ms([&] {
+		for (auto i = 0; i < N_ACCESSES; i++)
+			total += scene.read_component<DeltaTime>(*singleton).seconds;
+	});
+
+	auto resource_ms = time_ms([&] {
+		for (auto i = 0; i < N_ACCESSES; i++)
+			total += scene.resource<DeltaTime>().seconds;
+	});
+
+	// How a system that keeps a ResourceRef gets the resource
+	ResourceRef<DeltaTime> ref{};
+	auto ref_ms = time_ms([&] {
+		for (auto i = 0; i < N_ACCESSES; i++)
+			total += scene.resource(ref).seconds;
+	});
+
+	fmt::print("{:>12} {:>14} {:>14} {:>14}\n", "accesses", "component ns", "resource ns", "cached ns");
+	fmt::print("{:>12} {:>14.2f} {:>14.2f} {:>14.2f}\n", N_ACCESSES, component_ms * 1e6 / N_ACCESSES, resource_ms * 1e6 / N_ACCESSES, ref_ms * 1e6 / N_ACCESSES);
+
+	// Keeps the loops from being optimized away
+	return total < 0.0f;
+}
@@ -0,0 +1,94 @@
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "ecs/scene_set.hpp"
+#include "engine/transform.hpp"
+#include "engine/transform_propagation.hpp"
+#include "util/thread_pool.hpp"
+
+// Many small levels or matches running side by side, like a game server
+constexpr auto N_SCENES = 64;
+constexpr auto N_ENTITIES_PER_SCENE = 1'000;
+constexpr auto N_TICKS = 100;
+constexpr size_t THREAD_COUNTS[] = {1, 2, 4, 8};
+
+struct Level {
+	TransformPropagation *propagation;
+	std::vector<std::shared_ptr<Entity>> entities{};
+};
+
+static auto populate(Scene &scene) -> Level {
+	Level level{&scene.create_system<TransformPropagation, Transform, GlobalTransform>()};
+	for (auto i = 0; i < N_ENTITIES_PER_SCENE; i++) {
+		auto &entity = level.entities.emplace_back(scene.create_entity());
+		entity->create_component<Transform>(Vector2{static_cast<float>(i), 1.0f});
+		entity->create_component<GlobalTransform>();
+	}
+	return level;
+}
+
+static auto step_level(Scene &scene, Level &level) -> void {
+	for (auto &entity : level.entities)
+		entity->get_component_raw<Transform>().position.x += 1.0f;
+	level.propagation->update(scene, nullptr);
+	scene.advance_tick();
+}
+
+int main() {
+	fmt::print("{:>10} {:>12} {:>14} {:>10}\n", "threads", "tick ms", "vs sequential", "stolen");
+
+	// Stepping every scene in turn on one thread is the baseline
+	std::vector<std::unique_ptr<Scene>> sequential{};
+	std::vector<Level> sequential_levels{};
+	for (auto i = 0; i < N_SCENES; i++) {
+		auto &scene = *sequential.emplace_back(std::make_unique<Scene>());
+		sequential_levels.push_back(populate(scene));
+	}
+	auto baseline_ms = time_ms([&] {
+		for (auto tick = 0; tick < N_TICKS; tick++)
+			for (size_t i = 0; i < sequential.size(); i++)
+				step_level(*sequential[i], sequential_levels[i]);
+	}) / N_TICKS;
+	fmt::print("{:>10} {:>12.3f} {:>14.2f} {:>10}\n", "sequential", baseline_ms, 1.0, "-");
+	sequential_levels.clear();
+	sequential.clear();
+
+	// More threads than cores would only measure time slicing, so those rows are skipped rather than reported as a speedup
+	auto n_cores = std::max(std::thread::hardware_concurrency(), 1u);
+	std::vector<size_t> skipped{};
+	for (auto n_threads : THREAD_COUNTS) {
+		if (n_threads > n_cores) {
+			skipped.push_back(n_threads);
+			continue;
+		}
+
+		ThreadPool pool{n_threads};
+		SceneSet set{pool};
+		std::vector<std::unique_ptr<Level>> levels{};
+		for (auto i = 0; i < N_SCENES; i++) {
+			auto &level = levels.emplace_back(std::make_unique<Level>());
+			auto &scene = set.create_scene([&level = *level](Scene &scene, ThreadPool *) { step_level(scene, level); });
+			*level = populate(scene);
+		}
+
+		size_t stolen = 0;
+		auto tick_ms = time_ms([&] {
+			for (auto tick = 0; tick < N_TICKS; tick++) {
+				set.step();
+				stolen += set.get_tick_stats().stolen;
+			}
+		}) / N_TICKS;
+		fmt::print("{:>10} {:>12.3f} {:>14.2f} {:>10}\n", n_threads, tick_ms, baseline_ms / tick_ms, stolen);
+	}
+
+	if (!skipped.empty())
+		fmt::print("Skipped {} threads: only {} core(s), so no parallel speedup was measured.\n", fmt::join(skipped, ", "), n_cores);
+}
@@ -0,0 +1,70 @@
+#include <fmt/core.h>
+
+#include <vector>
+
+#include "bench.hpp"
+#include "engine/script.hpp"
+
+constexpr auto N_BEHAVIORS = 100000;
+constexpr auto N_FRAMES = 600;
+constexpr auto DELTA_SECONDS = 1.0 / 60.0;
+
+// Each behavior waits a while, does a little work, and waits again, like an NPC that idles between actions
+static auto interval(int i, double scale) -> double {
+	return scale * (1.0 + (i % 7) * 0.5);
+}
+
+struct Behavior {
+	double remaining;
+	int actions = 0;
+};
+
+// The usual alternative to scripts: every behavior's timer is checked every frame
+static auto run_polled(double scale) -> double {
+	std::vector<Behavior> behaviors{};
+	for (auto i = 0; i < N_BEHAVIORS; i++)
+		behaviors.push_back({interval(i, scale)});
+
+	auto total_ms = time_ms([&] {
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			for (size_t i = 0; i < behaviors.size(); i++) {
+				auto &behavior = behaviors[i];
+				behavior.remaining -= DELTA_SECONDS;
+				if (behavior.remaining > 0.0) continue;
+
+				behavior.actions++;
+				behavior.remaining += interval(static_cast<int>(i), scale);
+			}
+		}
+	});
+	return total_ms / N_FRAMES;
+}
+
+static auto idle(ScriptScheduler &, int i, double scale, int &actions) -> Script {
+	while (true) {
+		co_await seconds(interval(i, scale));
+		actions++;
+	}
+}
+
+static auto run_scripted(double scale) -> double {
+	ScriptScheduler scheduler{};
+	std::vector<int> actions(N_BEHAVIORS);
+	for (auto i = 0; i < N_BEHAVIORS; i++)
+		scheduler.start(idle(scheduler, i, scale, actions[i]));
+
+	auto total_ms = time_ms([&] {
+		for (auto frame = 0; frame < N_FRAMES; frame++)
+			scheduler.update(DELTA_SECONDS);
+	});
+	return total_ms / N_FRAMES;
+}
+
+int main() {
+	// Polling costs the same however long behaviors wait, while scripts only cost something when they wake
+	fmt::print("{:>12} {:>12} {:>12}\n", "waits", "polled ms", "scripts ms");
+	for (auto scale : {1.0, 10.0}) {
+		auto waits = fmt::format("{:.0f}-{:.0f}s", scale, scale * 4.0);
+		fmt::print("{:>12} {:>12.3f} {:>12.3f}\n", waits, run_polled(scale), run_scripted(scale));
+	}
+}
@@ -0,0 +1,73 @@
+#include <fmt/core.h>
+
+#include <bitset>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/signature.hpp"
+
+constexpr auto N_ENTITIES = 4096;
+constexpr auto N_SYSTEMS = 32;
+constexpr auto N_ROUNDS = 50;
+constexpr auto COMPONENTS_PER_ENTITY = 8;
+constexpr auto COMPONENTS_PER_SYSTEM = 3;
+
+// Random bits across the whole range, which is the worst case for the summary word
+template <size_t N>
+static auto random_ids(std::mt19937 &rng, int count) -> std::vector<size_t> {
+	std::uniform_int_distribution<size_t> distribution{0, N - 1};
+	std::vector<size_t> ids(count);
+	for (auto &id : ids)
+		id = distribution(rng);
+	return ids;
+}
+
+template <typename S, size_t N>
+static auto bench_matching(auto &&matches) -> double {
+	std::mt19937 rng{N};
+
+	std::vector<S> entities(N_ENTITIES);
+	for (auto &signature : entities)
+		for (auto id : random_ids<N>(rng, COMPONENTS_PER_ENTITY))
+			signature.set(id);
+
+	// Systems are built from entity signatures so some of them actually match
+	std::vector<S> systems(N_SYSTEMS);
+	for (auto &signature : systems) {
+		auto &source = entities[rng() % N_ENTITIES];
+		for (auto id : random_ids<N>(rng, COMPONENTS_PER_SYSTEM))
+			if (source.test(id) || rng() % 2 == 0)
+				signature.set(id);
+	}
+
+	size_t n_matches = 0;
+	auto ms = time_ms([&] {
+		for (auto round = 0; round < N_ROUNDS; round++)
+			for (auto &entity : entities)
+				for (auto &system : systems)
+					n_matches += matches(entity, system);
+	});
+
+	if (n_matches == static_cast<size_t>(-1))
+		fmt::print("Impossible.\n");
+
+	return ms * 1e6 / (static_cast<double>(N_ENTITIES) * N_SYSTEMS * N_ROUNDS);
+}
+
+template <size_t N>
+static auto print_row() -> void {
+	auto bitset_ns = bench_matching<std::bitset<N>, N>([](const auto &entity, const auto &system) { return (entity & system) == system; });
+	auto signature_ns = bench_matching<BasicSignature<N>, N>([](const auto &entity, const auto &system) { return entity.contains(system); });
+
+	fmt::print("{:>10} {:>14} {:>14} {:>14.2f} {:>14.2f}\n", N, sizeof(std::bitset<N>), sizeof(BasicSignature<N>), bitset_ns, signature_ns);
+}
+
+int main() {
+	fmt::print("{:>10} {:>14} {:>14} {:>14} {:>14}\n", "types", "bitset bytes", "summary bytes", "bitset ns", "summary ns");
+	print_row<64>();
+	print_row<256>();
+	print_row<1024>();
+	print_row<4096>();
+}
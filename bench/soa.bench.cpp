@@ -0,0 +1,95 @@
+#include <fmt/core.h>
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "math/vector2.hpp"
+
+// Set the `max_entities` build option to 1048576 to run this at a million entities
+constexpr auto N_ENTITIES = MAX_ENTITIES;
+constexpr auto N_STEPS = 100;
+constexpr auto DT = 1.0f / 60.0f;
+
+struct Body {
+	Vector2 position;
+	Vector2 velocity;
+	Vector2 scale;
+	float rotation;
+	float angular_velocity;
+};
+
+struct SoaBody {
+	float x, y;
+	float vx, vy;
+	float sx, sy;
+	float rotation;
+	float angular_velocity;
+};
+
+template <>
+struct SoaLayout<SoaBody> {
+	static constexpr auto fields = std::tuple{
+		&SoaBody::x,
+		&SoaBody::y,
+		&SoaBody::vx,
+		&SoaBody::vy,
+		&SoaBody::sx,
+		&SoaBody::sy,
+		&SoaBody::rotation,
+		&SoaBody::angular_velocity,
+	};
+};
+
+int main() {
+	Scene scene{};
+
+	std::vector<std::shared_ptr<Entity>> entities{};
+	entities.reserve(N_ENTITIES);
+	for (auto i = 0; i < N_ENTITIES; i++) {
+		auto &entity = entities.emplace_back(scene.create_entity());
+		auto v = static_cast<float>(i % 17) - 8.0f;
+		entity->create_component<Body>(Vector2{0.0f, 0.0f}, Vector2{v, -v}, Vector2{1.0f, 1.0f}, 0.0f, v);
+		entity->create_component<SoaBody>(0.0f, 0.0f, v, -v, 1.0f, 1.0f, 0.0f, v);
+	}
+
+	auto &bodies = scene.group<Body>();
+	auto aos_ms = time_ms([&] {
+		for (auto step = 0; step < N_STEPS; step++) {
+			for (auto &body : bodies.get<Body>()) {
+				body.position += body.velocity * DT;
+				body.rotation += body.angular_velocity * DT;
+			}
+		}
+	});
+
+	auto soa_ms = time_ms([&] {
+		for (auto step = 0; step < N_STEPS; step++) {
+			auto x = scene.get_field<&SoaBody::x>();
+			auto y = scene.get_field<&SoaBody::y>();
+			auto vx = scene.read_field<&SoaBody::vx>();
+			auto vy = scene.read_field<&SoaBody::vy>();
+			auto rotation = scene.get_field<&SoaBody::rotation>();
+			auto angular_velocity = scene.read_field<&SoaBody::angular_velocity>();
+
+			for (size_t i = 0; i < x.size(); i++) {
+				x[i] += vx[i] * DT;
+				y[i] += vy[i] * DT;
+				rotation[i] += angular_velocity[i] * DT;
+			}
+		}
+	});
+
+	// Both layouts should have integrated to the same place
+	auto aos = bodies.read<Body>();
+	auto soa = scene.read_field<&SoaBody::x>();
+	if (aos.front().position.x != soa.front())
+		fmt::print("Layouts disagree: {} != {}\n", aos.front().position.x, soa.front());
+
+	auto per_entity = [](double ms) { return ms * 1e6 / (static_cast<double>(N_ENTITIES) * N_STEPS); };
+	fmt::print("{:>10} {:>12} {:>12} {:>10}\n", "entities", "AoS ns", "SoA ns", "speedup");
+	fmt::print("{:>10} {:>12.3f} {:>12.3f} {:>9.2f}x\n", N_ENTITIES, per_entity(aos_ms), per_entity(soa_ms), aos_ms / soa_ms);
+}
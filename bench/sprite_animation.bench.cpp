@@ -0,0 +1,103 @@
+#include <fmt/core.h>
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "ecs/system.hpp"
+#include "engine/sprite_animation.hpp"
+
+// Set the `max_entities` build option to 65536 to run this at the full size
+constexpr auto TARGET_SPRITES = 50'000;
+constexpr auto N_CLIPS = 16;
+constexpr auto N_FRAMES = 200;
+constexpr auto DT = 1.0f / 60.0f;
+
+// The per-entity approach: each animation points at its clip and computes its own source rect
+struct NaiveAnimation {
+	const AnimationClip *clip;
+	float time;
+	float speed;
+	SDL_Rect srcrect;
+};
+
+class NaiveAnimationSystem : public System {
+   public:
+	auto update(float seconds) -> void {
+		for (auto &entity : entities) {
+			auto &animation = entity->get_component_raw<NaiveAnimation>();
+			auto &clip = *animation.clip;
+			auto duration = static_cast<float>(clip.frames.size()) / clip.frames_per_second;
+
+			animation.time += seconds * animation.speed;
+			if (clip.looping)
+				animation.time = std::fmod(animation.time, duration);
+			else if (animation.time > duration)
+				animation.time = duration;
+
+			auto frame = static_cast<size_t>(animation.time * clip.frames_per_second);
+			if (frame >= clip.frames.size())
+				frame = clip.frames.size() - 1;
+			animation.srcrect = clip.frames[frame];
+		}
+	}
+};
+
+int main() {
+	auto n_sprites = std::min(TARGET_SPRITES, MAX_ENTITIES);
+
+	Scene scene{};
+	auto &library = scene.create_resource<AnimationLibrary>();
+	auto &naive_system = scene.create_system<NaiveAnimationSystem, NaiveAnimation>();
+	auto &animation_system = scene.create_system<SpriteAnimationSystem, SpriteAnimation>();
+
+	// Clips of 4 to 19 frames from a 1024x1024 sheet of 32x32 frames
+	std::vector<AnimationId> clips{};
+	for (auto i = 0; i < N_CLIPS; i++) {
+		AnimationClip clip{.frames_per_second = 8.0f + static_cast<float>(i), .looping = i % 4 != 0};
+		for (auto frame = 0; frame < 4 + i; frame++)
+			clip.frames.push_back({(frame % 32) * 32, (i * 2 + frame / 32) * 32, 32, 32});
+		clips.push_back(library.add_clip(clip));
+	}
+
+	std::vector<std::shared_ptr<Entity>> sprites{};
+	sprites.reserve(n_sprites);
+	for (auto i = 0; i < n_sprites; i++) {
+		auto &sprite = sprites.emplace_back(scene.create_entity());
+		auto clip = clips[i % N_CLIPS];
+		auto speed = 0.5f + static_cast<float>(i % 7) * 0.25f;
+		sprite->create_component<NaiveAnimation>(&library.get_clip(clip), 0.0f, speed, SDL_Rect{});
+		sprite->create_component<SpriteAnimation>(library.play(clip, speed));
+	}
+
+	// Rendering reads each source rect, so that's included for both
+	auto checksum = 0;
+	auto naive_ms = time_ms([&] {
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			naive_system.update(DT);
+			for (auto &sprite : sprites)
+				checksum += sprite->read_component<NaiveAnimation>().srcrect.x;
+		}
+	});
+
+	auto table_ms = time_ms([&] {
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			animation_system.update(scene, DT);
+			for (auto index : scene.read_field<&SpriteAnimation::frame>())
+				checksum += library.get_frame(index).x;
+		}
+	});
+
+	fmt::print("{:>8} {:>16} {:>16}\n", "sprites", "per-entity ms", "frame table ms");
+	fmt::print("{:>8} {:>16.3f} {:>16.3f}\n", n_sprites, naive_ms / N_FRAMES, table_ms / N_FRAMES);
+
+	// Keeps the loops from being optimized away
+	return checksum < 0;
+}
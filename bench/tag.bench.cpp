@@ -0,0 +1,74 @@
+#include <fmt/core.h>
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/component.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+
+constexpr auto N_ENTITIES = MAX_ENTITIES / 2;
+constexpr auto N_ROUNDS = 100;
+
+struct Tagged {};
+
+// The old way of storing a marker: a component with a byte of data that nobody reads
+struct Flagged {
+	bool value = true;
+};
+
+template <typename T>
+static auto bench_component(Scene &scene, const std::vector<std::shared_ptr<Entity>> &entities) -> double {
+	size_t hits = 0;
+
+	auto ms = time_ms([&] {
+		for (auto round = 0; round < N_ROUNDS; round++) {
+			for (auto &entity : entities)
+				entity->create_component<T>();
+			for (auto &entity : entities)
+				hits += entity->has_component<T>();
+			for (auto &entity : entities)
+				entity->remove_component<T>();
+			scene.advance_tick();
+		}
+	});
+
+	if (hits != static_cast<size_t>(N_ENTITIES) * N_ROUNDS)
+		fmt::print("Missed {} components.\n", static_cast<size_t>(N_ENTITIES) * N_ROUNDS - hits);
+
+	// Add, check, and remove for every entity in every round
+	return ms * 1e6 / (3.0 * N_ENTITIES * N_ROUNDS);
+}
+
+template <typename T>
+static auto array_bytes() -> size_t {
+	Tick tick = 0;
+	auto array = std::make_unique<ComponentArray<T>>(&tick);
+	for (EntityId id = 0; id < N_ENTITIES; id++)
+		array->create_component(id);
+
+	// Tag arrays grow their membership lists on the heap, so count what they reserved
+	size_t heap_bytes = 0;
+	if constexpr (std::is_empty_v<T>)
+		heap_bytes = array->size() * (sizeof(EntityId) + sizeof(Tick) + sizeof(std::uint32_t));
+	return sizeof(ComponentArray<T>) + heap_bytes;
+}
+
+int main() {
+	Scene scene{};
+
+	std::vector<std::shared_ptr<Entity>> entities{};
+	entities.reserve(N_ENTITIES);
+	for (auto i = 0; i < N_ENTITIES; i++)
+		entities.push_back(scene.create_entity());
+
+	auto flag_ns = bench_component<Flagged>(scene, entities);
+	auto tag_ns = bench_component<Tagged>(scene, entities);
+
+	fmt::print("{:>10} {:>10} {:>14} {:>10}\n", "type", "entities", "array bytes", "ns/op");
+	fmt::print("{:>10} {:>10} {:>14} {:>10.2f}\n", "component", N_ENTITIES, array_bytes<Flagged>(), flag_ns);
+	fmt::print("{:>10} {:>10} {:>14} {:>10.2f}\n", "tag", N_ENTITIES, array_bytes<Tagged>(), tag_ns);
+}
@@ -0,0 +1,59 @@
+#include <fmt/core.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "sdl/font.hpp"
+#include "sdl/render_list.hpp"
+#include "sdl/text.hpp"
+#include "sdl/texture.hpp"
+
+// A debug HUD: a few dozen lines, where only one number changes each frame
+constexpr auto N_LINES = 32;
+constexpr auto N_FRAMES = 10'000;
+
+int main() {
+	std::array<Glyph, Font::N_GLYPHS> glyphs{};
+	for (size_t index = 0; index < glyphs.size(); index++)
+		glyphs[index] = {{static_cast<int>(index % 16) * 8, static_cast<int>(index / 16) * 16, 8, 16}, 8};
+	Font font{Texture{}, glyphs, 18};
+
+	auto line = [](int index, int frame) {
+		return fmt::format("{:<24} {:>8.3f} ms", fmt::format("system {}", index), index == frame % N_LINES ? frame * 0.001 : index * 0.25);
+	};
+
+	RenderList list{};
+
+	// Laying out every line from scratch each frame
+	auto relayout_ms = time_ms([&] {
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			list.clear();
+			for (auto index = 0; index < N_LINES; index++) {
+				TextRun run{font};
+				run.set_text(line(index, frame));
+				run.set_position(8.0f, static_cast<float>(index * 18));
+				run.render(list);
+			}
+		}
+	});
+
+	std::vector<TextRun> runs(N_LINES, TextRun{font});
+	for (auto index = 0; index < N_LINES; index++)
+		runs[index].set_position(8.0f, static_cast<float>(index * 18));
+
+	auto n_laid_out = 0;
+	auto cached_ms = time_ms([&] {
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			list.clear();
+			for (auto index = 0; index < N_LINES; index++) {
+				n_laid_out += runs[index].set_text(line(index, frame));
+				runs[index].render(list);
+			}
+		}
+	});
+
+	fmt::print("{:>8} {:>16} {:>16} {:>20}\n", "lines", "relayout us", "cached us", "laid out per frame");
+	fmt::print("{:>8} {:>16.2f} {:>16.2f} {:>20.2f}\n", N_LINES, relayout_ms * 1000.0 / N_FRAMES, cached_ms * 1000.0 / N_FRAMES, static_cast<double>(n_laid_out) / N_FRAMES);
+}
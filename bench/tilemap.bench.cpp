@@ -0,0 +1,95 @@
+#include <SDL.h>
+#include <fmt/core.h>
+
+#include <initializer_list>
+
+#include "bench.hpp"
+#include "context.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "engine/camera.hpp"
+#include "engine/tilemap.hpp"
+#include "engine/transform.hpp"
+#include "sdl/render_list.hpp"
+#include "sdl/render_target.hpp"
+#include "sdl/types.hpp"
+#include "sdl/window.hpp"
+
+constexpr WindowOptions BENCH_WINDOW_OPTIONS{
+	.title = "tilemap benchmark",
+	.x = SDL_WINDOWPOS_UNDEFINED,
+	.y = SDL_WINDOWPOS_UNDEFINED,
+	.w = 1280,
+	.h = 720,
+	.offscreen = true,
+};
+
+// 16px tiles from an 8x8 tileset
+constexpr auto TILE_SIZE = 16;
+constexpr auto N_TILE_KINDS = 64;
+constexpr auto N_FRAMES = 120;
+
+int main() {
+	Context ctx{BENCH_WINDOW_OPTIONS};
+	auto &window = ctx.get_window();
+	auto tileset = window.create_render_target(TILE_SIZE * 8, TILE_SIZE * 8);
+
+	auto tile_at = [](int x, int y) {
+		return static_cast<TileId>((x * 7 + y * 13) % N_TILE_KINDS);
+	};
+
+	RenderList list{};
+
+	// Every tile copied on its own, as if each were an entity with a `Texture` and a `Transform`
+	constexpr auto N_BASELINE_TILES = 512;
+	auto baseline_record_ms = 0.0, baseline_draw_ms = 0.0;
+	for (auto frame = 0; frame < N_FRAMES / 10; frame++) {
+		list.clear();
+		baseline_record_ms += time_ms([&] {
+			for (auto y = 0; y < N_BASELINE_TILES; y++) {
+				for (auto x = 0; x < N_BASELINE_TILES; x++) {
+					auto tile = tile_at(x, y);
+					SDL_Rect srcrect{(tile % 8) * TILE_SIZE, (tile / 8) * TILE_SIZE, TILE_SIZE, TILE_SIZE};
+					SDL_Rect dstrect{x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE};
+					list.render(tileset.get_texture(), &srcrect, &dstrect);
+				}
+			}
+		});
+		baseline_draw_ms += time_ms([&] { window.render(list); });
+	}
+	fmt::print("{:>8} {:>12} {:>12} {:>12} {:>12}\n", "map", "chunks", "record ms", "draw ms", "rebuild ms");
+	fmt::print("{:>8} {:>12} {:>12.3f} {:>12.3f} {:>12}\n", "entities", "-", baseline_record_ms / (N_FRAMES / 10), baseline_draw_ms / (N_FRAMES / 10), "-");
+
+	// The camera scrolls diagonally across each map, so the cost should only depend on the size of the view
+	for (auto n_tiles : {128, 512, 2048}) {
+		auto scene = ctx.create_scene();
+		auto &camera = scene.create_resource<Camera>(Vector2{0.0f, 0.0f}, Vector2{BENCH_WINDOW_OPTIONS.w, BENCH_WINDOW_OPTIONS.h});
+		auto &tilemap_system = scene.create_system<TilemapSystem, GlobalTransform, Tilemap>();
+
+		auto entity = scene.create_entity();
+		entity->create_component<GlobalTransform>();
+		auto &tilemap = entity->create_component<Tilemap>(tileset.get_texture(), TILE_SIZE, n_tiles, n_tiles);
+		for (auto y = 0; y < n_tiles; y++)
+			for (auto x = 0; x < n_tiles; x++)
+				tilemap.set_tile(x, y, tile_at(x, y));
+
+		// The first frame lays out every visible chunk
+		list.clear();
+		auto rebuild_ms = time_ms([&] { tilemap_system.render(list, scene); });
+
+		auto extent = static_cast<float>(n_tiles * TILE_SIZE);
+		auto record_ms = 0.0, draw_ms = 0.0;
+		size_t n_chunks = 0;
+		for (auto frame = 0; frame < N_FRAMES; frame++) {
+			auto t = static_cast<float>(frame) / N_FRAMES;
+			camera.position = Vector2{extent - camera.size.x, extent - camera.size.y} * t;
+
+			list.clear();
+			record_ms += time_ms([&] { tilemap_system.render(list, scene); });
+			draw_ms += time_ms([&] { window.render(list); });
+			n_chunks += tilemap_system.get_stats().visible_chunks;
+		}
+
+		fmt::print("{:>8} {:>12.1f} {:>12.3f} {:>12.3f} {:>12.3f}\n", n_tiles, static_cast<double>(n_chunks) / N_FRAMES, record_ms / N_FRAMES, draw_ms / N_FRAMES, rebuild_ms);
+	}
+}
@@ -0,0 +1,76 @@
+#include <fmt/core.h>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "bench.hpp"
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+
+// Peak load: cooldowns, buffs and despawn timers spread over every entity
+constexpr auto N_TIMERS = 200000;
+constexpr auto N_FRAMES = 3600;
+
+struct CooldownEnded {};
+
+// Timers last between 1 and 60 seconds at 60 ticks per second, and restart when they end
+static auto get_delay(size_t i, int tick) -> Tick {
+	return static_cast<Tick>(60 + (i * 7919 + static_cast<size_t>(tick) * 31) % 3540);
+}
+
+struct Cooldown {
+	Tick remaining;
+	EntityId entity;
+};
+
+// The usual alternative to a timer service: a system that counts every timer down every frame
+static auto run_polled(size_t &n_expired) -> double {
+	std::vector<Cooldown> cooldowns{};
+	for (auto i = 0; i < N_TIMERS; i++)
+		cooldowns.push_back({get_delay(i, 0), static_cast<EntityId>(i % MAX_ENTITIES)});
+
+	auto total_ms = time_ms([&] {
+		for (auto tick = 1; tick <= N_FRAMES; tick++) {
+			for (size_t i = 0; i < cooldowns.size(); i++) {
+				if (--cooldowns[i].remaining > 0) continue;
+
+				n_expired++;
+				cooldowns[i].remaining = get_delay(cooldowns[i].entity, tick);
+			}
+		}
+	});
+	return total_ms / N_FRAMES;
+}
+
+static auto run_wheel(size_t &n_expired) -> double {
+	Scene scene{};
+	std::vector<std::shared_ptr<Entity>> entities{};
+	for (auto i = 0; i < MAX_ENTITIES; i++)
+		entities.push_back(scene.create_entity());
+
+	auto tick = 0;
+	scene.on_timer<CooldownEnded>([&](Scene &scene, std::span<const EntityId> ids) {
+		n_expired += ids.size();
+		for (auto id : ids)
+			scene.schedule<CooldownEnded>(*entities[id], get_delay(id, tick));
+	});
+	for (auto i = 0; i < N_TIMERS; i++)
+		scene.schedule<CooldownEnded>(*entities[i % MAX_ENTITIES], get_delay(i, 0));
+
+	auto total_ms = time_ms([&] {
+		for (tick = 1; tick <= N_FRAMES; tick++)
+			scene.advance_tick();
+	});
+	return total_ms / N_FRAMES;
+}
+
+int main() {
+	fmt::print("{:>12} {:>12} {:>12}\n", "timers", "frame ms", "expired");
+	size_t n_polled = 0, n_wheel = 0;
+	auto polled_ms = run_polled(n_polled);
+	fmt::print("{:>12} {:>12.3f} {:>12}\n", "polled", polled_ms, n_polled);
+	auto wheel_ms = run_wheel(n_wheel);
+	fmt::print("{:>12} {:>12.3f} {:>12}\n", "wheel", wheel_ms, n_wheel);
+}
@@ -1,5 +1,40 @@
 #include "context.hpp"
+#include "ecs/group.hpp"
+#include "ecs/observer.hpp"
+#include "ecs/prefab.hpp"
+#include "ecs/resource.hpp"
 #include "ecs/scene.hpp"
+#include "ecs/scene_set.hpp"
+#include "ecs/soa.hpp"
 #include "ecs/system.hpp"
+#include "ecs/timer.hpp"
+#include "engine/camera.hpp"
+#include "engine/event_queue.hpp"
+#include "engine/input_recording.hpp"
+#include "engine/input_state.hpp"
+#include "engine/particles.hpp"
+#include "engine/physics.hpp"
+#include "engine/prefab_loader.hpp"
+#include "engine/script.hpp"
+#include "engine/spatial_index.hpp"
+#include "engine/sprite_animation.hpp"
+#include "engine/tilemap.hpp"
+#include "engine/time.hpp"
+#include "engine/transform.hpp"
+#include "engine/transform_propagation.hpp"
+#include "math/bounds.hpp"
+#include "math/vector2.hpp"
+#include "sdl/asset_pack.hpp"
+#include "sdl/font.hpp"
+#include "sdl/render_list.hpp"
+#include "sdl/render_target.hpp"
+#include "sdl/render_thread.hpp"
+#include "sdl/surface.hpp"
+#include "sdl/text.hpp"
 #include "sdl/texture.hpp"
+#include "sdl/texture_reloader.hpp"
 #include "sdl/window.hpp"
+#include "util/file_watcher.hpp"
+#include "util/frame_pool.hpp"
+#include "util/mapped_file.hpp"
+#include "util/thread_pool.hpp"
@@ -1,6 +1,7 @@
 #include "context.hpp"
 
 #include <SDL_image.h>
+#include <SDL_ttf.h>
 
 #include <utility>
 
@@ -13,9 +14,11 @@ constexpr auto IMG_FLAGS = IMG_INIT_PNG | IMG_INIT_JPG;
 
 Context::Context(const WindowOptions& window_options) : window{window_options} {
 	check_error((IMG_Init(IMG_FLAGS) & IMG_FLAGS) == IMG_FLAGS, IMG_GetError);
+	check_error(TTF_Init(), TTF_GetError);
 }
 
 Context::~Context() {
+	TTF_Quit();
 	IMG_Quit();
 }
 
@@ -1,6 +1,88 @@
 #include "component.hpp"
 
+#include <vector>
+
+auto GenericComponentArray::set_observed(std::uint8_t mask) -> void {
+	observed = mask;
+
+	// Events that nobody observes anymore are dropped, so they aren't delivered to a later observer
+	std::erase_if(events, [&](const LifecycleRecord &record) { return !(mask & (1u << static_cast<unsigned>(record.event))); });
+}
+
+auto GenericComponentArray::take_events(std::vector<LifecycleRecord> &out) -> void {
+	out.insert(out.end(), events.begin(), events.end());
+	events.clear();
+}
+
 auto ComponentManager::entity_destroyed(EntityId id) -> void {
 	for (auto &[_, component_array] : component_arrays)
 		component_array->entity_destroyed(id);
-}
\ No newline at end of file
+}
+
+auto ComponentManager::get_component_array(ComponentId id) -> GenericComponentArray & {
+	return *component_arrays_by_id.at(id);
+}
+
+auto ComponentManager::get_tick() const -> Tick {
+	return tick;
+}
+
+auto ComponentManager::advance_tick() -> void {
+	tick++;
+
+	for (auto &[_, component_array] : component_arrays)
+		component_array->clear_removed(tick - 1);
+}
+
+auto ComponentManager::create_snapshot() -> Snapshot {
+	Snapshot snapshot{.tick = tick};
+
+	for (ComponentId id = 0; id < next_component_id; id++) {
+		ComponentSnapshot component{};
+		if (component_arrays_by_id[id]->write_snapshot(component))
+			snapshot.components.insert({id, std::move(component)});
+	}
+
+	advance_tick();
+	return snapshot;
+}
+
+auto ComponentManager::create_delta(const Snapshot &baseline) -> Delta {
+	Delta delta{.base_tick = baseline.tick, .tick = tick};
+	std::vector<std::byte> entries{};
+
+	for (ComponentId id = 0; id < next_component_id; id++) {
+		auto search = baseline.components.find(id);
+		auto component_baseline = search == baseline.components.end() ? nullptr : &search->second;
+
+		entries.clear();
+		auto n_entries = component_arrays_by_id[id]->write_delta(component_baseline, baseline.tick, entries);
+		if (n_entries == 0) continue;
+
+		write_varint(id, delta.data);
+		write_varint(component_arrays_by_id[id]->get_component_size(), delta.data);
+		write_varint(n_entries, delta.data);
+		delta.data.insert(delta.data.end(), entries.begin(), entries.end());
+	}
+
+	advance_tick();
+	return delta;
+}
+
+auto ComponentManager::restore_snapshot(const Snapshot &snapshot, const std::bitset<MAX_ENTITIES> &alive, const std::function<void(EntityId, ComponentId, bool)> &on_change) -> void {
+	std::vector<EntityId> added{};
+	std::vector<EntityId> removed{};
+
+	for (auto &[id, component] : snapshot.components) {
+		if (id >= next_component_id) continue;
+
+		added.clear();
+		removed.clear();
+		component_arrays_by_id[id]->restore_snapshot(component, alive, added, removed);
+
+		for (auto entity : added)
+			on_change(entity, id, true);
+		for (auto entity : removed)
+			on_change(entity, id, false);
+	}
+}
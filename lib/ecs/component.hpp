@@ -1,12 +1,24 @@
 #pragma once
 
 #include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "component_traits.hpp"
 #include "constants.hpp"
+#include "observer.hpp"
+#include "snapshot.hpp"
+#include "soa.hpp"
 #include "types.hpp"
 
 /// @brief An interface to allow storing a collection of component arrays.
@@ -14,18 +26,161 @@ class GenericComponentArray {
    public:
 	virtual ~GenericComponentArray() = default;
 	virtual auto entity_destroyed(EntityId id) -> void = 0;
+
+	/// @internal
+	/// @brief Get the size of one component in bytes.
+	/// @return The size of one component in bytes.
+	virtual auto get_component_size() const -> size_t = 0;
+
+	/// @internal
+	/// @brief Forget removal events from before a tick, and drop stale change log entries.
+	/// @param before The oldest tick to keep removal events for.
+	virtual auto clear_removed(Tick before) -> void = 0;
+
+	/// @internal
+	/// @brief Copy every component into a snapshot.
+	/// @param snapshot The snapshot to write to.
+	/// @return Whether this component type can be snapshotted (only trivially copyable types can).
+	virtual auto write_snapshot(ComponentSnapshot &snapshot) const -> bool = 0;
+
+	/// @internal
+	/// @brief Encode every component that changed after a tick.
+	/// @param baseline The state at tick `since`, or nullptr if this component type didn't exist yet.
+	/// @param since The tick to look for changes after.
+	/// @param out The buffer to append the encoded entries to.
+	/// @return The number of entries written.
+	virtual auto write_delta(const ComponentSnapshot *baseline, Tick since, std::vector<std::byte> &out) const -> size_t = 0;
+
+	/// @internal
+	/// @brief Overwrite every component with the state in a snapshot.
+	/// @param snapshot The state to restore.
+	/// @param alive Which entities are still alive, since components can't be restored onto destroyed entities.
+	/// @param added Entity IDs that gained this component are appended here.
+	/// @param removed Entity IDs that lost this component are appended here.
+	virtual auto restore_snapshot(const ComponentSnapshot &snapshot, const std::bitset<MAX_ENTITIES> &alive, std::vector<EntityId> &added, std::vector<EntityId> &removed) -> void = 0;
+
+	/// @internal
+	/// @brief Set which lifecycle events are recorded for observers.
+	/// @param mask A bit for each observed `LifecycleEvent`.
+	auto set_observed(std::uint8_t mask) -> void;
+
+	/// @internal
+	/// @brief Move every recorded lifecycle event into a buffer, in the order they happened.
+	/// @param out The buffer to append the events to.
+	auto take_events(std::vector<LifecycleRecord> &out) -> void;
+
+   protected:
+	/// @internal
+	/// @brief Record a lifecycle event, if it's observed.
+	/// @param id The entity that the event happened to.
+	/// @param event The event.
+	auto record(EntityId id, LifecycleEvent event) -> void {
+		if (observed & (1u << static_cast<unsigned>(event))) [[unlikely]]
+			events.push_back({id, event});
+	}
+
+   private:
+	std::uint8_t observed = 0;
+	std::vector<LifecycleRecord> events{};
+};
+
+/// @internal
+/// @brief A log of the entities whose component was stamped with a tick, so change queries only visit what changed.
+///
+/// Entries are appended in tick order, and an entity is only logged the first time it's stamped on a tick.
+/// An entry goes stale once its entity is stamped again or loses the component, and stale entries are dropped once they
+/// outnumber the components, so the log stays proportional to the array.
+class TickLog {
+   public:
+	/// @brief Log that an entity was stamped.
+	/// @param id The entity's ID.
+	/// @param tick The tick it was stamped with.
+	auto push(EntityId id, Tick tick) -> void {
+		entries.emplace_back(id, tick);
+	}
+
+	/// @brief Get every entity stamped after a tick.
+	/// @tparam Current A function type with the signature `bool(EntityId, Tick)`.
+	/// @tparam IndexOf A function type with the signature `size_t(EntityId)`.
+	/// @param since The tick to look for stamps after.
+	/// @param current Returns whether an entity still has a component stamped with a tick.
+	/// @param index_of Returns an entity's index in storage.
+	/// @return The entity IDs, in storage order.
+	template <typename Current, typename IndexOf>
+	auto collect(Tick since, Current current, IndexOf index_of) const -> std::vector<EntityId>;
+
+	/// @brief Drop stale entries, if there are enough of them.
+	/// @tparam Current A function type with the signature `bool(EntityId, Tick)`.
+	/// @param n_components The number of components in the array.
+	/// @param current Returns whether an entity still has a component stamped with a tick.
+	template <typename Current>
+	auto compact(size_t n_components, Current current) -> void;
+
+   private:
+	std::vector<std::pair<EntityId, Tick>> entries{};
+};
+
+/// @brief An interface for groups, which keep several component arrays aligned.
+///
+/// A component array that is owned by a group notifies it whenever a component is added or removed.
+class GenericGroup {
+   public:
+	virtual ~GenericGroup() = default;
+
+	/// @internal
+	/// @brief Called after a component has been added to an owned array.
+	/// @param id The entity that gained the component.
+	virtual auto component_added(EntityId id) -> void = 0;
+
+	/// @internal
+	/// @brief Called before a component is removed from an owned array.
+	/// @param id The entity that is losing the component.
+	virtual auto component_removed(EntityId id) -> void = 0;
 };
 
 /// @brief A helper class for a packed array of components.
+///
+/// Components are stored densely, with a sparse array mapping entity IDs to their index.
+///
 /// @tparam T The component type.
 template <typename T>
 class ComponentArray : public GenericComponentArray {
    public:
+	/// @brief Create an empty component array.
+	/// @param tick A pointer to the scene's current tick, used to stamp changed components.
+	explicit ComponentArray(const Tick *tick);
+
 	/// @brief Get an entity's component.
+	///
+	/// The component is marked as changed on the current tick.
+	///
 	/// @param id The entity ID to get the component of.
 	/// @return A reference to the component, or std::nullopt if the entity doesn't have this component.
 	auto get_component(EntityId id) -> std::optional<std::reference_wrapper<T>>;
 
+	/// @brief Get an entity's component without marking it as changed.
+	/// @param id The entity ID to get the component of.
+	/// @return A const reference to the component, or std::nullopt if the entity doesn't have this component.
+	auto read_component(EntityId id) const -> std::optional<std::reference_wrapper<const T>>;
+
+	/// @brief Get every entity whose component was created after a tick.
+	/// @param since The tick to look for additions after.
+	/// @return The entity IDs, in storage order.
+	auto get_added(Tick since) const -> std::vector<EntityId>;
+
+	/// @brief Get every entity whose component was created or mutably accessed after a tick.
+	/// @param since The tick to look for changes after.
+	/// @return The entity IDs, in storage order.
+	auto get_changed(Tick since) const -> std::vector<EntityId>;
+
+	/// @brief Get every entity whose component was removed after a tick.
+	///
+	/// Removals are only remembered until they are cleared by `clear_removed`.
+	///
+	/// @param since The tick to look for removals after.
+	/// @return The entity IDs, in removal order.
+	auto get_removed(Tick since) const -> std::vector<EntityId>;
+
 	/// @brief Create a component in place.
 	/// @tparam ...Args Argument types for the component constructor.
 	/// @param id The entity ID to assign this component to.
@@ -55,14 +210,333 @@ class ComponentArray : public GenericComponentArray {
 	/// @param id The entity ID that was destroyed.
 	auto entity_destroyed(EntityId id) -> void override;
 
+	/// @brief Check whether an entity has this component.
+	/// @param id The entity ID.
+	/// @return Whether the entity has this component.
+	auto contains(EntityId id) const -> bool;
+
+	/// @internal
+	/// @brief Get the index of an entity's component in the dense array.
+	/// @param id The entity ID, which must have this component.
+	/// @return The index.
+	auto get_index(EntityId id) const -> size_t;
+
+	/// @brief Get the number of components.
+	/// @return The number of components.
+	auto size() const -> size_t;
+
+	/// @brief Get the entity ID of every component, in storage order.
+	/// @return A span of entity IDs.
+	auto get_entities() const -> std::span<const EntityId>;
+
+	/// @internal
+	/// @brief Get every component, in storage order, without marking them as changed.
+	/// @return A span of components.
+	auto get_components() -> std::span<T>;
+
+	/// @internal
+	/// @brief Mark a range of components as changed on the current tick.
+	/// @param begin The first index to mark.
+	/// @param end One past the last index to mark.
+	auto mark_changed(size_t begin, size_t end) -> void;
+
+	/// @internal
+	/// @brief Swap two components in the dense array.
+	/// @param a The index of the first component.
+	/// @param b The index of the second component.
+	auto swap_indices(size_t a, size_t b) -> void;
+
+	/// @brief Sort the components.
+	///
+	/// This uses an insertion sort, so keeping an array sorted every update is cheap when only a few components move.
+	///
+	/// @tparam Compare A function type with the signature `bool(const T&, const T&)`.
+	/// @param compare Returns whether the first component should come before the second.
+	/// @throw std::runtime_error Throws if this array is owned by a group.
+	template <typename Compare>
+	auto sort(Compare compare) -> void;
+
+	/// @internal
+	/// @brief Insertion sort a range of components with a custom swap.
+	/// @param begin The first index to sort.
+	/// @param end One past the last index to sort.
+	/// @param compare Returns whether the first component should come before the second.
+	/// @param swap Called with two indices to swap them.
+	template <typename Compare, typename Swap>
+	auto sort_range(size_t begin, size_t end, Compare compare, Swap swap) const -> void;
+
+	/// @internal
+	/// @brief Get the group that owns this array.
+	/// @return The group, or nullptr if this array isn't owned.
+	auto get_owner() const -> GenericGroup*;
+
+	/// @internal
+	/// @brief Set the group that owns this array.
+	/// @param group The group, or nullptr to release ownership.
+	/// @throw std::runtime_error Throws if this array is already owned by another group.
+	auto set_owner(GenericGroup* group) -> void;
+
+	auto get_component_size() const -> size_t override;
+	auto clear_removed(Tick before) -> void override;
+	auto write_snapshot(ComponentSnapshot &snapshot) const -> bool override;
+	auto write_delta(const ComponentSnapshot *baseline, Tick since, std::vector<std::byte> &out) const -> size_t override;
+	auto restore_snapshot(const ComponentSnapshot &snapshot, const std::bitset<MAX_ENTITIES> &alive, std::vector<EntityId> &added, std::vector<EntityId> &removed) -> void override;
+
    private:
 	std::array<T, MAX_ENTITIES> components{};
-	std::unordered_map<EntityId, size_t> id_to_index_map{};
-	std::unordered_map<size_t, EntityId> index_to_id_map{};
+	std::array<Tick, MAX_ENTITIES> added_ticks{};
+	std::array<Tick, MAX_ENTITIES> changed_ticks{};
+	TickLog added_log{}, changed_log{};
+	std::vector<std::pair<EntityId, Tick>> removed_events{};
+	std::array<EntityId, MAX_ENTITIES> index_to_id{};
+	std::array<size_t, MAX_ENTITIES> id_to_index{};
+	std::bitset<MAX_ENTITIES> present{};
+
+	const Tick *tick;
+	GenericGroup *owner = nullptr;
+	size_t len = 0;
+
+	/// @brief Remove an entity's component, recording why for observers.
+	/// @param target_id The entity ID to remove the component from.
+	/// @param event Whether the component was removed or its entity was destroyed.
+	/// @return The component, or std::nullopt if the entity doesn't have this component.
+	auto remove(EntityId target_id, LifecycleEvent event) -> std::optional<T>;
+};
+
+/// @brief A component array for tags, which are empty component types.
+///
+/// Tags carry no data, so only membership is stored: a bit per entity and a dense list of members.
+/// Every tag shares one instance, so references to a tag are all the same.
+/// Tags can't change, so `get_changed` is the same as `get_added`, and they can't be sorted or grouped.
+///
+/// @tparam T The tag type.
+template <typename T>
+	requires std::is_empty_v<T>
+class ComponentArray<T> : public GenericComponentArray {
+   public:
+	/// @brief Create an empty tag array.
+	/// @param tick A pointer to the scene's current tick, used to stamp added tags.
+	explicit ComponentArray(const Tick *tick);
+
+	/// @brief Get an entity's tag.
+	/// @param id The entity ID to get the tag of.
+	/// @return A reference to the shared tag instance, or std::nullopt if the entity doesn't have this tag.
+	auto get_component(EntityId id) -> std::optional<std::reference_wrapper<T>>;
+
+	/// @brief Get an entity's tag.
+	/// @param id The entity ID to get the tag of.
+	/// @return A const reference to the shared tag instance, or std::nullopt if the entity doesn't have this tag.
+	auto read_component(EntityId id) const -> std::optional<std::reference_wrapper<const T>>;
+
+	/// @brief Get every entity whose tag was added after a tick.
+	/// @param since The tick to look for additions after.
+	/// @return The entity IDs, in storage order.
+	auto get_added(Tick since) const -> std::vector<EntityId>;
+
+	/// @brief Get every entity whose tag was added after a tick, since tags can't change.
+	/// @param since The tick to look for additions after.
+	/// @return The entity IDs, in storage order.
+	auto get_changed(Tick since) const -> std::vector<EntityId>;
+
+	/// @brief Get every entity whose tag was removed after a tick.
+	/// @param since The tick to look for removals after.
+	/// @return The entity IDs, in removal order.
+	auto get_removed(Tick since) const -> std::vector<EntityId>;
+
+	/// @brief Add a tag to an entity.
+	/// @tparam ...Args Ignored, since tags have nothing to construct.
+	/// @param id The entity ID to tag.
+	/// @return A reference to the shared tag instance.
+	/// @throw std::runtime_error Throws if the entity already has this tag.
+	template <typename... Args>
+	auto create_component(EntityId id, Args &&...args) -> T &;
+
+	/// @brief Add a tag to an entity.
+	/// @param id The entity ID to tag.
+	/// @param component Ignored, since tags carry no data.
+	/// @return A reference to the shared tag instance.
+	/// @throw std::runtime_error Throws if the entity already has this tag.
+	auto set_component(EntityId id, T &&component) -> T &;
+
+	/// @brief Remove an entity's tag.
+	/// @param id The entity ID to remove the tag from.
+	/// @return The tag, or std::nullopt if the entity doesn't have this tag.
+	auto remove_component(EntityId id) -> std::optional<T>;
+
+	/// @internal
+	/// @brief Remove an entity's tag.
+	///
+	/// This method should be called by `ComponentManager` when an entity is destroyed.
+	///
+	/// @param id The entity ID that was destroyed.
+	auto entity_destroyed(EntityId id) -> void override;
 
+	/// @brief Check whether an entity has this tag.
+	/// @param id The entity ID.
+	/// @return Whether the entity has this tag.
+	auto contains(EntityId id) const -> bool;
+
+	/// @brief Get the number of tagged entities.
+	/// @return The number of tagged entities.
+	auto size() const -> size_t;
+
+	/// @brief Get every tagged entity, in storage order.
+	/// @return A span of entity IDs.
+	auto get_entities() const -> std::span<const EntityId>;
+
+	auto get_component_size() const -> size_t override;
+	auto clear_removed(Tick before) -> void override;
+	auto write_snapshot(ComponentSnapshot &snapshot) const -> bool override;
+	auto write_delta(const ComponentSnapshot *baseline, Tick since, std::vector<std::byte> &out) const -> size_t override;
+	auto restore_snapshot(const ComponentSnapshot &snapshot, const std::bitset<MAX_ENTITIES> &alive, std::vector<EntityId> &added, std::vector<EntityId> &removed) -> void override;
+
+   private:
+	inline static T instance{};
+
+	std::bitset<MAX_ENTITIES> present{};
+	std::vector<EntityId> members{};
+	std::vector<Tick> added_ticks{};
+	TickLog added_log{};
+	std::vector<std::uint32_t> id_to_index{};
+	std::vector<std::pair<EntityId, Tick>> removed_events{};
+
+	const Tick *tick;
+
+	/// @brief Remove an entity's tag, recording why for observers.
+	/// @param id The entity ID to remove the tag from.
+	/// @param event Whether the component was removed or its entity was destroyed.
+	/// @return The component, or std::nullopt if the entity doesn't have this component.
+	auto remove(EntityId id, LifecycleEvent event) -> std::optional<T>;
+};
+
+/// @brief A component array that stores each field of a component in its own array.
+///
+/// Components are packed densely like any other component, but each field listed in the component's `SoaLayout`
+/// lives in a separate aligned array, so systems that only touch a few fields can stream through exactly those.
+/// Components can't be sorted or grouped, and they are accessed through `SoaRef` instead of references.
+///
+/// @tparam T The component type.
+template <SoaComponent T>
+class ComponentArray<T> : public GenericComponentArray {
+   public:
+	/// @brief Create an empty component array.
+	/// @param tick A pointer to the scene's current tick, used to stamp changed components.
+	explicit ComponentArray(const Tick *tick);
+
+	/// @brief Get an entity's component.
+	///
+	/// The component is marked as changed on the current tick.
+	///
+	/// @param id The entity ID to get the component of.
+	/// @return A reference to the component, or std::nullopt if the entity doesn't have this component.
+	auto get_component(EntityId id) -> std::optional<SoaRef<T>>;
+
+	/// @brief Get a copy of an entity's component without marking it as changed.
+	/// @param id The entity ID to get the component of.
+	/// @return A copy of the component, or std::nullopt if the entity doesn't have this component.
+	auto read_component(EntityId id) const -> std::optional<T>;
+
+	/// @brief Get every entity whose component was created after a tick.
+	/// @param since The tick to look for additions after.
+	/// @return The entity IDs, in storage order.
+	auto get_added(Tick since) const -> std::vector<EntityId>;
+
+	/// @brief Get every entity whose component was created or mutably accessed after a tick.
+	/// @param since The tick to look for changes after.
+	/// @return The entity IDs, in storage order.
+	auto get_changed(Tick since) const -> std::vector<EntityId>;
+
+	/// @brief Get every entity whose component was removed after a tick.
+	/// @param since The tick to look for removals after.
+	/// @return The entity IDs, in removal order.
+	auto get_removed(Tick since) const -> std::vector<EntityId>;
+
+	/// @brief Create a component.
+	/// @tparam ...Args Argument types for the component constructor.
+	/// @param id The entity ID to assign this component to.
+	/// @param ...args The arguments to forward to the component constructor.
+	/// @return A reference to the component.
+	/// @throw std::runtime_error Throws if the entity already has a component of this type.
+	template <typename... Args>
+	auto create_component(EntityId id, Args &&...args) -> SoaRef<T>;
+
+	/// @brief Set an entity's component.
+	/// @param id The entity ID to assign this component to.
+	/// @param component The component to assign.
+	/// @return A reference to the component.
+	/// @throw std::runtime_error Throws if the entity already has a component of this type.
+	auto set_component(EntityId id, T &&component) -> SoaRef<T>;
+
+	/// @brief Remove an entity's component.
+	/// @param target_id The entity ID to remove the component from.
+	/// @return The component, or std::nullopt if the entity doesn't have this component.
+	auto remove_component(EntityId target_id) -> std::optional<T>;
+
+	/// @internal
+	/// @brief Remove an entity's component.
+	///
+	/// This method should be called by `ComponentManager` when an entity is destroyed.
+	///
+	/// @param id The entity ID that was destroyed.
+	auto entity_destroyed(EntityId id) -> void override;
+
+	/// @brief Check whether an entity has this component.
+	/// @param id The entity ID.
+	/// @return Whether the entity has this component.
+	auto contains(EntityId id) const -> bool;
+
+	/// @brief Get the number of components.
+	/// @return The number of components.
+	auto size() const -> size_t;
+
+	/// @brief Get the entity ID of every component, in storage order.
+	/// @return A span of entity IDs.
+	auto get_entities() const -> std::span<const EntityId>;
+
+	/// @brief Get one field of every component, in storage order.
+	///
+	/// Every component is marked as changed on the current tick.
+	///
+	/// @tparam Member A member pointer listed in the component's layout.
+	/// @return A span of fields, aligned with `get_entities()`.
+	template <auto Member>
+	auto get_field() -> std::span<MemberField<Member>>;
+
+	/// @brief Get one field of every component, in storage order, without marking them as changed.
+	/// @tparam Member A member pointer listed in the component's layout.
+	/// @return A span of fields, aligned with `get_entities()`.
+	template <auto Member>
+	auto read_field() const -> std::span<const MemberField<Member>>;
+
+	auto get_component_size() const -> size_t override;
+	auto clear_removed(Tick before) -> void override;
+	auto write_snapshot(ComponentSnapshot &snapshot) const -> bool override;
+	auto write_delta(const ComponentSnapshot *baseline, Tick since, std::vector<std::byte> &out) const -> size_t override;
+	auto restore_snapshot(const ComponentSnapshot &snapshot, const std::bitset<MAX_ENTITIES> &alive, std::vector<EntityId> &added, std::vector<EntityId> &removed) -> void override;
+
+   private:
+	SoaColumns<T> storage{};
+	std::array<Tick, MAX_ENTITIES> added_ticks{};
+	std::array<Tick, MAX_ENTITIES> changed_ticks{};
+	TickLog added_log{}, changed_log{};
+	std::vector<std::pair<EntityId, Tick>> removed_events{};
+	std::array<EntityId, MAX_ENTITIES> index_to_id{};
+	std::array<size_t, MAX_ENTITIES> id_to_index{};
+	std::bitset<MAX_ENTITIES> present{};
+
+	const Tick *tick;
 	size_t len = 0;
+
+	/// @brief Remove an entity's component, recording why for observers.
+	/// @param target_id The entity ID to remove the component from.
+	/// @param event Whether the component was removed or its entity was destroyed.
+	/// @return The component, or std::nullopt if the entity doesn't have this component.
+	auto remove(EntityId target_id, LifecycleEvent event) -> std::optional<T>;
 };
 
+template <typename... Ts>
+class Group;
+
 /// @brief Helper class to manage components and assign them to entities.
 class ComponentManager {
    public:
@@ -71,7 +545,7 @@ class ComponentManager {
 	/// @param id The entity ID to get the component of.
 	/// @return A reference to the component, or std::nullopt if the entity doesn't have this component.
 	template <typename T>
-	auto get_component(EntityId id) -> std::optional<std::reference_wrapper<T>>;
+	auto get_component(EntityId id) -> std::optional<ComponentHandle<T>>;
 
 	/// @brief Get an entity's component, throwing an exception if it doesn't exist.
 	/// @tparam T The component type to get.
@@ -79,7 +553,22 @@ class ComponentManager {
 	/// @return A reference to the component.
 	/// @throw std::runtime_error Throws if the entity doesn't have this component.
 	template <typename T>
-	auto get_component_raw(EntityId id) -> T&;
+	auto get_component_raw(EntityId id) -> ComponentRef<T>;
+
+	/// @brief Get an entity's component without marking it as changed, throwing an exception if it doesn't exist.
+	/// @tparam T The component type to get.
+	/// @param id The entity ID to get the component of.
+	/// @return A const reference to the component.
+	/// @throw std::runtime_error Throws if the entity doesn't have this component.
+	template <typename T>
+	auto read_component(EntityId id) -> ComponentConstRef<T>;
+
+	/// @brief Get every entity that matches a change filter.
+	/// @tparam Filter `Added<T>`, `Changed<T>`, or `Removed<T>`.
+	/// @param since The tick to look for changes after.
+	/// @return The matching entity IDs.
+	template <typename Filter>
+	auto query(Tick since) -> std::vector<EntityId>;
 
 	/// @brief Create a component in place.
 	/// @tparam T The component type to create.
@@ -89,7 +578,7 @@ class ComponentManager {
 	/// @return A reference to the component.
 	/// @throw std::runtime_error Throws if the entity already has a component of this type.
 	template <typename T, typename... Args>
-	auto create_component(EntityId id, Args&&... args) -> T&;
+	auto create_component(EntityId id, Args&&... args) -> ComponentRef<T>;
 
 	/// @brief Set an entity's component.
 	/// @tparam T The component type to set.
@@ -98,7 +587,7 @@ class ComponentManager {
 	/// @return A reference to the component.
 	/// @throw std::runtime_error Throws if the entity already has a component of this type.
 	template <typename T>
-	auto set_component(EntityId id, T&& component) -> T&;
+	auto set_component(EntityId id, T&& component) -> ComponentRef<T>;
 
 	/// @brief Remove an entity's component.
 	/// @tparam T The component type to remove.
@@ -107,12 +596,51 @@ class ComponentManager {
 	template <typename T>
 	auto remove_component(EntityId id) -> std::optional<T>;
 
+	/// @brief Sort every component of a type.
+	/// @tparam T The component type to sort.
+	/// @tparam Compare A function type with the signature `bool(const T&, const T&)`.
+	/// @param compare Returns whether the first component should come before the second.
+	/// @throw std::runtime_error Throws if the component array is owned by a group.
+	template <typename T, typename Compare>
+	auto sort(Compare compare) -> void;
+
+	/// @brief Get the entity ID of every component of a type, in storage order.
+	/// @tparam T The component type.
+	/// @return A span of entity IDs.
+	template <typename T>
+	auto get_entities() -> std::span<const EntityId>;
+
+	/// @brief Get one field of every component of a type, in storage order.
+	/// @tparam Member A member pointer listed in the component's `SoaLayout`.
+	/// @return A span of fields, aligned with `get_entities()`.
+	template <auto Member>
+	auto get_field() -> std::span<MemberField<Member>>;
+
+	/// @brief Get one field of every component of a type, in storage order, without marking them as changed.
+	/// @tparam Member A member pointer listed in the component's `SoaLayout`.
+	/// @return A span of fields, aligned with `get_entities()`.
+	template <auto Member>
+	auto read_field() -> std::span<const MemberField<Member>>;
+
+	/// @brief Get a group of component arrays, creating it if it doesn't exist.
+	/// @tparam Ts The component types in the group.
+	/// @return A reference to the group.
+	/// @throw std::runtime_error Throws if any of the component arrays is already owned by another group.
+	template <typename... Ts>
+	auto group() -> Group<Ts...>&;
+
 	/// @brief Get a component's ID.
 	/// @tparam T The component type to get the ID of.
 	/// @return The component's ID.
 	template <typename T>
 	auto get_component_id() -> ComponentId;
 
+	/// @internal
+	/// @brief Get a component array by ID, without knowing its type.
+	/// @param id The component's ID, from `get_component_id`.
+	/// @return A reference to the component array.
+	auto get_component_array(ComponentId id) -> GenericComponentArray&;
+
 	/// @internal
 	/// @brief Remove all of an entity's components.
 	///
@@ -121,10 +649,39 @@ class ComponentManager {
 	/// @param id The entity ID that was destroyed.
 	auto entity_destroyed(EntityId id) -> void;
 
+	/// @brief Get the current tick.
+	/// @return The current tick.
+	auto get_tick() const -> Tick;
+
+	/// @brief Advance to the next tick.
+	///
+	/// Components that are mutably accessed after this call are stamped with the new tick.
+	/// Removal events older than the previous tick are forgotten.
+	auto advance_tick() -> void;
+
+	/// @brief Copy every trivially copyable component into a snapshot, then advance the tick.
+	/// @return The snapshot.
+	auto create_snapshot() -> Snapshot;
+
+	/// @brief Encode every component that changed since a snapshot was taken, then advance the tick.
+	/// @param baseline The snapshot to compare against.
+	/// @return The delta.
+	auto create_delta(const Snapshot& baseline) -> Delta;
+
+	/// @internal
+	/// @brief Overwrite components with the state in a snapshot.
+	/// @param snapshot The state to restore.
+	/// @param alive Which entities are still alive.
+	/// @param on_change A callback invoked for each entity that gained (`true`) or lost (`false`) a component.
+	auto restore_snapshot(const Snapshot& snapshot, const std::bitset<MAX_ENTITIES>& alive, const std::function<void(EntityId, ComponentId, bool)>& on_change) -> void;
+
    private:
 	std::unordered_map<std::string, std::unique_ptr<GenericComponentArray>> component_arrays{};
 	std::unordered_map<std::string, ComponentId> component_ids{};
+	std::vector<GenericComponentArray*> component_arrays_by_id{};
+	std::unordered_map<std::string, std::unique_ptr<GenericGroup>> groups{};
 	ComponentId next_component_id = 0;
+	Tick tick = 1;
 
 	/// @internal
 	/// @brief Get a component array.
@@ -2,86 +2,789 @@
 
 #include <fmt/core.h>
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 #include "component.hpp"
+#include "filters.hpp"
+#include "group.hpp"
 #include "types.hpp"
 
+template <typename Current, typename IndexOf>
+inline auto TickLog::collect(Tick since, Current current, IndexOf index_of) const -> std::vector<EntityId> {
+	std::vector<EntityId> ids{};
+	auto first = std::ranges::upper_bound(entries, since, {}, &std::pair<EntityId, Tick>::second);
+	for (auto it = first; it != entries.end(); ++it)
+		if (current(it->first, it->second))
+			ids.push_back(it->first);
+
+	// An entity that lost and regained the component on the same tick is logged twice
+	std::ranges::sort(ids, {}, index_of);
+	auto [last, end] = std::ranges::unique(ids);
+	ids.erase(last, end);
+	return ids;
+}
+
+template <typename Current>
+inline auto TickLog::compact(size_t n_components, Current current) -> void {
+	// At most one entry per component is current, so this only runs after at least `n_components` stale stamps
+	if (entries.size() <= 2 * n_components + 64) return;
+	std::erase_if(entries, [&](auto entry) { return !current(entry.first, entry.second); });
+}
+
+template <typename T>
+inline ComponentArray<T>::ComponentArray(const Tick* tick) : tick{tick} {}
+
 template <typename T>
 inline auto ComponentArray<T>::get_component(EntityId id) -> std::optional<std::reference_wrapper<T>> {
-	auto index_search = id_to_index_map.find(id);
-	if (index_search == id_to_index_map.end())
+	if (!present.test(id))
 		return {};
-	auto [_, index] = *index_search;
+	auto index = id_to_index[id];
+	if (changed_ticks[index] != *tick) {
+		changed_ticks[index] = *tick;
+		changed_log.push(id, *tick);
+	}
 	return std::ref(components[index]);
 }
 
+template <typename T>
+inline auto ComponentArray<T>::read_component(EntityId id) const -> std::optional<std::reference_wrapper<const T>> {
+	if (!present.test(id))
+		return {};
+	return std::cref(components[id_to_index[id]]);
+}
+
 template <typename T>
 template <typename... Args>
 inline auto ComponentArray<T>::create_component(EntityId id, Args&&... args) -> T& {
 	return set_component(id, {std::forward<Args>(args)...});
 }
 
+template <typename T>
+inline auto ComponentArray<T>::get_added(Tick since) const -> std::vector<EntityId> {
+	return added_log.collect(
+		since, [this](EntityId id, Tick added) { return present.test(id) && added_ticks[id_to_index[id]] == added; },
+		[this](EntityId id) { return id_to_index[id]; });
+}
+
+template <typename T>
+inline auto ComponentArray<T>::get_changed(Tick since) const -> std::vector<EntityId> {
+	return changed_log.collect(
+		since, [this](EntityId id, Tick changed) { return present.test(id) && changed_ticks[id_to_index[id]] == changed; },
+		[this](EntityId id) { return id_to_index[id]; });
+}
+
+template <typename T>
+inline auto ComponentArray<T>::get_removed(Tick since) const -> std::vector<EntityId> {
+	std::vector<EntityId> ids{};
+	for (auto [id, removed_tick] : removed_events)
+		if (removed_tick > since)
+			ids.push_back(id);
+	return ids;
+}
+
 template <typename T>
 inline auto ComponentArray<T>::set_component(EntityId id, T&& component) -> T& {
-	if (id_to_index_map.find(id) != id_to_index_map.end())
+	if (present.test(id))
 		throw std::runtime_error{fmt::format("Cannot add component `{}` to entity {} more than once.", typeid(T).name(), id)};
 
 	auto new_index = len++;
-	id_to_index_map[id] = new_index;
-	index_to_id_map[new_index] = id;
+	id_to_index[id] = new_index;
+	index_to_id[new_index] = id;
 	components[new_index] = std::move(component);
+	added_ticks[new_index] = *tick;
+	changed_ticks[new_index] = *tick;
+	added_log.push(id, *tick);
+	changed_log.push(id, *tick);
+	present.set(id);
+	record(id, LifecycleEvent::added);
+
+	if (owner != nullptr) {
+		owner->component_added(id);
+		return components[id_to_index[id]];
+	}
 
 	return components[new_index];
 }
 
 template <typename T>
 inline auto ComponentArray<T>::remove_component(EntityId target_id) -> std::optional<T> {
-	if (id_to_index_map.find(target_id) == id_to_index_map.end())
+	return remove(target_id, LifecycleEvent::removed);
+}
+
+template <typename T>
+inline auto ComponentArray<T>::remove(EntityId target_id, LifecycleEvent event) -> std::optional<T> {
+	if (!present.test(target_id))
 		return {};
+	record(target_id, event);
 
-	auto target_index = id_to_index_map[target_id];
+	if (owner != nullptr)
+		owner->component_removed(target_id);
+
+	auto target_index = id_to_index[target_id];
 	auto last_index = --len;
 	auto target_component = std::move(components[target_index]);
 	components[target_index] = std::move(components[last_index]);
+	added_ticks[target_index] = added_ticks[last_index];
+	changed_ticks[target_index] = changed_ticks[last_index];
+	present.reset(target_id);
+	removed_events.emplace_back(target_id, *tick);
 
-	auto last_id = index_to_id_map[last_index];
-	id_to_index_map[last_id] = target_index;
-	index_to_id_map[target_index] = last_id;
-
-	id_to_index_map.erase(target_id);
-	index_to_id_map.erase(last_index);
+	auto last_id = index_to_id[last_index];
+	id_to_index[last_id] = target_index;
+	index_to_id[target_index] = last_id;
 
 	return target_component;
 }
 
 template <typename T>
 inline auto ComponentArray<T>::entity_destroyed(EntityId id) -> void {
-	if (id_to_index_map.find(id) != id_to_index_map.end())
-		remove_component(id);
+	remove(id, LifecycleEvent::destroyed);
+}
+
+template <typename T>
+inline auto ComponentArray<T>::contains(EntityId id) const -> bool {
+	return present.test(id);
+}
+
+template <typename T>
+inline auto ComponentArray<T>::get_index(EntityId id) const -> size_t {
+	return id_to_index[id];
+}
+
+template <typename T>
+inline auto ComponentArray<T>::size() const -> size_t {
+	return len;
+}
+
+template <typename T>
+inline auto ComponentArray<T>::get_entities() const -> std::span<const EntityId> {
+	return {index_to_id.data(), len};
+}
+
+template <typename T>
+inline auto ComponentArray<T>::get_components() -> std::span<T> {
+	return {components.data(), len};
+}
+
+template <typename T>
+inline auto ComponentArray<T>::mark_changed(size_t begin, size_t end) -> void {
+	for (auto index = begin; index < end; index++) {
+		if (changed_ticks[index] == *tick) continue;
+		changed_ticks[index] = *tick;
+		changed_log.push(index_to_id[index], *tick);
+	}
+}
+
+template <typename T>
+inline auto ComponentArray<T>::swap_indices(size_t a, size_t b) -> void {
+	if (a == b) return;
+
+	std::swap(components[a], components[b]);
+	std::swap(added_ticks[a], added_ticks[b]);
+	std::swap(changed_ticks[a], changed_ticks[b]);
+	std::swap(index_to_id[a], index_to_id[b]);
+	id_to_index[index_to_id[a]] = a;
+	id_to_index[index_to_id[b]] = b;
+}
+
+template <typename T>
+template <typename Compare>
+inline auto ComponentArray<T>::sort(Compare compare) -> void {
+	if (owner != nullptr)
+		throw std::runtime_error{fmt::format("Component `{}` is owned by a group, so only the group can sort it.", typeid(T).name())};
+
+	sort_range(0, len, compare, [this](size_t a, size_t b) { swap_indices(a, b); });
+}
+
+template <typename T>
+template <typename Compare, typename Swap>
+inline auto ComponentArray<T>::sort_range(size_t begin, size_t end, Compare compare, Swap swap) const -> void {
+	for (auto i = begin + 1; i < end; i++)
+		for (auto j = i; j > begin && compare(components[j], components[j - 1]); j--)
+			swap(j, j - 1);
+}
+
+template <typename T>
+inline auto ComponentArray<T>::get_owner() const -> GenericGroup* {
+	return owner;
+}
+
+template <typename T>
+inline auto ComponentArray<T>::set_owner(GenericGroup* group) -> void {
+	if (owner != nullptr && group != nullptr)
+		throw std::runtime_error{fmt::format("Component `{}` is already owned by a group.", typeid(T).name())};
+	owner = group;
+}
+
+template <typename T>
+inline auto ComponentArray<T>::get_component_size() const -> size_t {
+	return sizeof(T);
 }
 
 template <typename T>
-inline auto ComponentManager::get_component(EntityId id) -> std::optional<std::reference_wrapper<T>> {
+inline auto ComponentArray<T>::clear_removed(Tick before) -> void {
+	std::erase_if(removed_events, [before](auto event) { return event.second < before; });
+	added_log.compact(len, [this](EntityId id, Tick added) { return present.test(id) && added_ticks[id_to_index[id]] == added; });
+	changed_log.compact(len, [this](EntityId id, Tick changed) { return present.test(id) && changed_ticks[id_to_index[id]] == changed; });
+}
+
+template <typename T>
+inline auto ComponentArray<T>::write_snapshot(ComponentSnapshot& snapshot) const -> bool {
+	if constexpr (!std::is_trivially_copyable_v<T> || sizeof(T) > MAX_SNAPSHOT_STRIDE) {
+		return false;
+	} else {
+		snapshot.stride = sizeof(T);
+		snapshot.present = present;
+		snapshot.data.assign(MAX_ENTITIES * sizeof(T), std::byte{0});
+
+		for (size_t index = 0; index < len; index++)
+			std::memcpy(snapshot.at(index_to_id[index]).data(), &components[index], sizeof(T));
+
+		return true;
+	}
+}
+
+template <typename T>
+inline auto ComponentArray<T>::write_delta(const ComponentSnapshot* baseline, Tick since, std::vector<std::byte>& out) const -> size_t {
+	if constexpr (!std::is_trivially_copyable_v<T> || sizeof(T) > MAX_SNAPSHOT_STRIDE) {
+		return 0;
+	} else {
+		static constexpr std::array<std::byte, sizeof(T)> ZEROES{};
+		size_t n_entries = 0;
+
+		for (auto id : get_changed(since)) {
+			auto index = id_to_index[id];
+			std::span<const std::byte> previous{ZEROES};
+			if (baseline != nullptr && baseline->present.test(id))
+				previous = baseline->at(id);
+
+			auto entry_start = out.size();
+			write_varint(id, out);
+			out.push_back(std::byte{1});
+
+			std::span<const std::byte> current{reinterpret_cast<const std::byte*>(&components[index]), sizeof(T)};
+			if (encode_xor_rle(current, previous, out))
+				n_entries++;
+			else
+				out.resize(entry_start);
+		}
+
+		if (baseline != nullptr) {
+			auto removed = baseline->present & ~present;
+			auto n_removed = removed.count();
+			for (EntityId id = 0; n_removed > 0; id++) {
+				if (!removed.test(id)) continue;
+				n_removed--;
+
+				write_varint(id, out);
+				out.push_back(std::byte{0});
+				n_entries++;
+			}
+		}
+
+		return n_entries;
+	}
+}
+
+template <typename T>
+inline auto ComponentArray<T>::restore_snapshot(const ComponentSnapshot& snapshot, const std::bitset<MAX_ENTITIES>& alive, std::vector<EntityId>& added, std::vector<EntityId>& removed) -> void {
+	if constexpr (std::is_trivially_copyable_v<T>) {
+		if (snapshot.stride != sizeof(T))
+			throw std::runtime_error{fmt::format("Cannot restore `{}` from a snapshot of {}-byte components.", typeid(T).name(), snapshot.stride)};
+
+		auto wanted = snapshot.present & alive;
+		for (EntityId id = 0; id < MAX_ENTITIES; id++) {
+			if (wanted.test(id)) {
+				T component;
+				std::memcpy(&component, snapshot.at(id).data(), sizeof(T));
+
+				if (present.test(id)) {
+					get_component(id)->get() = component;
+				} else {
+					set_component(id, std::move(component));
+					added.push_back(id);
+				}
+			} else if (present.test(id)) {
+				remove_component(id);
+				removed.push_back(id);
+			}
+		}
+	}
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline ComponentArray<T>::ComponentArray(const Tick* tick) : tick{tick} {}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::get_component(EntityId id) -> std::optional<std::reference_wrapper<T>> {
+	if (!present.test(id))
+		return {};
+	return std::ref(instance);
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::read_component(EntityId id) const -> std::optional<std::reference_wrapper<const T>> {
+	if (!present.test(id))
+		return {};
+	return std::cref(instance);
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::get_added(Tick since) const -> std::vector<EntityId> {
+	return added_log.collect(
+		since, [this](EntityId id, Tick added) { return present.test(id) && added_ticks[id_to_index[id]] == added; },
+		[this](EntityId id) { return id_to_index[id]; });
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::get_changed(Tick since) const -> std::vector<EntityId> {
+	return get_added(since);
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::get_removed(Tick since) const -> std::vector<EntityId> {
+	std::vector<EntityId> ids{};
+	for (auto [id, removed_tick] : removed_events)
+		if (removed_tick > since)
+			ids.push_back(id);
+	return ids;
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+template <typename... Args>
+inline auto ComponentArray<T>::create_component(EntityId id, Args&&... args) -> T& {
+	return set_component(id, T{});
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::set_component(EntityId id, T&& component) -> T& {
+	if (present.test(id))
+		throw std::runtime_error{fmt::format("Cannot add component `{}` to entity {} more than once.", typeid(T).name(), id)};
+
+	if (id >= id_to_index.size())
+		id_to_index.resize(id + 1);
+
+	id_to_index[id] = static_cast<std::uint32_t>(members.size());
+	members.push_back(id);
+	added_ticks.push_back(*tick);
+	added_log.push(id, *tick);
+	present.set(id);
+	record(id, LifecycleEvent::added);
+
+	return instance;
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::remove_component(EntityId id) -> std::optional<T> {
+	return remove(id, LifecycleEvent::removed);
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::remove(EntityId id, LifecycleEvent event) -> std::optional<T> {
+	if (!present.test(id))
+		return {};
+	record(id, event);
+
+	auto index = id_to_index[id];
+	auto last_id = members.back();
+	members[index] = last_id;
+	added_ticks[index] = added_ticks.back();
+	id_to_index[last_id] = index;
+	members.pop_back();
+	added_ticks.pop_back();
+
+	present.reset(id);
+	removed_events.emplace_back(id, *tick);
+
+	return T{};
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::entity_destroyed(EntityId id) -> void {
+	remove(id, LifecycleEvent::destroyed);
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::contains(EntityId id) const -> bool {
+	return present.test(id);
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::size() const -> size_t {
+	return members.size();
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::get_entities() const -> std::span<const EntityId> {
+	return members;
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::get_component_size() const -> size_t {
+	return 0;
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::clear_removed(Tick before) -> void {
+	std::erase_if(removed_events, [before](auto event) { return event.second < before; });
+	added_log.compact(members.size(), [this](EntityId id, Tick added) { return present.test(id) && added_ticks[id_to_index[id]] == added; });
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::write_snapshot(ComponentSnapshot& snapshot) const -> bool {
+	snapshot.stride = 0;
+	snapshot.present = present;
+	snapshot.data.clear();
+	return true;
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::write_delta(const ComponentSnapshot* baseline, Tick since, std::vector<std::byte>& out) const -> size_t {
+	// Tags have no bytes to encode, so an entry is just the entity ID and whether the tag was added or removed
+	size_t n_entries = 0;
+
+	for (auto id : get_added(since)) {
+		if (baseline != nullptr && baseline->present.test(id)) continue;
+
+		write_varint(id, out);
+		out.push_back(std::byte{1});
+		n_entries++;
+	}
+
+	if (baseline != nullptr) {
+		auto removed = baseline->present & ~present;
+		auto n_removed = removed.count();
+		for (EntityId id = 0; n_removed > 0; id++) {
+			if (!removed.test(id)) continue;
+			n_removed--;
+
+			write_varint(id, out);
+			out.push_back(std::byte{0});
+			n_entries++;
+		}
+	}
+
+	return n_entries;
+}
+
+template <typename T>
+	requires std::is_empty_v<T>
+inline auto ComponentArray<T>::restore_snapshot(const ComponentSnapshot& snapshot, const std::bitset<MAX_ENTITIES>& alive, std::vector<EntityId>& added, std::vector<EntityId>& removed) -> void {
+	if (snapshot.stride != 0)
+		throw std::runtime_error{fmt::format("Cannot restore tag `{}` from a snapshot of {}-byte components.", typeid(T).name(), snapshot.stride)};
+
+	auto wanted = snapshot.present & alive;
+	auto to_add = wanted & ~present;
+	auto to_remove = present & ~wanted;
+
+	for (EntityId id = 0; id < MAX_ENTITIES; id++) {
+		if (to_add.test(id)) {
+			set_component(id, T{});
+			added.push_back(id);
+		} else if (to_remove.test(id)) {
+			remove_component(id);
+			removed.push_back(id);
+		}
+	}
+}
+
+template <SoaComponent T>
+inline ComponentArray<T>::ComponentArray(const Tick* tick) : tick{tick} {}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::get_component(EntityId id) -> std::optional<SoaRef<T>> {
+	if (!present.test(id))
+		return {};
+	auto index = id_to_index[id];
+	if (changed_ticks[index] != *tick) {
+		changed_ticks[index] = *tick;
+		changed_log.push(id, *tick);
+	}
+	return SoaRef<T>{&storage, index};
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::read_component(EntityId id) const -> std::optional<T> {
+	if (!present.test(id))
+		return {};
+	return storage.load(id_to_index[id]);
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::get_added(Tick since) const -> std::vector<EntityId> {
+	return added_log.collect(
+		since, [this](EntityId id, Tick added) { return present.test(id) && added_ticks[id_to_index[id]] == added; },
+		[this](EntityId id) { return id_to_index[id]; });
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::get_changed(Tick since) const -> std::vector<EntityId> {
+	return changed_log.collect(
+		since, [this](EntityId id, Tick changed) { return present.test(id) && changed_ticks[id_to_index[id]] == changed; },
+		[this](EntityId id) { return id_to_index[id]; });
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::get_removed(Tick since) const -> std::vector<EntityId> {
+	std::vector<EntityId> ids{};
+	for (auto [id, removed_tick] : removed_events)
+		if (removed_tick > since)
+			ids.push_back(id);
+	return ids;
+}
+
+template <SoaComponent T>
+template <typename... Args>
+inline auto ComponentArray<T>::create_component(EntityId id, Args&&... args) -> SoaRef<T> {
+	return set_component(id, {std::forward<Args>(args)...});
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::set_component(EntityId id, T&& component) -> SoaRef<T> {
+	if (present.test(id))
+		throw std::runtime_error{fmt::format("Cannot add component `{}` to entity {} more than once.", typeid(T).name(), id)};
+
+	auto new_index = len++;
+	id_to_index[id] = new_index;
+	index_to_id[new_index] = id;
+	storage.store(new_index, component);
+	added_ticks[new_index] = *tick;
+	changed_ticks[new_index] = *tick;
+	added_log.push(id, *tick);
+	changed_log.push(id, *tick);
+	present.set(id);
+	record(id, LifecycleEvent::added);
+
+	return SoaRef<T>{&storage, new_index};
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::remove_component(EntityId target_id) -> std::optional<T> {
+	return remove(target_id, LifecycleEvent::removed);
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::remove(EntityId target_id, LifecycleEvent event) -> std::optional<T> {
+	if (!present.test(target_id))
+		return {};
+	record(target_id, event);
+
+	auto target_index = id_to_index[target_id];
+	auto last_index = --len;
+	auto target_component = storage.load(target_index);
+	storage.move(target_index, last_index);
+	added_ticks[target_index] = added_ticks[last_index];
+	changed_ticks[target_index] = changed_ticks[last_index];
+	present.reset(target_id);
+	removed_events.emplace_back(target_id, *tick);
+
+	auto last_id = index_to_id[last_index];
+	id_to_index[last_id] = target_index;
+	index_to_id[target_index] = last_id;
+
+	return target_component;
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::entity_destroyed(EntityId id) -> void {
+	remove(id, LifecycleEvent::destroyed);
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::contains(EntityId id) const -> bool {
+	return present.test(id);
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::size() const -> size_t {
+	return len;
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::get_entities() const -> std::span<const EntityId> {
+	return {index_to_id.data(), len};
+}
+
+template <SoaComponent T>
+template <auto Member>
+inline auto ComponentArray<T>::get_field() -> std::span<MemberField<Member>> {
+	for (size_t index = 0; index < len; index++) {
+		if (changed_ticks[index] == *tick) continue;
+		changed_ticks[index] = *tick;
+		changed_log.push(index_to_id[index], *tick);
+	}
+	return {std::get<soa_index<Member>()>(storage.columns).values.data(), len};
+}
+
+template <SoaComponent T>
+template <auto Member>
+inline auto ComponentArray<T>::read_field() const -> std::span<const MemberField<Member>> {
+	return {std::get<soa_index<Member>()>(storage.columns).values.data(), len};
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::get_component_size() const -> size_t {
+	return sizeof(T);
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::clear_removed(Tick before) -> void {
+	std::erase_if(removed_events, [before](auto event) { return event.second < before; });
+	added_log.compact(len, [this](EntityId id, Tick added) { return present.test(id) && added_ticks[id_to_index[id]] == added; });
+	changed_log.compact(len, [this](EntityId id, Tick changed) { return present.test(id) && changed_ticks[id_to_index[id]] == changed; });
+}
+
+// Snapshots store whole components, so the fields are gathered back into structs and look the same as an array of structs
+template <SoaComponent T>
+inline auto ComponentArray<T>::write_snapshot(ComponentSnapshot& snapshot) const -> bool {
+	if constexpr (!std::is_trivially_copyable_v<T> || sizeof(T) > MAX_SNAPSHOT_STRIDE) {
+		return false;
+	} else {
+		snapshot.stride = sizeof(T);
+		snapshot.present = present;
+		snapshot.data.assign(MAX_ENTITIES * sizeof(T), std::byte{0});
+
+		for (size_t index = 0; index < len; index++) {
+			auto component = storage.load(index);
+			std::memcpy(snapshot.at(index_to_id[index]).data(), &component, sizeof(T));
+		}
+
+		return true;
+	}
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::write_delta(const ComponentSnapshot* baseline, Tick since, std::vector<std::byte>& out) const -> size_t {
+	if constexpr (!std::is_trivially_copyable_v<T> || sizeof(T) > MAX_SNAPSHOT_STRIDE) {
+		return 0;
+	} else {
+		static constexpr std::array<std::byte, sizeof(T)> ZEROES{};
+		size_t n_entries = 0;
+
+		for (auto id : get_changed(since)) {
+			auto index = id_to_index[id];
+			std::span<const std::byte> previous{ZEROES};
+			if (baseline != nullptr && baseline->present.test(id))
+				previous = baseline->at(id);
+
+			auto entry_start = out.size();
+			write_varint(id, out);
+			out.push_back(std::byte{1});
+
+			auto component = storage.load(index);
+			std::span<const std::byte> current{reinterpret_cast<const std::byte*>(&component), sizeof(T)};
+			if (encode_xor_rle(current, previous, out))
+				n_entries++;
+			else
+				out.resize(entry_start);
+		}
+
+		if (baseline != nullptr) {
+			auto removed = baseline->present & ~present;
+			auto n_removed = removed.count();
+			for (EntityId id = 0; n_removed > 0; id++) {
+				if (!removed.test(id)) continue;
+				n_removed--;
+
+				write_varint(id, out);
+				out.push_back(std::byte{0});
+				n_entries++;
+			}
+		}
+
+		return n_entries;
+	}
+}
+
+template <SoaComponent T>
+inline auto ComponentArray<T>::restore_snapshot(const ComponentSnapshot& snapshot, const std::bitset<MAX_ENTITIES>& alive, std::vector<EntityId>& added, std::vector<EntityId>& removed) -> void {
+	if constexpr (std::is_trivially_copyable_v<T>) {
+		if (snapshot.stride != sizeof(T))
+			throw std::runtime_error{fmt::format("Cannot restore `{}` from a snapshot of {}-byte components.", typeid(T).name(), snapshot.stride)};
+
+		auto wanted = snapshot.present & alive;
+		for (EntityId id = 0; id < MAX_ENTITIES; id++) {
+			if (wanted.test(id)) {
+				T component;
+				std::memcpy(&component, snapshot.at(id).data(), sizeof(T));
+
+				if (present.test(id)) {
+					*get_component(id) = component;
+				} else {
+					set_component(id, std::move(component));
+					added.push_back(id);
+				}
+			} else if (present.test(id)) {
+				remove_component(id);
+				removed.push_back(id);
+			}
+		}
+	}
+}
+
+template <typename T>
+inline auto ComponentManager::get_component(EntityId id) -> std::optional<ComponentHandle<T>> {
 	return get_component_array<T>().get_component(id);
 }
 
 template <typename T>
-inline auto ComponentManager::get_component_raw(EntityId id) -> T& {
+inline auto ComponentManager::get_component_raw(EntityId id) -> ComponentRef<T> {
 	auto component = get_component_array<T>().get_component(id);
 	if (!component)
 		throw std::runtime_error{fmt::format("Entity with ID `{}` does not have a `{}` component.", id, typeid(T).name())};
 	return *component;
 }
 
+template <typename T>
+inline auto ComponentManager::read_component(EntityId id) -> ComponentConstRef<T> {
+	auto component = get_component_array<T>().read_component(id);
+	if (!component)
+		throw std::runtime_error{fmt::format("Entity with ID `{}` does not have a `{}` component.", id, typeid(T).name())};
+	return *component;
+}
+
+template <typename Filter>
+inline auto ComponentManager::query(Tick since) -> std::vector<EntityId> {
+	using T = typename Filter::Component;
+	auto& component_array = get_component_array<T>();
+
+	if constexpr (std::is_same_v<Filter, Added<T>>)
+		return component_array.get_added(since);
+	else if constexpr (std::is_same_v<Filter, Changed<T>>)
+		return component_array.get_changed(since);
+	else
+		return component_array.get_removed(since);
+}
+
 template <typename T, typename... Args>
-inline auto ComponentManager::create_component(EntityId id, Args&&... args) -> T& {
+inline auto ComponentManager::create_component(EntityId id, Args&&... args) -> ComponentRef<T> {
 	return get_component_array<T>().create_component(id, std::forward<Args>(args)...);
 }
 
 template <typename T>
-inline auto ComponentManager::set_component(EntityId id, T&& component) -> T& {
+inline auto ComponentManager::set_component(EntityId id, T&& component) -> ComponentRef<T> {
 	return get_component_array<T>().set_component(id, std::move(component));
 }
 
@@ -90,6 +793,35 @@ inline auto ComponentManager::remove_component(EntityId id) -> std::optional<T>
 	return get_component_array<T>().remove_component(id);
 }
 
+template <typename T, typename Compare>
+inline auto ComponentManager::sort(Compare compare) -> void {
+	get_component_array<T>().sort(compare);
+}
+
+template <typename T>
+inline auto ComponentManager::get_entities() -> std::span<const EntityId> {
+	return get_component_array<T>().get_entities();
+}
+
+template <auto Member>
+inline auto ComponentManager::get_field() -> std::span<MemberField<Member>> {
+	return get_component_array<MemberClass<Member>>().template get_field<Member>();
+}
+
+template <auto Member>
+inline auto ComponentManager::read_field() -> std::span<const MemberField<Member>> {
+	return get_component_array<MemberClass<Member>>().template read_field<Member>();
+}
+
+template <typename... Ts>
+inline auto ComponentManager::group() -> Group<Ts...>& {
+	auto type_name = typeid(Group<Ts...>).name();
+	auto search = groups.find(type_name);
+	if (search == groups.end())
+		search = groups.insert({type_name, std::make_unique<Group<Ts...>>(get_component_array<Ts>()...)}).first;
+	return static_cast<Group<Ts...>&>(*(search->second));
+}
+
 template <typename T>
 inline auto ComponentManager::get_component_id() -> ComponentId {
 	auto type_name = typeid(T).name();
@@ -121,6 +853,8 @@ inline auto ComponentManager::register_component_array() -> void {
 
 	auto type_name = typeid(T).name();
 	if (component_arrays.find(type_name) != component_arrays.end()) return;
-	component_arrays.insert({type_name, std::make_unique<ComponentArray<T>>()});
+	auto component_array = std::make_unique<ComponentArray<T>>(&tick);
+	component_arrays_by_id.push_back(component_array.get());
+	component_arrays.insert({type_name, std::move(component_array)});
 	component_ids.insert({type_name, next_component_id++});
 }
\ No newline at end of file
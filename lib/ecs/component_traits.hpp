@@ -0,0 +1,37 @@
+#pragma once
+
+#include <functional>
+
+#include "soa.hpp"
+
+/// @brief The types used to access a component.
+///
+/// Most components are accessed by reference, but components with a `SoaLayout` are split across several arrays,
+/// so they are accessed through a `SoaRef` and read by value instead.
+///
+/// @tparam T The component type.
+template <typename T>
+struct ComponentTraits {
+	/// @brief A mutable handle to a component, as returned by `get_component`.
+	using Handle = std::reference_wrapper<T>;
+	/// @brief A mutable reference to a component.
+	using Ref = T &;
+	/// @brief A read-only reference to a component.
+	using ConstRef = const T &;
+};
+
+template <SoaComponent T>
+struct ComponentTraits<T> {
+	using Handle = SoaRef<T>;
+	using Ref = SoaRef<T>;
+	using ConstRef = T;
+};
+
+template <typename T>
+using ComponentHandle = typename ComponentTraits<T>::Handle;
+
+template <typename T>
+using ComponentRef = typename ComponentTraits<T>::Ref;
+
+template <typename T>
+using ComponentConstRef = typename ComponentTraits<T>::ConstRef;
@@ -1,6 +1,18 @@
 #pragma once
 
+#ifndef CEGE_MAX_ENTITIES
+#define CEGE_MAX_ENTITIES 4096
+#endif
+
+#ifndef CEGE_MAX_COMPONENTS
+#define CEGE_MAX_COMPONENTS 1024
+#endif
+
 /// @brief Maximum number of entities that can be alive.
-constexpr auto MAX_ENTITIES = 4096;
+///
+/// This can be raised with the `max_entities` build option.
+constexpr auto MAX_ENTITIES = CEGE_MAX_ENTITIES;
 /// @brief Maximum number of components that can be registered.
-constexpr auto MAX_COMPONENTS = 64;
+///
+/// This can be raised with the `max_components` build option, up to 4096.
+constexpr auto MAX_COMPONENTS = CEGE_MAX_COMPONENTS;
@@ -37,16 +37,23 @@ auto EntityManager::create_entity(Scene *scene) -> std::shared_ptr<Entity> {
 }
 
 auto EntityManager::get_entity(EntityId id) -> std::shared_ptr<Entity> {
-	auto entity_ptr = entities.at(id);
-	if (entity_ptr.expired())
-		throw std::runtime_error{fmt::format("No entity with ID `{}` exists.", id)};
-
-	auto entity = entity_ptr.lock();
+	auto entity = find_entity(id);
 	if (entity == nullptr)
 		throw std::runtime_error{fmt::format("No entity with ID `{}` exists.", id)};
 	return entity;
 }
 
+auto EntityManager::find_entity(EntityId id) -> std::shared_ptr<Entity> {
+	return entities.at(id).lock();
+}
+
 auto EntityManager::destroy_entity(EntityId id) -> void {
 	entities.at(id).reset();
 }
+
+auto EntityManager::get_alive() const -> std::bitset<MAX_ENTITIES> {
+	std::bitset<MAX_ENTITIES> alive{};
+	for (auto i : std::ranges::views::iota(0, MAX_ENTITIES))
+		alive.set(i, !entities[i].expired());
+	return alive;
+}
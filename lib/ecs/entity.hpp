@@ -1,10 +1,12 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <memory>
 #include <optional>
 #include <queue>
 
+#include "component_traits.hpp"
 #include "constants.hpp"
 #include "types.hpp"
 
@@ -24,14 +26,27 @@ class Entity {
 	/// @tparam T The component type to get.
 	/// @return A reference to the component, or std::nullopt if the entity doesn't have this component.
 	template <typename T>
-	auto get_component() -> std::optional<std::reference_wrapper<T>>;
+	auto get_component() -> std::optional<ComponentHandle<T>>;
 
 	/// @brief Get an entity's component, throwing an exception if it doesn't exist.
 	/// @tparam T The component type to get.
 	/// @return A reference to the component.
 	/// @throw std::runtime_error Throws if the entity doesn't have this component.
 	template <typename T>
-	auto get_component_raw() -> T &;
+	auto get_component_raw() -> ComponentRef<T>;
+
+	/// @brief Get an entity's component without marking it as changed, throwing an exception if it doesn't exist.
+	/// @tparam T The component type to get.
+	/// @return A const reference to the component.
+	/// @throw std::runtime_error Throws if the entity doesn't have this component.
+	template <typename T>
+	auto read_component() -> ComponentConstRef<T>;
+
+	/// @brief Check whether this entity has a component.
+	/// @tparam T The component type to check for.
+	/// @return Whether this entity has this component.
+	template <typename T>
+	auto has_component() const -> bool;
 
 	/// @brief Create a component in place.
 	/// @tparam T The component type to create.
@@ -40,7 +55,7 @@ class Entity {
 	/// @return A reference to the component.
 	/// @throw std::runtime_error Throws if the entity already has a component of this type.
 	template <typename T, typename... Args>
-	auto create_component(Args &&...args) -> T &;
+	auto create_component(Args &&...args) -> ComponentRef<T>;
 
 	/// @brief Set a component.
 	/// @tparam T The component type to set.
@@ -48,7 +63,7 @@ class Entity {
 	/// @return A reference to the component.
 	/// @throw std::runtime_error Throws if the entity already has a component of this type.
 	template <typename T>
-	auto set_component(T &&component) -> T &;
+	auto set_component(T &&component) -> ComponentRef<T>;
 
 	/// @brief Remove a component.
 	/// @tparam T The component type to remove.
@@ -95,10 +110,20 @@ class EntityManager {
 	/// @throw std::out_of_range Throws if an invalid entity ID is passed.
 	auto get_entity(EntityId id) -> std::shared_ptr<Entity>;
 
+	/// @brief Find an entity that may not exist.
+	/// @param id The entity's ID.
+	/// @return A shared pointer to the entity, or nullptr if it doesn't exist or is being destroyed.
+	/// @throw std::out_of_range Throws if an invalid entity ID is passed.
+	auto find_entity(EntityId id) -> std::shared_ptr<Entity>;
+
 	/// @brief Destroy an entity.
 	/// @param id The entity's ID.
 	auto destroy_entity(EntityId id) -> void;
 
+	/// @brief Get which entities are alive.
+	/// @return A bitset with a bit set for each living entity's ID.
+	auto get_alive() const -> std::bitset<MAX_ENTITIES>;
+
    private:
 	std::queue<EntityId> available_ids{};
 	std::array<std::weak_ptr<Entity>, MAX_ENTITIES> entities{};
@@ -4,22 +4,32 @@
 #include "scene.hpp"
 
 template <typename T>
-inline auto Entity::get_component() -> std::optional<std::reference_wrapper<T>> {
+inline auto Entity::get_component() -> std::optional<ComponentHandle<T>> {
 	return scene->get_component<T>(*this);
 }
 
 template <typename T>
-inline auto Entity::get_component_raw() -> T & {
+inline auto Entity::get_component_raw() -> ComponentRef<T> {
 	return scene->get_component_raw<T>(*this);
 }
 
+template <typename T>
+inline auto Entity::read_component() -> ComponentConstRef<T> {
+	return scene->read_component<T>(*this);
+}
+
+template <typename T>
+inline auto Entity::has_component() const -> bool {
+	return scene->has_component<T>(*this);
+}
+
 template <typename T, typename... Args>
-inline auto Entity::create_component(Args &&...args) -> T & {
+inline auto Entity::create_component(Args &&...args) -> ComponentRef<T> {
 	return scene->create_component<T>(*this, std::forward<Args>(args)...);
 }
 
 template <typename T>
-inline auto Entity::set_component(T &&component) -> T & {
+inline auto Entity::set_component(T &&component) -> ComponentRef<T> {
 	return scene->set_component<T>(*this, std::move(component));
 }
 
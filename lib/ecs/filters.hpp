@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+class Entity;
+
+/// @brief A query filter for entities that gained a `T` component after a tick.
+/// @tparam T The component type.
+template <typename T>
+struct Added {
+	using Component = T;
+	using Result = std::vector<std::shared_ptr<Entity>>;
+};
+
+/// @brief A query filter for entities whose `T` component was created or mutably accessed after a tick.
+/// @tparam T The component type.
+template <typename T>
+struct Changed {
+	using Component = T;
+	using Result = std::vector<std::shared_ptr<Entity>>;
+};
+
+/// @brief A query filter for entities that lost a `T` component after a tick.
+///
+/// Since the entity may have been destroyed, this yields entity IDs instead of entities.
+/// Removals are only remembered for the current and previous tick.
+///
+/// @tparam T The component type.
+template <typename T>
+struct Removed {
+	using Component = T;
+	using Result = std::vector<EntityId>;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+#include "component.hpp"
+#include "types.hpp"
+
+/// @brief A set of component arrays that are kept aligned with each other.
+///
+/// Every entity that has all of the group's components is packed into the front of each array, in the same order.
+/// This means iterating the group is a lockstep walk over contiguous arrays, with no lookups.
+/// A component array can only be owned by one group at a time.
+///
+/// @tparam Ts The component types in the group.
+template <typename... Ts>
+class Group : public GenericGroup {
+	static_assert(!(std::is_empty_v<Ts> || ...), "Tags have no storage to pack, so they can't be grouped.");
+	static_assert(!(SoaComponent<Ts> || ...), "Components with a SoaLayout can't be grouped.");
+
+   public:
+	/// @internal
+	/// @brief Create a group and take ownership of its component arrays.
+	/// @param ...arrays The component arrays to own.
+	/// @throw std::runtime_error Throws if any of the arrays is already owned by another group.
+	Group(ComponentArray<Ts> &...arrays);
+
+	~Group() override;
+
+	/// @brief Get the number of entities in the group.
+	/// @return The number of entities that have every component in the group.
+	auto size() const -> size_t;
+
+	/// @brief Get the entities in the group, in iteration order.
+	/// @return A span of entity IDs.
+	auto get_entities() const -> std::span<const EntityId>;
+
+	/// @brief Get a component of every entity in the group, in iteration order.
+	///
+	/// Every component in the span is marked as changed on the current tick.
+	///
+	/// @tparam T The component type, which must be in the group.
+	/// @return A span of components, aligned with `get_entities()`.
+	template <typename T>
+	auto get() -> std::span<T>;
+
+	/// @brief Get a component of every entity in the group, in iteration order, without marking them as changed.
+	/// @tparam T The component type, which must be in the group.
+	/// @return A span of components, aligned with `get_entities()`.
+	template <typename T>
+	auto read() -> std::span<const T>;
+
+	/// @brief Call a function for every entity in the group, without marking components as changed.
+	/// @tparam F A function type with the signature `void(EntityId, const Ts&...)`.
+	/// @param f The function to call.
+	template <typename F>
+	auto each(F &&f) -> void;
+
+	/// @brief Sort the group by one of its components.
+	///
+	/// This uses an insertion sort, so keeping a group sorted every update is cheap when only a few entities move.
+	///
+	/// @tparam T The component type to sort by, which must be in the group.
+	/// @tparam Compare A function type with the signature `bool(const T&, const T&)`.
+	/// @param compare Returns whether the first component should come before the second.
+	template <typename T, typename Compare>
+	auto sort(Compare compare) -> void;
+
+	auto component_added(EntityId id) -> void override;
+	auto component_removed(EntityId id) -> void override;
+
+   private:
+	std::tuple<ComponentArray<Ts> *...> arrays;
+	size_t len = 0;
+
+	auto swap_all(size_t a, size_t b) -> void;
+};
+
+#include "group.ipp"
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <fmt/core.h>
+
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+
+#include "group.hpp"
+
+template <typename... Ts>
+inline Group<Ts...>::Group(ComponentArray<Ts> &...arrays) : arrays{&arrays...} {
+	// Every array is checked before any is taken, so a group that overlaps another doesn't leave arrays pointing at it
+	auto check_unowned = []<typename T>(const ComponentArray<T> &array) {
+		if (array.get_owner() != nullptr)
+			throw std::runtime_error{fmt::format("Component `{}` is already owned by a group.", typeid(T).name())};
+	};
+	(check_unowned(arrays), ...);
+	(arrays.set_owner(this), ...);
+
+	auto &first = *std::get<0>(this->arrays);
+	for (size_t index = 0; index < first.size(); index++)
+		component_added(first.get_entities()[index]);
+}
+
+template <typename... Ts>
+inline Group<Ts...>::~Group() {
+	std::apply([](auto *...arrays) { (arrays->set_owner(nullptr), ...); }, arrays);
+}
+
+template <typename... Ts>
+inline auto Group<Ts...>::size() const -> size_t {
+	return len;
+}
+
+template <typename... Ts>
+inline auto Group<Ts...>::get_entities() const -> std::span<const EntityId> {
+	return std::get<0>(arrays)->get_entities().first(len);
+}
+
+template <typename... Ts>
+template <typename T>
+inline auto Group<Ts...>::get() -> std::span<T> {
+	auto &array = *std::get<ComponentArray<T> *>(arrays);
+	array.mark_changed(0, len);
+	return array.get_components().first(len);
+}
+
+template <typename... Ts>
+template <typename T>
+inline auto Group<Ts...>::read() -> std::span<const T> {
+	return std::get<ComponentArray<T> *>(arrays)->get_components().first(len);
+}
+
+template <typename... Ts>
+template <typename F>
+inline auto Group<Ts...>::each(F &&f) -> void {
+	auto entities = get_entities();
+	auto components = std::make_tuple(read<Ts>()...);
+
+	for (size_t index = 0; index < len; index++)
+		std::apply([&](auto &...spans) { f(entities[index], spans[index]...); }, components);
+}
+
+template <typename... Ts>
+template <typename T, typename Compare>
+inline auto Group<Ts...>::sort(Compare compare) -> void {
+	std::get<ComponentArray<T> *>(arrays)->sort_range(0, len, compare, [this](size_t a, size_t b) { swap_all(a, b); });
+}
+
+template <typename... Ts>
+inline auto Group<Ts...>::component_added(EntityId id) -> void {
+	auto in_all = std::apply([id](auto *...arrays) { return (arrays->contains(id) && ...); }, arrays);
+	if (!in_all) return;
+
+	auto &first = *std::get<0>(arrays);
+	if (first.get_index(id) < len) return;
+
+	std::apply([this, id](auto *...arrays) { (arrays->swap_indices(arrays->get_index(id), len), ...); }, arrays);
+	len++;
+}
+
+template <typename... Ts>
+inline auto Group<Ts...>::component_removed(EntityId id) -> void {
+	auto in_all = std::apply([id](auto *...arrays) { return (arrays->contains(id) && ...); }, arrays);
+	if (!in_all) return;
+
+	auto &first = *std::get<0>(arrays);
+	if (first.get_index(id) >= len) return;
+
+	len--;
+	std::apply([this, id](auto *...arrays) { (arrays->swap_indices(arrays->get_index(id), len), ...); }, arrays);
+}
+
+template <typename... Ts>
+inline auto Group<Ts...>::swap_all(size_t a, size_t b) -> void {
+	std::apply([a, b](auto *...arrays) { (arrays->swap_indices(a, b), ...); }, arrays);
+}
@@ -0,0 +1,87 @@
+#include "observer.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "component.hpp"
+
+auto ObserverManager::add(ComponentManager &components, ComponentId component, LifecycleEvent event, ObserverCallback callback) -> ObserverId {
+	if (delivering)
+		throw std::runtime_error{"Observers cannot be added while events are being delivered."};
+
+	auto id = next_id++;
+	observers.push_back({id, component, event, std::move(callback)});
+	update_mask(components, component);
+	return id;
+}
+
+auto ObserverManager::remove(ComponentManager &components, ObserverId id) -> void {
+	if (delivering)
+		throw std::runtime_error{"Observers cannot be removed while events are being delivered."};
+
+	auto search = std::ranges::find(observers, id, &Observer::id);
+	if (search == observers.end())
+		throw std::runtime_error{fmt::format("No observer with ID `{}` exists.", id)};
+
+	auto component = search->component;
+	observers.erase(search);
+	update_mask(components, component);
+}
+
+auto ObserverManager::flush(Scene &scene, ComponentManager &components) -> size_t {
+	if (delivering)
+		throw std::runtime_error{"Events cannot be flushed while they are being delivered."};
+
+	delivering = true;
+	size_t n_delivered = 0;
+
+	try {
+		// Observed component types are visited in ID order, so delivery doesn't depend on how observers were added
+		std::vector<ComponentId> observed{};
+		for (auto &observer : observers)
+			observed.push_back(observer.component);
+		std::ranges::sort(observed);
+		auto [unique_end, _] = std::ranges::unique(observed);
+		observed.erase(unique_end, observed.end());
+
+		// Every buffer is taken before anything is delivered, so events caused by observers wait for the next flush
+		records.clear();
+		std::vector<size_t> ends{};
+		for (auto component : observed) {
+			components.get_component_array(component).take_events(records);
+			ends.push_back(records.size());
+		}
+		n_delivered = records.size();
+
+		size_t begin = 0;
+		for (size_t i = 0; i < observed.size(); i++) {
+			while (begin < ends[i]) {
+				auto event = records[begin].event;
+				ids.clear();
+				for (; begin < ends[i] && records[begin].event == event; begin++)
+					ids.push_back(records[begin].id);
+
+				for (auto &observer : observers)
+					if (observer.component == observed[i] && observer.event == event)
+						observer.callback(scene, ids);
+			}
+		}
+	} catch (...) {
+		delivering = false;
+		throw;
+	}
+
+	delivering = false;
+	return n_delivered;
+}
+
+auto ObserverManager::update_mask(ComponentManager &components, ComponentId component) -> void {
+	std::uint8_t mask = 0;
+	for (auto &observer : observers)
+		if (observer.component == component)
+			mask |= 1u << static_cast<unsigned>(observer.event);
+	components.get_component_array(component).set_observed(mask);
+}
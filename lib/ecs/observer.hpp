@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "types.hpp"
+
+class ComponentManager;
+class Scene;
+
+/// @brief Something that happened to a component, which observers can be told about.
+enum class LifecycleEvent : std::uint8_t {
+	/// @brief The component was added to an entity.
+	added,
+	/// @brief The component was removed from an entity that still exists.
+	removed,
+	/// @brief An entity with the component was destroyed.
+	destroyed,
+};
+
+/// @internal
+/// @brief A lifecycle event waiting to be delivered.
+struct LifecycleRecord {
+	EntityId id;
+	LifecycleEvent event;
+};
+
+/// @brief An observer event for entities that gained a `T` component.
+/// @tparam T The component type.
+template <typename T>
+struct OnAdd {
+	using Component = T;
+	static constexpr auto event = LifecycleEvent::added;
+};
+
+/// @brief An observer event for entities that lost a `T` component, but still exist.
+/// @tparam T The component type.
+template <typename T>
+struct OnRemove {
+	using Component = T;
+	static constexpr auto event = LifecycleEvent::removed;
+};
+
+/// @brief An observer event for destroyed entities that had a `T` component.
+/// @tparam T The component type.
+template <typename T>
+struct OnDestroy {
+	using Component = T;
+	static constexpr auto event = LifecycleEvent::destroyed;
+};
+
+/// @brief A unique identifier for an observer, used to remove it.
+using ObserverId = size_t;
+
+/// @brief Reacts to a batch of lifecycle events.
+///
+/// The IDs are in the order that the events happened. Destroyed entities can't be looked up anymore.
+using ObserverCallback = std::function<void(Scene &scene, std::span<const EntityId> ids)>;
+
+/// @brief A class to store observers and deliver lifecycle events to them.
+///
+/// Component arrays only record the events that someone observes, into a buffer per component type.
+/// Nothing is called while components change, since the buffers are only delivered when `flush` is called.
+class ObserverManager {
+   public:
+	/// @brief Add an observer.
+	/// @param components The scene's component manager.
+	/// @param component The ID of the component type to observe.
+	/// @param event The event to observe.
+	/// @param callback The function to call with each batch of events.
+	/// @return The observer's ID.
+	/// @throw std::runtime_error Throws if events are being delivered.
+	auto add(ComponentManager &components, ComponentId component, LifecycleEvent event, ObserverCallback callback) -> ObserverId;
+
+	/// @brief Remove an observer.
+	/// @param components The scene's component manager.
+	/// @param id The observer's ID.
+	/// @throw std::runtime_error Throws if the observer doesn't exist, or if events are being delivered.
+	auto remove(ComponentManager &components, ObserverId id) -> void;
+
+	/// @brief Deliver every recorded event.
+	///
+	/// Each component type's events are delivered in order, with consecutive events of the same kind in one batch.
+	/// Events caused by observers are recorded for the next flush.
+	///
+	/// @param scene The scene to pass to observers.
+	/// @param components The scene's component manager.
+	/// @return The number of events delivered.
+	/// @throw std::runtime_error Throws if events are already being delivered.
+	auto flush(Scene &scene, ComponentManager &components) -> size_t;
+
+   private:
+	struct Observer {
+		ObserverId id;
+		ComponentId component;
+		LifecycleEvent event;
+		ObserverCallback callback;
+	};
+
+	std::vector<Observer> observers{};
+	ObserverId next_id = 0;
+	bool delivering = false;
+
+	std::vector<LifecycleRecord> records{};
+	std::vector<EntityId> ids{};
+
+	auto update_mask(ComponentManager &components, ComponentId component) -> void;
+};
@@ -0,0 +1,21 @@
+#include "prefab.hpp"
+
+#include <utility>
+
+auto Prefab::size() const -> size_t {
+	return components.size();
+}
+
+auto Prefab::get_components() const -> std::span<const std::shared_ptr<const GenericPrefabComponent>> {
+	return components;
+}
+
+auto Prefab::insert(std::shared_ptr<const GenericPrefabComponent> component) -> void {
+	for (auto &existing : components) {
+		if (existing->get_type_name() == component->get_type_name()) {
+			existing = std::move(component);
+			return;
+		}
+	}
+	components.push_back(std::move(component));
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+class ComponentManager;
+class GenericComponentArray;
+
+/// @internal
+/// @brief An interface to allow storing a prefab's components without knowing their types.
+class GenericPrefabComponent {
+   public:
+	virtual ~GenericPrefabComponent() = default;
+
+	/// @internal
+	/// @brief Get the component's type name, which identifies it within a prefab.
+	/// @return The type name.
+	virtual auto get_type_name() const -> const std::string & = 0;
+
+	/// @internal
+	/// @brief Find the component's ID in a scene, registering its array if it doesn't exist.
+	/// @param manager The scene's component manager.
+	/// @return The component's ID.
+	virtual auto resolve(ComponentManager &manager) const -> ComponentId = 0;
+
+	/// @internal
+	/// @brief Give every entity in a batch a copy of the component.
+	/// @param array The component's array, as resolved by `resolve`.
+	/// @param ids The entities to write to, which don't have the component yet.
+	virtual auto write(GenericComponentArray &array, std::span<const EntityId> ids) const -> void = 0;
+};
+
+/// @internal
+/// @brief A prefab's component, with the value that it's copied from.
+/// @tparam T The component type.
+template <typename T>
+class PrefabComponent : public GenericPrefabComponent {
+   public:
+	/// @brief Store a component value.
+	/// @param value The value to copy into each instance.
+	explicit PrefabComponent(T value);
+
+	auto get_type_name() const -> const std::string & override;
+	auto resolve(ComponentManager &manager) const -> ComponentId override;
+	auto write(GenericComponentArray &array, std::span<const EntityId> ids) const -> void override;
+
+   private:
+	T value;
+	std::string type_name;
+};
+
+/// @brief A blueprint for entities, made of components with initial values.
+///
+/// Instantiating a prefab with `Scene::instantiate` gives each entity all of its components at once,
+/// so systems only have to match the entity once, instead of once per component.
+/// Prefabs don't belong to a scene, and copying one is cheap since the stored components are shared.
+class Prefab {
+   public:
+	/// @brief Add a component, constructed in place.
+	///
+	/// Adding a component type that the prefab already has replaces it.
+	///
+	/// @tparam T The component type to add, which must be copyable.
+	/// @tparam ...Args Argument types for the component constructor.
+	/// @param ...args The arguments to forward to the component constructor.
+	/// @return A reference to this prefab, for chaining.
+	template <typename T, typename... Args>
+	auto add(Args &&...args) -> Prefab &;
+
+	/// @brief Set a component.
+	///
+	/// Setting a component type that the prefab already has replaces it.
+	///
+	/// @tparam T The component type to set, which must be copyable.
+	/// @param component The component to copy into each instance.
+	/// @return A reference to this prefab, for chaining.
+	template <typename T>
+	auto set(T component) -> Prefab &;
+
+	/// @brief Check whether the prefab has a component.
+	/// @tparam T The component type to check for.
+	/// @return Whether the prefab has this component.
+	template <typename T>
+	auto has() const -> bool;
+
+	/// @brief Get the number of components.
+	/// @return The number of components.
+	auto size() const -> size_t;
+
+	/// @internal
+	/// @brief Get every component.
+	/// @return A span of components, in the order they were first added.
+	auto get_components() const -> std::span<const std::shared_ptr<const GenericPrefabComponent>>;
+
+   private:
+	std::vector<std::shared_ptr<const GenericPrefabComponent>> components{};
+
+	auto insert(std::shared_ptr<const GenericPrefabComponent> component) -> void;
+};
+
+#include "prefab.ipp"
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <typeinfo>
+#include <utility>
+
+#include "component.hpp"
+#include "prefab.hpp"
+
+template <typename T>
+inline PrefabComponent<T>::PrefabComponent(T value) : value{std::move(value)}, type_name{typeid(T).name()} {}
+
+template <typename T>
+inline auto PrefabComponent<T>::get_type_name() const -> const std::string & {
+	return type_name;
+}
+
+template <typename T>
+inline auto PrefabComponent<T>::resolve(ComponentManager &manager) const -> ComponentId {
+	return manager.get_component_id<T>();
+}
+
+template <typename T>
+inline auto PrefabComponent<T>::write(GenericComponentArray &array, std::span<const EntityId> ids) const -> void {
+	auto &components = static_cast<ComponentArray<T> &>(array);
+	for (auto id : ids)
+		components.set_component(id, T{value});
+}
+
+template <typename T, typename... Args>
+inline auto Prefab::add(Args &&...args) -> Prefab & {
+	return set(T{std::forward<Args>(args)...});
+}
+
+template <typename T>
+inline auto Prefab::set(T component) -> Prefab & {
+	insert(std::make_shared<PrefabComponent<T>>(std::move(component)));
+	return *this;
+}
+
+template <typename T>
+inline auto Prefab::has() const -> bool {
+	std::string type_name = typeid(T).name();
+	for (auto &component : components)
+		if (component->get_type_name() == type_name)
+			return true;
+	return false;
+}
@@ -0,0 +1,27 @@
+#include "resource.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+auto next_resource_id() -> ResourceId {
+	static std::atomic<ResourceId> next_id = 0;
+	return next_id++;
+}
+
+auto next_resource_epoch() -> size_t {
+	// Epoch 0 is never used, so a reference that was never resolved never matches
+	static std::atomic<size_t> next_epoch = 1;
+	return next_epoch++;
+}
+
+auto ResourceManager::get_epoch() const -> size_t {
+	return epoch;
+}
+
+auto ResourceAccess::conflicts_with(const ResourceAccess &other) const -> bool {
+	auto overlaps = [](const std::vector<ResourceId> &a, const std::vector<ResourceId> &b) {
+		return std::ranges::any_of(a, [&](auto id) { return std::ranges::find(b, id) != b.end(); });
+	};
+
+	return overlaps(writes, other.writes) || overlaps(writes, other.reads) || overlaps(reads, other.writes);
+}
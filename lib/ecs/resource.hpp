@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "types.hpp"
+
+/// @brief An interface to allow storing a collection of resources.
+class GenericResource {
+   public:
+	virtual ~GenericResource() = default;
+};
+
+/// @internal
+/// @brief Storage for a single resource.
+/// @tparam T The resource type.
+template <typename T>
+class Resource : public GenericResource {
+   public:
+	T value;
+
+	template <typename... Args>
+	Resource(Args &&...args);
+};
+
+/// @internal
+/// @brief Allocate the next resource type ID.
+/// @return A resource type ID that hasn't been used before.
+auto next_resource_id() -> ResourceId;
+
+/// @internal
+/// @brief Allocate the next resource epoch.
+/// @return An epoch that no resource manager has used before.
+auto next_resource_epoch() -> size_t;
+
+/// @brief Get the ID of a resource type.
+///
+/// IDs are assigned the first time a type is used, and are shared by every scene.
+///
+/// @tparam T The resource type.
+/// @return The resource type's ID.
+template <typename T>
+auto get_resource_id() -> ResourceId;
+
+/// @brief Marks a resource type that a system only reads.
+/// @tparam T The resource type.
+template <typename T>
+struct Read {};
+
+/// @brief Marks a resource type that a system writes.
+/// @tparam T The resource type.
+template <typename T>
+struct Write {};
+
+/// @brief The resource types that a system reads and writes.
+///
+/// Systems whose accesses don't conflict can safely run at the same time.
+struct ResourceAccess {
+	/// @brief The IDs of the resource types that are only read.
+	std::vector<ResourceId> reads{};
+
+	/// @brief The IDs of the resource types that are written.
+	std::vector<ResourceId> writes{};
+
+	/// @brief Build the accesses of a system.
+	/// @tparam ...Accesses `Read<T>` or `Write<T>` for each resource type the system uses.
+	/// @return The accesses.
+	template <typename... Accesses>
+	static auto of() -> ResourceAccess;
+
+	/// @brief Check whether two systems can't safely run at the same time.
+	/// @param other The other system's accesses.
+	/// @return Whether either system writes a resource that the other reads or writes.
+	auto conflicts_with(const ResourceAccess &other) const -> bool;
+
+	/// @internal
+	/// @brief Add a read-only access.
+	template <typename T>
+	auto add(Read<T>) -> void;
+
+	/// @internal
+	/// @brief Add a write access.
+	template <typename T>
+	auto add(Write<T>) -> void;
+};
+
+/// @brief A class to store and manage resources.
+///
+/// Resources are singletons that live outside of the entity pool, like the timestep or the input state.
+/// Each resource type's storage is found by indexing an array with its ID, and never moves once created,
+/// so references to resources stay valid until they are removed.
+class ResourceManager {
+   public:
+	/// @brief Create a resource in place.
+	/// @tparam T The resource type to create.
+	/// @tparam ...Args Argument types for the resource constructor.
+	/// @param ...args The arguments to forward to the resource constructor.
+	/// @return A reference to the resource.
+	/// @throw std::runtime_error Throws if the resource already exists.
+	template <typename T, typename... Args>
+	auto create(Args &&...args) -> T &;
+
+	/// @brief Get a resource.
+	/// @tparam T The resource type to get.
+	/// @return A reference to the resource.
+	/// @throw std::runtime_error Throws if the resource doesn't exist.
+	template <typename T>
+	auto get() -> T &;
+
+	/// @brief Check whether a resource exists.
+	/// @tparam T The resource type to check.
+	/// @return Whether the resource exists.
+	template <typename T>
+	auto contains() const -> bool;
+
+	/// @brief Remove a resource, invalidating any references to it.
+	/// @tparam T The resource type to remove.
+	/// @return The resource, or std::nullopt if it didn't exist.
+	template <typename T>
+	auto remove() -> std::optional<T>;
+
+	/// @brief Get a number that changes whenever a reference to a resource might have been invalidated.
+	///
+	/// Epochs are unique across every resource manager, so a cached epoch can't match another manager's.
+	///
+	/// @return The current epoch.
+	auto get_epoch() const -> size_t;
+
+   private:
+	std::vector<std::unique_ptr<GenericResource>> resources{};
+	size_t epoch = next_resource_epoch();
+};
+
+/// @brief A pointer to a resource that is looked up once, for systems that use the resource every update.
+///
+/// Keep one as a member of the system and pass it to `Scene::resource`.
+/// After the first lookup, getting the resource is a single comparison, until a resource is removed from the scene
+/// or the reference is used with a different scene, which looks it up again.
+///
+/// @tparam T The resource type.
+template <typename T>
+class ResourceRef {
+   public:
+	/// @brief Get the resource, looking it up only if the cached pointer might be stale.
+	/// @param manager The resource manager to get the resource from.
+	/// @return A reference to the resource.
+	/// @throw std::runtime_error Throws if the resource doesn't exist.
+	auto get(ResourceManager &manager) -> T &;
+
+   private:
+	T *value = nullptr;
+	size_t epoch = 0;
+};
+
+#include "resource.ipp"
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <fmt/core.h>
+
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+
+template <typename T>
+template <typename... Args>
+inline Resource<T>::Resource(Args &&...args) : value{std::forward<Args>(args)...} {}
+
+template <typename T>
+inline auto get_resource_id() -> ResourceId {
+	static const auto id = next_resource_id();
+	return id;
+}
+
+template <typename... Accesses>
+inline auto ResourceAccess::of() -> ResourceAccess {
+	ResourceAccess access{};
+	(access.add(Accesses{}), ...);
+	return access;
+}
+
+template <typename T>
+inline auto ResourceAccess::add(Read<T>) -> void {
+	reads.push_back(get_resource_id<T>());
+}
+
+template <typename T>
+inline auto ResourceAccess::add(Write<T>) -> void {
+	writes.push_back(get_resource_id<T>());
+}
+
+template <typename T, typename... Args>
+inline auto ResourceManager::create(Args &&...args) -> T & {
+	auto id = get_resource_id<T>();
+	if (id >= resources.size())
+		resources.resize(id + 1);
+
+	if (resources[id])
+		throw std::runtime_error{fmt::format("Resource `{}` cannot be created more than once.", typeid(T).name())};
+
+	auto resource = std::make_unique<Resource<T>>(std::forward<Args>(args)...);
+	auto &value = resource->value;
+	resources[id] = std::move(resource);
+	return value;
+}
+
+template <typename T>
+inline auto ResourceManager::get() -> T & {
+	auto id = get_resource_id<T>();
+	if (id >= resources.size() || !resources[id])
+		throw std::runtime_error{fmt::format("Resource `{}` does not exist.", typeid(T).name())};
+
+	return static_cast<Resource<T> &>(*resources[id]).value;
+}
+
+template <typename T>
+inline auto ResourceManager::contains() const -> bool {
+	auto id = get_resource_id<T>();
+	return id < resources.size() && resources[id];
+}
+
+template <typename T>
+inline auto ResourceManager::remove() -> std::optional<T> {
+	auto id = get_resource_id<T>();
+	if (id >= resources.size() || !resources[id])
+		return std::nullopt;
+
+	auto value = std::move(static_cast<Resource<T> &>(*resources[id]).value);
+	resources[id].reset();
+	epoch = next_resource_epoch();
+	return value;
+}
+
+template <typename T>
+inline auto ResourceRef<T>::get(ResourceManager &manager) -> T & {
+	if (epoch != manager.get_epoch()) {
+		value = &manager.get<T>();
+		epoch = manager.get_epoch();
+	}
+	return *value;
+}
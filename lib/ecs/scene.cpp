@@ -1,31 +1,135 @@
 #include "scene.hpp"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "component.hpp"
 #include "entity.hpp"
+#include "observer.hpp"
+#include "prefab.hpp"
+#include "resource.hpp"
 #include "system.hpp"
+#include "timer.hpp"
 
 Scene::Scene()
 	: entity_manager{std::make_unique<EntityManager>()},
 	  component_manager{std::make_unique<ComponentManager>()},
-	  system_manager{std::make_unique<SystemManager>()} {}
+	  system_manager{std::make_unique<SystemManager>()},
+	  resource_manager{std::make_unique<ResourceManager>()},
+	  observer_manager{std::make_unique<ObserverManager>()},
+	  timer_manager{std::make_unique<TimerManager>()} {}
+
+Scene::~Scene() {
+	// Each manager is null while it's being destroyed, so entities it owned skip it in destroy_entity
+	timer_manager.reset();
+	observer_manager.reset();
+	resource_manager.reset();
+	system_manager.reset();
+}
 
 auto Scene::create_entity() -> std::shared_ptr<Entity> {
 	return entity_manager->create_entity(this);
 }
 
+auto Scene::instantiate(const Prefab& prefab) -> std::shared_ptr<Entity> {
+	return std::move(instantiate(prefab, 1).front());
+}
+
+auto Scene::instantiate(const Prefab& prefab, size_t count) -> std::vector<std::shared_ptr<Entity>> {
+	// Every entity gets the same components, so each one is only looked up once
+	auto components = prefab.get_components();
+	Signature signature{};
+	std::vector<GenericComponentArray*> arrays{};
+	arrays.reserve(components.size());
+	for (auto& component : components) {
+		auto id = component->resolve(*component_manager);
+		signature.set(id);
+		arrays.push_back(&component_manager->get_component_array(id));
+	}
+
+	std::vector<std::shared_ptr<Entity>> entities{};
+	std::vector<EntityId> ids{};
+	entities.reserve(count);
+	ids.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		auto& entity = entities.emplace_back(entity_manager->create_entity(this));
+		ids.push_back(entity->get_id());
+	}
+
+	for (size_t i = 0; i < components.size(); i++)
+		components[i]->write(*arrays[i], ids);
+	for (auto& entity : entities)
+		entity->set_signature(signature);
+	system_manager->entities_created(entities, signature);
+
+	return entities;
+}
+
 auto Scene::destroy_entity(Entity& entity) -> void {
 	auto id = entity.get_id();
 
+	// Entities destroyed by their destructor can't be found anymore, but they aren't in any system either,
+	// since systems keep entities alive
+	auto entity_ptr = entity_manager->find_entity(id);
+
 	entity_manager->destroy_entity(id);
 	component_manager->entity_destroyed(id);
-
-	try {
-		auto entity_ptr = entity_manager->get_entity(id);
+	if (timer_manager)
+		timer_manager->entity_destroyed(id);
+	if (entity_ptr && system_manager)
 		system_manager->entity_destroyed(entity_ptr);
-	} catch (const std::runtime_error&) {
-		return;
-	}
+}
+
+auto Scene::get_entity(EntityId id) -> std::shared_ptr<Entity> {
+	return entity_manager->get_entity(id);
+}
+
+auto Scene::unobserve(ObserverId id) -> void {
+	observer_manager->remove(*component_manager, id);
+}
+
+auto Scene::flush_events() -> size_t {
+	return observer_manager->flush(*this, *component_manager);
+}
+
+auto Scene::schedule(Tick delay, TimerCallback callback) -> TimerId {
+	return timer_manager->schedule(delay, std::move(callback));
+}
+
+auto Scene::cancel_timer(TimerId id) -> bool {
+	return timer_manager->cancel(id);
+}
+
+auto Scene::get_timer_count() const -> size_t {
+	return timer_manager->size();
+}
+
+auto Scene::get_tick() const -> Tick {
+	return component_manager->get_tick();
+}
+
+auto Scene::advance_tick() -> void {
+	component_manager->advance_tick();
+	timer_manager->advance(*this);
+}
+
+auto Scene::create_snapshot() -> Snapshot {
+	return component_manager->create_snapshot();
+}
+
+auto Scene::create_delta(const Snapshot& baseline) -> Delta {
+	return component_manager->create_delta(baseline);
+}
+
+auto Scene::restore_snapshot(const Snapshot& snapshot) -> void {
+	component_manager->restore_snapshot(snapshot, entity_manager->get_alive(), [this](EntityId id, ComponentId component_id, bool added) {
+		auto entity = entity_manager->get_entity(id);
+
+		auto signature = entity->get_signature();
+		signature.set(component_id, added);
+		entity->set_signature(signature);
+
+		system_manager->entity_signature_changed(entity, signature);
+	});
 }
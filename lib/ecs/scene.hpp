@@ -3,35 +3,83 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string_view>
+#include <vector>
 
+#include "component_traits.hpp"
+#include "filters.hpp"
+#include "observer.hpp"
+#include "snapshot.hpp"
+#include "timer.hpp"
 #include "types.hpp"
 
 class ComponentManager;
 class Entity;
 class EntityManager;
+class ObserverManager;
+template <typename... Ts>
+class Group;
+class Prefab;
+class ResourceManager;
+template <typename T>
+class ResourceRef;
+struct ResourceAccess;
 class SystemManager;
+class TimerManager;
 
 /// @brief A container that manages a single ECS.
 class Scene {
    public:
 	Scene();
 
+	/// @brief Destroy the scene.
+	///
+	/// Systems, resources, observers and timers can own entities, so they're destroyed first,
+	/// while everything that destroying an entity touches still exists.
+	~Scene();
+
+	Scene(Scene &&) = default;
+	auto operator=(Scene &&) -> Scene & = default;
+
 	/// @brief Create an entity.
 	/// @return The entity.
 	/// @throw std::length_error Throws if too many entities are created.
 	auto create_entity() -> std::shared_ptr<Entity>;
 
+	/// @brief Create an entity from a prefab.
+	/// @param prefab The prefab to copy components from.
+	/// @return The entity.
+	/// @throw std::length_error Throws if too many entities are created.
+	auto instantiate(const Prefab &prefab) -> std::shared_ptr<Entity>;
+
+	/// @brief Create many entities from a prefab.
+	///
+	/// The prefab's components are looked up once for the whole batch, each component array is filled in one pass,
+	/// and systems are updated once for the batch, rather than once per component of every entity.
+	///
+	/// @param prefab The prefab to copy components from.
+	/// @param count The number of entities to create.
+	/// @return The entities, in creation order.
+	/// @throw std::length_error Throws if too many entities are created, in which case none are.
+	auto instantiate(const Prefab &prefab, size_t count) -> std::vector<std::shared_ptr<Entity>>;
+
 	/// @brief Destroy an entity.
 	/// @param entity The entity to be destroyed.
 	auto destroy_entity(Entity &entity) -> void;
 
+	/// @brief Get an existing entity.
+	/// @param id The entity's ID.
+	/// @return A shared pointer to the entity.
+	/// @throw std::runtime_error Throws if no entity with ID `id` exists.
+	auto get_entity(EntityId id) -> std::shared_ptr<Entity>;
+
 	/// @brief Get an entity's component.
 	/// @tparam T The component type to get.
 	/// @param entity The entity to get the component of.
 	/// @return A reference to the component, or std::nullopt if the entity doesn't have this component.
 	template <typename T>
-	auto get_component(const Entity &entity) -> std::optional<std::reference_wrapper<T>>;
+	auto get_component(const Entity &entity) -> std::optional<ComponentHandle<T>>;
 
 	/// @brief Get an entity's component, throwing an exception if it doesn't exist.
 	/// @tparam T The component type to get.
@@ -39,7 +87,36 @@ class Scene {
 	/// @return A reference to the component.
 	/// @throw std::runtime_error Throws if the entity doesn't have this component.
 	template <typename T>
-	auto get_component_raw(const Entity &entity) -> T &;
+	auto get_component_raw(const Entity &entity) -> ComponentRef<T>;
+
+	/// @brief Get an entity's component without marking it as changed, throwing an exception if it doesn't exist.
+	/// @tparam T The component type to get.
+	/// @param entity The entity to get the component of.
+	/// @return A const reference to the component.
+	/// @throw std::runtime_error Throws if the entity doesn't have this component.
+	template <typename T>
+	auto read_component(const Entity &entity) -> ComponentConstRef<T>;
+
+	/// @brief Check whether an entity has a component.
+	///
+	/// This only tests the entity's signature, so it's the cheapest way to check for a tag.
+	///
+	/// @tparam T The component type to check for.
+	/// @param entity The entity to check.
+	/// @return Whether the entity has this component.
+	template <typename T>
+	auto has_component(const Entity &entity) const -> bool;
+
+	/// @brief Find entities whose components were added, changed, or removed after a tick.
+	///
+	/// Systems that only care about changes can remember the tick they last ran on and pass it here,
+	/// so they only do work proportional to the number of changes.
+	///
+	/// @tparam Filter `Added<T>`, `Changed<T>`, or `Removed<T>`.
+	/// @param since The tick to look for changes after.
+	/// @return The matching entities, or entity IDs for `Removed<T>`.
+	template <typename Filter>
+	auto query(Tick since) -> typename Filter::Result;
 
 	/// @brief Create a component in place.
 	/// @tparam T The component type to create.
@@ -49,7 +126,7 @@ class Scene {
 	/// @return A reference to the component.
 	/// @throw std::runtime_error Throws if the entity already has a component of this type.
 	template <typename T, typename... Args>
-	auto create_component(Entity &entity, Args &&...args) -> T &;
+	auto create_component(Entity &entity, Args &&...args) -> ComponentRef<T>;
 
 	/// @brief Set an entity's component.
 	/// @tparam T The component type to set.
@@ -58,7 +135,7 @@ class Scene {
 	/// @return A reference to the component.
 	/// @throw std::runtime_error Throws if the entity already has a component of this type.
 	template <typename T>
-	auto set_component(Entity &entity, T &&component) -> T &;
+	auto set_component(Entity &entity, T &&component) -> ComponentRef<T>;
 
 	/// @brief Remove an entity's component.
 	/// @tparam T The component type to remove.
@@ -67,6 +144,94 @@ class Scene {
 	template <typename T>
 	auto remove_component(Entity &entity) -> std::optional<T>;
 
+	/// @brief Sort every component of a type.
+	///
+	/// This uses an insertion sort, so keeping components sorted every update is cheap when only a few of them move.
+	///
+	/// @tparam T The component type to sort.
+	/// @tparam Compare A function type with the signature `bool(const T&, const T&)`.
+	/// @param compare Returns whether the first component should come before the second.
+	/// @throw std::runtime_error Throws if the component type is owned by a group.
+	template <typename T, typename Compare>
+	auto sort(Compare compare) -> void;
+
+	/// @brief Get every entity that has a component, in storage order.
+	/// @tparam T The component type.
+	/// @return A span of entity IDs.
+	template <typename T>
+	auto get_entities() -> std::span<const EntityId>;
+
+	/// @brief Get one field of every component of a type, in storage order.
+	///
+	/// The component type must have a `SoaLayout`, so the span is a single contiguous array that loops can vectorize over.
+	/// Every component of the type is marked as changed on the current tick.
+	///
+	/// @tparam Member A member pointer listed in the component's layout, such as `&Velocity::x`.
+	/// @return A span of fields, aligned with `get_entities()`.
+	template <auto Member>
+	auto get_field() -> std::span<MemberField<Member>>;
+
+	/// @brief Get one field of every component of a type, in storage order, without marking them as changed.
+	/// @tparam Member A member pointer listed in the component's layout, such as `&Velocity::x`.
+	/// @return A span of fields, aligned with `get_entities()`.
+	template <auto Member>
+	auto read_field() -> std::span<const MemberField<Member>>;
+
+	/// @brief Get a group that keeps several component types aligned, creating it if it doesn't exist.
+	///
+	/// Entities with every component in the group are packed at the front of each component array in the same order,
+	/// so the group can be iterated as a lockstep walk over contiguous arrays.
+	///
+	/// @tparam T1 The first component type.
+	/// @tparam ...TN The rest of the component types.
+	/// @return A reference to the group.
+	/// @throw std::runtime_error Throws if any of the component types is already owned by another group.
+	template <typename T1, typename... TN>
+	auto group() -> Group<T1, TN...> &;
+
+	/// @brief Create a resource in place.
+	///
+	/// Resources are singletons that don't belong to any entity, like the timestep or the input state.
+	///
+	/// @tparam T The resource type to create.
+	/// @tparam ...Args Argument types for the resource constructor.
+	/// @param ...args The arguments to forward to the resource constructor.
+	/// @return A reference to the resource, which stays valid until the resource is removed.
+	/// @throw std::runtime_error Throws if the resource already exists.
+	template <typename T, typename... Args>
+	auto create_resource(Args &&...args) -> T &;
+
+	/// @brief Get a resource.
+	///
+	/// This indexes an array by the resource type's ID, so it never hashes anything.
+	/// Systems that use a resource every update can keep a `ResourceRef` instead, which skips the lookup.
+	///
+	/// @tparam T The resource type to get.
+	/// @return A reference to the resource.
+	/// @throw std::runtime_error Throws if the resource doesn't exist.
+	template <typename T>
+	auto resource() -> T &;
+
+	/// @brief Get a resource through a cached pointer.
+	/// @tparam T The resource type to get.
+	/// @param ref The cached pointer, which is updated if it's stale.
+	/// @return A reference to the resource.
+	/// @throw std::runtime_error Throws if the resource doesn't exist.
+	template <typename T>
+	auto resource(ResourceRef<T> &ref) -> T &;
+
+	/// @brief Check whether a resource exists.
+	/// @tparam T The resource type to check.
+	/// @return Whether the resource exists.
+	template <typename T>
+	auto has_resource() const -> bool;
+
+	/// @brief Remove a resource, invalidating any references to it.
+	/// @tparam T The resource type to remove.
+	/// @return The resource, or std::nullopt if it didn't exist.
+	template <typename T>
+	auto remove_resource() -> std::optional<T>;
+
 	/// @brief Create a system.
 	/// @tparam T The system to create.
 	/// @return A reference to the system instance.
@@ -114,10 +279,127 @@ class Scene {
 	template <typename T, typename Sig1, typename... Sigs>
 	auto set_system_signature() -> void;
 
+	/// @brief Declare the resources that a system reads and writes, so systems that conflict can be found.
+	/// @tparam T The system to set the resource accesses of.
+	/// @tparam ...Accesses `Read<R>` or `Write<R>` for each resource type the system uses.
+	template <typename T, typename... Accesses>
+	auto set_system_resources() -> void;
+
+	/// @brief Get the resources that a system reads and writes.
+	/// @tparam T The system to get the resource accesses of.
+	/// @return The resource accesses, which are empty if they were never set.
+	template <typename T>
+	auto get_system_resources() -> const ResourceAccess &;
+
+	/// @brief Observe a component's lifecycle.
+	///
+	/// Events are recorded as they happen, but the observer is only called by `flush_events`,
+	/// with every event since the last flush in as few batches as possible.
+	///
+	/// @tparam Event `OnAdd<T>`, `OnRemove<T>`, or `OnDestroy<T>`.
+	/// @param callback The function to call with each batch of entity IDs.
+	/// @return The observer's ID, which can be passed to `unobserve`.
+	/// @throw std::runtime_error Throws if events are being delivered.
+	template <typename Event>
+	auto observe(ObserverCallback callback) -> ObserverId;
+
+	/// @brief Stop observing a component's lifecycle.
+	/// @param id The observer's ID.
+	/// @throw std::runtime_error Throws if the observer doesn't exist, or if events are being delivered.
+	auto unobserve(ObserverId id) -> void;
+
+	/// @brief Deliver every lifecycle event since the last flush to its observers.
+	///
+	/// This should be called at sync points, such as once per update.
+	/// Events caused by observers are delivered by the next flush.
+	///
+	/// @return The number of events delivered.
+	/// @throw std::runtime_error Throws if called by an observer.
+	auto flush_events() -> size_t;
+
+	/// @brief Schedule a callback.
+	///
+	/// Timers are counted in calls to `advance_tick`, and cost nothing on ticks where they don't fire,
+	/// so cooldowns and expirations don't need a system that counts them down every update.
+	///
+	/// @param delay The number of ticks until the callback runs, where 0 is treated as 1.
+	/// @param callback The function to call.
+	/// @return The timer's ID, which can be passed to `cancel_timer`.
+	auto schedule(Tick delay, TimerCallback callback) -> TimerId;
+
+	/// @brief Schedule an event for an entity.
+	///
+	/// The event is delivered to the handler set by `on_timer`, batched with every other entity whose event fires on the same tick.
+	/// The timer is cancelled if the entity is destroyed first.
+	///
+	/// @tparam Event The timer event type.
+	/// @param entity The entity to deliver the event for.
+	/// @param delay The number of ticks until the event is delivered, where 0 is treated as 1.
+	/// @return The timer's ID, which can be passed to `cancel_timer`.
+	template <typename Event>
+	auto schedule(const Entity &entity, Tick delay) -> TimerId;
+
+	/// @brief Set the function that receives a timer event type.
+	/// @tparam Event The timer event type.
+	/// @param callback The function to call with each batch of entity IDs, replacing any previous one.
+	/// @throw std::runtime_error Throws if timers are being fired.
+	template <typename Event>
+	auto on_timer(ObserverCallback callback) -> void;
+
+	/// @brief Cancel a timer.
+	/// @param id The timer's ID.
+	/// @return Whether the timer was cancelled, which is false if it already fired or was cancelled.
+	auto cancel_timer(TimerId id) -> bool;
+
+	/// @brief Get the number of timers that haven't fired or been cancelled.
+	/// @return The number of timers.
+	auto get_timer_count() const -> size_t;
+
+	/// @brief Get the current tick.
+	///
+	/// Components are stamped with the current tick whenever they are created or mutably accessed.
+	///
+	/// @return The current tick.
+	auto get_tick() const -> Tick;
+
+	/// @brief Advance to the next tick, and fire every timer that is due on it.
+	///
+	/// This should be called once per update.
+	///
+	/// @throw std::runtime_error Throws if called by a timer.
+	/// @throw Rethrows the first exception thrown by a timer, after every other timer has fired.
+	auto advance_tick() -> void;
+
+	/// @brief Copy every trivially copyable component into a snapshot.
+	///
+	/// This ends the current tick, so later changes are attributed to the next one.
+	///
+	/// @return The snapshot.
+	auto create_snapshot() -> Snapshot;
+
+	/// @brief Encode every trivially copyable component that changed since a snapshot was taken.
+	///
+	/// This only visits components that were created or mutably accessed after the snapshot's tick,
+	/// and ends the current tick, so later changes are attributed to the next one.
+	///
+	/// @param baseline The snapshot to compare against.
+	/// @return The delta, which can be applied to a copy of `baseline` with `Snapshot::apply_delta`.
+	auto create_delta(const Snapshot &baseline) -> Delta;
+
+	/// @brief Overwrite components with the state in a snapshot.
+	///
+	/// Components are created and removed to match the snapshot, but only on entities that are still alive.
+	///
+	/// @param snapshot The snapshot to restore.
+	auto restore_snapshot(const Snapshot &snapshot) -> void;
+
    private:
 	std::unique_ptr<EntityManager> entity_manager;
 	std::unique_ptr<ComponentManager> component_manager;
 	std::unique_ptr<SystemManager> system_manager;
+	std::unique_ptr<ResourceManager> resource_manager;
+	std::unique_ptr<ObserverManager> observer_manager;
+	std::unique_ptr<TimerManager> timer_manager;
 };
 
 #include "scene.ipp"
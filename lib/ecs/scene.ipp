@@ -1,25 +1,57 @@
 #pragma once
 
 #include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "component.hpp"
 #include "entity.hpp"
+#include "group.hpp"
+#include "observer.hpp"
+#include "resource.hpp"
 #include "system.hpp"
+#include "timer.hpp"
 #include "types.hpp"
 
 template <typename T>
-inline auto Scene::get_component(const Entity &entity) -> std::optional<std::reference_wrapper<T>> {
+inline auto Scene::get_component(const Entity &entity) -> std::optional<ComponentHandle<T>> {
 	return component_manager->get_component<T>(entity.get_id());
 }
 
 template <typename T>
-inline auto Scene::get_component_raw(const Entity &entity) -> T &{
+inline auto Scene::get_component_raw(const Entity &entity) -> ComponentRef<T> {
 	return component_manager->get_component_raw<T>(entity.get_id());
 }
 
+template <typename T>
+inline auto Scene::read_component(const Entity &entity) -> ComponentConstRef<T> {
+	return component_manager->read_component<T>(entity.get_id());
+}
+
+template <typename T>
+inline auto Scene::has_component(const Entity &entity) const -> bool {
+	return entity.get_signature().test(component_manager->get_component_id<T>());
+}
+
+template <typename Filter>
+inline auto Scene::query(Tick since) -> typename Filter::Result {
+	auto ids = component_manager->query<Filter>(since);
+
+	if constexpr (std::is_same_v<typename Filter::Result, std::vector<EntityId>>) {
+		return ids;
+	} else {
+		typename Filter::Result entities{};
+		entities.reserve(ids.size());
+		for (auto id : ids)
+			entities.push_back(entity_manager->get_entity(id));
+		return entities;
+	}
+}
+
 template <typename T, typename... Args>
-inline auto Scene::create_component(Entity &entity, Args &&...args) -> T & {
-	auto &component_ref = component_manager->create_component<T>(entity.get_id(), std::forward<Args>(args)...);
+inline auto Scene::create_component(Entity &entity, Args &&...args) -> ComponentRef<T> {
+	ComponentRef<T> component_ref = component_manager->create_component<T>(entity.get_id(), std::forward<Args>(args)...);
 
 	auto signature = entity.get_signature();
 	signature.set(component_manager->get_component_id<T>());
@@ -31,8 +63,8 @@ inline auto Scene::create_component(Entity &entity, Args &&...args) -> T & {
 }
 
 template <typename T>
-inline auto Scene::set_component(Entity &entity, T &&component) -> T & {
-	auto &component_ref = component_manager->set_component<T>(entity.get_id(), std::move(component));
+inline auto Scene::set_component(Entity &entity, T &&component) -> ComponentRef<T> {
+	ComponentRef<T> component_ref = component_manager->set_component<T>(entity.get_id(), std::move(component));
 
 	auto signature = entity.get_signature();
 	signature.set(component_manager->get_component_id<T>());
@@ -56,6 +88,72 @@ inline auto Scene::remove_component(Entity &entity) -> std::optional<T> {
 	return component;
 }
 
+template <typename T, typename Compare>
+inline auto Scene::sort(Compare compare) -> void {
+	component_manager->sort<T>(compare);
+}
+
+template <typename T>
+inline auto Scene::get_entities() -> std::span<const EntityId> {
+	return component_manager->get_entities<T>();
+}
+
+template <auto Member>
+inline auto Scene::get_field() -> std::span<MemberField<Member>> {
+	return component_manager->get_field<Member>();
+}
+
+template <auto Member>
+inline auto Scene::read_field() -> std::span<const MemberField<Member>> {
+	return component_manager->read_field<Member>();
+}
+
+template <typename T1, typename... TN>
+inline auto Scene::group() -> Group<T1, TN...> & {
+	return component_manager->group<T1, TN...>();
+}
+
+template <typename T, typename... Args>
+inline auto Scene::create_resource(Args &&...args) -> T & {
+	return resource_manager->create<T>(std::forward<Args>(args)...);
+}
+
+template <typename T>
+inline auto Scene::resource() -> T & {
+	return resource_manager->get<T>();
+}
+
+template <typename T>
+inline auto Scene::resource(ResourceRef<T> &ref) -> T & {
+	return ref.get(*resource_manager);
+}
+
+template <typename T>
+inline auto Scene::has_resource() const -> bool {
+	return resource_manager->contains<T>();
+}
+
+template <typename T>
+inline auto Scene::remove_resource() -> std::optional<T> {
+	return resource_manager->remove<T>();
+}
+
+template <typename Event>
+inline auto Scene::observe(ObserverCallback callback) -> ObserverId {
+	auto component = component_manager->get_component_id<typename Event::Component>();
+	return observer_manager->add(*component_manager, component, Event::event, std::move(callback));
+}
+
+template <typename Event>
+inline auto Scene::schedule(const Entity &entity, Tick delay) -> TimerId {
+	return timer_manager->schedule(get_timer_event_id<Event>(), entity.get_id(), delay);
+}
+
+template <typename Event>
+inline auto Scene::on_timer(ObserverCallback callback) -> void {
+	timer_manager->set_handler(get_timer_event_id<Event>(), std::move(callback));
+}
+
 template <typename T>
 inline auto Scene::create_system() -> T & {
 	return system_manager->create_system<T>();
@@ -91,3 +189,13 @@ inline auto Scene::set_system_signature() -> void {
 	auto signature = create_signature<Sig1, Sigs...>();
 	set_system_signature<T>(signature);
 }
+
+template <typename T, typename... Accesses>
+inline auto Scene::set_system_resources() -> void {
+	system_manager->set_resource_access<T>(ResourceAccess::of<Accesses...>());
+}
+
+template <typename T>
+inline auto Scene::get_system_resources() -> const ResourceAccess & {
+	return system_manager->get_resource_access<T>();
+}
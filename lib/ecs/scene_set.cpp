@@ -0,0 +1,158 @@
+#include "scene_set.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "util/thread_pool.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// How much each step moves a scene's average step time, which is used to predict whether it fits in a tick
+constexpr auto MEAN_WEIGHT = 0.125;
+
+SceneSet::SceneSet(ThreadPool &pool) : pool{pool}, queues(pool.get_thread_count()) {}
+
+auto SceneSet::create_scene(StepFunction step, bool parallel) -> Scene & {
+	auto member = std::make_unique<Member>();
+	member->step = std::move(step);
+	member->parallel = parallel;
+
+	// New scenes go to the thread with the fewest scenes, and stay there
+	if (!parallel) {
+		std::vector<size_t> n_scenes(queues.size());
+		for (auto &other : members)
+			if (!other->parallel)
+				n_scenes[other->stats.home_thread]++;
+		member->stats.home_thread = static_cast<size_t>(std::ranges::min_element(n_scenes) - n_scenes.begin());
+	}
+
+	auto &scene = member->scene;
+	indices[&scene] = members.size();
+	members.push_back(std::move(member));
+	return scene;
+}
+
+auto SceneSet::destroy_scene(Scene &scene) -> void {
+	members.erase(members.begin() + static_cast<std::ptrdiff_t>(find(scene)));
+
+	indices.clear();
+	for (size_t i = 0; i < members.size(); i++)
+		indices[&members[i]->scene] = i;
+}
+
+auto SceneSet::size() const -> size_t {
+	return members.size();
+}
+
+auto SceneSet::step() -> void {
+	auto start = Clock::now();
+	auto elapsed_ms = [&] {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	};
+
+	for (auto &queue : queues)
+		queue.clear();
+	parallel_members.clear();
+	for (auto &member : members)
+		(member->parallel ? parallel_members : queues[member->stats.home_thread]).push_back(member.get());
+
+	// Scenes that have waited the longest go first, so they're the last to be skipped again
+	auto by_lag = [](const Member *member) { return member->stats.lag; };
+	for (auto &queue : queues)
+		std::ranges::stable_sort(queue, std::greater{}, by_lag);
+	std::ranges::stable_sort(parallel_members, std::greater{}, by_lag);
+
+	std::vector<std::atomic<size_t>> cursors(queues.size());
+	std::atomic<size_t> n_stepped = 0, n_skipped = 0, n_stolen = 0;
+	std::mutex error_mutex{};
+	std::exception_ptr error{};
+
+	// Every thread steps at least one scene, so an overloaded set still makes progress
+	auto run = [&](Member &member, size_t thread, bool &stepped_any, ThreadPool *scene_pool) {
+		auto &stats = member.stats;
+		auto over_budget = settings.tick_budget_ms > 0.0 && elapsed_ms() + stats.mean_ms > settings.tick_budget_ms;
+		if (over_budget && stepped_any && stats.lag < settings.max_skipped_ticks) {
+			stats.lag++;
+			stats.skipped_ticks++;
+			n_skipped++;
+			return;
+		}
+
+		stepped_any = true;
+		auto step_start = Clock::now();
+		try {
+			member.step(member.scene, scene_pool);
+		} catch (...) {
+			std::scoped_lock lock{error_mutex};
+			if (!error)
+				error = std::current_exception();
+		}
+		auto ms = std::chrono::duration<double, std::milli>(Clock::now() - step_start).count();
+
+		stats.ticks++;
+		stats.lag = 0;
+		stats.last_ms = ms;
+		stats.mean_ms = stats.ticks == 1 ? ms : stats.mean_ms + (ms - stats.mean_ms) * MEAN_WEIGHT;
+		stats.max_ms = std::max(stats.max_ms, ms);
+		if (thread != stats.home_thread) {
+			stats.stolen_ticks++;
+			n_stolen++;
+		}
+		n_stepped++;
+	};
+
+	pool.run_on_each([&](size_t thread) {
+		// Each thread works through its own queue, then helps with the others, starting with the next thread's
+		auto stepped_any = false;
+		for (size_t offset = 0; offset < queues.size(); offset++) {
+			auto index = (thread + offset) % queues.size();
+			auto &queue = queues[index];
+			for (auto i = cursors[index]++; i < queue.size(); i = cursors[index]++)
+				run(*queue[i], thread, stepped_any, nullptr);
+		}
+	});
+
+	// Scenes that use the pool themselves get all of it, one at a time
+	auto stepped_any = false;
+	for (auto member : parallel_members)
+		run(*member, 0, stepped_any, &pool);
+
+	tick_stats = {
+		.tick_ms = elapsed_ms(),
+		.stepped = n_stepped,
+		.skipped = n_skipped,
+		.stolen = n_stolen,
+	};
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+auto SceneSet::get_stats(const Scene &scene) const -> const SceneStats & {
+	return members[find(scene)]->stats;
+}
+
+auto SceneSet::get_tick_stats() const -> const SceneSetStats & {
+	return tick_stats;
+}
+
+auto SceneSet::get_settings() const -> const SceneSetSettings & {
+	return settings;
+}
+
+auto SceneSet::set_settings(const SceneSetSettings &settings) -> void {
+	this->settings = settings;
+}
+
+auto SceneSet::find(const Scene &scene) const -> size_t {
+	auto it = indices.find(&scene);
+	if (it == indices.end())
+		throw std::runtime_error{"Scene isn't in this set."};
+	return it->second;
+}
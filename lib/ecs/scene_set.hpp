@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "scene.hpp"
+
+class ThreadPool;
+
+/// @brief How a `SceneSet` steps its scenes.
+struct SceneSetSettings {
+	/// @brief How long a tick may take, in milliseconds, or 0 to always step every scene.
+	///
+	/// When stepping every scene would take longer, the scenes that have waited the longest are stepped first,
+	/// and the rest wait for a later tick, so every scene gets a fair share of an overloaded tick.
+	double tick_budget_ms = 0.0;
+
+	/// @brief How many ticks in a row a scene can wait before it is stepped regardless of the budget.
+	size_t max_skipped_ticks = 4;
+};
+
+/// @brief Timings of a single scene in a `SceneSet`.
+struct SceneStats {
+	/// @brief The number of ticks that the scene was stepped in.
+	size_t ticks = 0;
+
+	/// @brief The number of ticks that the scene waited through, because the tick was over budget.
+	size_t skipped_ticks = 0;
+
+	/// @brief The number of ticks in a row that the scene has waited through.
+	size_t lag = 0;
+
+	/// @brief The number of ticks that the scene was stepped on a thread other than its own.
+	size_t stolen_ticks = 0;
+
+	/// @brief The thread that the scene is usually stepped on.
+	size_t home_thread = 0;
+
+	/// @brief The time that the last step took, in milliseconds.
+	double last_ms = 0.0;
+
+	/// @brief A moving average of the time that a step takes, in milliseconds.
+	double mean_ms = 0.0;
+
+	/// @brief The longest time that a step took, in milliseconds.
+	double max_ms = 0.0;
+};
+
+/// @brief Timings of the last tick of a `SceneSet`.
+struct SceneSetStats {
+	/// @brief The time that the tick took, in milliseconds.
+	double tick_ms = 0.0;
+
+	/// @brief The number of scenes that were stepped.
+	size_t stepped = 0;
+
+	/// @brief The number of scenes that waited for a later tick.
+	size_t skipped = 0;
+
+	/// @brief The number of scenes that were stepped on a thread other than their own.
+	size_t stolen = 0;
+};
+
+/// @brief A set of independent scenes that are stepped together, spread across a thread pool.
+///
+/// Each scene is assigned to a thread, which steps it every tick, so its data tends to stay in one core's cache.
+/// Threads that run out of their own scenes take scenes from other threads' queues.
+/// How much faster this is than stepping the scenes in turn depends on the number of cores and the size of each scene,
+/// so measure it with `scene_set.bench` on the target machine; with one core, the set can only add overhead.
+///
+/// A scene is only ever stepped by one thread at a time, so scenes don't need to be thread-safe.
+/// Scenes that want to use the pool themselves are stepped one at a time on the calling thread, after the others.
+class SceneSet {
+   public:
+	/// @brief Steps a scene by one tick.
+	///
+	/// The pool is only passed to scenes that were created as parallel, and is nullptr for every other scene.
+	using StepFunction = std::function<void(Scene &scene, ThreadPool *pool)>;
+
+	/// @brief Create an empty set.
+	/// @param pool The pool to step scenes on. It must outlive the set.
+	explicit SceneSet(ThreadPool &pool);
+
+	/// @brief Create a scene that is stepped with the rest of the set.
+	/// @param step The function that steps the scene.
+	/// @param parallel Whether the scene uses the pool itself (false by default).
+	/// @return The scene, which stays at the same address until it is destroyed.
+	auto create_scene(StepFunction step, bool parallel = false) -> Scene &;
+
+	/// @brief Destroy a scene.
+	/// @param scene The scene to destroy.
+	/// @throw std::runtime_error Throws if the scene isn't in this set.
+	auto destroy_scene(Scene &scene) -> void;
+
+	/// @brief Get the number of scenes.
+	/// @return The number of scenes.
+	auto size() const -> size_t;
+
+	/// @brief Step every scene by one tick, or as many as the tick budget allows.
+	/// @throw Rethrows the first exception thrown by a step function, after every other scene has been stepped.
+	auto step() -> void;
+
+	/// @brief Get the timings of a scene.
+	/// @param scene The scene.
+	/// @return The scene's timings.
+	/// @throw std::runtime_error Throws if the scene isn't in this set.
+	auto get_stats(const Scene &scene) const -> const SceneStats &;
+
+	/// @brief Get the timings of the last tick.
+	/// @return The tick's timings.
+	auto get_tick_stats() const -> const SceneSetStats &;
+
+	/// @brief Get how scenes are stepped.
+	/// @return The settings.
+	auto get_settings() const -> const SceneSetSettings &;
+
+	/// @brief Set how scenes are stepped.
+	/// @param settings The new settings.
+	auto set_settings(const SceneSetSettings &settings) -> void;
+
+	SceneSet(const SceneSet &) = delete;
+	SceneSet(SceneSet &&) = delete;
+	auto operator=(const SceneSet &) -> void = delete;
+
+   private:
+	struct Member {
+		Scene scene{};
+		StepFunction step;
+		bool parallel;
+		SceneStats stats{};
+	};
+
+	ThreadPool &pool;
+	SceneSetSettings settings{};
+	SceneSetStats tick_stats{};
+	std::vector<std::unique_ptr<Member>> members{};
+	std::unordered_map<const Scene *, size_t> indices{};
+	std::vector<std::vector<Member *>> queues;
+	std::vector<Member *> parallel_members{};
+
+	auto find(const Scene &scene) const -> size_t;
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <fmt/core.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "constants.hpp"
+
+/// @brief A bitset used to identify which components an entity has.
+///
+/// The bits are stored in 64-bit words, and a summary word records which of those words are non-zero.
+/// Operations only visit the words that the summary marks, so their cost depends on how many components are set
+/// rather than on the number of bits.
+///
+/// @tparam N The number of bits, which can't be more than 4096.
+template <size_t N>
+class BasicSignature {
+   public:
+	/// @brief Set or clear a bit.
+	/// @param id The component ID.
+	/// @param value Whether the bit should be set.
+	/// @return This signature.
+	/// @throw std::out_of_range Throws if the ID is `N` or more.
+	auto set(size_t id, bool value = true) -> BasicSignature & {
+		if (!value)
+			return reset(id);
+
+		check(id);
+		words[id / WORD_BITS] |= bit(id);
+		summary |= bit(id / WORD_BITS);
+		return *this;
+	}
+
+	/// @brief Clear a bit.
+	/// @param id The component ID.
+	/// @return This signature.
+	/// @throw std::out_of_range Throws if the ID is `N` or more.
+	auto reset(size_t id) -> BasicSignature & {
+		check(id);
+		auto &word = words[id / WORD_BITS];
+		word &= ~bit(id);
+		if (word == 0)
+			summary &= ~bit(id / WORD_BITS);
+		return *this;
+	}
+
+	/// @brief Check whether a bit is set.
+	/// @param id The component ID.
+	/// @return Whether the bit is set.
+	/// @throw std::out_of_range Throws if the ID is `N` or more.
+	auto test(size_t id) const -> bool {
+		check(id);
+		return (words[id / WORD_BITS] & bit(id)) != 0;
+	}
+
+	/// @brief Check whether no bits are set.
+	/// @return Whether no bits are set.
+	auto none() const -> bool {
+		return summary == 0;
+	}
+
+	/// @brief Count the set bits.
+	/// @return The number of set bits.
+	auto count() const -> size_t {
+		size_t n = 0;
+		for (auto rest = summary; rest != 0; rest &= rest - 1)
+			n += std::popcount(words[std::countr_zero(rest)]);
+		return n;
+	}
+
+	/// @brief Check whether every bit set in another signature is also set in this one.
+	///
+	/// This is the same as `(*this & other) == other`, without building the intersection.
+	///
+	/// @param other The signature to look for, such as a system's signature.
+	/// @return Whether this signature contains the other one.
+	auto contains(const BasicSignature &other) const -> bool {
+		// A few words are cheaper to compare outright than to walk through the summary
+		if constexpr (N_WORDS <= 4) {
+			auto missing = std::uint64_t{0};
+			for (size_t index = 0; index < N_WORDS; index++)
+				missing |= other.words[index] & ~words[index];
+			return missing == 0;
+		}
+
+		if ((other.summary & ~summary) != 0) return false;
+
+		for (auto rest = other.summary; rest != 0; rest &= rest - 1) {
+			auto index = std::countr_zero(rest);
+			if ((words[index] & other.words[index]) != other.words[index]) return false;
+		}
+		return true;
+	}
+
+	/// @brief Intersect two signatures.
+	/// @param other The other signature.
+	/// @return A signature with the bits that are set in both.
+	auto operator&(const BasicSignature &other) const -> BasicSignature {
+		BasicSignature result{};
+		for (auto rest = summary & other.summary; rest != 0; rest &= rest - 1) {
+			auto index = std::countr_zero(rest);
+			result.words[index] = words[index] & other.words[index];
+			if (result.words[index] != 0)
+				result.summary |= bit(index);
+		}
+		return result;
+	}
+
+	/// @brief Combine two signatures.
+	/// @param other The other signature.
+	/// @return A signature with the bits that are set in either.
+	auto operator|(const BasicSignature &other) const -> BasicSignature {
+		BasicSignature result{};
+		result.summary = summary | other.summary;
+		for (auto rest = result.summary; rest != 0; rest &= rest - 1) {
+			auto index = std::countr_zero(rest);
+			result.words[index] = words[index] | other.words[index];
+		}
+		return result;
+	}
+
+	/// @brief Check whether two signatures have the same bits set.
+	/// @param other The other signature.
+	/// @return Whether the signatures are equal.
+	auto operator==(const BasicSignature &other) const -> bool {
+		if (summary != other.summary) return false;
+
+		for (auto rest = summary; rest != 0; rest &= rest - 1) {
+			auto index = std::countr_zero(rest);
+			if (words[index] != other.words[index]) return false;
+		}
+		return true;
+	}
+
+   private:
+	static constexpr size_t WORD_BITS = 64;
+	static constexpr size_t N_WORDS = (N + WORD_BITS - 1) / WORD_BITS;
+	static_assert(N_WORDS <= WORD_BITS, "Signatures can't have more than 4096 bits, since the summary is a single word.");
+
+	static constexpr auto bit(size_t index) -> std::uint64_t {
+		return std::uint64_t{1} << (index % WORD_BITS);
+	}
+
+	static auto check(size_t id) -> void {
+		if (id >= N) [[unlikely]]
+			throw std::out_of_range{fmt::format("Component ID {} is out of range for a {}-bit signature.", id, N)};
+	}
+
+	std::array<std::uint64_t, N_WORDS> words{};
+	std::uint64_t summary = 0;
+};
+
+/// @brief A signature with a bit for every component that can be registered.
+using Signature = BasicSignature<MAX_COMPONENTS>;
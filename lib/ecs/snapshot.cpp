@@ -0,0 +1,126 @@
+#include "snapshot.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+auto ComponentSnapshot::at(EntityId id) -> std::span<std::byte> {
+	return {data.data() + id * stride, stride};
+}
+
+auto ComponentSnapshot::at(EntityId id) const -> std::span<const std::byte> {
+	return {data.data() + id * stride, stride};
+}
+
+auto Snapshot::apply_delta(const Delta &delta) -> void {
+	if (delta.base_tick != tick)
+		throw std::runtime_error{fmt::format("Cannot apply a delta against tick {} to a snapshot at tick {}.", delta.base_tick, tick)};
+
+	std::span<const std::byte> in{delta.data};
+	while (!in.empty()) {
+		// Every count is checked before it's used, so a corrupt delta can't pick the wrong component or allocate without bound
+		auto raw_component_id = read_varint(in);
+		auto stride = read_varint(in);
+		auto n_entries = read_varint(in);
+		if (raw_component_id >= MAX_COMPONENTS || stride > MAX_SNAPSHOT_STRIDE)
+			throw std::runtime_error{"Malformed delta."};
+		auto component_id = static_cast<ComponentId>(raw_component_id);
+
+		auto &component = components[component_id];
+		if (component.data.empty()) {
+			component.stride = stride;
+			component.data.resize(MAX_ENTITIES * stride);
+		} else if (component.stride != stride) {
+			throw std::runtime_error{fmt::format("Component {} changed size from {} to {} bytes.", component_id, component.stride, stride)};
+		}
+
+		for (size_t i = 0; i < n_entries; i++) {
+			auto id = read_varint(in);
+			if (id >= MAX_ENTITIES || in.empty())
+				throw std::runtime_error{"Malformed delta."};
+
+			auto removed = in.front() == std::byte{0};
+			in = in.subspan(1);
+
+			auto bytes = component.at(id);
+			if (removed) {
+				std::ranges::fill(bytes, std::byte{0});
+				component.present.reset(id);
+			} else {
+				decode_xor_rle(in, bytes);
+				component.present.set(id);
+			}
+		}
+	}
+
+	tick = delta.tick;
+}
+
+auto write_varint(size_t value, std::vector<std::byte> &out) -> void {
+	while (value >= 0x80) {
+		out.push_back(static_cast<std::byte>((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<std::byte>(value));
+}
+
+auto read_varint(std::span<const std::byte> &in) -> size_t {
+	size_t value = 0;
+	for (auto shift = 0; !in.empty(); shift += 7) {
+		if (shift >= 64)
+			throw std::runtime_error{"Varint is longer than 64 bits."};
+
+		auto byte = std::to_integer<size_t>(in.front());
+		in = in.subspan(1);
+		value |= (byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+			return value;
+	}
+	throw std::runtime_error{"Unexpected end of varint."};
+}
+
+auto encode_xor_rle(std::span<const std::byte> current, std::span<const std::byte> previous, std::vector<std::byte> &out) -> bool {
+	auto changed = false;
+	size_t i = 0;
+
+	while (i < current.size()) {
+		auto zeros_start = i;
+		while (i < current.size() && current[i] == previous[i])
+			i++;
+
+		auto literal_start = i;
+		while (i < current.size() && current[i] != previous[i])
+			i++;
+
+		write_varint(literal_start - zeros_start, out);
+		write_varint(i - literal_start, out);
+		for (auto j = literal_start; j < i; j++)
+			out.push_back(current[j] ^ previous[j]);
+
+		changed |= i > literal_start;
+	}
+
+	return changed;
+}
+
+auto decode_xor_rle(std::span<const std::byte> &in, std::span<std::byte> target) -> void {
+	size_t i = 0;
+
+	while (i < target.size()) {
+		auto zeros_len = read_varint(in);
+		auto literal_len = read_varint(in);
+		if (zeros_len > target.size() - i)
+			throw std::runtime_error{"Malformed run-length encoding."};
+
+		i += zeros_len;
+		if (literal_len > target.size() - i || literal_len > in.size())
+			throw std::runtime_error{"Malformed run-length encoding."};
+
+		for (size_t j = 0; j < literal_len; j++)
+			target[i + j] ^= in[j];
+
+		in = in.subspan(literal_len);
+		i += literal_len;
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "constants.hpp"
+#include "types.hpp"
+
+struct Delta;
+
+/// @brief The largest component, in bytes, that snapshots and deltas store.
+constexpr size_t MAX_SNAPSHOT_STRIDE = 64 * 1024;
+
+/// @brief The serialized state of a single component type.
+struct ComponentSnapshot {
+	/// @brief The size of one component in bytes.
+	size_t stride = 0;
+
+	/// @brief Which entities have this component.
+	std::bitset<MAX_ENTITIES> present{};
+
+	/// @brief The raw component bytes, indexed by entity ID.
+	///
+	/// Slots of entities that don't have this component are always zeroed.
+	std::vector<std::byte> data{};
+
+	/// @brief Get the bytes of an entity's component.
+	/// @param id The entity ID.
+	/// @return A span over the component's bytes.
+	auto at(EntityId id) -> std::span<std::byte>;
+
+	/// @brief Get the bytes of an entity's component.
+	/// @param id The entity ID.
+	/// @return A span over the component's bytes.
+	auto at(EntityId id) const -> std::span<const std::byte>;
+};
+
+/// @brief A copy of every trivially copyable component in a scene at a given tick.
+///
+/// Components that aren't trivially copyable (such as `Texture`), or are larger than `MAX_SNAPSHOT_STRIDE`, are not included.
+struct Snapshot {
+	/// @brief The tick that this snapshot was taken at.
+	Tick tick = 0;
+
+	/// @brief The state of each component type, keyed by component ID.
+	std::unordered_map<ComponentId, ComponentSnapshot> components{};
+
+	/// @brief Advance this snapshot to a newer tick.
+	/// @param delta A delta that was created against a snapshot at this snapshot's tick.
+	/// @throw std::runtime_error Throws if the delta was created against a different tick, or is malformed.
+	auto apply_delta(const Delta &delta) -> void;
+};
+
+/// @brief The components that changed between two ticks.
+///
+/// Each changed component is XORed against its previous value and run-length encoded, so unchanged bytes cost almost nothing.
+struct Delta {
+	/// @brief The tick of the snapshot that this delta was created against.
+	Tick base_tick = 0;
+
+	/// @brief The tick that applying this delta advances a snapshot to.
+	Tick tick = 0;
+
+	/// @brief The encoded changes.
+	std::vector<std::byte> data{};
+};
+
+/// @internal
+/// @brief Append an unsigned integer to a buffer as a LEB128 varint.
+/// @param value The value to write.
+/// @param out The buffer to append to.
+auto write_varint(size_t value, std::vector<std::byte> &out) -> void;
+
+/// @internal
+/// @brief Read a LEB128 varint from the front of a buffer.
+/// @param in The buffer to read from, which is advanced past the varint.
+/// @return The value.
+/// @throw std::runtime_error Throws if the buffer ends in the middle of the varint, or the varint doesn't fit in 64 bits.
+auto read_varint(std::span<const std::byte> &in) -> size_t;
+
+/// @internal
+/// @brief XOR two equally sized byte ranges and run-length encode the zero runs of the result.
+/// @param current The new bytes.
+/// @param previous The old bytes.
+/// @param out The buffer to append the encoded bytes to.
+/// @return Whether the ranges differed at all.
+auto encode_xor_rle(std::span<const std::byte> current, std::span<const std::byte> previous, std::vector<std::byte> &out) -> bool;
+
+/// @internal
+/// @brief Decode bytes written by `encode_xor_rle` and XOR them into a target.
+/// @param in The buffer to read from, which is advanced past the encoded bytes.
+/// @param target The previous bytes, which are overwritten with the new bytes.
+/// @throw std::runtime_error Throws if the encoded bytes are malformed.
+auto decode_xor_rle(std::span<const std::byte> &in, std::span<std::byte> target) -> void;
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "constants.hpp"
+
+/// @brief Opts a component into a struct-of-arrays layout.
+///
+/// Specialize this with a `fields` tuple of member pointers, and each of those members will be stored in its own array:
+///
+/// ```cpp
+/// template <>
+/// struct SoaLayout<Velocity> {
+/// 	static constexpr auto fields = std::tuple{&Velocity::x, &Velocity::y};
+/// };
+/// ```
+///
+/// Members that aren't listed are not stored, so every member must be listed once, in declaration order.
+/// This is checked at compile time by comparing the listed fields' layout with the component's size,
+/// and their count with the number of members that the component can be brace-initialized with.
+///
+/// @tparam T The component type.
+template <typename T>
+struct SoaLayout;
+
+/// @brief A component type with a `SoaLayout`.
+template <typename T>
+concept SoaComponent = requires { SoaLayout<T>::fields; };
+
+/// @brief The alignment of each field array, which is wide enough for any SIMD register.
+constexpr size_t SOA_ALIGNMENT = 64;
+
+/// @internal
+/// @brief The class and value type of a member pointer.
+template <typename M>
+struct MemberTraits;
+
+template <typename C, typename F>
+struct MemberTraits<F C::*> {
+	using Class = C;
+	using Field = F;
+};
+
+/// @brief The component type that a member pointer belongs to.
+template <auto Member>
+using MemberClass = typename MemberTraits<decltype(Member)>::Class;
+
+/// @brief The type of the member that a member pointer points to.
+template <auto Member>
+using MemberField = typename MemberTraits<decltype(Member)>::Field;
+
+/// @brief The number of fields in a component's layout.
+template <SoaComponent T>
+constexpr auto SOA_FIELD_COUNT = std::tuple_size_v<std::remove_cvref_t<decltype(SoaLayout<T>::fields)>>;
+
+/// @brief The type of a component's field.
+/// @tparam T The component type.
+/// @tparam I The index of the field in the layout.
+template <SoaComponent T, size_t I>
+using SoaField = typename MemberTraits<std::remove_cvref_t<decltype(std::get<I>(SoaLayout<T>::fields))>>::Field;
+
+/// @internal
+/// @brief Find the index of a member in its component's layout.
+/// @tparam Member The member pointer.
+/// @return The index of the field.
+template <auto Member, size_t I = 0>
+consteval auto soa_index() -> size_t {
+	using T = MemberClass<Member>;
+	static_assert(I < SOA_FIELD_COUNT<T>, "This member isn't listed in the component's layout.");
+
+	constexpr auto field = std::get<I>(SoaLayout<T>::fields);
+	if constexpr (std::is_same_v<std::remove_cv_t<decltype(field)>, decltype(Member)>) {
+		if constexpr (field == Member)
+			return I;
+		else
+			return soa_index<Member, I + 1>();
+	} else {
+		return soa_index<Member, I + 1>();
+	}
+}
+
+/// @internal
+/// @brief Get the size of a struct with only the fields in a component's layout, in the listed order.
+/// @tparam T The component type.
+/// @return The size, including padding.
+template <SoaComponent T, size_t... Is>
+consteval auto soa_layout_size(std::index_sequence<Is...>) -> size_t {
+	auto align = [](size_t offset, size_t alignment) { return (offset + alignment - 1) / alignment * alignment; };
+
+	size_t size = 0;
+	((size = align(size, alignof(SoaField<T, Is>)) + sizeof(SoaField<T, Is>)), ...);
+	return align(size, alignof(T));
+}
+
+/// @internal
+/// @brief Check that no member is listed twice in a component's layout.
+/// @tparam T The component type.
+/// @return Whether every field is a different member.
+template <SoaComponent T, size_t... Is>
+consteval auto soa_fields_are_distinct(std::index_sequence<Is...>) -> bool {
+	// A member listed twice is always found at its first index
+	return ((soa_index<std::get<Is>(SoaLayout<T>::fields)>() == Is) && ...);
+}
+
+/// @internal
+/// @brief Converts to any member type, to count an aggregate's members by how many initializers it accepts.
+struct SoaAnyMember {
+	template <typename F>
+	operator F() const;
+};
+
+/// @internal
+/// @brief Check whether an aggregate can be brace-initialized with a number of values.
+/// @tparam T The aggregate type.
+/// @return Whether it can.
+template <typename T, size_t... Is>
+consteval auto soa_accepts_initializers(std::index_sequence<Is...>) -> bool {
+	return requires { T{(static_cast<void>(Is), SoaAnyMember{})...}; };
+}
+
+/// @internal
+/// @brief Count the members of an aggregate.
+/// @tparam T The aggregate type.
+/// @return The number of members.
+template <typename T, size_t N = 0>
+consteval auto soa_member_count() -> size_t {
+	if constexpr (soa_accepts_initializers<T>(std::make_index_sequence<N + 1>{}))
+		return soa_member_count<T, N + 1>();
+	else
+		return N;
+}
+
+/// @internal
+/// @brief Check that a component's layout lists every one of its members once, in declaration order.
+/// @tparam T The component type.
+/// @return Whether the layout is complete.
+template <SoaComponent T>
+consteval auto soa_layout_is_complete() -> bool {
+	constexpr auto fields = std::make_index_sequence<SOA_FIELD_COUNT<T>>{};
+	if (soa_layout_size<T>(fields) != sizeof(T)) return false;
+	if (!soa_fields_are_distinct<T>(fields)) return false;
+
+	// Only aggregates can be counted, so other components are only checked by size
+	if constexpr (std::is_aggregate_v<T>)
+		return soa_member_count<T>() == SOA_FIELD_COUNT<T>;
+	return true;
+}
+
+/// @brief Whether a component's layout lists every one of its members once, in declaration order.
+///
+/// A member that is left out would silently be reset whenever the component is stored,
+/// so components whose layout isn't complete can't be stored.
+///
+/// @tparam T The component type.
+template <SoaComponent T>
+constexpr auto SOA_LAYOUT_IS_COMPLETE = soa_layout_is_complete<T>();
+
+/// @internal
+/// @brief The array that one field is stored in.
+/// @tparam F The field type.
+template <typename F>
+struct alignas(SOA_ALIGNMENT) SoaColumn {
+	std::array<F, MAX_ENTITIES> values{};
+};
+
+/// @internal
+/// @brief Every field array of a component.
+template <SoaComponent T, typename Is = std::make_index_sequence<SOA_FIELD_COUNT<T>>>
+struct SoaColumns;
+
+template <SoaComponent T, size_t... Is>
+struct SoaColumns<T, std::index_sequence<Is...>> {
+	static_assert(SOA_LAYOUT_IS_COMPLETE<T>, "A SoaLayout must list every member of its component once, in declaration order.");
+
+	std::tuple<SoaColumn<SoaField<T, Is>>...> columns{};
+
+	/// @brief Copy a component's fields into the arrays.
+	/// @param index The index to write to.
+	/// @param component The component to copy.
+	auto store(size_t index, const T &component) -> void {
+		((std::get<Is>(columns).values[index] = component.*std::get<Is>(SoaLayout<T>::fields)), ...);
+	}
+
+	/// @brief Gather a component's fields from the arrays.
+	/// @param index The index to read from.
+	/// @return A copy of the component.
+	auto load(size_t index) const -> T {
+		T component{};
+		((component.*std::get<Is>(SoaLayout<T>::fields) = std::get<Is>(columns).values[index]), ...);
+		return component;
+	}
+
+	/// @brief Move the fields at one index to another.
+	/// @param to The index to write to.
+	/// @param from The index to read from.
+	auto move(size_t to, size_t from) -> void {
+		((std::get<Is>(columns).values[to] = std::move(std::get<Is>(columns).values[from])), ...);
+	}
+};
+
+/// @brief A reference to a component that is stored as separate fields.
+///
+/// Like a reference to any other component, this is invalidated when a component of the same type is removed.
+///
+/// @tparam T The component type.
+template <SoaComponent T>
+class SoaRef {
+   public:
+	/// @internal
+	/// @brief Create a reference to a component.
+	/// @param storage The field arrays the component is stored in.
+	/// @param index The component's index in the arrays.
+	SoaRef(SoaColumns<T> *storage, size_t index) : storage{storage}, index{index} {}
+
+	/// @brief Get one of the component's fields.
+	/// @tparam Member A member pointer listed in the component's layout, such as `&Velocity::x`.
+	/// @return A reference to the field.
+	template <auto Member>
+	auto get() const -> MemberField<Member> & {
+		return std::get<soa_index<Member>()>(storage->columns).values[index];
+	}
+
+	/// @brief Gather a copy of the component.
+	/// @return A copy of the component.
+	auto load() const -> T {
+		return storage->load(index);
+	}
+
+	operator T() const {
+		return load();
+	}
+
+	/// @brief Overwrite every field of the component.
+	/// @param component The new value.
+	/// @return This reference.
+	auto operator=(const T &component) const -> const SoaRef & {
+		storage->store(index, component);
+		return *this;
+	}
+
+   private:
+	SoaColumns<T> *storage;
+	size_t index;
+};
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <span>
 #include <utility>
 
 #include "entity.hpp"
@@ -11,17 +12,23 @@
 
 auto SystemManager::entity_destroyed(std::shared_ptr<Entity> entity) -> void {
 	for (auto& [_, system] : systems)
-		system.entities.erase(entity);
+		system->entities.erase(entity);
 }
 
 auto SystemManager::entity_signature_changed(std::shared_ptr<Entity> entity, Signature signature) -> void {
 	for (auto& [type, system] : systems) {
 		auto entity_ptr = std::shared_ptr{entity};
-		auto system_signature = signatures[type];
+		auto &system_signature = signatures[type];
 
-		if ((signature & system_signature) == system_signature)
-			system.entities.insert(entity_ptr);
+		if (signature.contains(system_signature))
+			system->entities.insert(entity_ptr);
 		else
-			system.entities.erase(entity_ptr);
+			system->entities.erase(entity_ptr);
 	}
 }
+
+auto SystemManager::entities_created(std::span<const std::shared_ptr<Entity>> entities, Signature signature) -> void {
+	for (auto& [type, system] : systems)
+		if (signature.contains(signatures[type]))
+			system->entities.insert(entities.begin(), entities.end());
+}
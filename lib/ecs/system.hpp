@@ -5,10 +5,12 @@
 #include <functional>
 #include <memory>
 #include <set>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
 
+#include "resource.hpp"
 #include "types.hpp"
 
 class Entity;
@@ -43,6 +45,18 @@ class SystemManager {
 	template <typename T>
 	auto set_signature(Signature signature) -> void;
 
+	/// @brief Set the resources that a system reads and writes.
+	/// @tparam T The system to set the resource accesses of.
+	/// @param access The resource accesses.
+	template <typename T>
+	auto set_resource_access(ResourceAccess access) -> void;
+
+	/// @brief Get the resources that a system reads and writes.
+	/// @tparam T The system to get the resource accesses of.
+	/// @return The resource accesses, which are empty if they were never set.
+	template <typename T>
+	auto get_resource_access() -> const ResourceAccess &;
+
 	/// @internal
 	/// @brief Remove an entity from all systems.
 	///
@@ -61,9 +75,20 @@ class SystemManager {
 	/// @param signature The new signature.
 	auto entity_signature_changed(std::shared_ptr<Entity> entity, Signature signature) -> void;
 
+	/// @internal
+	/// @brief Add a batch of new entities to every system that they match.
+	///
+	/// This method should be called by `Scene` when a prefab is instantiated.
+	/// Every entity has the same signature, so each system's signature is only checked once.
+	///
+	/// @param entities The new entities, which aren't in any system yet.
+	/// @param signature The signature that every entity has.
+	auto entities_created(std::span<const std::shared_ptr<Entity>> entities, Signature signature) -> void;
+
    private:
 	std::unordered_map<std::string, Signature> signatures{};
-	std::unordered_map<std::string, System> systems{};
+	std::unordered_map<std::string, ResourceAccess> resource_accesses{};
+	std::unordered_map<std::string, std::unique_ptr<System>> systems{};
 };
 
 #include "system.ipp"
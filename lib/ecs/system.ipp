@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include "entity.hpp"
 
 template <typename T>
@@ -9,9 +11,8 @@ inline auto SystemManager::create_system() -> T& {
 	if (systems.find(type_name) != systems.end())
 		throw std::runtime_error{fmt::format("System `{}` cannot be created more than once.", type_name)};
 
-	systems.insert({type_name, T{}});
-	auto search = systems.find(type_name);
-	return static_cast<T&>(search->second);
+	auto [search, _] = systems.insert({type_name, std::make_unique<T>()});
+	return static_cast<T&>(*(search->second));
 }
 
 template <typename T>
@@ -19,3 +20,15 @@ inline auto SystemManager::set_signature(Signature signature) -> void {
 	auto type_name = typeid(T).name();
 	signatures.insert_or_assign(type_name, signature);
 }
+
+template <typename T>
+inline auto SystemManager::set_resource_access(ResourceAccess access) -> void {
+	auto type_name = typeid(T).name();
+	resource_accesses.insert_or_assign(type_name, std::move(access));
+}
+
+template <typename T>
+inline auto SystemManager::get_resource_access() -> const ResourceAccess& {
+	auto type_name = typeid(T).name();
+	return resource_accesses[type_name];
+}
@@ -0,0 +1,210 @@
+#include "timer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+auto next_timer_event_id() -> TimerEventId {
+	static std::atomic<TimerEventId> next_id = 0;
+	return next_id++;
+}
+
+TimerManager::TimerManager() {
+	slots.fill(NONE);
+	entity_timers.fill(NONE);
+}
+
+auto TimerManager::schedule(Tick delay, TimerCallback callback) -> TimerId {
+	auto index = create(delay);
+	callbacks[index] = std::move(callback);
+	return (static_cast<TimerId>(timers[index].generation) << 32) | index;
+}
+
+auto TimerManager::schedule(TimerEventId event, EntityId entity, Tick delay) -> TimerId {
+	auto head = entity_timers.at(entity);
+	auto index = create(delay);
+	auto &timer = timers[index];
+	timer.event = event;
+	timer.entity = entity;
+
+	timer.entity_next = head;
+	if (timer.entity_next != NONE)
+		timers[timer.entity_next].entity_prev = index;
+	entity_timers[entity] = index;
+
+	return (static_cast<TimerId>(timer.generation) << 32) | index;
+}
+
+auto TimerManager::set_handler(TimerEventId event, ObserverCallback callback) -> void {
+	if (advancing)
+		throw std::runtime_error{"Can't set a timer handler while timers are being fired."};
+
+	if (event >= handlers.size())
+		handlers.resize(event + 1);
+	handlers[event] = std::move(callback);
+}
+
+auto TimerManager::cancel(TimerId id) -> bool {
+	auto index = static_cast<std::uint32_t>(id);
+	if (index >= timers.size()) return false;
+
+	auto &timer = timers[index];
+	if (timer.slot == NONE || timer.generation != static_cast<std::uint32_t>(id >> 32)) return false;
+
+	// The callback is destroyed last, since it may own an entity whose destruction cancels more timers
+	auto callback = std::move(callbacks[index]);
+	unlink(index);
+	release(index);
+	return true;
+}
+
+auto TimerManager::entity_destroyed(EntityId entity) -> void {
+	if (entity >= entity_timers.size()) return;
+
+	while (entity_timers[entity] != NONE) {
+		auto index = entity_timers[entity];
+		unlink(index);
+		release(index);
+	}
+}
+
+auto TimerManager::advance(Scene &scene) -> size_t {
+	if (advancing)
+		throw std::runtime_error{"Can't advance timers while they're being fired."};
+
+	now++;
+
+	// Higher levels go first, so timers that move down land in slots that are about to be emptied
+	for (auto level = LEVELS - 1; level > 0; level--) {
+		if ((now & ((std::uint64_t{1} << (SLOT_BITS * level)) - 1)) == 0)
+			cascade(level);
+	}
+
+	// Every timer is taken out of the wheel before anything runs, so callbacks can schedule and cancel freely
+	size_t n_fired = 0;
+	auto index = std::exchange(slots[now & (SLOTS - 1)], NONE);
+	while (index != NONE) {
+		auto &timer = timers[index];
+		auto next = timer.next;
+		if (timer.event == NO_EVENT) {
+			firing.push_back(std::move(callbacks[index]));
+		} else {
+			if (timer.event >= batches.size())
+				batches.resize(timer.event + 1);
+			batches[timer.event].push_back(timer.entity);
+		}
+
+		release(index);
+		n_fired++;
+		index = next;
+	}
+
+	advancing = true;
+	std::exception_ptr exception{};
+	auto run = [&](auto &&f) {
+		try {
+			f();
+		} catch (...) {
+			if (!exception)
+				exception = std::current_exception();
+		}
+	};
+
+	for (auto &callback : firing)
+		run([&] { callback(scene); });
+	firing.clear();
+
+	for (TimerEventId event = 0; event < batches.size(); event++) {
+		auto &batch = batches[event];
+		if (batch.empty()) continue;
+
+		if (event < handlers.size() && handlers[event])
+			run([&] { handlers[event](scene, batch); });
+		batch.clear();
+	}
+	advancing = false;
+
+	if (exception)
+		std::rethrow_exception(exception);
+	return n_fired;
+}
+
+auto TimerManager::size() const -> size_t {
+	return n_live;
+}
+
+auto TimerManager::create(Tick delay) -> std::uint32_t {
+	std::uint32_t index;
+	if (free_timers != NONE) {
+		index = free_timers;
+		free_timers = timers[index].next;
+	} else {
+		index = static_cast<std::uint32_t>(timers.size());
+		timers.emplace_back();
+		callbacks.emplace_back();
+	}
+
+	auto &timer = timers[index];
+	timer.expiry = now + std::max<Tick>(delay, 1);
+	timer.event = NO_EVENT;
+	timer.entity_next = timer.entity_prev = NONE;
+	link(index);
+	n_live++;
+	return index;
+}
+
+auto TimerManager::release(std::uint32_t index) -> void {
+	auto &timer = timers[index];
+	if (timer.event != NO_EVENT) {
+		if (timer.entity_prev != NONE)
+			timers[timer.entity_prev].entity_next = timer.entity_next;
+		else
+			entity_timers[timer.entity] = timer.entity_next;
+		if (timer.entity_next != NONE)
+			timers[timer.entity_next].entity_prev = timer.entity_prev;
+	}
+
+	// Bumping the generation makes every ID of this timer stale, so the slot can be reused
+	timer.generation++;
+	timer.slot = NONE;
+	timer.next = free_timers;
+	free_timers = index;
+	n_live--;
+}
+
+auto TimerManager::link(std::uint32_t index) -> void {
+	auto &timer = timers[index];
+	auto remaining = timer.expiry - now;
+
+	std::uint64_t level = 0;
+	while (level + 1 < LEVELS && remaining >= (std::uint64_t{1} << (SLOT_BITS * (level + 1))))
+		level++;
+
+	timer.slot = static_cast<std::uint32_t>(level * SLOTS + ((timer.expiry >> (SLOT_BITS * level)) & (SLOTS - 1)));
+	timer.prev = NONE;
+	timer.next = slots[timer.slot];
+	if (timer.next != NONE)
+		timers[timer.next].prev = index;
+	slots[timer.slot] = index;
+}
+
+auto TimerManager::unlink(std::uint32_t index) -> void {
+	auto &timer = timers[index];
+	if (timer.prev != NONE)
+		timers[timer.prev].next = timer.next;
+	else
+		slots[timer.slot] = timer.next;
+	if (timer.next != NONE)
+		timers[timer.next].prev = timer.prev;
+}
+
+auto TimerManager::cascade(std::uint64_t level) -> void {
+	auto index = std::exchange(slots[level * SLOTS + ((now >> (SLOT_BITS * level)) & (SLOTS - 1))], NONE);
+	while (index != NONE) {
+		auto next = timers[index].next;
+		link(index);
+		index = next;
+	}
+}
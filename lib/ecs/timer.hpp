@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "constants.hpp"
+#include "observer.hpp"
+#include "types.hpp"
+
+class Scene;
+
+/// @brief A unique identifier for a timer, used to cancel it.
+///
+/// IDs aren't reused, so cancelling a timer that already fired does nothing.
+using TimerId = std::uint64_t;
+
+/// @brief A unique identifier for a timer event type.
+using TimerEventId = size_t;
+
+/// @brief Runs when a timer fires.
+using TimerCallback = std::function<void(Scene &scene)>;
+
+/// @internal
+/// @brief Allocate the next timer event type ID.
+/// @return A timer event type ID that hasn't been used before.
+auto next_timer_event_id() -> TimerEventId;
+
+/// @brief Get the ID of a timer event type.
+///
+/// Timer event types are empty structs that name what a timer means, like `CooldownEnded` or `Despawn`.
+/// IDs are assigned the first time a type is used, and are shared by every scene.
+///
+/// @tparam T The timer event type.
+/// @return The timer event type's ID.
+template <typename T>
+auto get_timer_event_id() -> TimerEventId;
+
+/// @brief A class to store timers and fire them as ticks pass.
+///
+/// Timers are kept in a hierarchical timer wheel: four levels of 256 slots, where each level's slots span 256 times as many ticks
+/// as the level below. A timer goes into the lowest level whose range reaches it, and moves down a level whenever the wheel
+/// reaches its slot, so scheduling, cancelling and firing a timer are O(1), and ticks where nothing fires cost almost nothing.
+///
+/// Entity timers don't hold a callback each. Every entity whose timers of the same event type fire on a tick is delivered to
+/// that event type's handler in one batch, like observers.
+class TimerManager {
+   public:
+	TimerManager();
+
+	/// @brief Schedule a callback.
+	/// @param delay The number of ticks until the callback runs, where 0 is treated as 1.
+	/// @param callback The function to call.
+	/// @return The timer's ID.
+	auto schedule(Tick delay, TimerCallback callback) -> TimerId;
+
+	/// @brief Schedule an event for an entity.
+	/// @param event The ID of the timer event type.
+	/// @param entity The entity's ID.
+	/// @param delay The number of ticks until the event is delivered, where 0 is treated as 1.
+	/// @return The timer's ID.
+	/// @throw std::out_of_range Throws if an invalid entity ID is passed.
+	auto schedule(TimerEventId event, EntityId entity, Tick delay) -> TimerId;
+
+	/// @brief Set the function that receives a timer event type.
+	/// @param event The ID of the timer event type.
+	/// @param callback The function to call with each batch of entity IDs, replacing any previous one.
+	/// @throw std::runtime_error Throws if timers are being fired.
+	auto set_handler(TimerEventId event, ObserverCallback callback) -> void;
+
+	/// @brief Cancel a timer.
+	/// @param id The timer's ID.
+	/// @return Whether the timer was cancelled, which is false if it already fired or was cancelled.
+	auto cancel(TimerId id) -> bool;
+
+	/// @brief Cancel every event scheduled for an entity.
+	/// @param entity The entity's ID.
+	auto entity_destroyed(EntityId entity) -> void;
+
+	/// @brief Advance by one tick and fire every timer that is due.
+	///
+	/// Callbacks run first, in no particular order, and then each event type's batch is delivered.
+	/// An entity that a callback destroys can still be in a batch on the same tick.
+	/// Timers scheduled while firing are due on a later tick.
+	///
+	/// @param scene The scene to pass to callbacks.
+	/// @return The number of timers that fired.
+	/// @throw std::runtime_error Throws if timers are already being fired.
+	/// @throw Rethrows the first exception thrown by a callback, after every other timer has fired.
+	auto advance(Scene &scene) -> size_t;
+
+	/// @brief Get the number of timers that haven't fired or been cancelled.
+	/// @return The number of timers.
+	auto size() const -> size_t;
+
+	TimerManager(const TimerManager &) = delete;
+	TimerManager(TimerManager &&) = delete;
+	auto operator=(const TimerManager &) -> void = delete;
+
+   private:
+	static constexpr std::uint64_t SLOT_BITS = 8;
+	static constexpr std::uint64_t SLOTS = 1 << SLOT_BITS;
+	static constexpr std::uint64_t LEVELS = 4;
+	static constexpr std::uint32_t NONE = UINT32_MAX;
+	static constexpr TimerEventId NO_EVENT = SIZE_MAX;
+
+	// Timers are linked into their slot's list and, for entity timers, their entity's list, by index
+	struct Timer {
+		std::uint64_t expiry = 0;
+		EntityId entity = 0;
+		TimerEventId event = NO_EVENT;
+		std::uint32_t generation = 0;
+		std::uint32_t slot = NONE;
+		std::uint32_t next = NONE, prev = NONE;
+		std::uint32_t entity_next = NONE, entity_prev = NONE;
+	};
+
+	std::uint64_t now = 0;
+	std::vector<Timer> timers{};
+	std::uint32_t free_timers = NONE;
+	size_t n_live = 0;
+	std::array<std::uint32_t, SLOTS * LEVELS> slots{};
+	std::array<std::uint32_t, MAX_ENTITIES> entity_timers{};
+	std::vector<ObserverCallback> handlers{};
+	bool advancing = false;
+
+	std::vector<TimerCallback> firing{};
+	std::vector<std::vector<EntityId>> batches{};
+
+	// Callbacks can own entities, whose destruction cancels their timers, so they're destroyed before anything they touch
+	std::vector<TimerCallback> callbacks{};
+
+	auto create(Tick delay) -> std::uint32_t;
+	auto release(std::uint32_t index) -> void;
+	auto link(std::uint32_t index) -> void;
+	auto unlink(std::uint32_t index) -> void;
+	auto cascade(std::uint64_t level) -> void;
+};
+
+#include "timer.ipp"
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "timer.hpp"
+
+template <typename T>
+inline auto get_timer_event_id() -> TimerEventId {
+	static const auto id = next_timer_event_id();
+	return id;
+}
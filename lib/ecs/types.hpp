@@ -1,13 +1,17 @@
 #pragma once
 
 #include <bitset>
+#include <cstddef>
 #include <functional>
 
 #include "constants.hpp"
+#include "signature.hpp"
 
 /// @brief A unique identifier for an entity.
 using EntityId = unsigned long long;
 /// @brief A unique identifier for a component type.
-using ComponentId = unsigned char;
-/// @brief A bitset used to identify which components an entity has.
-using Signature = std::bitset<MAX_COMPONENTS>;
+using ComponentId = unsigned short;
+/// @brief A unique identifier for a resource type.
+using ResourceId = size_t;
+/// @brief A counter that advances once per scene update, used to detect changes.
+using Tick = unsigned int;
@@ -0,0 +1,14 @@
+#include "camera.hpp"
+
+auto Camera::get_bounds() const -> Bounds {
+	return Bounds{position, position + size};
+}
+
+auto Camera::to_screen(const GlobalTransform &transform) const -> SDL_Rect {
+	return SDL_Rect{
+		.x = static_cast<int>(transform.position.x - position.x),
+		.y = static_cast<int>(size.y - (transform.position.y - position.y) - transform.scale.y),
+		.w = static_cast<int>(transform.scale.x),
+		.h = static_cast<int>(transform.scale.y),
+	};
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "math/bounds.hpp"
+#include "math/vector2.hpp"
+#include "transform.hpp"
+
+/// @brief The part of the world that is visible in the window.
+struct Camera {
+	/// @brief The bottom-left corner of the view, in world space.
+	Vector2 position{0.0f, 0.0f};
+
+	/// @brief The size of the view, which is the size of the window in pixels.
+	Vector2 size{640.0f, 480.0f};
+
+	/// @brief Get the world-space box that the camera can see.
+	/// @return The visible box.
+	auto get_bounds() const -> Bounds;
+
+	/// @brief Convert an entity's transform to a window rect, flipping the y-axis.
+	/// @param transform The entity's transform.
+	/// @return The destination rect to render the entity to.
+	auto to_screen(const GlobalTransform &transform) const -> SDL_Rect;
+};
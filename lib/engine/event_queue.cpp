@@ -0,0 +1,117 @@
+#include "event_queue.hpp"
+
+#include <SDL.h>
+
+#include <array>
+
+#include "sdl/util.hpp"
+
+constexpr auto EVENT_BATCH_SIZE = 64;
+
+auto EventQueue::poll() -> void {
+	clear();
+
+	// Headless runs might never start SDL's event queue, and then there's nothing to poll
+	if (!SDL_WasInit(SDL_INIT_EVENTS)) return;
+	SDL_PumpEvents();
+
+	std::array<SDL_Event, EVENT_BATCH_SIZE> batch;
+	while (true) {
+		auto n_events = SDL_PeepEvents(batch.data(), EVENT_BATCH_SIZE, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+		check_error(n_events);
+
+		for (auto i = 0; i < n_events; i++)
+			push(batch[i]);
+
+		if (n_events < EVENT_BATCH_SIZE) break;
+	}
+}
+
+auto EventQueue::clear() -> void {
+	keyboard_events.clear();
+	mouse_motion_events.clear();
+	mouse_button_events.clear();
+	mouse_wheel_events.clear();
+	window_events.clear();
+	user_events.clear();
+	quit = false;
+
+	input.pressed_keys.reset();
+	input.released_keys.reset();
+}
+
+auto EventQueue::push(const SDL_Event &event) -> void {
+	switch (event.type) {
+		case SDL_QUIT:
+			quit = true;
+			break;
+		case SDL_KEYDOWN:
+		case SDL_KEYUP: {
+			keyboard_events.push_back(event.key);
+
+			auto scancode = event.key.keysym.scancode;
+			if (scancode < 0 || scancode >= SDL_NUM_SCANCODES || event.key.repeat) break;
+			auto pressed = event.type == SDL_KEYDOWN;
+			input.keys[scancode] = pressed;
+			(pressed ? input.pressed_keys : input.released_keys).set(scancode);
+			break;
+		}
+		case SDL_MOUSEMOTION:
+			mouse_motion_events.push_back(event.motion);
+			input.mouse_x = event.motion.x;
+			input.mouse_y = event.motion.y;
+			break;
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			mouse_button_events.push_back(event.button);
+			input.mouse_x = event.button.x;
+			input.mouse_y = event.button.y;
+			if (event.type == SDL_MOUSEBUTTONDOWN)
+				input.mouse_buttons |= SDL_BUTTON(event.button.button);
+			else
+				input.mouse_buttons &= ~SDL_BUTTON(event.button.button);
+			break;
+		case SDL_MOUSEWHEEL:
+			mouse_wheel_events.push_back(event.wheel);
+			break;
+		case SDL_WINDOWEVENT:
+			window_events.push_back(event.window);
+			break;
+		default:
+			if (event.type >= SDL_USEREVENT && event.type < SDL_LASTEVENT)
+				user_events.push_back(event.user);
+			break;
+	}
+}
+
+auto EventQueue::get_keyboard_events() const -> const std::vector<SDL_KeyboardEvent> & {
+	return keyboard_events;
+}
+
+auto EventQueue::get_mouse_motion_events() const -> const std::vector<SDL_MouseMotionEvent> & {
+	return mouse_motion_events;
+}
+
+auto EventQueue::get_mouse_button_events() const -> const std::vector<SDL_MouseButtonEvent> & {
+	return mouse_button_events;
+}
+
+auto EventQueue::get_mouse_wheel_events() const -> const std::vector<SDL_MouseWheelEvent> & {
+	return mouse_wheel_events;
+}
+
+auto EventQueue::get_window_events() const -> const std::vector<SDL_WindowEvent> & {
+	return window_events;
+}
+
+auto EventQueue::get_user_events() const -> const std::vector<SDL_UserEvent> & {
+	return user_events;
+}
+
+auto EventQueue::quit_requested() const -> bool {
+	return quit;
+}
+
+auto EventQueue::get_input() const -> const InputState & {
+	return input;
+}
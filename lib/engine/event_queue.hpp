@@ -0,0 +1,70 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <vector>
+
+#include "input_state.hpp"
+
+/// @brief The SDL events of a single frame, sorted into a buffer per event type.
+///
+/// `poll` drains SDL's queue in batches once per frame, so systems can read input without calling into SDL.
+/// Headless runs can `push` events themselves instead.
+class EventQueue {
+   public:
+	/// @brief Start a new frame and move every pending SDL event into the queue.
+	///
+	/// If SDL's event subsystem isn't initialized, this only starts a new frame.
+	auto poll() -> void;
+
+	/// @brief Start a new frame without reading from SDL.
+	///
+	/// Events from the previous frame are discarded, but keys and buttons that are held down stay held down.
+	auto clear() -> void;
+
+	/// @brief Add an event to the current frame.
+	/// @param event The event to add.
+	auto push(const SDL_Event &event) -> void;
+
+	/// @brief Get this frame's key presses and releases.
+	/// @return The keyboard events, in the order they happened.
+	auto get_keyboard_events() const -> const std::vector<SDL_KeyboardEvent> &;
+
+	/// @brief Get this frame's mouse movements.
+	/// @return The mouse motion events, in the order they happened.
+	auto get_mouse_motion_events() const -> const std::vector<SDL_MouseMotionEvent> &;
+
+	/// @brief Get this frame's mouse button presses and releases.
+	/// @return The mouse button events, in the order they happened.
+	auto get_mouse_button_events() const -> const std::vector<SDL_MouseButtonEvent> &;
+
+	/// @brief Get this frame's mouse wheel movements.
+	/// @return The mouse wheel events, in the order they happened.
+	auto get_mouse_wheel_events() const -> const std::vector<SDL_MouseWheelEvent> &;
+
+	/// @brief Get this frame's window events, like resizes and focus changes.
+	/// @return The window events, in the order they happened.
+	auto get_window_events() const -> const std::vector<SDL_WindowEvent> &;
+
+	/// @brief Get this frame's user events, including ones registered with `SDL_RegisterEvents`.
+	/// @return The user events, in the order they happened.
+	auto get_user_events() const -> const std::vector<SDL_UserEvent> &;
+
+	/// @brief Check whether the application was asked to quit this frame.
+	/// @return Whether a quit event was received.
+	auto quit_requested() const -> bool;
+
+	/// @brief Get the input state after this frame's events.
+	/// @return The input state.
+	auto get_input() const -> const InputState &;
+
+   private:
+	std::vector<SDL_KeyboardEvent> keyboard_events{};
+	std::vector<SDL_MouseMotionEvent> mouse_motion_events{};
+	std::vector<SDL_MouseButtonEvent> mouse_button_events{};
+	std::vector<SDL_MouseWheelEvent> mouse_wheel_events{};
+	std::vector<SDL_WindowEvent> window_events{};
+	std::vector<SDL_UserEvent> user_events{};
+	bool quit = false;
+	InputState input{};
+};
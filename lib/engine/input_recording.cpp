@@ -0,0 +1,129 @@
+#include "input_recording.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+#include "ecs/snapshot.hpp"
+
+constexpr std::byte INPUT_LOG_MAGIC[] = {std::byte{'C'}, std::byte{'E'}, std::byte{'G'}, std::byte{'E'}, std::byte{'I'}, std::byte{'N'}, std::byte{'P'}, std::byte{'T'}};
+constexpr size_t INPUT_LOG_VERSION = 1;
+constexpr size_t KEY_BYTES = (SDL_NUM_SCANCODES + 7) / 8;
+
+static auto write_u32(std::uint32_t value, std::span<std::byte> &out) -> void {
+	for (auto i = 0; i < 4; i++)
+		out[i] = static_cast<std::byte>(value >> (i * 8));
+	out = out.subspan(4);
+}
+
+static auto read_u32(std::span<const std::byte> &in) -> std::uint32_t {
+	std::uint32_t value = 0;
+	for (auto i = 0; i < 4; i++)
+		value |= std::to_integer<std::uint32_t>(in[i]) << (i * 8);
+	in = in.subspan(4);
+	return value;
+}
+
+static auto write_keys(const std::bitset<SDL_NUM_SCANCODES> &keys, std::span<std::byte> &out) -> void {
+	std::fill_n(out.begin(), KEY_BYTES, std::byte{0});
+	for (size_t i = 0; i < keys.size(); i++)
+		if (keys[i])
+			out[i / 8] |= static_cast<std::byte>(1 << (i % 8));
+	out = out.subspan(KEY_BYTES);
+}
+
+static auto read_keys(std::bitset<SDL_NUM_SCANCODES> &keys, std::span<const std::byte> &in) -> void {
+	for (size_t i = 0; i < keys.size(); i++)
+		keys[i] = std::to_integer<int>(in[i / 8] >> (i % 8)) & 1;
+	in = in.subspan(KEY_BYTES);
+}
+
+static auto get_input_frame_size() -> size_t {
+	return 4 + KEY_BYTES * 3 + 4 * 3;
+}
+
+static auto write_input_frame(const InputFrame &frame, std::span<std::byte> out) -> void {
+	write_u32(frame.delta_ms, out);
+	write_keys(frame.input.keys, out);
+	write_keys(frame.input.pressed_keys, out);
+	write_keys(frame.input.released_keys, out);
+	write_u32(static_cast<std::uint32_t>(frame.input.mouse_x), out);
+	write_u32(static_cast<std::uint32_t>(frame.input.mouse_y), out);
+	write_u32(frame.input.mouse_buttons, out);
+}
+
+static auto read_input_frame(std::span<const std::byte> in) -> InputFrame {
+	InputFrame frame{};
+	frame.delta_ms = read_u32(in);
+	read_keys(frame.input.keys, in);
+	read_keys(frame.input.pressed_keys, in);
+	read_keys(frame.input.released_keys, in);
+	frame.input.mouse_x = static_cast<std::int32_t>(read_u32(in));
+	frame.input.mouse_y = static_cast<std::int32_t>(read_u32(in));
+	frame.input.mouse_buttons = read_u32(in);
+	return frame;
+}
+
+InputRecorder::InputRecorder(const std::filesystem::path &path)
+	: file{path, std::ios::binary | std::ios::trunc},
+	  previous(get_input_frame_size()),
+	  current(get_input_frame_size()) {
+	if (!file)
+		throw std::runtime_error{fmt::format("Couldn't open {} for recording.", path.string())};
+
+	std::vector<std::byte> header{std::begin(INPUT_LOG_MAGIC), std::end(INPUT_LOG_MAGIC)};
+	write_varint(INPUT_LOG_VERSION, header);
+	write_varint(get_input_frame_size(), header);
+	file.write(reinterpret_cast<const char *>(header.data()), header.size());
+}
+
+auto InputRecorder::record(const InputFrame &frame) -> void {
+	write_input_frame(frame, current);
+
+	encoded.clear();
+	encode_xor_rle(current, previous, encoded);
+	file.write(reinterpret_cast<const char *>(encoded.data()), encoded.size());
+
+	std::swap(previous, current);
+	n_frames++;
+}
+
+auto InputRecorder::get_frame_count() const -> size_t {
+	return n_frames;
+}
+
+InputReplay::InputReplay(const std::filesystem::path &path) : frame(get_input_frame_size()) {
+	std::ifstream file{path, std::ios::binary};
+	if (!file)
+		throw std::runtime_error{fmt::format("Couldn't open {} for replaying.", path.string())};
+
+	auto size = std::filesystem::file_size(path);
+	data.resize(size);
+	file.read(reinterpret_cast<char *>(data.data()), size);
+	remaining = data;
+
+	if (remaining.size() < std::size(INPUT_LOG_MAGIC) || !std::equal(std::begin(INPUT_LOG_MAGIC), std::end(INPUT_LOG_MAGIC), remaining.begin()))
+		throw std::runtime_error{fmt::format("{} isn't an input log.", path.string())};
+	remaining = remaining.subspan(std::size(INPUT_LOG_MAGIC));
+
+	auto version = read_varint(remaining);
+	auto frame_size = read_varint(remaining);
+	if (version != INPUT_LOG_VERSION || frame_size != get_input_frame_size())
+		throw std::runtime_error{fmt::format("{} was recorded by an incompatible version (version {}, {}-byte frames).", path.string(), version, frame_size)};
+}
+
+auto InputReplay::next() -> std::optional<InputFrame> {
+	if (remaining.empty()) return std::nullopt;
+
+	decode_xor_rle(remaining, frame);
+	n_frames++;
+	return read_input_frame(frame);
+}
+
+auto InputReplay::get_frame_count() const -> size_t {
+	return n_frames;
+}
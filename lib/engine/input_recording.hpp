@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "input_state.hpp"
+
+/// @brief Everything that a frame of simulation depends on besides the scene itself.
+struct InputFrame {
+	/// @brief The input state of the frame.
+	InputState input{};
+
+	/// @brief The time since the previous frame, in milliseconds.
+	Uint32 delta_ms = 0;
+
+	auto operator==(const InputFrame &other) const -> bool = default;
+};
+
+/// @brief Writes a frame-by-frame log of input and timesteps, so a session can be replayed deterministically.
+///
+/// Each frame is XORed against the previous one and run-length encoded, so frames where nothing changed take a few bytes.
+class InputRecorder {
+   public:
+	/// @brief Start a new recording.
+	/// @param path Path to the log file, which is overwritten.
+	/// @throw std::runtime_error Throws if the file can't be opened.
+	explicit InputRecorder(const std::filesystem::path &path);
+
+	/// @brief Append a frame to the log.
+	/// @param frame The frame to append.
+	auto record(const InputFrame &frame) -> void;
+
+	/// @brief Get the number of frames recorded so far.
+	/// @return The number of frames.
+	auto get_frame_count() const -> size_t;
+
+   private:
+	std::ofstream file;
+	std::vector<std::byte> previous;
+	std::vector<std::byte> current;
+	std::vector<std::byte> encoded{};
+	size_t n_frames = 0;
+};
+
+/// @brief Reads back a log written by `InputRecorder`.
+class InputReplay {
+   public:
+	/// @brief Load a recording.
+	/// @param path Path to the log file.
+	/// @throw std::runtime_error Throws if the file can't be read or isn't an input log.
+	explicit InputReplay(const std::filesystem::path &path);
+
+	/// @brief Read the next frame.
+	/// @return The next frame, or nothing if the recording is over.
+	/// @throw std::runtime_error Throws if the log is malformed.
+	auto next() -> std::optional<InputFrame>;
+
+	/// @brief Get the number of frames read so far.
+	/// @return The number of frames.
+	auto get_frame_count() const -> size_t;
+
+   private:
+	std::vector<std::byte> data{};
+	std::span<const std::byte> remaining{};
+	std::vector<std::byte> frame;
+	size_t n_frames = 0;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <bitset>
+
+/// @brief The state of the keyboard and mouse at the end of a frame, built from that frame's events.
+///
+/// Systems should read input from here instead of calling `SDL_GetKeyboardState`,
+/// so that input can be injected or replayed without a window.
+struct InputState {
+	/// @brief Which keys are held down, indexed by scancode.
+	std::bitset<SDL_NUM_SCANCODES> keys{};
+
+	/// @brief Which keys went down this frame, indexed by scancode.
+	std::bitset<SDL_NUM_SCANCODES> pressed_keys{};
+
+	/// @brief Which keys went up this frame, indexed by scancode.
+	std::bitset<SDL_NUM_SCANCODES> released_keys{};
+
+	/// @brief The x-position of the mouse in window pixels, from the left.
+	int mouse_x = 0;
+
+	/// @brief The y-position of the mouse in window pixels, from the top.
+	int mouse_y = 0;
+
+	/// @brief Which mouse buttons are held down, as an `SDL_BUTTON` mask.
+	Uint32 mouse_buttons = 0;
+
+	auto operator==(const InputState &other) const -> bool = default;
+
+	/// @brief Check whether a key is held down.
+	/// @param scancode The key to check.
+	/// @return Whether the key is held down.
+	auto is_down(SDL_Scancode scancode) const -> bool {
+		return keys[scancode];
+	}
+
+	/// @brief Check whether a key went down this frame.
+	/// @param scancode The key to check.
+	/// @return Whether the key went down this frame.
+	auto was_pressed(SDL_Scancode scancode) const -> bool {
+		return pressed_keys[scancode];
+	}
+
+	/// @brief Check whether a key went up this frame.
+	/// @param scancode The key to check.
+	/// @return Whether the key went up this frame.
+	auto was_released(SDL_Scancode scancode) const -> bool {
+		return released_keys[scancode];
+	}
+};
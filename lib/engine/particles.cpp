@@ -0,0 +1,181 @@
+#include "particles.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "camera.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "sdl/render_list.hpp"
+#include "transform.hpp"
+
+auto ParticleBuffer::set_capacity(size_t capacity) -> void {
+	count = std::min(count, capacity);
+	for (auto field : {&x, &y, &velocity_x, &velocity_y, &remaining, &inverse_lifetime})
+		field->resize(capacity);
+}
+
+auto ParticleBuffer::capacity() const -> size_t {
+	return x.size();
+}
+
+auto ParticleBuffer::size() const -> size_t {
+	return count;
+}
+
+auto ParticleBuffer::spawn(Vector2 position, Vector2 velocity, float lifetime) -> bool {
+	if (count == capacity() || !(lifetime > 0.0f)) return false;
+
+	x[count] = position.x;
+	y[count] = position.y;
+	velocity_x[count] = velocity.x;
+	velocity_y[count] = velocity.y;
+	remaining[count] = lifetime;
+	inverse_lifetime[count] = 1.0f / lifetime;
+	count++;
+	return true;
+}
+
+auto ParticleBuffer::kill(size_t index) -> void {
+	count--;
+	x[index] = x[count];
+	y[index] = y[count];
+	velocity_x[index] = velocity_x[count];
+	velocity_y[index] = velocity_y[count];
+	remaining[index] = remaining[count];
+	inverse_lifetime[index] = inverse_lifetime[count];
+}
+
+auto ParticleBuffer::clear() -> void {
+	count = 0;
+}
+
+auto ParticleBuffer::update(float seconds, Vector2 acceleration) -> void {
+	// Separate loops over raw pointers keep each one simple enough to vectorize
+	auto *px = x.data();
+	auto *py = y.data();
+	auto *pvx = velocity_x.data();
+	auto *pvy = velocity_y.data();
+	auto *premaining = remaining.data();
+
+	auto dvx = acceleration.x * seconds;
+	auto dvy = acceleration.y * seconds;
+	for (size_t index = 0; index < count; index++) {
+		pvx[index] += dvx;
+		pvy[index] += dvy;
+	}
+	for (size_t index = 0; index < count; index++) {
+		px[index] += pvx[index] * seconds;
+		py[index] += pvy[index] * seconds;
+	}
+	for (size_t index = 0; index < count; index++)
+		premaining[index] -= seconds;
+
+	// Killing moves the last particle into the current index, so the index is only advanced past live particles
+	for (size_t index = 0; index < count;) {
+		if (premaining[index] <= 0.0f)
+			kill(index);
+		else
+			index++;
+	}
+}
+
+auto ParticleBuffer::get_x() const -> std::span<const float> {
+	return {x.data(), count};
+}
+
+auto ParticleBuffer::get_y() const -> std::span<const float> {
+	return {y.data(), count};
+}
+
+auto ParticleBuffer::get_velocity_x() const -> std::span<const float> {
+	return {velocity_x.data(), count};
+}
+
+auto ParticleBuffer::get_velocity_y() const -> std::span<const float> {
+	return {velocity_y.data(), count};
+}
+
+auto ParticleBuffer::get_life(size_t index) const -> float {
+	return remaining[index] * inverse_lifetime[index];
+}
+
+/// @internal
+/// @brief Get a random number from -1 to 1 and advance a xorshift generator.
+/// @param state The generator's state.
+/// @return The random number.
+static auto next_random(std::uint32_t &state) -> float {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return static_cast<float>(state >> 8) / static_cast<float>(1 << 23) - 1.0f;
+}
+
+auto ParticleSystem::update(Scene &scene, float seconds) -> void {
+	for (auto &entity : entities) {
+		auto &emitter = entity->get_component_raw<ParticleEmitter>();
+		auto &settings = emitter.settings;
+		auto &particles = emitter.particles;
+
+		if (particles.capacity() != settings.capacity)
+			particles.set_capacity(settings.capacity);
+		particles.update(seconds, settings.acceleration);
+
+		if (!emitter.emitting) {
+			emitter.spawn_debt = 0.0f;
+			continue;
+		}
+
+		emitter.spawn_debt += settings.rate * seconds;
+		auto n_spawned = std::floor(emitter.spawn_debt);
+		emitter.spawn_debt -= n_spawned;
+
+		if (emitter.seed == 0)
+			emitter.seed = 1;
+		auto origin = entity->read_component<GlobalTransform>().position + emitter.offset;
+		for (auto i = 0; i < static_cast<int>(n_spawned); i++) {
+			Vector2 velocity{
+				settings.velocity.x + settings.velocity_spread.x * next_random(emitter.seed),
+				settings.velocity.y + settings.velocity_spread.y * next_random(emitter.seed),
+			};
+			if (!particles.spawn(origin, velocity, settings.lifetime)) break;
+		}
+	}
+}
+
+auto ParticleSystem::render(RenderList &list, Scene &scene) -> void {
+	auto &camera = scene.resource<Camera>();
+
+	for (auto &entity : entities) {
+		auto &emitter = entity->read_component<ParticleEmitter>();
+		auto &settings = emitter.settings;
+		auto &particles = emitter.particles;
+		auto n_particles = particles.size();
+		if (n_particles == 0) continue;
+
+		vertices.resize(n_particles * 4);
+		auto xs = particles.get_x();
+		auto ys = particles.get_y();
+		auto half = settings.size * 0.5f;
+		for (size_t index = 0; index < n_particles; index++) {
+			// The camera flips the y-axis, so the top of the screen is the top of the world
+			auto left = xs[index] - camera.position.x - half;
+			auto top = camera.size.y - (ys[index] - camera.position.y) - half;
+			auto right = left + settings.size;
+			auto bottom = top + settings.size;
+
+			auto color = settings.color;
+			if (settings.fade)
+				color.a = static_cast<Uint8>(static_cast<float>(color.a) * particles.get_life(index));
+
+			auto *quad = &vertices[index * 4];
+			quad[0] = {{left, top}, color, {0.0f, 0.0f}};
+			quad[1] = {{right, top}, color, {1.0f, 0.0f}};
+			quad[2] = {{right, bottom}, color, {1.0f, 1.0f}};
+			quad[3] = {{left, bottom}, color, {0.0f, 1.0f}};
+		}
+
+		auto texture = *emitter.texture ? &emitter.texture : nullptr;
+		list.render_geometry(texture, vertices, get_quad_indices(indices, n_particles));
+	}
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ecs/system.hpp"
+#include "math/vector2.hpp"
+#include "sdl/texture.hpp"
+
+class RenderList;
+class Scene;
+
+/// @brief A pool of particles, with each field stored in its own array.
+///
+/// Live particles are packed at the front of the arrays, and dead ones are swapped with the last live particle,
+/// so updating the pool is a few straight loops over floats that the compiler can vectorize.
+/// The arrays are allocated once, so spawning and killing particles never allocates.
+class ParticleBuffer {
+   public:
+	/// @brief Resize the pool, killing the newest particles if there are too many for the new size.
+	/// @param capacity The maximum number of live particles.
+	auto set_capacity(size_t capacity) -> void;
+
+	/// @brief Get the maximum number of live particles.
+	/// @return The capacity.
+	auto capacity() const -> size_t;
+
+	/// @brief Get the number of live particles.
+	/// @return The number of live particles.
+	auto size() const -> size_t;
+
+	/// @brief Spawn a particle.
+	/// @param position The particle's position, in world space.
+	/// @param velocity The particle's velocity, in world units per second.
+	/// @param lifetime How long the particle lives, in seconds.
+	/// @return Whether the particle was spawned, which fails if the pool is full.
+	auto spawn(Vector2 position, Vector2 velocity, float lifetime) -> bool;
+
+	/// @brief Kill a particle by moving the last live particle into its place.
+	/// @param index The particle's index, which will hold a different particle afterwards.
+	auto kill(size_t index) -> void;
+
+	/// @brief Kill every particle.
+	auto clear() -> void;
+
+	/// @brief Move every particle and kill the ones whose lifetime ran out.
+	/// @param seconds The time to advance by.
+	/// @param acceleration The acceleration applied to every particle, in world units per second squared.
+	auto update(float seconds, Vector2 acceleration) -> void;
+
+	/// @brief Get the x-coordinate of every live particle.
+	/// @return The x-coordinates, indexed by particle.
+	auto get_x() const -> std::span<const float>;
+
+	/// @brief Get the y-coordinate of every live particle.
+	/// @return The y-coordinates, indexed by particle.
+	auto get_y() const -> std::span<const float>;
+
+	/// @brief Get the x-velocity of every live particle.
+	/// @return The x-velocitys, indexed by particle.
+	auto get_velocity_x() const -> std::span<const float>;
+
+	/// @brief Get the y-velocity of every live particle.
+	/// @return The y-velocitys, indexed by particle.
+	auto get_velocity_y() const -> std::span<const float>;
+
+	/// @brief Get the fraction of its lifetime that a particle has left.
+	/// @param index The particle's index.
+	/// @return The fraction, from 1 when it spawned to 0.
+	auto get_life(size_t index) const -> float;
+
+   private:
+	std::vector<float> x{}, y{};
+	std::vector<float> velocity_x{}, velocity_y{};
+	std::vector<float> remaining{};
+	std::vector<float> inverse_lifetime{};
+	size_t count = 0;
+};
+
+/// @brief How a `ParticleEmitter` spawns and draws particles.
+struct ParticleSettings {
+	/// @brief How many particles are spawned per second.
+	float rate = 100.0f;
+
+	/// @brief How long each particle lives, in seconds.
+	float lifetime = 1.0f;
+
+	/// @brief The velocity of each particle when it spawns.
+	Vector2 velocity{0.0f, 100.0f};
+
+	/// @brief The largest random amount added to or removed from each axis of `velocity`.
+	Vector2 velocity_spread{50.0f, 50.0f};
+
+	/// @brief The acceleration applied to every particle, in world units per second squared.
+	Vector2 acceleration{0.0f, 0.0f};
+
+	/// @brief The width and height of each particle.
+	float size = 4.0f;
+
+	/// @brief The color that each particle is drawn with, which tints `ParticleEmitter::texture`.
+	SDL_Color color{0xff, 0xff, 0xff, 0xff};
+
+	/// @brief Whether particles fade out over their lifetime.
+	bool fade = true;
+
+	/// @brief The maximum number of live particles.
+	size_t capacity = 1024;
+};
+
+/// @brief Spawns particles from an entity's `GlobalTransform`.
+///
+/// Particles aren't entities. Each emitter owns a `ParticleBuffer`, and particles keep moving in world space
+/// after they spawn, even if the emitter moves or stops emitting.
+struct ParticleEmitter {
+	ParticleSettings settings{};
+
+	/// @brief Where particles spawn, relative to the bottom-left corner of the entity.
+	Vector2 offset{0.0f, 0.0f};
+
+	/// @brief Whether new particles are spawned.
+	bool emitting = true;
+
+	/// @brief The texture that each particle is drawn with, or an empty texture to draw solid squares.
+	Texture texture{};
+
+	/// @brief The emitter's particles.
+	ParticleBuffer particles{};
+
+	/// @brief The state of the emitter's random number generator, which shouldn't be 0.
+	std::uint32_t seed = 1;
+
+	/// @internal
+	/// @brief The fraction of a particle that is due to spawn.
+	float spawn_debt = 0.0f;
+};
+
+/// @brief A system that spawns, moves, and draws the particles of every `ParticleEmitter`.
+///
+/// Each emitter's particles are drawn with a single `SDL_RenderGeometry` call.
+///
+/// Create it with `scene.create_system<ParticleSystem, GlobalTransform, ParticleEmitter>()`.
+class ParticleSystem : public System {
+   public:
+	/// @brief Move every particle, kill the ones whose lifetime ran out, and spawn new ones.
+	/// @param scene The scene that this system belongs to.
+	/// @param seconds The time to advance by.
+	auto update(Scene &scene, float seconds) -> void;
+
+	/// @brief Record every emitter's particles.
+	/// @param list The list to record to.
+	/// @param scene The scene that this system belongs to, which needs a `Camera` resource.
+	auto render(RenderList &list, Scene &scene) -> void;
+
+   private:
+	std::vector<SDL_Vertex> vertices{};
+	std::vector<int> indices{};
+};
@@ -0,0 +1,509 @@
+#include "physics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/filters.hpp"
+#include "ecs/scene.hpp"
+#include "transform.hpp"
+
+auto PhysicsSystem::get_settings() const -> const PhysicsSettings & {
+	return settings;
+}
+
+auto PhysicsSystem::set_settings(const PhysicsSettings &settings) -> void {
+	this->settings = settings;
+	resting_dirty = true;
+}
+
+auto PhysicsSystem::step(Scene &scene) -> void {
+	// Changes stamped with the previous step's tick may have happened after it ran, so that tick is checked again.
+	// Components are compared against the cached copies, so the system's own writes don't wake anything.
+	auto since = last_tick > 0 ? last_tick - 1 : 0;
+	last_tick = scene.get_tick();
+
+	if (needs_rebuild(scene, since))
+		rebuild(scene);
+	else
+		pull_changes(scene, since);
+
+	auto dt = settings.timestep;
+	for (std::uint32_t slot = 0; slot < ids.size(); slot++)
+		if (awake[slot])
+			velocities[slot] += settings.gravity * dt;
+
+	// Finding contacts can wake sleeping bodies, so integration happens after it
+	find_contacts();
+	solve();
+
+	for (std::uint32_t slot = 0; slot < ids.size(); slot++)
+		if (awake[slot])
+			positions[slot] += velocities[slot] * dt;
+
+	correct_positions();
+	update_sleep();
+	push_changes();
+}
+
+auto PhysicsSystem::wake(EntityId id) -> void {
+	if (id < slot_of.size() && slot_of[id] != NO_INDEX)
+		wake_slot(slot_of[id]);
+}
+
+auto PhysicsSystem::is_sleeping(EntityId id) const -> bool {
+	if (id >= slot_of.size() || slot_of[id] == NO_INDEX) return false;
+	auto slot = slot_of[id];
+	return is_dynamic(slot) && !awake[slot];
+}
+
+auto PhysicsSystem::get_stats() const -> const PhysicsStats & {
+	return stats;
+}
+
+auto PhysicsSystem::needs_rebuild(Scene &scene, Tick since) -> bool {
+	if (slot_of.empty() || ids.size() != entities.size()) return true;
+
+	auto members = scene.create_signature<Transform, RigidBody, Velocity>();
+	auto is_new_member = [&](const Entity &entity) {
+		return slot_of[entity.get_id()] == NO_INDEX && entity.get_signature().contains(members);
+	};
+
+	for (auto &entity : scene.query<Added<Transform>>(since))
+		if (is_new_member(*entity)) return true;
+	for (auto &entity : scene.query<Added<RigidBody>>(since))
+		if (is_new_member(*entity)) return true;
+	for (auto &entity : scene.query<Added<Velocity>>(since))
+		if (is_new_member(*entity)) return true;
+
+	for (auto id : scene.query<Removed<Transform>>(since))
+		if (slot_of[id] != NO_INDEX) return true;
+	for (auto id : scene.query<Removed<RigidBody>>(since))
+		if (slot_of[id] != NO_INDEX) return true;
+	for (auto id : scene.query<Removed<Velocity>>(since))
+		if (slot_of[id] != NO_INDEX) return true;
+
+	return false;
+}
+
+auto PhysicsSystem::rebuild(Scene &scene) -> void {
+	std::vector<Entity *> members{};
+	members.reserve(entities.size());
+	for (auto &entity : entities)
+		members.push_back(entity.get());
+	std::ranges::sort(members, {}, &Entity::get_id);
+
+	auto old_ids = std::move(ids);
+	auto old_awake = std::move(awake);
+	auto old_rest_times = std::move(rest_times);
+	auto old_sleeping_island = std::move(sleeping_island);
+	auto old_slot_of = std::move(slot_of);
+	old_slot_of.resize(MAX_ENTITIES, NO_INDEX);
+
+	auto n = members.size();
+	bodies = members;
+	ids.resize(n);
+	positions.resize(n);
+	sizes.resize(n);
+	velocities.resize(n);
+	materials.resize(n);
+	inverse_masses.resize(n);
+	rest_times.assign(n, 0.0f);
+	awake.assign(n, 1);
+	sleeping_island.assign(n, NO_INDEX);
+	slot_of.assign(MAX_ENTITIES, NO_INDEX);
+
+	for (std::uint32_t slot = 0; slot < n; slot++) {
+		auto &entity = *members[slot];
+		auto id = entity.get_id();
+		auto &transform = entity.read_component<Transform>();
+
+		ids[slot] = id;
+		slot_of[id] = slot;
+		positions[slot] = transform.position;
+		sizes[slot] = transform.scale;
+		velocities[slot] = entity.read_component<Velocity>().linear;
+		materials[slot] = entity.read_component<RigidBody>();
+		inverse_masses[slot] = materials[slot].mass > 0.0f ? 1.0f / materials[slot].mass : 0.0f;
+
+		auto old_slot = old_slot_of[id];
+		if (old_slot != NO_INDEX) {
+			awake[slot] = old_awake[old_slot];
+			rest_times[slot] = old_rest_times[old_slot];
+			sleeping_island[slot] = old_sleeping_island[old_slot];
+		}
+		if (!is_dynamic(slot))
+			awake[slot] = 0;
+	}
+
+	// Sleeping islands keep their indices, but their members move to new slots.
+	// An island that lost a member might have been resting on it, so it's woken.
+	for (std::uint32_t island = 0; island < sleeping_islands.size(); island++) {
+		auto &island_slots = sleeping_islands[island];
+		if (island_slots.empty()) continue;
+
+		auto complete = true;
+		for (auto &slot : island_slots) {
+			auto new_slot = slot_of[old_ids[slot]];
+			if (new_slot == NO_INDEX || !is_dynamic(new_slot) || sleeping_island[new_slot] != island) {
+				complete = false;
+				slot = NO_INDEX;
+			} else {
+				slot = new_slot;
+			}
+		}
+
+		if (!complete) {
+			for (auto slot : island_slots) {
+				if (slot == NO_INDEX) continue;
+				awake[slot] = 1;
+				rest_times[slot] = 0.0f;
+				sleeping_island[slot] = NO_INDEX;
+			}
+			island_slots.clear();
+			free_islands.push_back(island);
+		}
+	}
+
+	resting_dirty = true;
+}
+
+auto PhysicsSystem::pull_changes(Scene &scene, Tick since) -> void {
+	auto moved_static = false;
+
+	for (auto &entity : scene.query<Changed<Transform>>(since)) {
+		auto slot = slot_of[entity->get_id()];
+		if (slot == NO_INDEX) continue;
+
+		auto &transform = entity->read_component<Transform>();
+		if (transform.position == positions[slot] && transform.scale == sizes[slot]) continue;
+
+		positions[slot] = transform.position;
+		sizes[slot] = transform.scale;
+		if (is_dynamic(slot))
+			wake_slot(slot);
+		else
+			moved_static = true;
+	}
+
+	for (auto &entity : scene.query<Changed<Velocity>>(since)) {
+		auto slot = slot_of[entity->get_id()];
+		if (slot == NO_INDEX) continue;
+
+		auto &velocity = entity->read_component<Velocity>().linear;
+		if (velocity == velocities[slot]) continue;
+
+		velocities[slot] = velocity;
+		wake_slot(slot);
+	}
+
+	for (auto &entity : scene.query<Changed<RigidBody>>(since)) {
+		auto slot = slot_of[entity->get_id()];
+		if (slot == NO_INDEX) continue;
+
+		auto &material = entity->read_component<RigidBody>();
+		if (material == materials[slot]) continue;
+
+		wake_slot(slot);
+		auto was_dynamic = is_dynamic(slot);
+		materials[slot] = material;
+		inverse_masses[slot] = material.mass > 0.0f ? 1.0f / material.mass : 0.0f;
+
+		if (is_dynamic(slot) != was_dynamic) {
+			awake[slot] = is_dynamic(slot);
+			moved_static = true;
+		}
+	}
+
+	// Anything might have been resting on a static body that moved, so everything wakes up
+	if (moved_static) {
+		for (std::uint32_t slot = 0; slot < ids.size(); slot++)
+			wake_slot(slot);
+		resting_dirty = true;
+	}
+}
+
+auto PhysicsSystem::find_contacts() -> void {
+	contacts.clear();
+
+	if (resting_dirty) {
+		resting_entries.clear();
+		for (std::uint32_t slot = 0; slot < ids.size(); slot++)
+			if (!awake[slot])
+				insert_entries(slot, resting_entries);
+		std::sort(resting_entries.begin(), resting_entries.end());
+		resting_dirty = false;
+	}
+
+	awake_entries.clear();
+	for (std::uint32_t slot = 0; slot < ids.size(); slot++)
+		if (awake[slot])
+			insert_entries(slot, awake_entries);
+	std::sort(awake_entries.begin(), awake_entries.end());
+
+	// Pairs of awake bodies that share a cell
+	for (size_t begin = 0; begin < awake_entries.size();) {
+		auto end = begin + 1;
+		while (end < awake_entries.size() && awake_entries[end].key == awake_entries[begin].key)
+			end++;
+
+		for (auto i = begin; i < end; i++)
+			for (auto j = i + 1; j < end; j++)
+				add_contact(awake_entries[i].body, awake_entries[j].body, awake_entries[begin].key);
+
+		begin = end;
+	}
+
+	// Awake bodies against static and sleeping bodies in the same cell
+	for (auto &entry : awake_entries) {
+		auto first = std::lower_bound(resting_entries.begin(), resting_entries.end(), CellEntry{entry.key, 0});
+		for (auto it = first; it != resting_entries.end() && it->key == entry.key; it++)
+			add_contact(entry.body, it->body, entry.key);
+	}
+
+	// Sleeping bodies that were hit wake up with the rest of their island before anything is solved
+	for (auto &contact : contacts)
+		if (is_dynamic(contact.b) && !awake[contact.b])
+			wake_slot(contact.b);
+}
+
+auto PhysicsSystem::add_contact(std::uint32_t a, std::uint32_t b, std::uint64_t key) -> void {
+	auto bounds_a = get_bounds(a);
+	auto bounds_b = get_bounds(b);
+	if (!bounds_a.intersects(bounds_b)) return;
+
+	// Bodies can share several cells, so each pair is only reported by the cell containing the corner of their overlap
+	auto corner_x = std::max(bounds_a.min.x, bounds_b.min.x);
+	auto corner_y = std::max(bounds_a.min.y, bounds_b.min.y);
+	if (get_key(get_cell(corner_x), get_cell(corner_y)) != key) return;
+
+	auto overlap_x = std::min(bounds_a.max.x, bounds_b.max.x) - corner_x;
+	auto overlap_y = std::min(bounds_a.max.y, bounds_b.max.y) - corner_y;
+	auto center_a = bounds_a.get_center();
+	auto center_b = bounds_b.get_center();
+
+	Contact contact{.a = a, .b = b};
+	if (overlap_x < overlap_y) {
+		contact.normal = {center_b.x >= center_a.x ? 1.0f : -1.0f, 0.0f};
+		contact.penetration = overlap_x;
+	} else {
+		contact.normal = {0.0f, center_b.y >= center_a.y ? 1.0f : -1.0f};
+		contact.penetration = overlap_y;
+	}
+
+	// Restitution is computed from the approaching speed before solving, so it doesn't change between iterations
+	auto approaching = (velocities[b] - velocities[a]).dot(contact.normal);
+	auto restitution = std::max(materials[a].restitution, materials[b].restitution);
+	contact.bounce = approaching < 0.0f ? -restitution * approaching : 0.0f;
+	contact.friction = std::sqrt(materials[a].friction * materials[b].friction);
+
+	// Starting from last step's impulses lets stacks converge in a few iterations instead of sinking into each other
+	CachedImpulse cached{.pair = get_pair(a, b)};
+	auto it = std::lower_bound(cached_impulses.begin(), cached_impulses.end(), cached);
+	if (it != cached_impulses.end() && it->pair == cached.pair && it->normal == contact.normal) {
+		contact.normal_impulse = it->normal_impulse;
+		contact.tangent_impulse = it->tangent_impulse;
+	}
+
+	contacts.push_back(contact);
+}
+
+auto PhysicsSystem::solve() -> void {
+	for (auto &contact : contacts) {
+		Vector2 tangent{-contact.normal.y, contact.normal.x};
+		auto impulse = contact.normal * contact.normal_impulse + tangent * contact.tangent_impulse;
+		velocities[contact.a] -= impulse * inverse_masses[contact.a];
+		velocities[contact.b] += impulse * inverse_masses[contact.b];
+	}
+
+	for (auto iteration = 0; iteration < settings.iterations; iteration++) {
+		for (auto &contact : contacts) {
+			auto inverse_a = inverse_masses[contact.a];
+			auto inverse_b = inverse_masses[contact.b];
+			auto inverse_sum = inverse_a + inverse_b;
+			if (inverse_sum == 0.0f) continue;
+
+			// Accumulated impulses are clamped rather than each iteration's, so later iterations can undo earlier ones
+			auto relative = velocities[contact.b] - velocities[contact.a];
+			auto normal_speed = relative.dot(contact.normal);
+			auto normal_impulse = std::max(contact.normal_impulse + (contact.bounce - normal_speed) / inverse_sum, 0.0f);
+			auto normal_delta = contact.normal * (normal_impulse - contact.normal_impulse);
+			contact.normal_impulse = normal_impulse;
+			velocities[contact.a] -= normal_delta * inverse_a;
+			velocities[contact.b] += normal_delta * inverse_b;
+
+			Vector2 tangent{-contact.normal.y, contact.normal.x};
+			relative = velocities[contact.b] - velocities[contact.a];
+			auto max_friction = contact.friction * contact.normal_impulse;
+			auto tangent_impulse = std::clamp(contact.tangent_impulse - relative.dot(tangent) / inverse_sum, -max_friction, max_friction);
+			auto tangent_delta = tangent * (tangent_impulse - contact.tangent_impulse);
+			contact.tangent_impulse = tangent_impulse;
+			velocities[contact.a] -= tangent_delta * inverse_a;
+			velocities[contact.b] += tangent_delta * inverse_b;
+		}
+	}
+}
+
+auto PhysicsSystem::correct_positions() -> void {
+	cached_impulses.clear();
+	for (auto &contact : contacts)
+		cached_impulses.push_back({get_pair(contact.a, contact.b), contact.normal, contact.normal_impulse, contact.tangent_impulse});
+	std::sort(cached_impulses.begin(), cached_impulses.end());
+
+	// The overlap is measured again on every pass, so corrections spread through stacks like impulses do
+	for (auto iteration = 0; iteration < settings.iterations; iteration++) {
+		for (auto &contact : contacts) {
+			auto inverse_a = inverse_masses[contact.a];
+			auto inverse_b = inverse_masses[contact.b];
+			auto bounds_a = get_bounds(contact.a);
+			auto bounds_b = get_bounds(contact.b);
+
+			auto depth = contact.normal.x != 0.0f
+				? std::min(bounds_a.max.x, bounds_b.max.x) - std::max(bounds_a.min.x, bounds_b.min.x)
+				: std::min(bounds_a.max.y, bounds_b.max.y) - std::max(bounds_a.min.y, bounds_b.min.y);
+			depth -= settings.slop;
+			if (depth <= 0.0f) continue;
+
+			auto push = contact.normal * (depth * settings.correction / (inverse_a + inverse_b));
+			positions[contact.a] -= push * inverse_a;
+			positions[contact.b] += push * inverse_b;
+		}
+	}
+}
+
+auto PhysicsSystem::update_sleep() -> void {
+	stats = PhysicsStats{.bodies = ids.size(), .contacts = contacts.size()};
+
+	island_parents.resize(ids.size());
+	island_rest_times.resize(ids.size());
+	for (std::uint32_t slot = 0; slot < ids.size(); slot++) {
+		if (!awake[slot]) continue;
+
+		island_parents[slot] = slot;
+		auto speed_squared = velocities[slot].dot(velocities[slot]);
+		rest_times[slot] = speed_squared < settings.sleep_speed * settings.sleep_speed ? rest_times[slot] + settings.timestep : 0.0f;
+		stats.awake_bodies++;
+	}
+
+	// Static bodies don't join islands, or everything on the ground would be one island
+	for (auto &contact : contacts) {
+		if (!awake[contact.a] || !awake[contact.b]) continue;
+
+		auto root_a = find_root(contact.a);
+		auto root_b = find_root(contact.b);
+		if (root_a != root_b)
+			island_parents[std::max(root_a, root_b)] = std::min(root_a, root_b);
+	}
+
+	// An island can only sleep once its most recently moving body has rested long enough
+	for (std::uint32_t slot = 0; slot < ids.size(); slot++)
+		if (awake[slot] && find_root(slot) == slot)
+			island_rest_times[slot] = rest_times[slot];
+	for (std::uint32_t slot = 0; slot < ids.size(); slot++) {
+		if (!awake[slot]) continue;
+
+		auto root = find_root(slot);
+		island_rest_times[root] = std::min(island_rest_times[root], rest_times[slot]);
+		if (root == slot)
+			stats.islands++;
+	}
+
+	for (std::uint32_t slot = 0; slot < ids.size(); slot++) {
+		if (!awake[slot] || find_root(slot) != slot || island_rest_times[slot] < settings.sleep_time) continue;
+
+		std::uint32_t island;
+		if (free_islands.empty()) {
+			island = static_cast<std::uint32_t>(sleeping_islands.size());
+			sleeping_islands.emplace_back();
+		} else {
+			island = free_islands.back();
+			free_islands.pop_back();
+		}
+
+		// Members are marked with the root's slot for now, since the root is still awake while they are gathered
+		sleeping_island[slot] = island;
+	}
+
+	for (std::uint32_t slot = 0; slot < ids.size(); slot++) {
+		if (!awake[slot]) continue;
+
+		auto island = sleeping_island[find_root(slot)];
+		if (island == NO_INDEX) continue;
+
+		sleeping_islands[island].push_back(slot);
+		sleeping_island[slot] = island;
+		velocities[slot] = {0.0f, 0.0f};
+		falling_asleep.push_back(slot);
+		resting_dirty = true;
+	}
+}
+
+auto PhysicsSystem::push_changes() -> void {
+	// Bodies that fell asleep this step still need their final position and zeroed velocity written
+	for (std::uint32_t slot = 0; slot < ids.size(); slot++) {
+		if (!awake[slot]) continue;
+
+		bodies[slot]->get_component_raw<Transform>().position = positions[slot];
+		bodies[slot]->get_component_raw<Velocity>().linear = velocities[slot];
+	}
+
+	for (auto slot : falling_asleep)
+		awake[slot] = 0;
+	falling_asleep.clear();
+}
+
+auto PhysicsSystem::wake_slot(std::uint32_t slot) -> void {
+	if (!is_dynamic(slot) || awake[slot]) return;
+
+	auto island = sleeping_island[slot];
+	if (island == NO_INDEX) {
+		awake[slot] = 1;
+		rest_times[slot] = 0.0f;
+	} else {
+		for (auto member : sleeping_islands[island]) {
+			awake[member] = 1;
+			rest_times[member] = 0.0f;
+			sleeping_island[member] = NO_INDEX;
+		}
+		sleeping_islands[island].clear();
+		free_islands.push_back(island);
+	}
+
+	resting_dirty = true;
+}
+
+auto PhysicsSystem::is_dynamic(std::uint32_t slot) const -> bool {
+	return inverse_masses[slot] > 0.0f;
+}
+
+auto PhysicsSystem::get_bounds(std::uint32_t slot) const -> Bounds {
+	return Bounds{positions[slot], positions[slot] + sizes[slot]};
+}
+
+auto PhysicsSystem::get_cell(float x) const -> std::int32_t {
+	return static_cast<std::int32_t>(std::floor(x / settings.cell_size));
+}
+
+auto PhysicsSystem::get_key(std::int32_t x, std::int32_t y) -> std::uint64_t {
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+auto PhysicsSystem::get_pair(std::uint32_t a, std::uint32_t b) const -> std::uint64_t {
+	return (static_cast<std::uint64_t>(ids[a]) << 32) | ids[b];
+}
+
+auto PhysicsSystem::insert_entries(std::uint32_t slot, std::vector<CellEntry> &entries) const -> void {
+	auto bounds = get_bounds(slot);
+	for (auto y = get_cell(bounds.min.y); y <= get_cell(bounds.max.y); y++)
+		for (auto x = get_cell(bounds.min.x); x <= get_cell(bounds.max.x); x++)
+			entries.push_back({get_key(x, y), slot});
+}
+
+auto PhysicsSystem::find_root(std::uint32_t slot) -> std::uint32_t {
+	while (island_parents[slot] != slot) {
+		island_parents[slot] = island_parents[island_parents[slot]];
+		slot = island_parents[slot];
+	}
+	return slot;
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ecs/system.hpp"
+#include "ecs/types.hpp"
+#include "math/bounds.hpp"
+#include "math/vector2.hpp"
+
+class Entity;
+class Scene;
+
+/// @brief The physical properties of a body, which collides as the box covered by its `Transform`.
+struct RigidBody {
+	/// @brief The mass of the body, or 0 for a static body that never moves.
+	float mass = 1.0f;
+
+	/// @brief How much of the approaching speed is kept after a collision, from 0 (none) to 1 (all).
+	float restitution = 0.0f;
+
+	/// @brief The friction coefficient against sliding along other bodies.
+	float friction = 0.2f;
+
+	auto operator==(const RigidBody &other) const -> bool = default;
+};
+
+/// @brief The linear velocity of a body, in world units per second.
+struct Velocity {
+	Vector2 linear{0.0f, 0.0f};
+
+	auto operator==(const Velocity &other) const -> bool = default;
+};
+
+/// @brief Settings for `PhysicsSystem`.
+struct PhysicsSettings {
+	/// @brief The acceleration applied to every dynamic body, in world units per second squared.
+	Vector2 gravity{0.0f, -980.0f};
+
+	/// @brief The length of one step, in seconds.
+	float timestep = 1.0f / 60.0f;
+
+	/// @brief The number of times contacts are solved per step.
+	int iterations = 8;
+
+	/// @brief The width and height of each broadphase cell, which should be about twice the size of a typical body.
+	float cell_size = 64.0f;
+
+	/// @brief Bodies slower than this, in world units per second, are considered to be resting.
+	float sleep_speed = 8.0f;
+
+	/// @brief How long every body in an island has to rest before the island falls asleep, in seconds.
+	float sleep_time = 0.5f;
+
+	/// @brief How far bodies may overlap before they are pushed apart, which keeps resting contacts stable.
+	float slop = 0.5f;
+
+	/// @brief The fraction of the remaining overlap that is removed each step.
+	float correction = 0.4f;
+};
+
+/// @brief Counters from the most recent physics step.
+struct PhysicsStats {
+	size_t bodies = 0;
+	size_t awake_bodies = 0;
+	size_t contacts = 0;
+	size_t islands = 0;
+};
+
+/// @brief A system that moves bodies with a fixed timestep and resolves collisions between them.
+///
+/// Bodies are entities with a `Transform`, `RigidBody`, and `Velocity`, and collide as axis-aligned boxes.
+/// Each step integrates velocities with semi-implicit Euler, finds overlapping pairs with a uniform grid,
+/// and resolves them with sequential impulses that start from the previous step's results.
+///
+/// Groups of touching bodies (islands) that stay at rest fall asleep together, and sleeping bodies aren't
+/// integrated, resolved, or re-inserted into the grid until something wakes them, so resting bodies cost almost nothing.
+/// Changing a body's components from outside the system, or hitting it with an awake body, wakes its island.
+///
+/// Bodies are processed in entity ID order on a single thread, so the same scene stepped with the same settings
+/// produces bit-identical results.
+///
+/// Create it with `scene.create_system<PhysicsSystem, Transform, RigidBody, Velocity>()`.
+class PhysicsSystem : public System {
+   public:
+	/// @brief Get the settings.
+	/// @return The settings.
+	auto get_settings() const -> const PhysicsSettings &;
+
+	/// @brief Replace the settings.
+	/// @param settings The new settings.
+	auto set_settings(const PhysicsSettings &settings) -> void;
+
+	/// @brief Advance every body by one timestep.
+	///
+	/// This should be called from a fixed-rate loop, once per `PhysicsSettings::timestep`.
+	///
+	/// @param scene The scene that this system belongs to.
+	auto step(Scene &scene) -> void;
+
+	/// @brief Wake a body and every body in its island.
+	/// @param id The body's entity ID.
+	auto wake(EntityId id) -> void;
+
+	/// @brief Check whether a body is asleep.
+	/// @param id The body's entity ID.
+	/// @return Whether the body is asleep. Static bodies and entities that aren't bodies are never asleep.
+	auto is_sleeping(EntityId id) const -> bool;
+
+	/// @brief Get counters from the most recent step.
+	/// @return The counters.
+	auto get_stats() const -> const PhysicsStats &;
+
+   private:
+	struct CellEntry {
+		std::uint64_t key;
+		std::uint32_t body;
+
+		auto operator<(const CellEntry &other) const -> bool {
+			return key != other.key ? key < other.key : body < other.body;
+		}
+	};
+
+	struct Contact {
+		std::uint32_t a, b;
+		Vector2 normal{0.0f, 0.0f};
+		float penetration = 0.0f;
+		float bounce = 0.0f;
+		float friction = 0.0f;
+		float normal_impulse = 0.0f;
+		float tangent_impulse = 0.0f;
+	};
+
+	struct CachedImpulse {
+		std::uint64_t pair = 0;
+		Vector2 normal{0.0f, 0.0f};
+		float normal_impulse = 0.0f;
+		float tangent_impulse = 0.0f;
+
+		auto operator<(const CachedImpulse &other) const -> bool {
+			return pair < other.pair;
+		}
+	};
+
+	static constexpr auto NO_INDEX = static_cast<std::uint32_t>(-1);
+
+	PhysicsSettings settings{};
+	PhysicsStats stats{};
+	Tick last_tick = 0;
+
+	// Per-body state, indexed by slot, with slots sorted by entity ID
+	std::vector<Entity *> bodies{};
+	std::vector<EntityId> ids{};
+	std::vector<Vector2> positions{};
+	std::vector<Vector2> sizes{};
+	std::vector<Vector2> velocities{};
+	std::vector<RigidBody> materials{};
+	std::vector<float> inverse_masses{};
+	std::vector<float> rest_times{};
+	std::vector<unsigned char> awake{};
+	std::vector<std::uint32_t> sleeping_island{};
+	std::vector<std::uint32_t> slot_of{};
+
+	// Each sleeping island is a list of slots, and freed lists are reused
+	std::vector<std::vector<std::uint32_t>> sleeping_islands{};
+	std::vector<std::uint32_t> free_islands{};
+
+	// Static and sleeping bodies only change cells when they wake or fall asleep, so their entries are kept between steps
+	std::vector<CellEntry> resting_entries{};
+	std::vector<CellEntry> awake_entries{};
+	bool resting_dirty = true;
+
+	std::vector<Contact> contacts{};
+	std::vector<CachedImpulse> cached_impulses{};
+	std::vector<std::uint32_t> island_parents{};
+	std::vector<float> island_rest_times{};
+	std::vector<std::uint32_t> falling_asleep{};
+
+	auto needs_rebuild(Scene &scene, Tick since) -> bool;
+	auto rebuild(Scene &scene) -> void;
+	auto pull_changes(Scene &scene, Tick since) -> void;
+	auto find_contacts() -> void;
+	auto add_contact(std::uint32_t a, std::uint32_t b, std::uint64_t key) -> void;
+	auto solve() -> void;
+	auto correct_positions() -> void;
+	auto update_sleep() -> void;
+	auto push_changes() -> void;
+
+	auto wake_slot(std::uint32_t slot) -> void;
+	auto is_dynamic(std::uint32_t slot) const -> bool;
+	auto get_bounds(std::uint32_t slot) const -> Bounds;
+	auto get_cell(float x) const -> std::int32_t;
+	auto get_pair(std::uint32_t a, std::uint32_t b) const -> std::uint64_t;
+	static auto get_key(std::int32_t x, std::int32_t y) -> std::uint64_t;
+	auto insert_entries(std::uint32_t slot, std::vector<CellEntry> &entries) const -> void;
+	auto find_root(std::uint32_t slot) -> std::uint32_t;
+};
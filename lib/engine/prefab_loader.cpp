@@ -0,0 +1,178 @@
+#include "prefab_loader.hpp"
+
+#include <fmt/core.h>
+
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "physics.hpp"
+#include "transform.hpp"
+
+constexpr std::string_view WHITESPACE = " \t\r";
+
+static auto trim(std::string_view text) -> std::string_view {
+	auto begin = text.find_first_not_of(WHITESPACE);
+	if (begin == std::string_view::npos) return {};
+	return text.substr(begin, text.find_last_not_of(WHITESPACE) - begin + 1);
+}
+
+static auto split(std::string_view text) -> std::vector<std::string_view> {
+	std::vector<std::string_view> tokens{};
+	while (true) {
+		auto begin = text.find_first_not_of(WHITESPACE);
+		if (begin == std::string_view::npos) return tokens;
+		text = text.substr(begin);
+
+		auto end = text.find_first_of(WHITESPACE);
+		tokens.push_back(text.substr(0, end));
+		if (end == std::string_view::npos) return tokens;
+		text = text.substr(end);
+	}
+}
+
+auto PrefabFields::has(std::string_view key) const -> bool {
+	return find(key) != nullptr;
+}
+
+auto PrefabFields::get_float(std::string_view key, float fallback) const -> float {
+	auto field = find(key);
+	if (!field) return fallback;
+	return parse_float(*field, field->value);
+}
+
+auto PrefabFields::get_vector(std::string_view key, Vector2 fallback) const -> Vector2 {
+	auto field = find(key);
+	if (!field) return fallback;
+
+	auto comma = field->value.find(',');
+	if (comma == std::string_view::npos)
+		throw std::runtime_error{fmt::format("{}: `{}` should be two numbers separated by a comma, but is `{}`.", location, field->key, field->value)};
+	return {parse_float(*field, field->value.substr(0, comma)), parse_float(*field, field->value.substr(comma + 1))};
+}
+
+auto PrefabFields::get_string(std::string_view key, std::string_view fallback) const -> std::string_view {
+	auto field = find(key);
+	return field ? field->value : fallback;
+}
+
+auto PrefabFields::find(std::string_view key) const -> const Field * {
+	for (auto &field : fields) {
+		if (field.key == key) {
+			field.used = true;
+			return &field;
+		}
+	}
+	return nullptr;
+}
+
+auto PrefabFields::parse_float(const Field &field, std::string_view text) const -> float {
+	auto value = 0.0f;
+	auto end = text.data() + text.size();
+	auto [parsed_end, error] = std::from_chars(text.data(), end, value);
+	if (error != std::errc{} || parsed_end != end)
+		throw std::runtime_error{fmt::format("{}: `{}` should be a number, but is `{}`.", location, field.key, field.value)};
+	return value;
+}
+
+PrefabLoader::PrefabLoader() {
+	register_component<Transform>("Transform", [](const PrefabFields &fields) {
+		Transform defaults{};
+		return Transform{
+			fields.get_vector("position", defaults.position),
+			fields.get_vector("scale", defaults.scale),
+			fields.get_float("rotation", defaults.rotation),
+		};
+	});
+	register_component<GlobalTransform>("GlobalTransform", [](const PrefabFields &fields) {
+		GlobalTransform defaults{};
+		return GlobalTransform{
+			fields.get_vector("position", defaults.position),
+			fields.get_vector("scale", defaults.scale),
+			fields.get_float("rotation", defaults.rotation),
+		};
+	});
+	register_component<RigidBody>("RigidBody", [](const PrefabFields &fields) {
+		RigidBody defaults{};
+		return RigidBody{
+			fields.get_float("mass", defaults.mass),
+			fields.get_float("restitution", defaults.restitution),
+			fields.get_float("friction", defaults.friction),
+		};
+	});
+	register_component<Velocity>("Velocity", [](const PrefabFields &fields) {
+		return Velocity{fields.get_vector("linear", Velocity{}.linear)};
+	});
+}
+
+auto PrefabLoader::load(const std::filesystem::path &path) const -> PrefabMap {
+	std::ifstream file{path};
+	if (!file)
+		throw std::runtime_error{fmt::format("Couldn't open {}.", path.string())};
+
+	std::stringstream source{};
+	source << file.rdbuf();
+	return parse(source.str(), path.string());
+}
+
+auto PrefabLoader::parse(std::string_view source, std::string_view origin) const -> PrefabMap {
+	PrefabMap prefabs{};
+	Prefab *prefab = nullptr;
+	size_t line_number = 0;
+
+	while (!source.empty()) {
+		line_number++;
+		auto end = source.find('\n');
+		auto line = source.substr(0, end);
+		source = end == std::string_view::npos ? std::string_view{} : source.substr(end + 1);
+
+		line = trim(line.substr(0, line.find('#')));
+		if (line.empty()) continue;
+		auto location = fmt::format("{}:{}", origin, line_number);
+
+		if (line.front() == '[') {
+			auto name = line.back() == ']' ? trim(line.substr(1, line.size() - 2)) : std::string_view{};
+			if (name.empty())
+				throw std::runtime_error{fmt::format("{}: Expected a prefab name in brackets, but got `{}`.", location, line)};
+
+			auto [search, inserted] = prefabs.try_emplace(std::string{name});
+			if (!inserted)
+				throw std::runtime_error{fmt::format("{}: Prefab `{}` is defined more than once.", location, name)};
+			prefab = &search->second;
+			continue;
+		}
+
+		if (!prefab)
+			throw std::runtime_error{fmt::format("{}: Components must come after a prefab name in brackets.", location)};
+
+		auto tokens = split(line);
+		auto parser = parsers.find(tokens.front());
+		if (parser == parsers.end())
+			throw std::runtime_error{fmt::format("{}: Unknown component `{}`.", location, tokens.front())};
+
+		PrefabFields fields{};
+		fields.location = location;
+		for (size_t i = 1; i < tokens.size(); i++) {
+			auto equals = tokens[i].find('=');
+			if (equals == std::string_view::npos || equals == 0)
+				throw std::runtime_error{fmt::format("{}: Expected `key=value`, but got `{}`.", location, tokens[i])};
+
+			auto key = tokens[i].substr(0, equals);
+			for (auto &field : fields.fields)
+				if (field.key == key)
+					throw std::runtime_error{fmt::format("{}: `{}` is given more than once.", location, key)};
+			fields.fields.push_back({key, tokens[i].substr(equals + 1)});
+		}
+
+		parser->second(*prefab, fields);
+
+		// Anything the parser didn't read is most likely a typo
+		for (auto &field : fields.fields)
+			if (!field.used)
+				throw std::runtime_error{fmt::format("{}: `{}` has no field `{}`.", location, tokens.front(), field.key)};
+	}
+
+	return prefabs;
+}
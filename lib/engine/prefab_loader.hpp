@@ -0,0 +1,113 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ecs/prefab.hpp"
+#include "math/vector2.hpp"
+
+/// @brief Prefabs loaded from a file, by name.
+using PrefabMap = std::map<std::string, Prefab, std::less<>>;
+
+/// @brief The fields given to one component in a prefab file.
+///
+/// Every field has to be read by the component's parser, so misspelled fields are reported instead of ignored.
+class PrefabFields {
+   public:
+	/// @brief Check whether a field was given.
+	/// @param key The field's name.
+	/// @return Whether the field was given.
+	auto has(std::string_view key) const -> bool;
+
+	/// @brief Get a number.
+	/// @param key The field's name.
+	/// @param fallback The value to use if the field wasn't given.
+	/// @return The number.
+	/// @throw std::runtime_error Throws if the field isn't a number.
+	auto get_float(std::string_view key, float fallback) const -> float;
+
+	/// @brief Get a vector, written as two numbers separated by a comma.
+	/// @param key The field's name.
+	/// @param fallback The value to use if the field wasn't given.
+	/// @return The vector.
+	/// @throw std::runtime_error Throws if the field isn't two numbers.
+	auto get_vector(std::string_view key, Vector2 fallback) const -> Vector2;
+
+	/// @brief Get a field as written, such as a path.
+	/// @param key The field's name.
+	/// @param fallback The value to use if the field wasn't given.
+	/// @return The field's text.
+	auto get_string(std::string_view key, std::string_view fallback) const -> std::string_view;
+
+   private:
+	friend class PrefabLoader;
+
+	struct Field {
+		std::string_view key;
+		std::string_view value;
+		mutable bool used = false;
+	};
+
+	std::string location;
+	std::vector<Field> fields{};
+
+	auto find(std::string_view key) const -> const Field *;
+	auto parse_float(const Field &field, std::string_view text) const -> float;
+};
+
+/// @brief Loads prefabs from text files, so they can be changed without recompiling.
+///
+/// A prefab file lists prefabs by name in brackets, followed by one component per line.
+/// Each component is named the way it was registered, followed by its fields as `key=value` pairs:
+///
+/// ```
+/// # Static walls, sized when they're placed
+/// [wall]
+/// Transform scale=100,100
+/// RigidBody mass=0
+/// Velocity
+/// ```
+///
+/// `Transform`, `GlobalTransform`, `RigidBody`, and `Velocity` are registered by default.
+class PrefabLoader {
+   public:
+	/// @brief Parses a component from its fields.
+	/// @tparam T The component type.
+	template <typename T>
+	using Parser = std::function<T(const PrefabFields &fields)>;
+
+	/// @brief Create a loader that knows the engine's components.
+	PrefabLoader();
+
+	/// @brief Teach the loader a component.
+	///
+	/// Registering a name again replaces its parser.
+	///
+	/// @tparam T The component type, which must be copyable.
+	/// @param name The component's name in prefab files.
+	/// @param parse Creates the component from its fields.
+	template <typename T>
+	auto register_component(std::string name, Parser<T> parse) -> void;
+
+	/// @brief Load every prefab in a file.
+	/// @param path Path to the prefab file.
+	/// @return The prefabs, by name.
+	/// @throw std::runtime_error Throws if the file can't be read or has an error, with the line it's on.
+	auto load(const std::filesystem::path &path) const -> PrefabMap;
+
+	/// @brief Load every prefab in a string.
+	/// @param source The prefab definitions.
+	/// @param origin The name to use for the source in error messages.
+	/// @return The prefabs, by name.
+	/// @throw std::runtime_error Throws if the source has an error, with the line it's on.
+	auto parse(std::string_view source, std::string_view origin = "prefabs") const -> PrefabMap;
+
+   private:
+	std::map<std::string, std::function<void(Prefab &, const PrefabFields &)>, std::less<>> parsers{};
+};
+
+#include "prefab_loader.ipp"
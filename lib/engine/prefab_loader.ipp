@@ -0,0 +1,12 @@
+#pragma once
+
+#include <utility>
+
+#include "prefab_loader.hpp"
+
+template <typename T>
+inline auto PrefabLoader::register_component(std::string name, Parser<T> parse) -> void {
+	parsers.insert_or_assign(std::move(name), [parse = std::move(parse)](Prefab &prefab, const PrefabFields &fields) {
+		prefab.set(parse(fields));
+	});
+}
@@ -0,0 +1,208 @@
+#include "script.hpp"
+
+#include <fmt/core.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+auto Script::promise_type::get_return_object() -> Script {
+	return Script{Handle::from_promise(*this)};
+}
+
+// Each frame is prefixed with the pool it came from, padded so the frame itself stays aligned for any type
+constexpr auto FRAME_HEADER_SIZE = alignof(std::max_align_t);
+
+auto Script::promise_type::operator new(size_t size) -> void * {
+	return allocate_frame(size, nullptr);
+}
+
+auto Script::promise_type::operator delete(void *pointer, size_t size) -> void {
+	auto base = static_cast<std::byte *>(pointer) - FRAME_HEADER_SIZE;
+	FramePool *pool;
+	std::memcpy(&pool, base, sizeof(pool));
+
+	if (pool)
+		pool->deallocate(base, size + FRAME_HEADER_SIZE);
+	else
+		::operator delete(base);
+}
+
+auto Script::promise_type::allocate_frame(size_t size, FramePool *pool) -> void * {
+	auto base = static_cast<std::byte *>(pool ? pool->allocate(size + FRAME_HEADER_SIZE) : ::operator new(size + FRAME_HEADER_SIZE));
+	std::memcpy(base, &pool, sizeof(pool));
+	return base + FRAME_HEADER_SIZE;
+}
+
+Script::Script(Handle handle) : handle{handle} {}
+
+Script::~Script() {
+	if (handle)
+		handle.destroy();
+}
+
+Script::Script(Script &&other) noexcept : handle{std::exchange(other.handle, nullptr)} {}
+
+auto Script::operator=(Script &&other) noexcept -> Script & {
+	std::swap(handle, other.handle);
+	return *this;
+}
+
+auto NextFrame::await_suspend(Script::Handle handle) const -> void {
+	handle.promise().scheduler->wait_frame(handle);
+}
+
+auto Delay::await_suspend(Script::Handle handle) const -> void {
+	handle.promise().scheduler->wait_seconds(handle, seconds);
+}
+
+auto next_frame() -> NextFrame {
+	return {};
+}
+
+auto seconds(double seconds) -> Delay {
+	if (!std::isfinite(seconds))
+		throw std::runtime_error{fmt::format("Cannot wait for {} seconds.", seconds)};
+	return {seconds};
+}
+
+auto ScriptScheduler::Timer::operator>(const Timer &other) const -> bool {
+	// Timers that are due at the same time wake in the order they were set
+	if (time != other.time) return time > other.time;
+	return sequence > other.sequence;
+}
+
+ScriptScheduler::~ScriptScheduler() {
+	for (auto handle : scripts)
+		handle.destroy();
+}
+
+auto ScriptScheduler::start(Script script) -> void {
+	run(std::move(script));
+}
+
+auto ScriptScheduler::start(const std::shared_ptr<Entity> &entity, Script script) -> void {
+	auto &promise = script.handle.promise();
+	promise.entity = entity;
+	promise.attached = true;
+	run(std::move(script));
+}
+
+auto ScriptScheduler::stop(const std::shared_ptr<Entity> &entity) -> size_t {
+	size_t n_stopped = 0;
+	for (auto handle : scripts) {
+		auto &promise = handle.promise();
+		if (!promise.attached || promise.cancelled) continue;
+		if (promise.entity.owner_before(entity) || entity.owner_before(promise.entity)) continue;
+
+		promise.cancelled = true;
+		n_stopped++;
+	}
+	return n_stopped;
+}
+
+auto ScriptScheduler::update(double delta_seconds) -> size_t {
+	time += delta_seconds;
+	size_t n_resumed = 0;
+
+	// Scripts that wait again while they're resumed go into a fresh list, so they wait for the next update
+	std::swap(resuming, frame_waiters);
+	for (auto handle : resuming)
+		n_resumed += resume(handle);
+	resuming.clear();
+
+	// Every due timer is taken out before any script runs, so a delay too short to move the clock waits for the next update
+	while (!timers.empty() && timers.top().time <= time) {
+		resuming.push_back(timers.top().handle);
+		timers.pop();
+	}
+	for (auto handle : resuming)
+		n_resumed += resume(handle);
+	resuming.clear();
+
+	std::swap(polling, polls);
+	for (auto &poll : polling) {
+		if (is_stopped(poll.handle) || poll.ready())
+			n_resumed += resume(poll.handle);
+		else
+			polls.push_back(std::move(poll));
+	}
+	polling.clear();
+
+	if (exception)
+		std::rethrow_exception(std::exchange(exception, nullptr));
+	return n_resumed;
+}
+
+auto ScriptScheduler::size() const -> size_t {
+	return scripts.size();
+}
+
+auto ScriptScheduler::get_time() const -> double {
+	return time;
+}
+
+auto ScriptScheduler::wait_frame(Script::Handle handle) -> void {
+	frame_waiters.push_back(handle);
+}
+
+auto ScriptScheduler::wait_seconds(Script::Handle handle, double seconds) -> void {
+	// NaN would never compare as due, and would break the heap's ordering for every other timer
+	if (!std::isfinite(seconds))
+		throw std::runtime_error{fmt::format("Cannot wait for {} seconds.", seconds)};
+	timers.push({time + seconds, next_sequence++, handle});
+}
+
+auto ScriptScheduler::wait_until(Script::Handle handle, std::function<bool()> ready) -> void {
+	polls.push_back({handle, std::move(ready)});
+}
+
+auto ScriptScheduler::get_frame_pool() -> FramePool & {
+	return frame_pool;
+}
+
+auto ScriptScheduler::run(Script script) -> void {
+	// The scheduler owns the frame from here on, and destroys it once the script finishes
+	auto handle = std::exchange(script.handle, nullptr);
+	auto &promise = handle.promise();
+	promise.scheduler = this;
+	promise.index = scripts.size();
+	scripts.push_back(handle);
+
+	// Scripts can start other scripts, which mustn't pick up exceptions collected for the current update
+	auto pending = std::exchange(exception, nullptr);
+	resume(handle);
+	if (auto thrown = std::exchange(exception, pending))
+		std::rethrow_exception(thrown);
+}
+
+auto ScriptScheduler::resume(Script::Handle handle) -> bool {
+	if (is_stopped(handle)) {
+		destroy(handle);
+		return false;
+	}
+
+	handle.resume();
+	if (handle.done()) {
+		if (handle.promise().exception && !exception)
+			exception = handle.promise().exception;
+		destroy(handle);
+	}
+	return true;
+}
+
+auto ScriptScheduler::destroy(Script::Handle handle) -> void {
+	auto index = handle.promise().index;
+	scripts[index] = scripts.back();
+	scripts[index].promise().index = index;
+	scripts.pop_back();
+	handle.destroy();
+}
+
+auto ScriptScheduler::is_stopped(Script::Handle handle) -> bool {
+	auto &promise = handle.promise();
+	return promise.cancelled || (promise.attached && promise.entity.expired());
+}
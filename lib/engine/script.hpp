@@ -0,0 +1,233 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "util/frame_pool.hpp"
+
+class Entity;
+class ScriptScheduler;
+
+/// @brief A scripted behavior, written as a coroutine that returns `Script`.
+///
+/// A script runs until it waits on `next_frame`, `seconds` or `asset_loaded`, and is resumed by a `ScriptScheduler` once
+/// what it waits on is done. Nothing is polled while a script waits for time to pass, so sleeping scripts cost nothing per frame.
+///
+/// Scripts don't run until they're started, and a script that is never started is destroyed with its `Script`.
+/// Scripts whose first parameter is a `ScriptScheduler &` get their coroutine frames from that scheduler's `FramePool`,
+/// and must be destroyed before it. Other scripts get them from the system allocator.
+/// Either way, a frame goes back to where it came from, whichever thread destroys it.
+class Script {
+   public:
+	/// @internal
+	/// @brief The state that a script's coroutine frame holds for the scheduler.
+	struct promise_type {
+		ScriptScheduler *scheduler = nullptr;
+		std::weak_ptr<Entity> entity{};
+		bool attached = false;
+		bool cancelled = false;
+		size_t index = 0;
+		std::exception_ptr exception{};
+
+		auto get_return_object() -> Script;
+		auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+		auto final_suspend() noexcept -> std::suspend_always { return {}; }
+		auto return_void() -> void {}
+		auto unhandled_exception() -> void { exception = std::current_exception(); }
+
+		static auto operator new(size_t size) -> void *;
+		template <typename... Args>
+		static auto operator new(size_t size, ScriptScheduler &scheduler, Args &&...) -> void *;
+		static auto operator delete(void *pointer, size_t size) -> void;
+
+		static auto allocate_frame(size_t size, FramePool *pool) -> void *;
+	};
+
+	/// @internal
+	using Handle = std::coroutine_handle<promise_type>;
+
+	~Script();
+
+	Script(Script &&other) noexcept;
+	auto operator=(Script &&other) noexcept -> Script &;
+
+	Script(const Script &) = delete;
+	auto operator=(const Script &) -> Script & = delete;
+
+   private:
+	Handle handle;
+
+	explicit Script(Handle handle);
+
+	friend class ScriptScheduler;
+};
+
+/// @brief Waits until the next `ScriptScheduler::update`.
+struct NextFrame {
+	auto await_ready() const noexcept -> bool { return false; }
+	auto await_suspend(Script::Handle handle) const -> void;
+	auto await_resume() const noexcept -> void {}
+};
+
+/// @brief Waits until an amount of scheduler time has passed.
+struct Delay {
+	/// @brief The time to wait, in seconds.
+	double seconds;
+
+	auto await_ready() const noexcept -> bool { return seconds <= 0.0; }
+	auto await_suspend(Script::Handle handle) const -> void;
+	auto await_resume() const noexcept -> void {}
+};
+
+/// @brief Waits until an asset that is loaded in the background is ready.
+/// @tparam T The asset type.
+template <typename T>
+struct AssetLoaded {
+	/// @brief The asset's future.
+	std::shared_future<T> future;
+
+	auto await_ready() const -> bool;
+	auto await_suspend(Script::Handle handle) const -> void;
+	auto await_resume() const -> decltype(auto);
+};
+
+/// @brief Wait until the next frame.
+/// @return An awaitable for `co_await`.
+auto next_frame() -> NextFrame;
+
+/// @brief Wait for an amount of time.
+///
+/// Time is counted by the scheduler, so it only passes while the scheduler is updated.
+///
+/// @param seconds The time to wait, in seconds. Scripts don't wait at all for 0 or less.
+/// @return An awaitable for `co_await`.
+/// @throw std::runtime_error Throws if the time is NaN or infinite.
+auto seconds(double seconds) -> Delay;
+
+/// @brief Wait until an asset is loaded.
+/// @tparam T The asset type.
+/// @param future The asset's future, such as one from `std::async`.
+/// @return An awaitable for `co_await`, which gives a reference to the asset that stays valid while any of its futures exist,
+/// or rethrows the exception that loading it threw.
+template <typename T>
+auto asset_loaded(std::shared_future<T> future) -> AssetLoaded<T>;
+
+/// @brief Runs scripts, and resumes each one in bulk once what it waits on is done.
+///
+/// Scripts waiting on time are kept in a queue sorted by when they wake, so an update only touches scripts that are due.
+/// Scripts waiting on the next frame are resumed every update, and scripts waiting on assets are checked every update.
+class ScriptScheduler {
+   public:
+	ScriptScheduler() = default;
+
+	/// @brief Destroy every script that hasn't finished.
+	///
+	/// Scripts that took this scheduler as their first parameter but were never started must already be destroyed.
+	~ScriptScheduler();
+
+	/// @brief Start a script, running it until it first waits.
+	/// @param script The script to start.
+	/// @throw Rethrows the exception that the script throws, if it throws before it first waits.
+	auto start(Script script) -> void;
+
+	/// @brief Start a script that belongs to an entity, running it until it first waits.
+	///
+	/// The script is stopped once the entity is destroyed, instead of being resumed with an entity that no longer exists.
+	///
+	/// @param entity The entity that the script belongs to.
+	/// @param script The script to start.
+	/// @throw Rethrows the exception that the script throws, if it throws before it first waits.
+	auto start(const std::shared_ptr<Entity> &entity, Script script) -> void;
+
+	/// @brief Stop every script that belongs to an entity.
+	///
+	/// Stopped scripts are never resumed again. Their frames are freed once what they wait on is done.
+	///
+	/// @param entity The entity whose scripts to stop.
+	/// @return The number of scripts that were stopped.
+	auto stop(const std::shared_ptr<Entity> &entity) -> size_t;
+
+	/// @brief Advance time and resume every script whose wait is done.
+	/// @param delta_seconds The time since the previous update, in seconds.
+	/// @return The number of scripts that were resumed.
+	/// @throw Rethrows the first exception that a script throws, after every other script has been resumed.
+	auto update(double delta_seconds) -> size_t;
+
+	/// @brief Get the number of scripts that haven't finished.
+	/// @return The number of scripts.
+	auto size() const -> size_t;
+
+	/// @brief Get the time that has passed across every update.
+	/// @return The time, in seconds.
+	auto get_time() const -> double;
+
+	/// @internal
+	/// @brief Resume a script on the next update.
+	/// @param handle The script.
+	auto wait_frame(Script::Handle handle) -> void;
+
+	/// @internal
+	/// @brief Resume a script once an amount of time has passed.
+	///
+	/// The script is resumed on a later update, even if the time is so short that it has already passed.
+	///
+	/// @param handle The script.
+	/// @param seconds The time to wait, in seconds.
+	/// @throw std::runtime_error Throws if the time is NaN or infinite.
+	auto wait_seconds(Script::Handle handle, double seconds) -> void;
+
+	/// @internal
+	/// @brief Resume a script once a condition is true, checking it every update.
+	/// @param handle The script.
+	/// @param ready The condition.
+	auto wait_until(Script::Handle handle, std::function<bool()> ready) -> void;
+
+	/// @internal
+	/// @brief Get the pool for the frames of scripts that take this scheduler as their first parameter.
+	/// @return The pool.
+	auto get_frame_pool() -> FramePool &;
+
+	ScriptScheduler(const ScriptScheduler &) = delete;
+	ScriptScheduler(ScriptScheduler &&) = delete;
+	auto operator=(const ScriptScheduler &) -> void = delete;
+
+   private:
+	struct Timer {
+		double time;
+		std::uint64_t sequence;
+		Script::Handle handle;
+
+		auto operator>(const Timer &other) const -> bool;
+	};
+
+	struct Poll {
+		Script::Handle handle;
+		std::function<bool()> ready;
+	};
+
+	// Declared first, so it outlives the frames that the other members refer to
+	FramePool frame_pool{};
+	double time = 0.0;
+	std::uint64_t next_sequence = 0;
+	std::vector<Script::Handle> scripts{};
+	std::vector<Script::Handle> frame_waiters{};
+	std::vector<Script::Handle> resuming{};
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers{};
+	std::vector<Poll> polls{};
+	std::vector<Poll> polling{};
+	std::exception_ptr exception{};
+
+	auto run(Script script) -> void;
+	auto resume(Script::Handle handle) -> bool;
+	auto destroy(Script::Handle handle) -> void;
+	static auto is_stopped(Script::Handle handle) -> bool;
+};
+
+#include "script.ipp"
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <utility>
+
+#include "script.hpp"
+
+template <typename... Args>
+inline auto Script::promise_type::operator new(size_t size, ScriptScheduler &scheduler, Args &&...) -> void * {
+	return allocate_frame(size, &scheduler.get_frame_pool());
+}
+
+template <typename T>
+inline auto AssetLoaded<T>::await_ready() const -> bool {
+	return future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+}
+
+template <typename T>
+inline auto AssetLoaded<T>::await_suspend(Script::Handle handle) const -> void {
+	handle.promise().scheduler->wait_until(handle, [future = future] {
+		return future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+	});
+}
+
+template <typename T>
+inline auto AssetLoaded<T>::await_resume() const -> decltype(auto) {
+	return future.get();
+}
+
+template <typename T>
+inline auto asset_loaded(std::shared_future<T> future) -> AssetLoaded<T> {
+	return AssetLoaded<T>{std::move(future)};
+}
@@ -0,0 +1,140 @@
+#include "spatial_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/filters.hpp"
+#include "ecs/scene.hpp"
+#include "transform.hpp"
+
+SpatialIndex::SpatialIndex(float cell_size) : cell_size{cell_size}, locations(MAX_ENTITIES) {}
+
+auto SpatialIndex::update(Scene &scene) -> void {
+	// Changes stamped with the previous update's tick may have happened after it ran, so that tick is checked again.
+	// Bounds are compared against the indexed ones, so nothing is moved twice.
+	auto since = last_tick > 0 ? last_tick - 1 : 0;
+	last_tick = scene.get_tick();
+
+	for (auto id : scene.query<Removed<GlobalTransform>>(since))
+		remove(id);
+
+	for (auto &entity : scene.query<Changed<GlobalTransform>>(since)) {
+		auto id = entity->get_id();
+		auto bounds = entity->read_component<GlobalTransform>().get_bounds();
+
+		auto &location = locations[id];
+		if (location) {
+			auto &cell = cells[location->key];
+			if (cell.bounds[location->index] == bounds) continue;
+
+			auto center = bounds.get_center();
+			if (get_key(get_cell(center.x), get_cell(center.y)) == location->key) {
+				remove_half_extent(cell.bounds[location->index]);
+				add_half_extent(bounds);
+				cell.bounds[location->index] = bounds;
+				continue;
+			}
+
+			remove(id);
+		}
+
+		insert(id, bounds);
+	}
+
+	max_half_extent = half_extents.empty() ? 0.0f : half_extents.rbegin()->first;
+}
+
+auto SpatialIndex::query(const Bounds &bounds, std::vector<EntityId> &out) const -> void {
+	auto search = bounds.expanded(max_half_extent);
+	auto min_x = get_cell(search.min.x), max_x = get_cell(search.max.x);
+	auto min_y = get_cell(search.min.y), max_y = get_cell(search.max.y);
+
+	auto query_cell = [&](const Cell &cell) {
+		for (size_t i = 0; i < cell.ids.size(); i++)
+			if (cell.bounds[i].intersects(bounds))
+				out.push_back(cell.ids[i]);
+	};
+
+	// When zoomed far out, it's cheaper to walk the occupied cells than every cell in range
+	auto n_cells_in_range = static_cast<double>(max_x - min_x + 1) * static_cast<double>(max_y - min_y + 1);
+	if (n_cells_in_range > static_cast<double>(cells.size())) {
+		for (auto &[_, cell] : cells)
+			query_cell(cell);
+		return;
+	}
+
+	for (auto y = min_y; y <= max_y; y++) {
+		for (auto x = min_x; x <= max_x; x++) {
+			auto search = cells.find(get_key(x, y));
+			if (search != cells.end())
+				query_cell(search->second);
+		}
+	}
+}
+
+auto SpatialIndex::get_max_half_extent() const -> float {
+	return max_half_extent;
+}
+
+auto SpatialIndex::size() const -> size_t {
+	return len;
+}
+
+auto SpatialIndex::get_cell(float x) const -> std::int32_t {
+	return static_cast<std::int32_t>(std::floor(x / cell_size));
+}
+
+auto SpatialIndex::get_key(std::int32_t x, std::int32_t y) -> std::uint64_t {
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+auto SpatialIndex::get_half_extent(const Bounds &bounds) -> float {
+	return std::max(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y) * 0.5f;
+}
+
+auto SpatialIndex::add_half_extent(const Bounds &bounds) -> void {
+	half_extents[get_half_extent(bounds)]++;
+}
+
+auto SpatialIndex::remove_half_extent(const Bounds &bounds) -> void {
+	auto search = half_extents.find(get_half_extent(bounds));
+	if (--search->second == 0)
+		half_extents.erase(search);
+}
+
+auto SpatialIndex::insert(EntityId id, const Bounds &bounds) -> void {
+	auto center = bounds.get_center();
+	auto key = get_key(get_cell(center.x), get_cell(center.y));
+
+	auto &cell = cells[key];
+	locations[id] = Location{key, cell.ids.size()};
+	cell.ids.push_back(id);
+	cell.bounds.push_back(bounds);
+	len++;
+
+	add_half_extent(bounds);
+}
+
+auto SpatialIndex::remove(EntityId id) -> void {
+	auto &location = locations[id];
+	if (!location) return;
+
+	auto search = cells.find(location->key);
+	auto &cell = search->second;
+	auto last_id = cell.ids.back();
+	remove_half_extent(cell.bounds[location->index]);
+
+	cell.ids[location->index] = last_id;
+	cell.bounds[location->index] = cell.bounds.back();
+	locations[last_id]->index = location->index;
+	cell.ids.pop_back();
+	cell.bounds.pop_back();
+
+	if (cell.ids.empty())
+		cells.erase(search);
+
+	location.reset();
+	len--;
+}
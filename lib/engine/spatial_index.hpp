@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "ecs/types.hpp"
+#include "math/bounds.hpp"
+#include "math/vector2.hpp"
+
+class Scene;
+
+/// @brief A loose grid over the bounds of every `GlobalTransform`, used to find the entities in an area without visiting every entity.
+///
+/// Each entity is stored once, in the cell that contains the center of its bounds,
+/// and queries are widened by the largest half-size in the grid to make up for it.
+/// Half-sizes are counted, so the widening shrinks again when the largest entity is removed or resized.
+/// Updates only visit entities whose `GlobalTransform` was added, changed, or removed since the previous update.
+class SpatialIndex {
+   public:
+	/// @brief Create an empty spatial index.
+	/// @param cell_size The width and height of each grid cell in world units (256 by default).
+	explicit SpatialIndex(float cell_size = 256.0f);
+
+	/// @brief Move every entity whose `GlobalTransform` changed since the last update.
+	///
+	/// This should be called once per tick, after `TransformPropagation`.
+	///
+	/// @param scene The scene to index.
+	auto update(Scene &scene) -> void;
+
+	/// @brief Find every entity whose bounds overlap a box.
+	/// @param bounds The box to search.
+	/// @param out The buffer to append the matching entity IDs to.
+	auto query(const Bounds &bounds, std::vector<EntityId> &out) const -> void;
+
+	/// @brief Get the largest half-width or half-height of any indexed entity's bounds, which queries are widened by.
+	/// @return The largest half-size, or 0 if nothing is indexed.
+	auto get_max_half_extent() const -> float;
+
+	/// @brief Get the number of indexed entities.
+	/// @return The number of indexed entities.
+	auto size() const -> size_t;
+
+   private:
+	struct Cell {
+		std::vector<EntityId> ids{};
+		std::vector<Bounds> bounds{};
+	};
+
+	struct Location {
+		std::uint64_t key;
+		size_t index;
+	};
+
+	float cell_size;
+	float max_half_extent = 0.0f;
+	std::map<float, size_t> half_extents{};
+	std::unordered_map<std::uint64_t, Cell> cells{};
+	std::vector<std::optional<Location>> locations;
+	size_t len = 0;
+	Tick last_tick = 0;
+
+	auto get_cell(float x) const -> std::int32_t;
+	static auto get_key(std::int32_t x, std::int32_t y) -> std::uint64_t;
+	static auto get_half_extent(const Bounds &bounds) -> float;
+
+	auto add_half_extent(const Bounds &bounds) -> void;
+	auto remove_half_extent(const Bounds &bounds) -> void;
+
+	auto insert(EntityId id, const Bounds &bounds) -> void;
+	auto remove(EntityId id) -> void;
+};
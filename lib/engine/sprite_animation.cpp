@@ -0,0 +1,96 @@
+#include "sprite_animation.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "ecs/scene.hpp"
+
+auto AnimationClip::from_grid(const Texture &sheet, int frame_width, int frame_height, int first, int count, float frames_per_second, bool looping) -> AnimationClip {
+	auto columns = frame_width > 0 ? sheet.get_width() / frame_width : 0;
+	auto rows = frame_height > 0 ? sheet.get_height() / frame_height : 0;
+	if (first < 0 || count <= 0 || first + count > columns * rows)
+		throw std::runtime_error{fmt::format("Frames {} to {} don't fit in a {}x{} grid.", first, first + count - 1, columns, rows)};
+
+	AnimationClip clip{.frames_per_second = frames_per_second, .looping = looping};
+	clip.frames.reserve(count);
+	for (auto frame = first; frame < first + count; frame++)
+		clip.frames.push_back({(frame % columns) * frame_width, (frame / columns) * frame_height, frame_width, frame_height});
+	return clip;
+}
+
+auto AnimationLibrary::add_clip(AnimationClip clip) -> AnimationId {
+	if (clip.frames.empty())
+		throw std::runtime_error{"Animation clips must have at least one frame."};
+	if (!(clip.frames_per_second > 0.0f))
+		throw std::runtime_error{fmt::format("Animation clips can't play at {} frames per second.", clip.frames_per_second)};
+
+	auto frame_count = static_cast<std::uint32_t>(clip.frames.size());
+	auto duration = static_cast<float>(frame_count) / clip.frames_per_second;
+	timings.push_back({
+		.first = static_cast<std::uint32_t>(frames.size()),
+		.last = frame_count - 1,
+		.frames_per_second = clip.frames_per_second,
+		.duration = duration,
+		.wrap_rate = clip.looping ? 1.0f / duration : 0.0f,
+	});
+
+	frames.insert(frames.end(), clip.frames.begin(), clip.frames.end());
+	clips.push_back(std::move(clip));
+	return static_cast<AnimationId>(clips.size() - 1);
+}
+
+auto AnimationLibrary::get_clip(AnimationId id) const -> const AnimationClip & {
+	if (id >= clips.size())
+		throw std::runtime_error{fmt::format("No animation clip with ID `{}` exists.", id)};
+	return clips[id];
+}
+
+auto AnimationLibrary::play(AnimationId id, float speed) const -> SpriteAnimation {
+	get_clip(id);
+	return {.clip = id, .time = 0.0f, .speed = speed, .frame = timings[id].first};
+}
+
+auto AnimationLibrary::get_frame(std::uint32_t frame) const -> const SDL_Rect & {
+	return frames[frame];
+}
+
+auto AnimationLibrary::is_finished(const SpriteAnimation &animation) const -> bool {
+	auto &timing = timings.at(animation.clip);
+	return timing.wrap_rate == 0.0f && animation.time >= timing.duration;
+}
+
+auto AnimationLibrary::get_timings() const -> std::span<const Timing> {
+	return timings;
+}
+
+auto SpriteAnimationSystem::update(Scene &scene, float seconds) -> void {
+	auto timings = scene.resource<AnimationLibrary>().get_timings();
+	auto clips = scene.read_field<&SpriteAnimation::clip>();
+	auto speeds = scene.read_field<&SpriteAnimation::speed>();
+	auto times = scene.get_field<&SpriteAnimation::time>();
+	auto frames = scene.get_field<&SpriteAnimation::frame>();
+
+	// Clips are checked up front, so the loop below doesn't branch on them
+	if (!clips.empty()) {
+		auto max_clip = std::ranges::max(clips);
+		if (max_clip >= timings.size())
+			throw std::runtime_error{fmt::format("No animation clip with ID `{}` exists.", max_clip)};
+	}
+
+	for (size_t index = 0; index < times.size(); index++) {
+		auto &timing = timings[clips[index]];
+
+		// Looping clips wrap around, and a wrap rate of 0 leaves the others to be clamped to their last frame
+		auto time = times[index] + seconds * speeds[index];
+		time -= std::floor(time * timing.wrap_rate) * timing.duration;
+		time = std::clamp(time, 0.0f, timing.duration);
+
+		auto frame = std::min(static_cast<std::uint32_t>(time * timing.frames_per_second), timing.last);
+		times[index] = time;
+		frames[index] = timing.first + frame;
+	}
+}
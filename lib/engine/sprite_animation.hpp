@@ -0,0 +1,156 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "ecs/soa.hpp"
+#include "ecs/system.hpp"
+#include "sdl/texture.hpp"
+
+class Scene;
+
+/// @brief A type for identifying animation clips in an `AnimationLibrary`.
+using AnimationId = std::uint32_t;
+
+/// @brief A sequence of frames from a sprite sheet, played at a fixed rate.
+struct AnimationClip {
+	/// @brief The source rect of each frame in the sprite sheet, in order.
+	std::vector<SDL_Rect> frames{};
+
+	/// @brief How many frames are shown per second.
+	float frames_per_second = 12.0f;
+
+	/// @brief Whether the clip starts over after the last frame, instead of holding it.
+	bool looping = true;
+
+	/// @brief Create a clip from a sprite sheet laid out as a grid of equally sized frames.
+	///
+	/// Frames are numbered left to right, then top to bottom.
+	///
+	/// @param sheet The sprite sheet.
+	/// @param frame_width The width of each frame.
+	/// @param frame_height The height of each frame.
+	/// @param first The number of the clip's first frame.
+	/// @param count The number of frames in the clip.
+	/// @param frames_per_second How many frames are shown per second (12 by default).
+	/// @param looping Whether the clip starts over after the last frame (true by default).
+	/// @return The clip.
+	/// @throw std::runtime_error Throws if the frames don't fit in the sheet.
+	static auto from_grid(const Texture &sheet, int frame_width, int frame_height, int first, int count, float frames_per_second = 12.0f, bool looping = true) -> AnimationClip;
+};
+
+/// @brief Plays an `AnimationClip` on an entity, whose `Texture` should be the clip's sprite sheet.
+///
+/// This is stored as separate fields, so `SpriteAnimationSystem` can advance every animation in one pass.
+/// Create it with `AnimationLibrary::play`, which checks the clip and sets its first frame.
+struct SpriteAnimation {
+	/// @brief The clip to play.
+	AnimationId clip = 0;
+
+	/// @brief How far into the clip the animation is, in seconds.
+	float time = 0.0f;
+
+	/// @brief How fast the clip is played, where 1 is its normal rate.
+	float speed = 1.0f;
+
+	/// @brief The current frame's index in `AnimationLibrary`'s frame table, which is computed by `SpriteAnimationSystem`.
+	std::uint32_t frame = 0;
+};
+
+template <>
+struct SoaLayout<SpriteAnimation> {
+	static constexpr auto fields = std::tuple{
+		&SpriteAnimation::clip,
+		&SpriteAnimation::time,
+		&SpriteAnimation::speed,
+		&SpriteAnimation::frame,
+	};
+};
+
+/// @brief Every animation clip in a scene, meant to be stored as a scene resource.
+///
+/// The frames of every clip are flattened into a single table, so a `SpriteAnimation`'s current source rect
+/// is a single lookup.
+class AnimationLibrary {
+   public:
+	/// @internal
+	/// @brief The timing of a clip, precomputed so that advancing an animation doesn't need to branch on it.
+	struct Timing {
+		/// @brief The index of the clip's first frame in the frame table.
+		std::uint32_t first;
+
+		/// @brief The index of the clip's last frame, relative to its first frame.
+		std::uint32_t last;
+
+		float frames_per_second;
+
+		/// @brief The length of the clip, in seconds.
+		float duration;
+
+		/// @brief `1 / duration` for looping clips, or 0 for clips that hold their last frame.
+		float wrap_rate;
+	};
+
+	/// @brief Add a clip.
+	/// @param clip The clip to add.
+	/// @return The clip's ID.
+	/// @throw std::runtime_error Throws if the clip has no frames or doesn't advance.
+	auto add_clip(AnimationClip clip) -> AnimationId;
+
+	/// @brief Get a clip.
+	/// @param id The clip's ID.
+	/// @return The clip.
+	/// @throw std::runtime_error Throws if there is no clip with this ID.
+	auto get_clip(AnimationId id) const -> const AnimationClip &;
+
+	/// @brief Start playing a clip from its first frame.
+	///
+	/// The returned animation already shows the clip's first frame, so it can be drawn before the system first updates it.
+	/// Assign it to an existing `SpriteAnimation` to switch clips.
+	///
+	/// @param id The clip's ID.
+	/// @param speed How fast the clip is played, where 1 is its normal rate (1 by default).
+	/// @return The animation.
+	/// @throw std::runtime_error Throws if there is no clip with this ID.
+	auto play(AnimationId id, float speed = 1.0f) const -> SpriteAnimation;
+
+	/// @brief Get a frame's source rect.
+	/// @param frame An index in the frame table, such as `SpriteAnimation::frame`.
+	/// @return The source rect.
+	auto get_frame(std::uint32_t frame) const -> const SDL_Rect &;
+
+	/// @brief Check whether an animation has reached the end of a clip that doesn't loop.
+	/// @param animation The animation.
+	/// @return Whether the animation is holding its clip's last frame.
+	auto is_finished(const SpriteAnimation &animation) const -> bool;
+
+	/// @internal
+	/// @brief Get the timing of every clip.
+	/// @return The timings, indexed by clip ID.
+	auto get_timings() const -> std::span<const Timing>;
+
+   private:
+	std::vector<AnimationClip> clips{};
+	std::vector<Timing> timings{};
+	std::vector<SDL_Rect> frames{};
+};
+
+/// @brief A system that advances every `SpriteAnimation` and updates its current frame.
+///
+/// Animations are advanced as a single loop over their field arrays, reading each clip's precomputed timing,
+/// so there's no per-entity lookup or branching.
+/// The scene needs an `AnimationLibrary` resource that every animation's clip belongs to.
+///
+/// Create it with `scene.create_system<SpriteAnimationSystem, SpriteAnimation>()`.
+class SpriteAnimationSystem : public System {
+   public:
+	/// @brief Advance every animation.
+	/// @param scene The scene that this system belongs to.
+	/// @param seconds The time to advance by.
+	/// @throw std::runtime_error Throws if an animation's clip isn't in the library, in which case no animation is advanced.
+	auto update(Scene &scene, float seconds) -> void;
+};
@@ -0,0 +1,193 @@
+#include "tilemap.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "camera.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "sdl/render_list.hpp"
+#include "transform.hpp"
+
+Tilemap::Tilemap() : tile_size{1}, width{0}, height{0}, chunk_columns{0}, chunk_rows{0} {}
+
+Tilemap::Tilemap(Texture tileset, int tile_size, int width, int height)
+	: tileset{std::move(tileset)}, tile_size{tile_size}, width{width}, height{height} {
+	if (tile_size <= 0 || width <= 0 || height <= 0)
+		throw std::runtime_error{fmt::format("Cannot create a {}x{} tilemap with {}px tiles", width, height, tile_size)};
+
+	chunk_columns = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	chunk_rows = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	tiles.resize(static_cast<size_t>(width) * height, EMPTY);
+	chunks.resize(static_cast<size_t>(chunk_columns) * chunk_rows);
+}
+
+auto Tilemap::set_tile(int x, int y, TileId tile) -> void {
+	auto &current = tiles[get_index(x, y)];
+	if (current == tile) return;
+
+	current = tile;
+	get_chunk(x / CHUNK_SIZE, y / CHUNK_SIZE).dirty = true;
+}
+
+auto Tilemap::get_tile(int x, int y) const -> TileId {
+	return tiles[get_index(x, y)];
+}
+
+auto Tilemap::fill(TileId tile) -> void {
+	std::ranges::fill(tiles, tile);
+	for (auto &chunk : chunks)
+		chunk.dirty = true;
+}
+
+auto Tilemap::get_tileset() const -> const Texture & {
+	return tileset;
+}
+
+auto Tilemap::get_tile_size() const -> int {
+	return tile_size;
+}
+
+auto Tilemap::get_width() const -> int {
+	return width;
+}
+
+auto Tilemap::get_height() const -> int {
+	return height;
+}
+
+auto Tilemap::get_chunk_columns() const -> int {
+	return chunk_columns;
+}
+
+auto Tilemap::get_chunk_rows() const -> int {
+	return chunk_rows;
+}
+
+auto Tilemap::is_dirty(int chunk_x, int chunk_y) const -> bool {
+	return get_chunk(chunk_x, chunk_y).dirty;
+}
+
+auto Tilemap::build_chunk(int chunk_x, int chunk_y) -> bool {
+	auto &chunk = get_chunk(chunk_x, chunk_y);
+	if (!chunk.dirty) return false;
+
+	chunk.vertices.clear();
+	chunk.dirty = false;
+
+	auto columns = std::max(tileset.get_width() / tile_size, 1);
+	auto tileset_width = static_cast<float>(std::max(tileset.get_width(), 1));
+	auto tileset_height = static_cast<float>(std::max(tileset.get_height(), 1));
+	auto size = static_cast<float>(tile_size);
+	SDL_Color white{0xff, 0xff, 0xff, 0xff};
+
+	auto last_x = std::min((chunk_x + 1) * CHUNK_SIZE, width);
+	auto last_y = std::min((chunk_y + 1) * CHUNK_SIZE, height);
+	for (auto y = chunk_y * CHUNK_SIZE; y < last_y; y++) {
+		for (auto x = chunk_x * CHUNK_SIZE; x < last_x; x++) {
+			auto tile = tiles[static_cast<size_t>(y) * width + x];
+			if (tile == EMPTY) continue;
+
+			// Rows count up from the bottom of the map, but the screen counts down from its top
+			auto left = static_cast<float>(x) * size;
+			auto top = static_cast<float>(height - 1 - y) * size;
+			auto right = left + size;
+			auto bottom = top + size;
+
+			auto source_x = static_cast<float>((tile % columns) * tile_size);
+			auto source_y = static_cast<float>((tile / columns) * tile_size);
+			auto u0 = source_x / tileset_width;
+			auto v0 = source_y / tileset_height;
+			auto u1 = (source_x + size) / tileset_width;
+			auto v1 = (source_y + size) / tileset_height;
+
+			chunk.vertices.push_back({{left, top}, white, {u0, v0}});
+			chunk.vertices.push_back({{right, top}, white, {u1, v0}});
+			chunk.vertices.push_back({{right, bottom}, white, {u1, v1}});
+			chunk.vertices.push_back({{left, bottom}, white, {u0, v1}});
+		}
+	}
+
+	return true;
+}
+
+auto Tilemap::get_chunk_vertices(int chunk_x, int chunk_y) const -> const std::vector<SDL_Vertex> & {
+	return get_chunk(chunk_x, chunk_y).vertices;
+}
+
+auto Tilemap::get_chunk(int chunk_x, int chunk_y) -> Chunk & {
+	return chunks[static_cast<size_t>(chunk_y) * chunk_columns + chunk_x];
+}
+
+auto Tilemap::get_chunk(int chunk_x, int chunk_y) const -> const Chunk & {
+	return chunks[static_cast<size_t>(chunk_y) * chunk_columns + chunk_x];
+}
+
+auto Tilemap::get_index(int x, int y) const -> size_t {
+	if (x < 0 || x >= width || y < 0 || y >= height)
+		throw std::runtime_error{fmt::format("Tile ({}, {}) is outside of a {}x{} tilemap", x, y, width, height)};
+	return static_cast<size_t>(y) * width + x;
+}
+
+auto TilemapSystem::render(RenderList &list, Scene &scene) -> void {
+	auto &camera = scene.resource<Camera>();
+	auto view = camera.get_bounds();
+	stats = {};
+
+	for (auto &entity : entities) {
+		auto &tilemap = entity->read_component<Tilemap>();
+		if (!*tilemap.get_tileset() || tilemap.get_width() == 0) continue;
+
+		auto origin = entity->read_component<GlobalTransform>().position;
+		auto chunk_extent = static_cast<float>(tilemap.get_tile_size() * Tilemap::CHUNK_SIZE);
+
+		// Only the chunks that overlap the camera are visited
+		auto columns = tilemap.get_chunk_columns();
+		auto rows = tilemap.get_chunk_rows();
+		auto first_x = std::clamp(static_cast<int>(std::floor((view.min.x - origin.x) / chunk_extent)), 0, columns);
+		auto last_x = std::clamp(static_cast<int>(std::ceil((view.max.x - origin.x) / chunk_extent)), 0, columns);
+		auto first_y = std::clamp(static_cast<int>(std::floor((view.min.y - origin.y) / chunk_extent)), 0, rows);
+		auto last_y = std::clamp(static_cast<int>(std::ceil((view.max.y - origin.y) / chunk_extent)), 0, rows);
+		if (first_x >= last_x || first_y >= last_y) continue;
+
+		// Chunks are only laid out again when they're about to be drawn, so edits offscreen cost nothing until they're seen
+		for (auto chunk_y = first_y; chunk_y < last_y; chunk_y++) {
+			for (auto chunk_x = first_x; chunk_x < last_x; chunk_x++) {
+				if (!tilemap.is_dirty(chunk_x, chunk_y)) continue;
+				stats.rebuilt_chunks += entity->get_component_raw<Tilemap>().build_chunk(chunk_x, chunk_y);
+			}
+		}
+
+		// Cached quads are relative to the top-left corner of the map on the screen
+		auto map_height = static_cast<float>(tilemap.get_height() * tilemap.get_tile_size());
+		auto dx = origin.x - camera.position.x;
+		auto dy = camera.size.y - (origin.y + map_height - camera.position.y);
+
+		vertices.clear();
+		for (auto chunk_y = first_y; chunk_y < last_y; chunk_y++) {
+			for (auto chunk_x = first_x; chunk_x < last_x; chunk_x++) {
+				auto &chunk_vertices = tilemap.get_chunk_vertices(chunk_x, chunk_y);
+				for (auto vertex : chunk_vertices) {
+					vertex.position.x += dx;
+					vertex.position.y += dy;
+					vertices.push_back(vertex);
+				}
+			}
+		}
+		stats.visible_chunks += static_cast<size_t>((last_x - first_x) * (last_y - first_y));
+
+		auto n_tiles = vertices.size() / 4;
+		stats.tiles += n_tiles;
+		if (n_tiles == 0) continue;
+
+		list.render_geometry(&tilemap.get_tileset(), vertices, get_quad_indices(indices, n_tiles));
+	}
+}
+
+auto TilemapSystem::get_stats() const -> const TilemapStats & {
+	return stats;
+}
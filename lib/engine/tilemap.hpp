@@ -0,0 +1,162 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ecs/system.hpp"
+#include "math/vector2.hpp"
+#include "sdl/texture.hpp"
+
+class RenderList;
+class Scene;
+
+/// @brief A type for identifying tiles in a tileset.
+///
+/// Tiles are numbered left to right, then top to bottom.
+using TileId = std::uint16_t;
+
+/// @brief A grid of tiles drawn from a tileset, with its bottom-left corner at the entity's `GlobalTransform`.
+///
+/// Tiles are stored as a flat array of `TileId`s, and the map is divided into square chunks of `CHUNK_SIZE` tiles.
+/// The quads of each chunk are laid out once and cached, and are only laid out again after one of its tiles changes,
+/// so drawing a map only copies the cached quads of the chunks that the camera can see.
+class Tilemap {
+   public:
+	/// @brief The tile that marks an empty cell, which isn't drawn.
+	static constexpr TileId EMPTY = 0xffff;
+
+	/// @brief The width and height of a chunk, in tiles.
+	static constexpr int CHUNK_SIZE = 32;
+
+	/// @internal
+	/// @brief Default constructor for a tilemap to allow it to be used as a component.
+	Tilemap();
+
+	/// @brief Create an empty tilemap.
+	/// @param tileset The texture to draw tiles from, laid out as a grid of `tile_size` squares.
+	/// @param tile_size The width and height of each tile, in the tileset and in the world.
+	/// @param width The width of the map, in tiles.
+	/// @param height The height of the map, in tiles.
+	/// @throw std::runtime_error Throws if any size isn't positive.
+	Tilemap(Texture tileset, int tile_size, int width, int height);
+
+	/// @brief Set a tile.
+	/// @param x The tile's column, from the left.
+	/// @param y The tile's row, from the bottom.
+	/// @param tile The new tile, or `EMPTY`.
+	/// @throw std::runtime_error Throws if the tile is outside the map.
+	auto set_tile(int x, int y, TileId tile) -> void;
+
+	/// @brief Get a tile.
+	/// @param x The tile's column, from the left.
+	/// @param y The tile's row, from the bottom.
+	/// @return The tile, or `EMPTY`.
+	/// @throw std::runtime_error Throws if the tile is outside the map.
+	auto get_tile(int x, int y) const -> TileId;
+
+	/// @brief Set every tile.
+	/// @param tile The new tile, or `EMPTY`.
+	auto fill(TileId tile) -> void;
+
+	/// @brief Get the texture that tiles are drawn from.
+	/// @return The tileset.
+	auto get_tileset() const -> const Texture &;
+
+	/// @brief Get the width and height of each tile.
+	/// @return The tile size.
+	auto get_tile_size() const -> int;
+
+	/// @brief Get the width of the map.
+	/// @return The width, in tiles.
+	auto get_width() const -> int;
+
+	/// @brief Get the height of the map.
+	/// @return The height, in tiles.
+	auto get_height() const -> int;
+
+	/// @brief Get the number of chunks across the map.
+	/// @return The number of chunk columns.
+	auto get_chunk_columns() const -> int;
+
+	/// @brief Get the number of chunks up the map.
+	/// @return The number of chunk rows.
+	auto get_chunk_rows() const -> int;
+
+	/// @brief Check whether a chunk needs to be laid out again before it is drawn.
+	/// @param chunk_x The chunk's column, from the left.
+	/// @param chunk_y The chunk's row, from the bottom.
+	/// @return Whether one of the chunk's tiles changed since it was last laid out.
+	auto is_dirty(int chunk_x, int chunk_y) const -> bool;
+
+	/// @internal
+	/// @brief Lay a chunk's quads out again if one of its tiles changed.
+	///
+	/// Quads are relative to the top-left corner of the map on the screen, so moving the map or the camera
+	/// only translates them.
+	///
+	/// @param chunk_x The chunk's column, from the left.
+	/// @param chunk_y The chunk's row, from the bottom.
+	/// @return Whether the chunk was laid out.
+	auto build_chunk(int chunk_x, int chunk_y) -> bool;
+
+	/// @internal
+	/// @brief Get the cached quads of a chunk, four vertices per non-empty tile.
+	/// @param chunk_x The chunk's column, from the left.
+	/// @param chunk_y The chunk's row, from the bottom.
+	/// @return The vertices.
+	auto get_chunk_vertices(int chunk_x, int chunk_y) const -> const std::vector<SDL_Vertex> &;
+
+   private:
+	struct Chunk {
+		std::vector<SDL_Vertex> vertices{};
+		bool dirty = true;
+	};
+
+	Texture tileset;
+	int tile_size, width, height;
+	int chunk_columns, chunk_rows;
+	std::vector<TileId> tiles{};
+	std::vector<Chunk> chunks{};
+
+	auto get_chunk(int chunk_x, int chunk_y) -> Chunk &;
+	auto get_chunk(int chunk_x, int chunk_y) const -> const Chunk &;
+	auto get_index(int x, int y) const -> size_t;
+};
+
+/// @brief How much work a `TilemapSystem` did in its last render.
+struct TilemapStats {
+	/// @brief The number of chunks that overlapped the camera.
+	size_t visible_chunks = 0;
+
+	/// @brief The number of visible chunks that were laid out again, because their tiles changed.
+	size_t rebuilt_chunks = 0;
+
+	/// @brief The number of tiles drawn.
+	size_t tiles = 0;
+};
+
+/// @brief A system that draws every `Tilemap`.
+///
+/// Only the chunks that overlap the camera are visited, so the cost of drawing a map depends on the size of the view,
+/// not the size of the map. Each map's visible chunks are drawn with a single `SDL_RenderGeometry` call.
+///
+/// Create it with `scene.create_system<TilemapSystem, GlobalTransform, Tilemap>()`.
+class TilemapSystem : public System {
+   public:
+	/// @brief Record every tilemap.
+	/// @param list The list to record to.
+	/// @param scene The scene that this system belongs to, which needs a `Camera` resource.
+	auto render(RenderList &list, Scene &scene) -> void;
+
+	/// @brief Get how much work the last render did.
+	/// @return The stats, summed over every tilemap.
+	auto get_stats() const -> const TilemapStats &;
+
+   private:
+	std::vector<SDL_Vertex> vertices{};
+	std::vector<int> indices{};
+	TilemapStats stats{};
+};
@@ -0,0 +1,7 @@
+#pragma once
+
+/// @brief The time since the previous update, meant to be stored as a scene resource.
+struct DeltaTime {
+	/// @brief The time since the previous update, in seconds.
+	float seconds = 0.0f;
+};
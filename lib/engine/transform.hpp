@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+#include <numbers>
+
+#include "ecs/types.hpp"
+#include "math/bounds.hpp"
+#include "math/vector2.hpp"
+
+/// @brief The position, size, and rotation of an entity.
+///
+/// If the entity has a `Parent`, this is relative to the parent's `GlobalTransform`.
+struct Transform {
+	/// @brief The position of the entity's bottom-left corner.
+	Vector2 position{0.0f, 0.0f};
+
+	/// @brief The size of the entity. Sizes are not inherited from parents.
+	Vector2 scale{100.0f, 100.0f};
+
+	/// @brief The rotation of the entity in degrees, clockwise.
+	float rotation = 0.0f;
+
+	auto operator==(const Transform &other) const -> bool = default;
+};
+
+/// @brief The position, size, and rotation of an entity in world space.
+///
+/// This is computed from `Transform` and `Parent` by `TransformPropagation`, and shouldn't be modified directly.
+struct GlobalTransform {
+	Vector2 position{0.0f, 0.0f};
+	Vector2 scale{100.0f, 100.0f};
+	float rotation = 0.0f;
+
+	auto operator==(const GlobalTransform &other) const -> bool = default;
+
+	/// @brief Get the world-space box that the entity covers, including its rotation around its center.
+	/// @return The bounding box.
+	auto get_bounds() const -> Bounds {
+		auto center = position + scale * 0.5f;
+		auto radians = rotation * std::numbers::pi_v<float> / 180.0f;
+		auto cos = std::abs(std::cos(radians));
+		auto sin = std::abs(std::sin(radians));
+
+		Vector2 half_extents{
+			(scale.x * cos + scale.y * sin) * 0.5f,
+			(scale.x * sin + scale.y * cos) * 0.5f,
+		};
+		return Bounds{center - half_extents, center + half_extents};
+	}
+};
+
+/// @brief Attaches an entity to a parent, so its `Transform` is relative to the parent's `GlobalTransform`.
+struct Parent {
+	/// @brief The parent entity's ID.
+	EntityId id;
+};
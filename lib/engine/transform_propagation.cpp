@@ -0,0 +1,197 @@
+#include "transform_propagation.hpp"
+
+#include <algorithm>
+#include <memory>
+
+#include "ecs/constants.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/filters.hpp"
+#include "ecs/scene.hpp"
+#include "util/thread_pool.hpp"
+
+constexpr auto NO_ENTITY = static_cast<EntityId>(-1);
+
+auto TransformPropagation::update(Scene &scene, ThreadPool *pool) -> void {
+	// Changes stamped with the previous update's tick may have happened after it ran, so that tick is checked again.
+	// Transforms are compared against the cached copies, so nothing is recomputed twice.
+	auto since = last_tick > 0 ? last_tick - 1 : 0;
+	last_tick = scene.get_tick();
+
+	if (order_index.empty() || needs_rebuild(scene, since)) {
+		rebuild(scene);
+	} else {
+		for (auto &entity : scene.query<Changed<Transform>>(since)) {
+			auto index = order_index[entity->get_id()];
+			if (index == NO_INDEX) continue;
+
+			auto &local = entity->read_component<Transform>();
+			if (local == locals[index]) continue;
+
+			locals[index] = local;
+			mark_dirty(index);
+		}
+	}
+
+	std::vector<size_t> changed_trees{};
+	for (size_t i = 0; i < trees.size(); i++)
+		if (dirty_trees[i])
+			changed_trees.push_back(i);
+
+	if (pool != nullptr && changed_trees.size() > 1) {
+		auto n_chunks = std::min(changed_trees.size(), pool->get_thread_count() * 4);
+		pool->parallel_for(n_chunks, [&](size_t chunk) {
+			for (auto i = chunk; i < changed_trees.size(); i += n_chunks)
+				propagate(trees[changed_trees[i]]);
+		});
+	} else {
+		for (auto i : changed_trees)
+			propagate(trees[i]);
+	}
+
+	for (auto i : changed_trees) {
+		for (auto index = trees[i].begin; index < trees[i].end; index++) {
+			if (!dirty[index]) continue;
+			dirty[index] = 0;
+			scene.get_entity(order[index])->get_component_raw<GlobalTransform>() = globals[index];
+		}
+		dirty_trees[i] = 0;
+	}
+}
+
+auto TransformPropagation::needs_rebuild(Scene &scene, Tick since) -> bool {
+	// Entities can leave the system without a change this would see, like when they're destroyed
+	if (entities.size() != n_members) return true;
+
+	auto members = scene.create_signature<Transform, GlobalTransform>();
+	auto is_member = [&](const Entity &entity) { return entity.get_signature().contains(members); };
+
+	for (auto &entity : scene.query<Added<Transform>>(since))
+		if (order_index[entity->get_id()] == NO_INDEX && is_member(*entity)) return true;
+	for (auto &entity : scene.query<Added<GlobalTransform>>(since))
+		if (order_index[entity->get_id()] == NO_INDEX && is_member(*entity)) return true;
+
+	for (auto id : scene.query<Removed<Transform>>(since))
+		if (order_index[id] != NO_INDEX) return true;
+	for (auto id : scene.query<Removed<GlobalTransform>>(since))
+		if (order_index[id] != NO_INDEX) return true;
+
+	for (auto &entity : scene.query<Changed<Parent>>(since)) {
+		auto index = order_index[entity->get_id()];
+		if (index == NO_INDEX ? is_member(*entity) : entity->read_component<Parent>().id != parent_ids[index]) return true;
+	}
+
+	for (auto id : scene.query<Removed<Parent>>(since)) {
+		auto index = order_index[id];
+		if (index != NO_INDEX && parent_ids[index] != NO_ENTITY) return true;
+		if (index == NO_INDEX && std::ranges::any_of(entities, [&](auto &entity) { return entity->get_id() == id; })) return true;
+	}
+
+	return false;
+}
+
+auto TransformPropagation::rebuild(Scene &scene) -> void {
+	auto parent_signature = scene.create_signature<Parent>();
+
+	std::vector<Entity *> members{};
+	std::vector<size_t> member_slots(MAX_ENTITIES, NO_INDEX);
+	members.reserve(entities.size());
+	for (auto &entity : entities) {
+		member_slots[entity->get_id()] = members.size();
+		members.push_back(entity.get());
+	}
+
+	std::vector<EntityId> member_parent_ids(members.size(), NO_ENTITY);
+	std::vector<size_t> member_parents(members.size(), NO_INDEX);
+	std::vector<size_t> child_offsets(members.size() + 1, 0);
+	for (size_t slot = 0; slot < members.size(); slot++) {
+		if ((members[slot]->get_signature() & parent_signature).none()) continue;
+
+		auto parent_id = members[slot]->read_component<Parent>().id;
+		member_parent_ids[slot] = parent_id;
+		if (parent_id < MAX_ENTITIES && parent_id != members[slot]->get_id() && member_slots[parent_id] != NO_INDEX) {
+			member_parents[slot] = member_slots[parent_id];
+			child_offsets[member_parents[slot] + 1]++;
+		}
+	}
+
+	// Children are stored contiguously per parent, like a compressed sparse row matrix
+	for (size_t slot = 0; slot < members.size(); slot++)
+		child_offsets[slot + 1] += child_offsets[slot];
+	std::vector<size_t> children(child_offsets.back());
+	auto child_cursors = child_offsets;
+	for (size_t slot = 0; slot < members.size(); slot++)
+		if (member_parents[slot] != NO_INDEX)
+			children[child_cursors[member_parents[slot]]++] = slot;
+
+	std::vector<size_t> order_slots{};
+	order_slots.reserve(members.size());
+	order.clear();
+	parents.clear();
+	trees.clear();
+	order_index.assign(MAX_ENTITIES, NO_INDEX);
+
+	for (size_t root = 0; root < members.size(); root++) {
+		if (member_parents[root] != NO_INDEX) continue;
+
+		Tree tree{.begin = order_slots.size(), .end = 0};
+		order_slots.push_back(root);
+		parents.push_back(NO_INDEX);
+
+		// The order itself is the breadth-first queue
+		for (auto head = tree.begin; head < order_slots.size(); head++) {
+			auto slot = order_slots[head];
+			for (auto child = child_offsets[slot]; child < child_offsets[slot + 1]; child++) {
+				order_slots.push_back(children[child]);
+				parents.push_back(head);
+			}
+		}
+
+		tree.end = order_slots.size();
+		trees.push_back(tree);
+	}
+
+	parent_ids.resize(order_slots.size());
+	locals.resize(order_slots.size());
+	globals.resize(order_slots.size());
+	tree_of.resize(order_slots.size());
+	dirty.assign(order_slots.size(), 1);
+	dirty_trees.assign(trees.size(), 1);
+
+	for (size_t index = 0; index < order_slots.size(); index++) {
+		auto slot = order_slots[index];
+		order.push_back(members[slot]->get_id());
+		order_index[members[slot]->get_id()] = index;
+		parent_ids[index] = member_parent_ids[slot];
+		locals[index] = members[slot]->read_component<Transform>();
+	}
+
+	for (size_t i = 0; i < trees.size(); i++)
+		std::fill(tree_of.begin() + trees[i].begin, tree_of.begin() + trees[i].end, i);
+	n_members = members.size();
+}
+
+auto TransformPropagation::mark_dirty(size_t index) -> void {
+	dirty[index] = 1;
+	dirty_trees[tree_of[index]] = 1;
+}
+
+auto TransformPropagation::propagate(const Tree &tree) -> void {
+	for (auto index = tree.begin; index < tree.end; index++) {
+		auto parent = parents[index];
+		if (parent != NO_INDEX)
+			dirty[index] |= dirty[parent];
+		if (!dirty[index]) continue;
+
+		auto &local = locals[index];
+		if (parent == NO_INDEX) {
+			globals[index] = GlobalTransform{local.position, local.scale, local.rotation};
+		} else {
+			auto &parent_global = globals[parent];
+			globals[index] = GlobalTransform{
+				.position = parent_global.position + local.position.rotated(parent_global.rotation),
+				.scale = local.scale,
+				.rotation = parent_global.rotation + local.rotation,
+			};
+		}
+	}
+}
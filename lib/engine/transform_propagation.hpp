@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ecs/system.hpp"
+#include "ecs/types.hpp"
+#include "transform.hpp"
+
+class Entity;
+class Scene;
+class ThreadPool;
+
+/// @brief A system that computes each entity's `GlobalTransform` from its `Transform` and its ancestors'.
+///
+/// Each hierarchy is stored contiguously in breadth-first order, so parents are always computed before their children.
+/// Only transforms that actually changed are recomputed, along with their descendants,
+/// hierarchies without changes are skipped entirely, and independent hierarchies can be computed in parallel.
+///
+/// Create it with `scene.create_system<TransformPropagation, Transform, GlobalTransform>()`.
+/// Entities whose parent doesn't have both components are treated as roots, and entities in a parent cycle are ignored.
+class TransformPropagation : public System {
+   public:
+	/// @brief Update every `GlobalTransform` whose `Transform`, or whose ancestors' `Transform`, changed.
+	/// @param scene The scene that this system belongs to.
+	/// @param pool A thread pool to compute independent hierarchies on, or nullptr to run on the calling thread (nullptr by default).
+	auto update(Scene &scene, ThreadPool *pool = nullptr) -> void;
+
+   private:
+	/// @brief A contiguous range of `order` that holds a single hierarchy.
+	struct Tree {
+		size_t begin, end;
+	};
+
+	static constexpr auto NO_INDEX = static_cast<size_t>(-1);
+
+	// Entities are kept by ID, so nothing here can outlive the entities it refers to
+	std::vector<EntityId> order{};
+	std::vector<size_t> parents{};
+	std::vector<EntityId> parent_ids{};
+	std::vector<Transform> locals{};
+	std::vector<GlobalTransform> globals{};
+	std::vector<unsigned char> dirty{};
+	std::vector<size_t> tree_of{};
+
+	std::vector<Tree> trees{};
+	std::vector<unsigned char> dirty_trees{};
+
+	std::vector<size_t> order_index{};
+	size_t n_members = 0;
+	Tick last_tick = 0;
+
+	auto needs_rebuild(Scene &scene, Tick since) -> bool;
+	auto rebuild(Scene &scene) -> void;
+	auto mark_dirty(size_t index) -> void;
+	auto propagate(const Tree &tree) -> void;
+};
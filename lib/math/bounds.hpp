@@ -0,0 +1,37 @@
+#pragma once
+
+#include "vector2.hpp"
+
+/// @brief An axis-aligned bounding box.
+struct Bounds {
+	/// @brief The bottom-left corner.
+	Vector2 min;
+
+	/// @brief The top-right corner.
+	Vector2 max;
+
+	auto operator==(const Bounds &other) const -> bool = default;
+
+	/// @brief Check whether this box overlaps another one.
+	/// @param other The other box.
+	/// @return Whether the boxes overlap.
+	auto intersects(const Bounds &other) const -> bool {
+		return min.x < other.max.x && other.min.x < max.x && min.y < other.max.y && other.min.y < max.y;
+	}
+
+	/// @brief Get the center of this box.
+	/// @return The center.
+	auto get_center() const -> Vector2 {
+		return (min + max) * 0.5f;
+	}
+
+	/// @brief Get a copy of this box grown by a margin on every side.
+	/// @param margin The margin to grow by.
+	/// @return The grown box.
+	auto expanded(float margin) const -> Bounds {
+		return Bounds{
+			min - Vector2{margin, margin},
+			max + Vector2{margin, margin},
+		};
+	}
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cmath>
+#include <numbers>
+
+/// @brief A two-dimensional vector.
+struct Vector2 {
+	float x, y;
+
+	auto operator+(const Vector2 &other) const -> Vector2 {
+		return Vector2{
+			x + other.x,
+			y + other.y,
+		};
+	}
+
+	auto operator-(const Vector2 &other) const -> Vector2 {
+		return Vector2{
+			x - other.x,
+			y - other.y,
+		};
+	}
+
+	auto operator*(float scalar) const -> Vector2 {
+		return Vector2{
+			x * scalar,
+			y * scalar,
+		};
+	}
+
+	auto operator+=(const Vector2 &other) -> Vector2 & {
+		x += other.x;
+		y += other.y;
+		return *this;
+	}
+
+	auto operator-=(const Vector2 &other) -> Vector2 & {
+		x -= other.x;
+		y -= other.y;
+		return *this;
+	}
+
+	auto operator*=(float scalar) -> Vector2 & {
+		x *= scalar;
+		y *= scalar;
+		return *this;
+	}
+
+	auto operator==(const Vector2 &other) const -> bool = default;
+
+	/// @brief Get the dot product with another vector.
+	/// @param other The other vector.
+	/// @return The dot product.
+	auto dot(const Vector2 &other) const -> float {
+		return x * other.x + y * other.y;
+	}
+
+	auto normalize() -> Vector2 & {
+		auto length = std::sqrt(x * x + y * y);
+		x /= length;
+		y /= length;
+		return *this;
+	}
+
+	/// @brief Rotate this vector.
+	/// @param degrees The angle to rotate by, clockwise.
+	/// @return The rotated vector.
+	auto rotated(float degrees) const -> Vector2 {
+		auto radians = degrees * std::numbers::pi_v<float> / 180.0f;
+		auto cos = std::cos(radians);
+		auto sin = std::sin(radians);
+		return Vector2{
+			x * cos + y * sin,
+			y * cos - x * sin,
+		};
+	}
+};
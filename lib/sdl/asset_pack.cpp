@@ -0,0 +1,262 @@
+#include "asset_pack.hpp"
+
+#include <fmt/core.h>
+
+#ifdef CEGE_LZ4
+#include <lz4.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "surface.hpp"
+#include "texture.hpp"
+#include "util.hpp"
+
+constexpr std::byte ASSET_PACK_MAGIC[] = {std::byte{'C'}, std::byte{'E'}, std::byte{'G'}, std::byte{'E'}, std::byte{'P'}, std::byte{'A'}, std::byte{'C'}, std::byte{'K'}};
+constexpr std::uint32_t ASSET_PACK_VERSION = 1;
+
+// Pixel data starts on cache line boundaries, so uploads read whole lines
+constexpr size_t DATA_ALIGNMENT = 64;
+
+static auto write_u32(std::uint32_t value, std::vector<std::byte> &out) -> void {
+	for (auto i = 0; i < 4; i++)
+		out.push_back(static_cast<std::byte>(value >> (i * 8)));
+}
+
+static auto write_u64(std::uint64_t value, std::vector<std::byte> &out) -> void {
+	write_u32(static_cast<std::uint32_t>(value), out);
+	write_u32(static_cast<std::uint32_t>(value >> 32), out);
+}
+
+static auto read_u32(std::span<const std::byte> &in) -> std::uint32_t {
+	if (in.size() < 4)
+		throw std::runtime_error{"Asset pack index is truncated."};
+
+	std::uint32_t value = 0;
+	for (auto i = 0; i < 4; i++)
+		value |= std::to_integer<std::uint32_t>(in[i]) << (i * 8);
+	in = in.subspan(4);
+	return value;
+}
+
+static auto read_u64(std::span<const std::byte> &in) -> std::uint64_t {
+	auto low = read_u32(in);
+	return low | (static_cast<std::uint64_t>(read_u32(in)) << 32);
+}
+
+AssetPack::AssetPack(const std::filesystem::path &path) : path{path}, file{path} {
+	auto data = file.get_data();
+	auto in = data;
+	if (in.size() < std::size(ASSET_PACK_MAGIC) || !std::equal(std::begin(ASSET_PACK_MAGIC), std::end(ASSET_PACK_MAGIC), in.begin()))
+		throw std::runtime_error{fmt::format("{} isn't an asset pack.", path.string())};
+	in = in.subspan(std::size(ASSET_PACK_MAGIC));
+
+	auto version = read_u32(in);
+	if (version != ASSET_PACK_VERSION)
+		throw std::runtime_error{fmt::format("{} was packed by an incompatible version (version {}).", path.string(), version)};
+
+	// Names and pixels are views into the mapping, so opening a pack only reads its index
+	auto n_entries = read_u32(in);
+	entries.reserve(n_entries);
+	for (std::uint32_t i = 0; i < n_entries; i++) {
+		auto name_size = read_u32(in);
+		if (in.size() < name_size)
+			throw std::runtime_error{fmt::format("{} has a truncated index.", path.string())};
+		std::string_view name{reinterpret_cast<const char *>(in.data()), name_size};
+		in = in.subspan(name_size);
+
+		auto width = static_cast<int>(read_u32(in));
+		auto height = static_cast<int>(read_u32(in));
+		auto pitch = static_cast<int>(read_u32(in));
+		auto compression = static_cast<AssetCompression>(read_u32(in));
+		auto offset = read_u64(in);
+		auto size = read_u64(in);
+		auto pixels_size = read_u64(in);
+		// Loading copies `width * 4` bytes out of every `pitch`, so a short pitch or a negative size would read out of bounds
+		auto valid_size = width > 0 && height > 0 && static_cast<std::int64_t>(pitch) >= static_cast<std::int64_t>(width) * 4;
+		if (!valid_size || offset > data.size() || size > data.size() - offset || pixels_size != static_cast<std::uint64_t>(pitch) * height)
+			throw std::runtime_error{fmt::format("{} has a corrupt entry for {}.", path.string(), name)};
+
+		entries.push_back({name, width, height, pitch, compression, data.subspan(offset, size), pixels_size});
+	}
+
+	if (!std::ranges::is_sorted(entries, {}, &Entry::name))
+		throw std::runtime_error{fmt::format("{} has an unsorted index.", path.string())};
+}
+
+auto AssetPack::contains(std::string_view name) const -> bool {
+	auto it = std::ranges::lower_bound(entries, name, {}, &Entry::name);
+	return it != entries.end() && it->name == name;
+}
+
+auto AssetPack::size() const -> size_t {
+	return entries.size();
+}
+
+auto AssetPack::get_names() const -> std::vector<std::string_view> {
+	std::vector<std::string_view> names{};
+	names.reserve(entries.size());
+	for (auto &entry : entries)
+		names.push_back(entry.name);
+	return names;
+}
+
+auto AssetPack::load_texture(std::string_view name, SDL_Renderer *renderer) const -> Texture {
+	auto &entry = find(name);
+	std::vector<std::byte> buffer{};
+	auto pixels = get_pixels(entry, buffer);
+
+	auto texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, entry.width, entry.height);
+	check_error(texture);
+	Texture result{texture};
+	check_error(SDL_UpdateTexture(texture, nullptr, pixels.data(), entry.pitch));
+	check_error(SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND));
+	return result;
+}
+
+auto AssetPack::load_surface(std::string_view name) const -> Surface {
+	auto &entry = find(name);
+	std::vector<std::byte> buffer{};
+	auto pixels = get_pixels(entry, buffer);
+
+	Surface surface{entry.width, entry.height};
+	auto row_size = static_cast<size_t>(entry.width) * 4;
+	for (auto y = 0; y < entry.height; y++)
+		std::memcpy(static_cast<std::byte *>(surface->pixels) + y * surface->pitch, pixels.data() + y * entry.pitch, row_size);
+	return surface;
+}
+
+auto AssetPack::find(std::string_view name) const -> const Entry & {
+	auto it = std::ranges::lower_bound(entries, name, {}, &Entry::name);
+	if (it == entries.end() || it->name != name)
+		throw std::runtime_error{fmt::format("{} doesn't contain {}.", path.string(), name)};
+	return *it;
+}
+
+auto AssetPack::get_pixels(const Entry &entry, std::vector<std::byte> &buffer) const -> std::span<const std::byte> {
+	switch (entry.compression) {
+		case AssetCompression::none:
+			if (entry.data.size() != entry.pixels_size) break;
+			return entry.data;
+
+		case AssetCompression::lz4:
+#ifdef CEGE_LZ4
+			buffer.resize(entry.pixels_size);
+			if (LZ4_decompress_safe(reinterpret_cast<const char *>(entry.data.data()), reinterpret_cast<char *>(buffer.data()), static_cast<int>(entry.data.size()), static_cast<int>(buffer.size())) != static_cast<int>(buffer.size()))
+				break;
+			return buffer;
+#else
+			throw std::runtime_error{fmt::format("{} is compressed with LZ4, but CEGE was built without it.", entry.name)};
+#endif
+	}
+
+	throw std::runtime_error{fmt::format("{} has corrupt pixel data for {}.", path.string(), entry.name)};
+}
+
+auto AssetPackWriter::add_image(std::string name, const Surface &image) -> void {
+	Image packed{std::move(name), image.get_width(), image.get_height(), {}};
+	auto row_size = static_cast<size_t>(packed.width) * 4;
+	packed.pixels.resize(row_size * packed.height);
+	for (auto y = 0; y < packed.height; y++)
+		std::memcpy(packed.pixels.data() + y * row_size, static_cast<const std::byte *>(image->pixels) + y * image->pitch, row_size);
+
+	auto it = std::ranges::find(images, packed.name, &Image::name);
+	if (it != images.end())
+		*it = std::move(packed);
+	else
+		images.push_back(std::move(packed));
+}
+
+auto AssetPackWriter::add_image(const std::filesystem::path &path) -> void {
+	add_image(path.generic_string(), Surface{path});
+}
+
+auto AssetPackWriter::size() const -> size_t {
+	return images.size();
+}
+
+auto AssetPackWriter::write(const std::filesystem::path &path, AssetCompression compression) const -> void {
+#ifndef CEGE_LZ4
+	if (compression == AssetCompression::lz4)
+		throw std::runtime_error{fmt::format("Couldn't write {} with LZ4, since CEGE was built without it.", path.string())};
+#endif
+
+	std::vector<const Image *> sorted{};
+	for (auto &image : images)
+		sorted.push_back(&image);
+	std::ranges::sort(sorted, {}, [](const Image *image) -> const std::string & { return image->name; });
+
+	// Compress every image first, so the index knows where each one ends up
+	std::vector<std::vector<std::byte>> blocks(sorted.size());
+	std::vector<AssetCompression> compressions(sorted.size(), AssetCompression::none);
+#ifdef CEGE_LZ4
+	if (compression == AssetCompression::lz4) {
+		for (size_t i = 0; i < sorted.size(); i++) {
+			auto &pixels = sorted[i]->pixels;
+			auto &block = blocks[i];
+			block.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(pixels.size()))));
+			auto size = LZ4_compress_default(reinterpret_cast<const char *>(pixels.data()), reinterpret_cast<char *>(block.data()), static_cast<int>(pixels.size()), static_cast<int>(block.size()));
+			if (size <= 0 || static_cast<size_t>(size) >= pixels.size()) continue;
+
+			block.resize(static_cast<size_t>(size));
+			compressions[i] = AssetCompression::lz4;
+		}
+	}
+#endif
+	auto get_data = [&](size_t i) -> const std::vector<std::byte> & {
+		return compressions[i] == AssetCompression::none ? sorted[i]->pixels : blocks[i];
+	};
+
+	auto index_size = std::size(ASSET_PACK_MAGIC) + 8;
+	for (auto image : sorted)
+		index_size += 4 + image->name.size() + 4 * 4 + 8 * 3;
+	auto align = [](size_t offset) {
+		return (offset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+	};
+
+	std::vector<std::byte> index{std::begin(ASSET_PACK_MAGIC), std::end(ASSET_PACK_MAGIC)};
+	write_u32(ASSET_PACK_VERSION, index);
+	write_u32(static_cast<std::uint32_t>(sorted.size()), index);
+
+	auto offset = align(index_size);
+	std::vector<size_t> offsets{};
+	for (size_t i = 0; i < sorted.size(); i++) {
+		auto &image = *sorted[i];
+		write_u32(static_cast<std::uint32_t>(image.name.size()), index);
+		auto name = std::as_bytes(std::span{image.name});
+		index.insert(index.end(), name.begin(), name.end());
+
+		write_u32(static_cast<std::uint32_t>(image.width), index);
+		write_u32(static_cast<std::uint32_t>(image.height), index);
+		write_u32(static_cast<std::uint32_t>(image.width * 4), index);
+		write_u32(static_cast<std::uint32_t>(compressions[i]), index);
+		write_u64(offset, index);
+		write_u64(get_data(i).size(), index);
+		write_u64(image.pixels.size(), index);
+
+		offsets.push_back(offset);
+		offset = align(offset + get_data(i).size());
+	}
+
+	std::ofstream file{path, std::ios::binary | std::ios::trunc};
+	if (!file)
+		throw std::runtime_error{fmt::format("Couldn't open {} for writing.", path.string())};
+
+	file.write(reinterpret_cast<const char *>(index.data()), static_cast<std::streamsize>(index.size()));
+	auto position = index.size();
+	const char padding[DATA_ALIGNMENT]{};
+	for (size_t i = 0; i < sorted.size(); i++) {
+		auto &data = get_data(i);
+		file.write(padding, static_cast<std::streamsize>(offsets[i] - position));
+		file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+		position = offsets[i] + data.size();
+	}
+
+	if (!file)
+		throw std::runtime_error{fmt::format("Couldn't write {}.", path.string())};
+}
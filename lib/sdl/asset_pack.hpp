@@ -0,0 +1,118 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/mapped_file.hpp"
+
+class Surface;
+class Texture;
+
+/// @brief How an image's pixels are stored in an `AssetPack`.
+enum class AssetCompression : std::uint32_t {
+	/// @brief Raw RGBA32 pixels, which are uploaded straight from the mapped file.
+	none = 0,
+
+	/// @brief A single LZ4 block, which is decompressed before uploading. Only available if CEGE was built with LZ4.
+	lz4 = 1,
+};
+
+/// @brief An archive of images that are already decoded into RGBA32 pixels, written by `AssetPackWriter`.
+///
+/// The pack is mapped into memory instead of read, and uncompressed images are uploaded to textures
+/// directly from the mapping, so loading an image doesn't open a file or decode a PNG or JPEG.
+///
+/// Images are named by the path they were packed from, such as `assets/ball.jpg`.
+class AssetPack {
+   public:
+	/// @internal
+	/// @brief Where an image is stored in the pack.
+	struct Entry {
+		std::string_view name;
+		int width, height, pitch;
+		AssetCompression compression;
+		std::span<const std::byte> data;
+		size_t pixels_size;
+	};
+
+	/// @brief Open a pack.
+	/// @param path Path to the pack.
+	/// @throw std::runtime_error Throws if the file can't be mapped or isn't a valid pack.
+	explicit AssetPack(const std::filesystem::path &path);
+
+	/// @brief Check whether an image is in the pack.
+	/// @param name The name of the image.
+	/// @return Whether the image is in the pack.
+	auto contains(std::string_view name) const -> bool;
+
+	/// @brief Get the number of images in the pack.
+	/// @return The number of images.
+	auto size() const -> size_t;
+
+	/// @brief Get the name of every image in the pack.
+	/// @return The names, in sorted order.
+	auto get_names() const -> std::vector<std::string_view>;
+
+	/// @brief Upload an image to a new texture.
+	/// @param name The name of the image.
+	/// @param renderer The renderer to use.
+	/// @return A texture containing the image.
+	/// @throw std::runtime_error Throws if the image isn't in the pack or can't be decompressed.
+	auto load_texture(std::string_view name, SDL_Renderer *renderer) const -> Texture;
+
+	/// @brief Copy an image into a surface.
+	/// @param name The name of the image.
+	/// @return A surface containing the image.
+	/// @throw std::runtime_error Throws if the image isn't in the pack or can't be decompressed.
+	auto load_surface(std::string_view name) const -> Surface;
+
+   private:
+	std::filesystem::path path;
+	MappedFile file;
+	std::vector<Entry> entries{};
+
+	auto find(std::string_view name) const -> const Entry &;
+	auto get_pixels(const Entry &entry, std::vector<std::byte> &buffer) const -> std::span<const std::byte>;
+};
+
+/// @brief Builds an `AssetPack` from images.
+class AssetPackWriter {
+   public:
+	/// @brief Add an image, replacing any image with the same name.
+	/// @param name The name to look the image up by.
+	/// @param image The image.
+	auto add_image(std::string name, const Surface &image) -> void;
+
+	/// @brief Decode an image file and add it, named by its path.
+	/// @param path Path to the image.
+	auto add_image(const std::filesystem::path &path) -> void;
+
+	/// @brief Get the number of images added so far.
+	/// @return The number of images.
+	auto size() const -> size_t;
+
+	/// @brief Write every image to a pack.
+	///
+	/// Compressed images that don't end up smaller are stored uncompressed.
+	///
+	/// @param path Path to the pack, which is overwritten.
+	/// @param compression How to store each image's pixels (uncompressed by default).
+	/// @throw std::runtime_error Throws if the file can't be written, or if LZ4 is requested but CEGE was built without it.
+	auto write(const std::filesystem::path &path, AssetCompression compression = AssetCompression::none) const -> void;
+
+   private:
+	struct Image {
+		std::string name;
+		int width, height;
+		std::vector<std::byte> pixels;
+	};
+
+	std::vector<Image> images{};
+};
@@ -0,0 +1,91 @@
+#include "font.hpp"
+
+#include <SDL_ttf.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "surface.hpp"
+#include "util.hpp"
+
+// Glyphs are packed into rows that wrap at this width
+constexpr auto ATLAS_WIDTH = 512;
+
+// Space between glyphs keeps linear filtering from bleeding neighbours into each other
+constexpr auto GLYPH_PADDING = 1;
+
+Font::Font(const std::filesystem::path &path, int point_size, SDL_Renderer *renderer) {
+	std::unique_ptr<TTF_Font, decltype(&TTF_CloseFont)> font{TTF_OpenFont(path.c_str(), point_size), TTF_CloseFont};
+	check_error(font.get(), TTF_GetError);
+	line_height = TTF_FontLineSkip(font.get());
+
+	std::vector<std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)>> surfaces{};
+	surfaces.reserve(N_GLYPHS);
+
+	int x = 0, y = 0, row_height = 0;
+	for (size_t index = 0; index < N_GLYPHS; index++) {
+		auto character = static_cast<Uint32>(FIRST_GLYPH + index);
+		auto &glyph = glyphs[index];
+
+		if (!TTF_GlyphIsProvided32(font.get(), character)) {
+			surfaces.emplace_back(nullptr, SDL_FreeSurface);
+			glyph = {{0, 0, 0, 0}, -1};
+			continue;
+		}
+
+		check_error(TTF_GlyphMetrics32(font.get(), character, nullptr, nullptr, nullptr, nullptr, &glyph.advance), TTF_GetError);
+		auto &surface = surfaces.emplace_back(TTF_RenderGlyph32_Blended(font.get(), character, {0xff, 0xff, 0xff, 0xff}), SDL_FreeSurface);
+		check_error(surface.get(), TTF_GetError);
+
+		if (x + surface->w > ATLAS_WIDTH) {
+			x = 0;
+			y += row_height + GLYPH_PADDING;
+			row_height = 0;
+		}
+
+		glyph.source = {x, y, surface->w, surface->h};
+		x += surface->w + GLYPH_PADDING;
+		row_height = std::max(row_height, surface->h);
+	}
+
+	// Glyphs are copied as-is, since blending them onto the transparent atlas would darken their edges
+	Surface atlas_surface{ATLAS_WIDTH, y + row_height};
+	for (size_t index = 0; index < N_GLYPHS; index++) {
+		auto &surface = surfaces[index];
+		if (!surface) continue;
+
+		SDL_SetSurfaceBlendMode(surface.get(), SDL_BLENDMODE_NONE);
+		check_error(SDL_BlitSurface(surface.get(), nullptr, *atlas_surface, &glyphs[index].source));
+	}
+
+	auto texture = SDL_CreateTextureFromSurface(renderer, *atlas_surface);
+	check_error(texture);
+	SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	atlas = Texture{texture};
+
+	// Characters the font doesn't have are drawn as `?`
+	auto &fallback = glyphs['?' - FIRST_GLYPH];
+	for (auto &glyph : glyphs)
+		if (glyph.advance < 0)
+			glyph = fallback.advance < 0 ? Glyph{{0, 0, 0, 0}, 0} : fallback;
+}
+
+Font::Font(Texture atlas, const std::array<Glyph, N_GLYPHS> &glyphs, int line_height)
+	: atlas{std::move(atlas)}, glyphs{glyphs}, line_height{line_height} {}
+
+auto Font::get_atlas() const -> const Texture & {
+	return atlas;
+}
+
+auto Font::get_glyph(char character) const -> const Glyph & {
+	auto code = static_cast<unsigned char>(character);
+	if (code < FIRST_GLYPH || code > LAST_GLYPH)
+		code = '?';
+	return glyphs[code - FIRST_GLYPH];
+}
+
+auto Font::get_line_height() const -> int {
+	return line_height;
+}
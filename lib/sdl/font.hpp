@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+
+#include "texture.hpp"
+
+/// @brief Where a glyph is in a font's atlas, and how far it moves the pen.
+struct Glyph {
+	/// @brief The glyph's rect in the atlas, which spans the font's whole line height.
+	SDL_Rect source;
+
+	/// @brief How far the next glyph is drawn from this one, in pixels.
+	int advance;
+};
+
+/// @brief A font whose glyphs are rasterized once into a single atlas texture.
+///
+/// Only printable ASCII is rasterized, and other characters are drawn as `?`.
+/// Glyphs are rasterized in white, so text can be any color by tinting its vertices.
+class Font {
+   public:
+	/// @brief The first character in the atlas.
+	static constexpr unsigned char FIRST_GLYPH = ' ';
+
+	/// @brief The last character in the atlas.
+	static constexpr unsigned char LAST_GLYPH = '~';
+
+	/// @brief The number of characters in the atlas.
+	static constexpr size_t N_GLYPHS = LAST_GLYPH - FIRST_GLYPH + 1;
+
+	/// @brief Load a font and rasterize its glyphs.
+	/// @param path Path to a font file supported by SDL_ttf.
+	/// @param point_size The size to rasterize the glyphs at.
+	/// @param renderer The renderer to create the atlas with.
+	Font(const std::filesystem::path &path, int point_size, SDL_Renderer *renderer);
+
+	/// @internal
+	/// @brief Create a font from glyphs that were already rasterized.
+	/// @param atlas The texture that holds every glyph.
+	/// @param glyphs Every glyph, starting from `FIRST_GLYPH`.
+	/// @param line_height The distance between lines, in pixels.
+	Font(Texture atlas, const std::array<Glyph, N_GLYPHS> &glyphs, int line_height);
+
+	/// @brief Get the texture that holds every glyph.
+	/// @return The atlas.
+	auto get_atlas() const -> const Texture &;
+
+	/// @brief Get a character's glyph.
+	/// @param character The character.
+	/// @return The character's glyph, or the glyph for `?` if the atlas doesn't have it.
+	auto get_glyph(char character) const -> const Glyph &;
+
+	/// @brief Get the distance between lines.
+	/// @return The distance between lines, in pixels.
+	auto get_line_height() const -> int;
+
+   private:
+	Texture atlas;
+	std::array<Glyph, N_GLYPHS> glyphs{};
+	int line_height = 0;
+};
@@ -0,0 +1,99 @@
+#include "render_list.hpp"
+
+#include <SDL.h>
+
+#include <utility>
+
+auto RenderList::set_clear_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a) -> void {
+	clear_color = {r, g, b, a};
+}
+
+auto RenderList::render(const Texture &texture, const SDL_Rect *srcrect, const SDL_Rect *dstrect, double angle, SDL_RendererFlip flip) -> void {
+	keep_alive(texture);
+	commands.push_back({
+		.texture = *texture,
+		.srcrect = srcrect ? *srcrect : SDL_Rect{},
+		.dstrect = dstrect ? *dstrect : SDL_Rect{},
+		.angle = angle,
+		.flip = flip,
+		.has_srcrect = srcrect != nullptr,
+		.has_dstrect = dstrect != nullptr,
+		.is_geometry = false,
+		.first_vertex = 0,
+		.n_vertices = 0,
+		.first_index = 0,
+		.n_indices = 0,
+	});
+}
+
+auto RenderList::render_geometry(const Texture *texture, std::span<const SDL_Vertex> vertices, std::span<const int> indices) -> void {
+	if (texture)
+		keep_alive(*texture);
+
+	commands.push_back({
+		.texture = texture ? **texture : nullptr,
+		.srcrect = {},
+		.dstrect = {},
+		.angle = 0.0,
+		.flip = SDL_FLIP_NONE,
+		.has_srcrect = false,
+		.has_dstrect = false,
+		.is_geometry = true,
+		.first_vertex = this->vertices.size(),
+		.n_vertices = vertices.size(),
+		.first_index = this->indices.size(),
+		.n_indices = indices.size(),
+	});
+	this->vertices.insert(this->vertices.end(), vertices.begin(), vertices.end());
+	this->indices.insert(this->indices.end(), indices.begin(), indices.end());
+}
+
+auto RenderList::run(std::function<void(SDL_Renderer *)> task) -> void {
+	tasks.push_back(std::move(task));
+}
+
+auto RenderList::clear() -> void {
+	commands.clear();
+	textures.clear();
+	vertices.clear();
+	indices.clear();
+	tasks.clear();
+}
+
+auto RenderList::get_clear_color() const -> SDL_Color {
+	return clear_color;
+}
+
+auto RenderList::get_commands() const -> const std::vector<RenderCommand> & {
+	return commands;
+}
+
+auto RenderList::get_vertices() const -> const std::vector<SDL_Vertex> & {
+	return vertices;
+}
+
+auto RenderList::get_indices() const -> const std::vector<int> & {
+	return indices;
+}
+
+auto RenderList::get_tasks() const -> const std::vector<std::function<void(SDL_Renderer *)>> & {
+	return tasks;
+}
+
+auto RenderList::size() const -> size_t {
+	return commands.size();
+}
+
+auto RenderList::keep_alive(const Texture &texture) -> void {
+	// Draws are usually batched by texture, so only holding a reference when the texture changes is enough to keep them all alive
+	if (textures.empty() || *textures.back() != *texture)
+		textures.push_back(texture);
+}
+
+auto get_quad_indices(std::vector<int> &indices, size_t n_quads) -> std::span<const int> {
+	for (auto quad = static_cast<int>(indices.size() / 6); quad < static_cast<int>(n_quads); quad++) {
+		auto first = quad * 4;
+		indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+	}
+	return std::span{indices}.first(n_quads * 6);
+}
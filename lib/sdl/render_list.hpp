@@ -0,0 +1,126 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "texture.hpp"
+
+/// @brief A single texture copy recorded by a `RenderList`.
+struct RenderCommand {
+	/// @brief The texture to copy.
+	SDL_Texture *texture;
+
+	/// @brief The source rect to copy from, if `has_srcrect` is set.
+	SDL_Rect srcrect;
+
+	/// @brief The destination rect to copy to, if `has_dstrect` is set.
+	SDL_Rect dstrect;
+
+	/// @brief The angle to rotate dstrect by clockwise.
+	double angle;
+
+	/// @brief Which axes to flip dstrect around.
+	SDL_RendererFlip flip;
+
+	/// @brief Whether to copy from `srcrect` instead of the entire texture.
+	bool has_srcrect;
+
+	/// @brief Whether to copy to `dstrect` instead of the entire target.
+	bool has_dstrect;
+
+	/// @brief Whether to draw triangles from the list's vertices instead of copying the texture.
+	bool is_geometry;
+
+	/// @brief The range of the list's vertices that a geometry command draws.
+	size_t first_vertex, n_vertices;
+
+	/// @brief The range of the list's indices that a geometry command draws, relative to `first_vertex`.
+	size_t first_index, n_indices;
+};
+
+/// @brief A recorded frame of texture copies that can be replayed on a renderer later, possibly on another thread.
+///
+/// The list keeps every texture it references alive until it is cleared.
+class RenderList {
+   public:
+	/// @brief Set the color that the frame is cleared to.
+	auto set_clear_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 0xff) -> void;
+
+	/// @brief Record a texture copy.
+	/// @param texture The texture to copy.
+	/// @param srcrect The source rect to copy from, or nullptr for the entire texture (nullptr by default).
+	/// @param dstrect The destination rect to copy to, or nullptr for the entire target (nullptr by default).
+	/// @param angle The angle to rotate dstrect by clockwise (0.0 by default).
+	/// @param flip Which axes to flip dstrect around (none by default).
+	auto render(const Texture &texture, const SDL_Rect *srcrect = nullptr, const SDL_Rect *dstrect = nullptr, double angle = 0.0, SDL_RendererFlip flip = SDL_FLIP_NONE) -> void;
+
+	/// @brief Record a batch of triangles, drawn with a single `SDL_RenderGeometry` call.
+	/// @param texture The texture to sample, or nullptr to only use vertex colors.
+	/// @param vertices The vertices, which are copied into the list.
+	/// @param indices Three indices into `vertices` per triangle, which are copied into the list.
+	auto render_geometry(const Texture *texture, std::span<const SDL_Vertex> vertices, std::span<const int> indices) -> void;
+
+	/// @brief Record a function to call with the renderer before the frame is drawn.
+	///
+	/// This is how work that needs the renderer, like uploading textures, reaches the render thread.
+	///
+	/// @param task The function to call, on the thread that replays the list.
+	auto run(std::function<void(SDL_Renderer *)> task) -> void;
+
+	/// @brief Hold a reference to a texture until the list is cleared.
+	///
+	/// The list is cleared on the thread that replays it, after the frame is drawn,
+	/// so this is also how textures that earlier frames might still use are released safely.
+	///
+	/// @param texture The texture to keep alive.
+	auto keep_alive(const Texture &texture) -> void;
+
+	/// @brief Remove every recorded command and task, and release the referenced textures.
+	auto clear() -> void;
+
+	/// @brief Get the color that the frame is cleared to.
+	/// @return The clear color.
+	auto get_clear_color() const -> SDL_Color;
+
+	/// @brief Get the recorded commands.
+	/// @return The recorded commands, in the order they were recorded.
+	auto get_commands() const -> const std::vector<RenderCommand> &;
+
+	/// @brief Get the vertices of every recorded geometry command.
+	/// @return The vertices.
+	auto get_vertices() const -> const std::vector<SDL_Vertex> &;
+
+	/// @brief Get the indices of every recorded geometry command.
+	/// @return The indices.
+	auto get_indices() const -> const std::vector<int> &;
+
+	/// @brief Get the recorded tasks.
+	/// @return The recorded tasks, in the order they were recorded.
+	auto get_tasks() const -> const std::vector<std::function<void(SDL_Renderer *)>> &;
+
+	/// @brief Get the number of recorded commands.
+	/// @return The number of recorded commands.
+	auto size() const -> size_t;
+
+   private:
+	SDL_Color clear_color{0, 0, 0, 0xff};
+	std::vector<RenderCommand> commands{};
+	std::vector<Texture> textures{};
+	std::vector<SDL_Vertex> vertices{};
+	std::vector<int> indices{};
+	std::vector<std::function<void(SDL_Renderer *)>> tasks{};
+};
+
+/// @brief Get the indices that draw a run of quads as triangles.
+///
+/// Each quad is four consecutive vertices, drawn as two triangles. Every quad uses the same pattern of indices,
+/// so the buffer is kept between batches and only grows when a batch has more quads than any before it.
+///
+/// @param indices The buffer to extend.
+/// @param n_quads The number of quads to draw.
+/// @return The first `n_quads * 6` indices in the buffer.
+auto get_quad_indices(std::vector<int> &indices, size_t n_quads) -> std::span<const int>;
@@ -0,0 +1,29 @@
+#include "render_target.hpp"
+
+#include <SDL.h>
+
+#include "util.hpp"
+
+RenderTarget::RenderTarget(SDL_Renderer *renderer, int width, int height)
+	: texture{initialize_texture(renderer, width, height)} {
+	// Layers drawn into a render target usually have transparent gaps
+	check_error(SDL_SetTextureBlendMode(*texture, SDL_BLENDMODE_BLEND));
+}
+
+auto RenderTarget::get_texture() const -> const Texture & {
+	return texture;
+}
+
+auto RenderTarget::get_width() const -> int {
+	return texture.get_width();
+}
+
+auto RenderTarget::get_height() const -> int {
+	return texture.get_height();
+}
+
+auto RenderTarget::initialize_texture(SDL_Renderer *renderer, int width, int height) -> SDL_Texture * {
+	auto texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+	check_error(texture);
+	return texture;
+}
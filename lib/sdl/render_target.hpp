@@ -0,0 +1,35 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "texture.hpp"
+
+/// @brief A texture that can be rendered to, managed by SDL.
+///
+/// Anything drawn while a render target is bound with `Window::set_target` goes into its texture instead of the window,
+/// so static layers like backgrounds can be drawn once and then copied as a single texture every frame.
+class RenderTarget {
+   public:
+	/// @brief Create a transparent render target.
+	/// @param renderer The renderer to use.
+	/// @param width The width of the render target.
+	/// @param height The height of the render target.
+	RenderTarget(SDL_Renderer *renderer, int width, int height);
+
+	/// @brief Get the texture that this render target draws into.
+	/// @return The texture that this render target draws into.
+	auto get_texture() const -> const Texture &;
+
+	/// @brief Get the width of the render target.
+	/// @return The width of the render target.
+	auto get_width() const -> int;
+
+	/// @brief Get the height of the render target.
+	/// @return The height of the render target.
+	auto get_height() const -> int;
+
+   private:
+	Texture texture;
+
+	static auto initialize_texture(SDL_Renderer *renderer, int width, int height) -> SDL_Texture *;
+};
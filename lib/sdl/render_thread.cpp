@@ -0,0 +1,194 @@
+#include "render_thread.hpp"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "asset_pack.hpp"
+#include "font.hpp"
+#include "surface.hpp"
+#include "util.hpp"
+#include "window.hpp"
+
+RenderThread::RenderThread(Window &window, size_t n_buffers)
+	: window{window},
+	  buffers(std::max<size_t>(n_buffers, 2)),
+	  submit_times(buffers.size()),
+	  thread{[this] { run(); }} {
+	std::unique_lock lock{mutex};
+	for (size_t i = 0; i < buffers.size(); i++)
+		free_buffers.push_back(i);
+
+	// The thread has stopped by the time a failure is reported, so it can be joined as the constructor unwinds
+	buffer_freed.wait(lock, [this] { return started; });
+	if (start_exception)
+		std::rethrow_exception(start_exception);
+}
+
+RenderThread::~RenderThread() {
+	{
+		std::scoped_lock lock{mutex};
+		stopping = true;
+	}
+	buffer_ready.notify_one();
+	thread.join();
+}
+
+auto RenderThread::invoke(std::function<void(SDL_Renderer *)> task) -> void {
+	Task pending{std::move(task)};
+	{
+		std::scoped_lock lock{mutex};
+		tasks.push_back(&pending);
+	}
+	buffer_ready.notify_one();
+
+	std::unique_lock lock{mutex};
+	task_done.wait(lock, [&] { return pending.done; });
+	if (pending.exception)
+		std::rethrow_exception(pending.exception);
+}
+
+auto RenderThread::load_image(const std::filesystem::path &path) -> Texture {
+	return upload(Surface{path});
+}
+
+auto RenderThread::load_image(const AssetPack &pack, std::string_view name) -> Texture {
+	return upload(pack.load_surface(name));
+}
+
+auto RenderThread::load_font(const std::filesystem::path &path, int point_size) -> Font {
+	std::optional<Font> font{};
+	invoke([&](SDL_Renderer *renderer) { font.emplace(path, point_size, renderer); });
+	return std::move(*font);
+}
+
+auto RenderThread::begin_frame() -> RenderList & {
+	std::unique_lock lock{mutex};
+	buffer_freed.wait(lock, [this] { return !free_buffers.empty(); });
+
+	current = free_buffers.front();
+	free_buffers.pop_front();
+	return buffers[current];
+}
+
+auto RenderThread::submit() -> void {
+	{
+		std::scoped_lock lock{mutex};
+		submit_times[current] = Clock::now();
+		ready_buffers.push_back(current);
+	}
+	buffer_ready.notify_one();
+}
+
+auto RenderThread::flush() -> void {
+	std::unique_lock lock{mutex};
+	buffer_freed.wait(lock, [this] { return ready_buffers.empty() && !presenting; });
+}
+
+auto RenderThread::get_stats() -> RenderStats {
+	std::scoped_lock lock{mutex};
+	if (frames == 0) return {};
+
+	return {
+		.frames = frames,
+		.mean_latency_ms = total_latency_ms / frames,
+		.max_latency_ms = max_latency_ms,
+		.mean_present_ms = total_present_ms / frames,
+	};
+}
+
+auto RenderThread::upload(const Surface &image) -> Texture {
+	Texture texture{};
+	invoke([&](SDL_Renderer *renderer) {
+		auto created = SDL_CreateTextureFromSurface(renderer, *image);
+		check_error(created);
+		texture = Texture{created};
+	});
+	return texture;
+}
+
+auto RenderThread::run() -> void {
+	std::exception_ptr exception{};
+	try {
+		window.create_renderer();
+	} catch (...) {
+		exception = std::current_exception();
+	}
+
+	{
+		std::scoped_lock lock{mutex};
+		started = true;
+		start_exception = exception;
+	}
+	buffer_freed.notify_all();
+	if (exception) return;
+
+	std::vector<Task *> taken{};
+	while (true) {
+		size_t index;
+		{
+			std::unique_lock lock{mutex};
+			buffer_ready.wait(lock, [this] { return stopping || !ready_buffers.empty() || !tasks.empty(); });
+			if (!tasks.empty()) {
+				std::swap(taken, tasks);
+			} else if (!ready_buffers.empty()) {
+				index = ready_buffers.front();
+				ready_buffers.pop_front();
+				presenting = true;
+			} else {
+				break;
+			}
+		}
+
+		if (!taken.empty()) {
+			run_tasks(taken);
+			continue;
+		}
+
+		auto start = Clock::now();
+		window.render(buffers[index]);
+		window.present();
+		auto end = Clock::now();
+
+		// Textures are released here so that they are destroyed on the thread that uses the renderer
+		buffers[index].clear();
+
+		{
+			std::scoped_lock lock{mutex};
+			auto latency_ms = std::chrono::duration<double, std::milli>(end - submit_times[index]).count();
+			frames++;
+			total_latency_ms += latency_ms;
+			max_latency_ms = std::max(max_latency_ms, latency_ms);
+			total_present_ms += std::chrono::duration<double, std::milli>(end - start).count();
+
+			presenting = false;
+			free_buffers.push_back(index);
+		}
+		buffer_freed.notify_all();
+	}
+
+	// Frames that were begun but never submitted still hold textures, which must go before the renderer that made them
+	for (auto &buffer : buffers)
+		buffer.clear();
+	window.destroy_renderer();
+}
+
+auto RenderThread::run_tasks(std::vector<Task *> &taken) -> void {
+	for (auto task : taken) {
+		try {
+			task->function(window.get_renderer());
+		} catch (...) {
+			task->exception = std::current_exception();
+		}
+	}
+
+	{
+		std::scoped_lock lock{mutex};
+		for (auto task : taken)
+			task->done = true;
+	}
+	taken.clear();
+	task_done.notify_all();
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "render_list.hpp"
+#include "texture.hpp"
+
+class AssetPack;
+class Font;
+class Surface;
+class Window;
+
+/// @brief Timings collected by a `RenderThread`.
+struct RenderStats {
+	/// @brief The number of frames presented.
+	size_t frames = 0;
+
+	/// @brief The mean time from a frame being submitted to it being presented, in milliseconds.
+	double mean_latency_ms = 0.0;
+
+	/// @brief The longest time from a frame being submitted to it being presented, in milliseconds.
+	double max_latency_ms = 0.0;
+
+	/// @brief The mean time spent replaying and presenting a frame on the render thread, in milliseconds.
+	double mean_present_ms = 0.0;
+};
+
+/// @brief A thread that replays recorded frames on a window's renderer, so the simulation doesn't wait on presentation.
+///
+/// Frames are recorded into a ring of `RenderList` buffers.
+/// While the render thread presents one buffer, the caller records the next one into another,
+/// and `begin_frame` only blocks once every buffer is waiting to be presented.
+///
+/// SDL renderers must only be used on the thread that created them, so the render thread creates the window's renderer
+/// when it starts and destroys it when it stops, and is its only user in between.
+/// Textures are created on it with `load_image`, `load_font` or `invoke`, or by tasks recorded into a frame,
+/// and textures that are only referenced by submitted frames are released on it.
+/// Destroying the renderer destroys every texture it created, so they must all be destroyed before the render thread.
+class RenderThread {
+   public:
+	/// @brief Start the render thread, which creates the window's renderer.
+	/// @param window The window to present frames on, created with `render_thread` set in its options. It must outlive the render thread.
+	/// @param n_buffers The number of frames that can be recorded or in flight at once (2 by default, for double buffering).
+	/// @throw std::runtime_error Throws if the window already has a renderer, or if it can't be created.
+	explicit RenderThread(Window &window, size_t n_buffers = 2);
+
+	/// @brief Present every submitted frame, destroy the window's renderer and stop the render thread.
+	~RenderThread();
+
+	/// @brief Call a function with the renderer on the render thread, and wait for it to return.
+	///
+	/// This is for work that needs the renderer outside of a frame, like loading assets.
+	///
+	/// @param task The function to call.
+	/// @throw Rethrows any exception thrown by the function.
+	auto invoke(std::function<void(SDL_Renderer *)> task) -> void;
+
+	/// @brief Load an image into a texture.
+	///
+	/// The image is decoded on the calling thread, and only uploaded on the render thread.
+	///
+	/// @param path Path to the image.
+	/// @return A texture containing the image.
+	/// @throw std::runtime_error Throws if the image can't be loaded or uploaded.
+	auto load_image(const std::filesystem::path &path) -> Texture;
+
+	/// @brief Upload an image from an asset pack into a texture.
+	/// @param pack The pack to load from.
+	/// @param name The name of the image in the pack.
+	/// @return A texture containing the image.
+	/// @throw std::runtime_error Throws if the image isn't in the pack, or can't be uploaded.
+	auto load_image(const AssetPack &pack, std::string_view name) -> Texture;
+
+	/// @brief Load a font and rasterize its glyphs into an atlas on the render thread.
+	/// @param path Path to a font file supported by SDL_ttf.
+	/// @param point_size The size to rasterize the glyphs at.
+	/// @return The font.
+	/// @throw std::runtime_error Throws if the font can't be loaded.
+	auto load_font(const std::filesystem::path &path, int point_size) -> Font;
+
+	/// @brief Get an empty buffer to record the next frame into.
+	///
+	/// This blocks until the render thread has finished with a buffer.
+	///
+	/// @return The buffer for the next frame, which is valid until `submit` is called.
+	auto begin_frame() -> RenderList &;
+
+	/// @brief Hand the buffer from `begin_frame` to the render thread to be presented.
+	auto submit() -> void;
+
+	/// @brief Wait until every submitted frame has been presented.
+	auto flush() -> void;
+
+	/// @brief Get the timings of every frame presented so far.
+	/// @return The timings.
+	auto get_stats() -> RenderStats;
+
+	RenderThread(const RenderThread &) = delete;
+	RenderThread(RenderThread &&) = delete;
+	auto operator=(const RenderThread &) -> void = delete;
+
+   private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Task {
+		std::function<void(SDL_Renderer *)> function;
+		std::exception_ptr exception{};
+		bool done = false;
+	};
+
+	Window &window;
+	std::vector<RenderList> buffers;
+	std::vector<Clock::time_point> submit_times;
+	std::deque<size_t> free_buffers{};
+	std::deque<size_t> ready_buffers{};
+	size_t current = 0;
+	bool presenting = false;
+	bool stopping = false;
+
+	// Tasks live on the stack of the thread that called `invoke`, which waits for them
+	std::vector<Task *> tasks{};
+	bool started = false;
+	std::exception_ptr start_exception{};
+
+	std::mutex mutex{};
+	std::condition_variable buffer_ready{};
+	std::condition_variable buffer_freed{};
+	std::condition_variable task_done{};
+
+	size_t frames = 0;
+	double total_latency_ms = 0.0;
+	double max_latency_ms = 0.0;
+	double total_present_ms = 0.0;
+
+	std::jthread thread;
+
+	auto upload(const Surface &image) -> Texture;
+	auto run() -> void;
+	auto run_tasks(std::vector<Task *> &taken) -> void;
+};
@@ -0,0 +1,95 @@
+#include "surface.hpp"
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "util.hpp"
+
+Surface::Surface(int width, int height) : surface{initialize_surface(width, height), SDL_FreeSurface} {}
+
+Surface::Surface(const std::filesystem::path &path) : surface{initialize_surface(path), SDL_FreeSurface} {}
+
+auto Surface::operator*() const -> SDL_Surface * {
+	return surface.get();
+}
+
+auto Surface::operator->() const -> SDL_Surface * {
+	return **this;
+}
+
+auto Surface::get_width() const -> int {
+	return surface->w;
+}
+
+auto Surface::get_height() const -> int {
+	return surface->h;
+}
+
+auto Surface::get_pixel(int x, int y) const -> SDL_Color {
+	auto pixel = get_pixel_data(x, y);
+	return {pixel[0], pixel[1], pixel[2], pixel[3]};
+}
+
+auto Surface::set_pixel(int x, int y, SDL_Color color) -> void {
+	auto pixel = get_pixel_data(x, y);
+	pixel[0] = color.r;
+	pixel[1] = color.g;
+	pixel[2] = color.b;
+	pixel[3] = color.a;
+}
+
+auto Surface::save_png(const std::filesystem::path &path) const -> void {
+	check_error(IMG_SavePNG(surface.get(), path.c_str()), IMG_GetError);
+}
+
+auto Surface::diff(const Surface &other, int tolerance) const -> SurfaceDiff {
+	if (get_width() != other.get_width() || get_height() != other.get_height())
+		throw std::runtime_error{fmt::format("Cannot compare a {}x{} surface to a {}x{} surface.", get_width(), get_height(), other.get_width(), other.get_height())};
+
+	SurfaceDiff diff{};
+	for (auto y = 0; y < get_height(); y++) {
+		auto row = static_cast<const Uint8 *>(surface->pixels) + y * surface->pitch;
+		auto other_row = static_cast<const Uint8 *>(other->pixels) + y * other->pitch;
+
+		for (auto x = 0; x < get_width(); x++) {
+			auto pixel_difference = 0;
+			for (auto channel = x * 4; channel < x * 4 + 4; channel++)
+				pixel_difference = std::max(pixel_difference, std::abs(row[channel] - other_row[channel]));
+
+			diff.max_difference = std::max(diff.max_difference, pixel_difference);
+			if (pixel_difference > tolerance)
+				diff.differing_pixels++;
+		}
+	}
+
+	return diff;
+}
+
+auto Surface::get_pixel_data(int x, int y) const -> Uint8 * {
+	if (x < 0 || y < 0 || x >= get_width() || y >= get_height())
+		throw std::out_of_range{fmt::format("Pixel ({}, {}) is outside of a {}x{} surface.", x, y, get_width(), get_height())};
+
+	return static_cast<Uint8 *>(surface->pixels) + y * surface->pitch + x * 4;
+}
+
+auto Surface::initialize_surface(int width, int height) -> SDL_Surface * {
+	auto surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+	check_error(surface);
+	return surface;
+}
+
+auto Surface::initialize_surface(const std::filesystem::path &path) -> SDL_Surface * {
+	auto image = IMG_Load(path.c_str());
+	check_error(image, IMG_GetError);
+
+	// Images can be in any format, but pixels are always accessed as RGBA32
+	auto surface = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+	SDL_FreeSurface(image);
+	check_error(surface);
+	return surface;
+}
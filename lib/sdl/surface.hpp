@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+/// @brief How much two surfaces differ.
+struct SurfaceDiff {
+	/// @brief The number of pixels where any channel differs by more than the tolerance.
+	size_t differing_pixels = 0;
+
+	/// @brief The largest difference between two channels of the same pixel.
+	int max_difference = 0;
+};
+
+/// @brief An RGBA32 image in system memory, managed by SDL.
+///
+/// Surfaces are mainly used to read frames back from a renderer and compare them against golden images.
+class Surface {
+   public:
+	/// @brief Create a transparent black surface.
+	/// @param width The width of the surface.
+	/// @param height The height of the surface.
+	Surface(int width, int height);
+
+	/// @brief Load an image into a surface.
+	/// @param path Path to the image.
+	Surface(const std::filesystem::path &path);
+
+	/// @brief Get a pointer to the underlying `SDL_Surface`.
+	/// @return A pointer to the `SDL_Surface` that this `Surface` manages.
+	auto operator*() const -> SDL_Surface *;
+
+	/// @brief Get a pointer to the underlying `SDL_Surface`.
+	/// @return A pointer to the `SDL_Surface` that this `Surface` manages.
+	auto operator->() const -> SDL_Surface *;
+
+	/// @brief Get the width of the surface.
+	/// @return The width of the surface.
+	auto get_width() const -> int;
+
+	/// @brief Get the height of the surface.
+	/// @return The height of the surface.
+	auto get_height() const -> int;
+
+	/// @brief Get the color of a pixel.
+	/// @param x The x-coordinate of the pixel, from the left.
+	/// @param y The y-coordinate of the pixel, from the top.
+	/// @return The color of the pixel.
+	/// @throw std::out_of_range Throws if the pixel is outside the surface.
+	auto get_pixel(int x, int y) const -> SDL_Color;
+
+	/// @brief Set the color of a pixel.
+	/// @param x The x-coordinate of the pixel, from the left.
+	/// @param y The y-coordinate of the pixel, from the top.
+	/// @param color The new color of the pixel.
+	/// @throw std::out_of_range Throws if the pixel is outside the surface.
+	auto set_pixel(int x, int y, SDL_Color color) -> void;
+
+	/// @brief Save the surface as a PNG image.
+	/// @param path Path to save the image to.
+	auto save_png(const std::filesystem::path &path) const -> void;
+
+	/// @brief Compare every pixel against another surface.
+	/// @param other The surface to compare against, such as a golden image.
+	/// @param tolerance How much a channel may differ before its pixel counts as different (0 by default).
+	/// @return How much the surfaces differ.
+	/// @throw std::runtime_error Throws if the surfaces are different sizes.
+	auto diff(const Surface &other, int tolerance = 0) const -> SurfaceDiff;
+
+   private:
+	std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface;
+
+	auto get_pixel_data(int x, int y) const -> Uint8 *;
+
+	static auto initialize_surface(int width, int height) -> SDL_Surface *;
+	static auto initialize_surface(const std::filesystem::path &path) -> SDL_Surface *;
+};
@@ -0,0 +1,106 @@
+#include "text.hpp"
+
+#include <algorithm>
+#include <span>
+
+#include "font.hpp"
+#include "render_list.hpp"
+#include "window.hpp"
+
+TextRun::TextRun(const Font &font, SDL_Color color) : font{&font}, color{color} {}
+
+auto TextRun::set_text(std::string_view text) -> bool {
+	if (text == this->text) return false;
+
+	this->text = text;
+	layout();
+	return true;
+}
+
+auto TextRun::get_text() const -> const std::string & {
+	return text;
+}
+
+auto TextRun::set_position(float x, float y) -> void {
+	auto dx = x - this->x;
+	auto dy = y - this->y;
+	this->x = x;
+	this->y = y;
+
+	for (auto &vertex : vertices) {
+		vertex.position.x += dx;
+		vertex.position.y += dy;
+	}
+}
+
+auto TextRun::set_color(SDL_Color color) -> void {
+	this->color = color;
+	for (auto &vertex : vertices)
+		vertex.color = color;
+}
+
+auto TextRun::get_width() const -> int {
+	return width;
+}
+
+auto TextRun::get_height() const -> int {
+	return height;
+}
+
+auto TextRun::get_quad_count() const -> size_t {
+	return vertices.size() / 4;
+}
+
+auto TextRun::render(RenderList &list) const -> void {
+	if (vertices.empty()) return;
+	list.render_geometry(&font->get_atlas(), vertices, std::span{indices}.first(vertices.size() / 4 * 6));
+}
+
+auto TextRun::render(Window &window) const -> void {
+	if (vertices.empty()) return;
+	window.render_geometry(&font->get_atlas(), vertices, std::span{indices}.first(vertices.size() / 4 * 6));
+}
+
+auto TextRun::layout() -> void {
+	vertices.clear();
+
+	auto atlas_width = static_cast<float>(std::max(font->get_atlas().get_width(), 1));
+	auto atlas_height = static_cast<float>(std::max(font->get_atlas().get_height(), 1));
+	auto line_height = font->get_line_height();
+
+	int pen_x = 0, pen_y = 0;
+	width = 0;
+	height = text.empty() ? 0 : line_height;
+	for (auto character : text) {
+		if (character == '\n') {
+			pen_x = 0;
+			pen_y += line_height;
+			height += line_height;
+			continue;
+		}
+
+		auto &glyph = font->get_glyph(character);
+		auto &source = glyph.source;
+		if (source.w > 0 && source.h > 0 && character != ' ') {
+			auto left = x + static_cast<float>(pen_x);
+			auto top = y + static_cast<float>(pen_y);
+			auto right = left + static_cast<float>(source.w);
+			auto bottom = top + static_cast<float>(source.h);
+
+			auto u0 = static_cast<float>(source.x) / atlas_width;
+			auto v0 = static_cast<float>(source.y) / atlas_height;
+			auto u1 = static_cast<float>(source.x + source.w) / atlas_width;
+			auto v1 = static_cast<float>(source.y + source.h) / atlas_height;
+
+			vertices.push_back({{left, top}, color, {u0, v0}});
+			vertices.push_back({{right, top}, color, {u1, v0}});
+			vertices.push_back({{right, bottom}, color, {u1, v1}});
+			vertices.push_back({{left, bottom}, color, {u0, v1}});
+		}
+
+		pen_x += glyph.advance;
+		width = std::max(width, pen_x);
+	}
+
+	get_quad_indices(indices, vertices.size() / 4);
+}
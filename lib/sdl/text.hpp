@@ -0,0 +1,79 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Font;
+class RenderList;
+class Window;
+
+/// @brief A string laid out as a run of quads over a font's atlas, drawn as a single batch.
+///
+/// The layout is cached, so drawing the same text every frame only copies its vertices.
+/// Setting the text lays it out again only if the string actually changed,
+/// and moving or recoloring it only adjusts the cached vertices.
+///
+/// The font must outlive the run.
+class TextRun {
+   public:
+	/// @brief Create an empty run.
+	/// @param font The font to draw with.
+	/// @param color The color to draw with (white by default).
+	TextRun(const Font &font, SDL_Color color = {0xff, 0xff, 0xff, 0xff});
+
+	/// @brief Set the text, laying it out again if it changed.
+	///
+	/// `\n` starts a new line.
+	///
+	/// @param text The new text.
+	/// @return Whether the text changed.
+	auto set_text(std::string_view text) -> bool;
+
+	/// @brief Get the text.
+	/// @return The text.
+	auto get_text() const -> const std::string &;
+
+	/// @brief Set the position of the text.
+	/// @param x The left edge of the text, in pixels from the left of the target.
+	/// @param y The top edge of the text, in pixels from the top of the target.
+	auto set_position(float x, float y) -> void;
+
+	/// @brief Set the color of the text.
+	/// @param color The new color.
+	auto set_color(SDL_Color color) -> void;
+
+	/// @brief Get the width of the widest line.
+	/// @return The width, in pixels.
+	auto get_width() const -> int;
+
+	/// @brief Get the height of every line together.
+	/// @return The height, in pixels.
+	auto get_height() const -> int;
+
+	/// @brief Get the number of quads that the text is drawn with.
+	/// @return The number of quads, which doesn't include whitespace.
+	auto get_quad_count() const -> size_t;
+
+	/// @brief Record the text.
+	/// @param list The list to record to.
+	auto render(RenderList &list) const -> void;
+
+	/// @brief Draw the text.
+	/// @param window The window to draw to.
+	auto render(Window &window) const -> void;
+
+   private:
+	const Font *font;
+	std::string text{};
+	SDL_Color color;
+	float x = 0.0f, y = 0.0f;
+	int width = 0, height = 0;
+
+	std::vector<SDL_Vertex> vertices{};
+	std::vector<int> indices{};
+
+	auto layout() -> void;
+};
@@ -3,17 +3,20 @@
 #include <SDL.h>
 #include <SDL_image.h>
 
+#include <utility>
+
 #include "util.hpp"
 
-Texture::Texture() : texture{nullptr, SDL_DestroyTexture}, width{0}, height{0} {}
+Texture::Texture() : shared{std::make_shared<Shared>(Shared{{nullptr, SDL_DestroyTexture}, 0, 0})} {}
+
+Texture::Texture(const std::filesystem::path& path, SDL_Renderer* renderer) : Texture{initialize_texture(path, renderer)} {}
 
-Texture::Texture(const std::filesystem::path& path, SDL_Renderer* renderer)
-	: texture{initialize_texture(path, renderer), SDL_DestroyTexture} {
-	SDL_QueryTexture(**this, nullptr, nullptr, &width, &height);
+Texture::Texture(SDL_Texture* texture) : shared{std::make_shared<Shared>(Shared{{texture, SDL_DestroyTexture}, 0, 0})} {
+	SDL_QueryTexture(texture, nullptr, nullptr, &shared->width, &shared->height);
 }
 
 auto Texture::operator*() const -> SDL_Texture* {
-	return texture.get();
+	return shared->texture.get();
 }
 
 auto Texture::operator->() const -> SDL_Texture* {
@@ -21,11 +24,15 @@ auto Texture::operator->() const -> SDL_Texture* {
 }
 
 auto Texture::get_width() const -> int {
-	return width;
+	return shared->width;
 }
 
 auto Texture::get_height() const -> int {
-	return height;
+	return shared->height;
+}
+
+auto Texture::swap_texture(Texture& other) -> void {
+	std::swap(*shared, *other.shared);
 }
 
 auto Texture::initialize_texture(const std::filesystem::path& path, SDL_Renderer* renderer) -> SDL_Texture* {
@@ -17,6 +17,10 @@ class Texture {
 	/// @param renderer The renderer to use.
 	Texture(const std::filesystem::path &path, SDL_Renderer *renderer);
 
+	/// @brief Take ownership of an existing texture.
+	/// @param texture The texture to manage.
+	explicit Texture(SDL_Texture *texture);
+
 	/// @brief Get a pointer to the underlying `SDL_Texture`.
 	/// @return A pointer to the `SDL_Texture` that this `Texture` manages.
 	auto operator*() const -> SDL_Texture *;
@@ -33,9 +37,22 @@ class Texture {
 	/// @return The height of the texture.
 	auto get_height() const -> int;
 
+	/// @brief Swap the underlying `SDL_Texture` with another texture's.
+	///
+	/// Copies of a texture share their `SDL_Texture`, so every copy of this texture sees the other's image afterwards,
+	/// and every copy of the other texture sees this one's. This is how `TextureReloader` updates a texture
+	/// without touching the components that hold it.
+	///
+	/// @param other The texture to swap with.
+	auto swap_texture(Texture &other) -> void;
+
    private:
-	std::shared_ptr<SDL_Texture> texture;
-	int width, height;
+	struct Shared {
+		std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)> texture;
+		int width, height;
+	};
+
+	std::shared_ptr<Shared> shared;
 
 	static auto initialize_texture(const std::filesystem::path &path, SDL_Renderer *renderer) -> SDL_Texture *;
 };
\ No newline at end of file
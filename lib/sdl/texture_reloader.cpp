@@ -0,0 +1,150 @@
+#include "texture_reloader.hpp"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "render_list.hpp"
+#include "util.hpp"
+#include "window.hpp"
+
+TextureReloader::TextureReloader() : thread{[this] { run(); }} {}
+
+TextureReloader::~TextureReloader() {
+	{
+		std::scoped_lock lock{mutex};
+		stopping = true;
+	}
+	work_ready.notify_one();
+	thread.join();
+}
+
+auto TextureReloader::watch(const Texture &texture, const std::filesystem::path &path) -> void {
+	auto normalized = normalize(path);
+	watcher.watch(normalized.parent_path());
+	textures.insert_or_assign(normalized, texture);
+}
+
+auto TextureReloader::update(RenderList &list) -> size_t {
+	// Uploads recorded into earlier frames have run by the time they're marked done
+	size_t n_swapped = 0;
+	std::erase_if(uploads, [&](const std::shared_ptr<Upload> &upload) {
+		if (!upload->done.load(std::memory_order_acquire)) return false;
+
+		auto texture = textures.find(upload->path);
+		if (!*upload->texture || texture == textures.end()) {
+			std::scoped_lock lock{mutex};
+			n_failed++;
+			return true;
+		}
+
+		// The upload now owns the old texture, which the list releases after this frame is replayed
+		texture->second.swap_texture(upload->texture);
+		list.keep_alive(upload->texture);
+		n_swapped++;
+		return true;
+	});
+
+	request_decodes();
+
+	for (auto &[path, image] : take_decoded()) {
+		auto &upload = uploads.emplace_back(std::make_shared<Upload>(path, std::move(image)));
+		list.run([upload](SDL_Renderer *renderer) {
+			// A failed upload is counted on the next update, since nothing on this thread can report it
+			if (auto texture = SDL_CreateTextureFromSurface(renderer, *upload->image))
+				upload->texture = Texture{texture};
+			upload->done.store(true, std::memory_order_release);
+		});
+	}
+
+	n_reloaded += n_swapped;
+	return n_swapped;
+}
+
+auto TextureReloader::update(Window &window) -> size_t {
+	request_decodes();
+
+	size_t n_swapped = 0;
+	for (auto &[path, image] : take_decoded()) {
+		auto texture = textures.find(path);
+		auto created = SDL_CreateTextureFromSurface(window.get_renderer(), *image);
+		if (!created || texture == textures.end()) {
+			if (created)
+				SDL_DestroyTexture(created);
+			std::scoped_lock lock{mutex};
+			n_failed++;
+			continue;
+		}
+
+		// The old texture is destroyed at the end of this iteration
+		Texture replacement{created};
+		texture->second.swap_texture(replacement);
+		n_swapped++;
+	}
+
+	n_reloaded += n_swapped;
+	return n_swapped;
+}
+
+auto TextureReloader::get_stats() -> TextureReloadStats {
+	std::scoped_lock lock{mutex};
+	return {
+		.reloaded = n_reloaded,
+		.failed = n_failed,
+		.pending = queue.size() + n_decoding + decoded.size() + uploads.size(),
+	};
+}
+
+auto TextureReloader::request_decodes() -> void {
+	auto changed = watcher.poll();
+	if (changed.empty()) return;
+
+	{
+		std::scoped_lock lock{mutex};
+		for (auto &path : changed) {
+			auto normalized = normalize(path);
+			if (textures.contains(normalized) && std::ranges::find(queue, normalized) == queue.end())
+				queue.push_back(std::move(normalized));
+		}
+	}
+	work_ready.notify_one();
+}
+
+auto TextureReloader::take_decoded() -> std::vector<std::pair<std::filesystem::path, Surface>> {
+	std::vector<std::pair<std::filesystem::path, Surface>> taken{};
+	std::scoped_lock lock{mutex};
+	std::swap(taken, decoded);
+	return taken;
+}
+
+auto TextureReloader::run() -> void {
+	while (true) {
+		std::filesystem::path path;
+		{
+			std::unique_lock lock{mutex};
+			work_ready.wait(lock, [this] { return stopping || !queue.empty(); });
+			if (stopping) return;
+
+			path = std::move(queue.front());
+			queue.pop_front();
+			n_decoding++;
+		}
+
+		// Decoding is the slow part of a reload, so it's the only part done here
+		try {
+			Surface image{path};
+			std::scoped_lock lock{mutex};
+			decoded.emplace_back(std::move(path), std::move(image));
+			n_decoding--;
+		} catch (const std::runtime_error &) {
+			std::scoped_lock lock{mutex};
+			n_failed++;
+			n_decoding--;
+		}
+	}
+}
+
+auto TextureReloader::normalize(const std::filesystem::path &path) -> std::filesystem::path {
+	return std::filesystem::absolute(path).lexically_normal();
+}
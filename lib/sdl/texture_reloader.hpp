@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "surface.hpp"
+#include "texture.hpp"
+#include "util/file_watcher.hpp"
+
+class RenderList;
+class Window;
+
+/// @brief Counts kept by a `TextureReloader`.
+struct TextureReloadStats {
+	/// @brief The number of textures that were swapped for a new image.
+	size_t reloaded = 0;
+
+	/// @brief The number of changed files that couldn't be decoded or uploaded, which keep their old image.
+	size_t failed = 0;
+
+	/// @brief The number of changed files that are being decoded or uploaded.
+	size_t pending = 0;
+};
+
+/// @brief Reloads textures when their image files change, for iterating on assets while the game runs.
+///
+/// Changed files are decoded on a background thread, and the new image is uploaded by whichever thread replays
+/// the frame, so the frame loop never waits on a decode. Once uploaded, the new `SDL_Texture` is swapped into the
+/// watched `Texture`, so every copy of it, like the ones in components, draws the new image.
+class TextureReloader {
+   public:
+	/// @brief Start the decoding thread.
+	/// @throw std::runtime_error Throws if files can't be watched.
+	TextureReloader();
+
+	/// @brief Stop the decoding thread, dropping any reloads that haven't finished.
+	~TextureReloader();
+
+	/// @brief Reload a texture whenever its file changes.
+	///
+	/// Each file reloads one texture, so watching a file again replaces the texture it reloads.
+	///
+	/// @param texture The texture to reload.
+	/// @param path Path to the texture's image.
+	/// @throw std::runtime_error Throws if the image's directory can't be watched.
+	auto watch(const Texture &texture, const std::filesystem::path &path) -> void;
+
+	/// @brief Swap in every image that has been uploaded, and start reloading files that changed.
+	///
+	/// New images are uploaded by tasks recorded into the list, so they're swapped in on a later update,
+	/// after the list has been replayed. Replaced textures are kept alive by the list, so earlier frames that are
+	/// still in flight can draw them.
+	///
+	/// @param list The frame being recorded.
+	/// @return The number of textures that were swapped.
+	auto update(RenderList &list) -> size_t;
+
+	/// @brief Upload and swap in every decoded image, and start reloading files that changed.
+	///
+	/// This is for single-threaded loops that draw straight to a window.
+	///
+	/// @param window The window whose renderer the textures belong to.
+	/// @return The number of textures that were swapped.
+	auto update(Window &window) -> size_t;
+
+	/// @brief Get how many reloads finished, failed, or are still in progress.
+	/// @return The counts.
+	auto get_stats() -> TextureReloadStats;
+
+	TextureReloader(const TextureReloader &) = delete;
+	TextureReloader(TextureReloader &&) = delete;
+	auto operator=(const TextureReloader &) -> void = delete;
+
+   private:
+	struct Upload {
+		std::filesystem::path path;
+		Surface image;
+		Texture texture{};
+		std::atomic<bool> done = false;
+	};
+
+	FileWatcher watcher{};
+	std::map<std::filesystem::path, Texture> textures{};
+	std::vector<std::shared_ptr<Upload>> uploads{};
+	size_t n_reloaded = 0;
+
+	std::mutex mutex{};
+	std::condition_variable work_ready{};
+	std::deque<std::filesystem::path> queue{};
+	std::vector<std::pair<std::filesystem::path, Surface>> decoded{};
+	size_t n_decoding = 0;
+	size_t n_failed = 0;
+	bool stopping = false;
+
+	std::jthread thread;
+
+	auto request_decodes() -> void;
+	auto take_decoded() -> std::vector<std::pair<std::filesystem::path, Surface>>;
+	auto run() -> void;
+
+	static auto normalize(const std::filesystem::path &path) -> std::filesystem::path;
+};
@@ -24,4 +24,12 @@ struct WindowOptions {
 
 	/// @brief 0 or multiple `SDL_RendererFlags` OR'd together (SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC by default).
 	Uint32 renderer_flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+
+	/// @brief Whether to render into an offscreen surface with the software renderer instead of opening a window (false by default).
+	///
+	/// This works without a display or GPU, and `window_flags` and `renderer_flags` are ignored.
+	bool offscreen = false;
+
+	/// @brief Whether to leave creating the renderer to a `RenderThread`, which owns it from then on (false by default).
+	bool render_thread = false;
 };
@@ -2,15 +2,25 @@
 
 #include <SDL.h>
 
+#include <stdexcept>
+
+#include "asset_pack.hpp"
+#include "font.hpp"
+#include "render_list.hpp"
+#include "render_target.hpp"
+#include "surface.hpp"
 #include "texture.hpp"
 #include "util.hpp"
 
 Window::Window(const WindowOptions &window_options)
-	: window{initialize_window(window_options), SDL_DestroyWindow},
-	  renderer{initialize_renderer(window.get(), window_options.renderer_flags), SDL_DestroyRenderer} {}
+	: window{window_options.offscreen ? nullptr : initialize_window(window_options), SDL_DestroyWindow},
+	  surface{window_options.offscreen ? initialize_surface(window_options) : nullptr, SDL_FreeSurface},
+	  renderer_flags{window_options.renderer_flags},
+	  renderer{window_options.render_thread ? nullptr : initialize_renderer(window.get(), surface.get(), renderer_flags), SDL_DestroyRenderer} {}
 
 Window::~Window() {
-	SDL_QuitSubSystem(SDL_INIT_VIDEO);
+	if (window)
+		SDL_QuitSubSystem(SDL_INIT_VIDEO);
 }
 
 auto Window::operator*() const -> SDL_Window * {
@@ -25,10 +35,48 @@ auto Window::get_renderer() const -> SDL_Renderer * {
 	return renderer.get();
 }
 
+auto Window::create_renderer() -> void {
+	if (renderer)
+		throw std::runtime_error{"The window already has a renderer."};
+	renderer.reset(initialize_renderer(window.get(), surface.get(), renderer_flags));
+}
+
+auto Window::destroy_renderer() -> void {
+	renderer.reset();
+}
+
 auto Window::load_image(const std::filesystem::path &path) const -> Texture {
 	return Texture{path, renderer.get()};
 }
 
+auto Window::load_image(const AssetPack &pack, std::string_view name) const -> Texture {
+	return pack.load_texture(name, renderer.get());
+}
+
+auto Window::load_font(const std::filesystem::path &path, int point_size) const -> Font {
+	return Font{path, point_size, renderer.get()};
+}
+
+auto Window::create_render_target(int width, int height) const -> RenderTarget {
+	return RenderTarget{renderer.get(), width, height};
+}
+
+auto Window::set_target(const RenderTarget *target) -> void {
+	check_error(SDL_SetRenderTarget(get_renderer(), target ? *target->get_texture() : nullptr));
+}
+
+auto Window::capture() const -> Surface {
+	int width, height;
+	if (auto target = SDL_GetRenderTarget(get_renderer()))
+		check_error(SDL_QueryTexture(target, nullptr, nullptr, &width, &height));
+	else
+		check_error(SDL_GetRendererOutputSize(get_renderer(), &width, &height));
+
+	Surface surface{width, height};
+	check_error(SDL_RenderReadPixels(get_renderer(), nullptr, SDL_PIXELFORMAT_RGBA32, surface->pixels, surface->pitch));
+	return surface;
+}
+
 auto Window::set_clear_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a) -> void {
 	SDL_SetRenderDrawColor(get_renderer(), r, g, b, a);
 }
@@ -37,10 +85,44 @@ auto Window::clear() -> void {
 	SDL_RenderClear(get_renderer());
 }
 
-auto Window::render(Texture &texture, const SDL_Rect *srcrect, const SDL_Rect *dstrect, double angle, const SDL_Point *center, SDL_RendererFlip flip) -> void {
+auto Window::render(const Texture &texture, const SDL_Rect *srcrect, const SDL_Rect *dstrect, double angle, const SDL_Point *center, SDL_RendererFlip flip) -> void {
 	SDL_RenderCopyEx(get_renderer(), *texture, srcrect, dstrect, angle, center, flip);
 }
 
+auto Window::render_geometry(const Texture *texture, std::span<const SDL_Vertex> vertices, std::span<const int> indices) -> void {
+	auto sdl_texture = texture ? **texture : nullptr;
+	SDL_RenderGeometry(get_renderer(), sdl_texture, vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+}
+
+auto Window::render(const RenderList &list) -> void {
+	for (auto &task : list.get_tasks())
+		task(get_renderer());
+
+	auto color = list.get_clear_color();
+	set_clear_color(color.r, color.g, color.b, color.a);
+	clear();
+
+	auto &vertices = list.get_vertices();
+	auto &indices = list.get_indices();
+	for (auto &command : list.get_commands()) {
+		if (command.is_geometry) {
+			SDL_RenderGeometry(
+				get_renderer(),
+				command.texture,
+				vertices.data() + command.first_vertex,
+				static_cast<int>(command.n_vertices),
+				indices.data() + command.first_index,
+				static_cast<int>(command.n_indices)
+			);
+			continue;
+		}
+
+		auto srcrect = command.has_srcrect ? &command.srcrect : nullptr;
+		auto dstrect = command.has_dstrect ? &command.dstrect : nullptr;
+		SDL_RenderCopyEx(get_renderer(), command.texture, srcrect, dstrect, command.angle, nullptr, command.flip);
+	}
+}
+
 auto Window::present() -> void {
 	SDL_RenderPresent(get_renderer());
 }
@@ -53,8 +135,14 @@ auto Window::initialize_window(const WindowOptions &window_options) -> SDL_Windo
 	return window;
 }
 
-auto Window::initialize_renderer(SDL_Window *window, Uint32 flags) -> SDL_Renderer * {
-	auto renderer = SDL_CreateRenderer(window, -1, flags);
+auto Window::initialize_surface(const WindowOptions &window_options) -> SDL_Surface * {
+	auto surface = SDL_CreateRGBSurfaceWithFormat(0, window_options.w, window_options.h, 32, SDL_PIXELFORMAT_RGBA32);
+	check_error(surface);
+	return surface;
+}
+
+auto Window::initialize_renderer(SDL_Window *window, SDL_Surface *surface, Uint32 flags) -> SDL_Renderer * {
+	auto renderer = surface ? SDL_CreateSoftwareRenderer(surface) : SDL_CreateRenderer(window, -1, flags);
 	check_error(renderer);
 	return renderer;
 }
\ No newline at end of file
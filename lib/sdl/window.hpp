@@ -4,12 +4,23 @@
 
 #include <filesystem>
 #include <memory>
+#include <span>
+#include <string_view>
 
 #include "types.hpp"
 
+class AssetPack;
+class Font;
+class RenderList;
+class RenderTarget;
+class Surface;
 class Texture;
 
 /// @brief A window/renderer pair managed by SDL.
+///
+/// Offscreen windows replace the window with a surface that the software renderer draws into.
+/// SDL renderers must only be used on the thread that created them, so windows that a `RenderThread` draws to
+/// are created without one, and the render thread creates and destroys it.
 class Window {
    public:
 	/// @brief Window constructor.
@@ -19,22 +30,60 @@ class Window {
 	~Window();
 
 	/// @brief Get a pointer to the underlying `SDL_Window`.
-	/// @return A pointer to the `SDL_Window` that this `Window` manages.
+	/// @return A pointer to the `SDL_Window` that this `Window` manages, or nullptr if it is offscreen.
 	auto operator*() const -> SDL_Window *;
 
 	/// @brief Get a pointer to the underlying `SDL_Window`.
-	/// @return A pointer to the `SDL_Window` that this `Window` manages.
+	/// @return A pointer to the `SDL_Window` that this `Window` manages, or nullptr if it is offscreen.
 	auto operator->() const -> SDL_Window *;
 
 	/// @brief Get a pointer to the associated `SDL_Renderer`.
-	/// @return A pointer to the `SDL_Renderer` that this `Window` manages.
+	/// @return A pointer to the `SDL_Renderer` that this `Window` manages, or nullptr if it doesn't have one.
 	auto get_renderer() const -> SDL_Renderer *;
 
+	/// @brief Create the window's renderer on the calling thread, which is the only thread that may use it.
+	/// @throw std::runtime_error Throws if the window already has a renderer, or if it can't be created.
+	auto create_renderer() -> void;
+
+	/// @brief Destroy the window's renderer, if it has one.
+	///
+	/// This must be called on the thread that created the renderer, after every texture it created is destroyed.
+	auto destroy_renderer() -> void;
+
 	/// @brief Load an image into a texture.
 	/// @param path Path to the image.
 	/// @return A texture containing the image.
 	auto load_image(const std::filesystem::path &path) const -> Texture;
 
+	/// @brief Upload an image from an asset pack into a texture, without decoding it.
+	/// @param pack The pack to load from.
+	/// @param name The name of the image in the pack.
+	/// @return A texture containing the image.
+	auto load_image(const AssetPack &pack, std::string_view name) const -> Texture;
+
+	/// @brief Load a font and rasterize its glyphs into an atlas.
+	/// @param path Path to a font file supported by SDL_ttf.
+	/// @param point_size The size to rasterize the glyphs at.
+	/// @return The font.
+	auto load_font(const std::filesystem::path &path, int point_size) const -> Font;
+
+	/// @brief Create a texture that can be rendered to.
+	/// @param width The width of the render target.
+	/// @param height The height of the render target.
+	/// @return A transparent render target.
+	auto create_render_target(int width, int height) const -> RenderTarget;
+
+	/// @brief Redirect rendering into a render target.
+	/// @param target The render target to draw into, or nullptr for the window.
+	auto set_target(const RenderTarget *target) -> void;
+
+	/// @brief Read the pixels of the current render target back into system memory.
+	///
+	/// This is slow, and is meant for tests and screenshots.
+	///
+	/// @return A copy of the current render target, or of the window if no render target is set.
+	auto capture() const -> Surface;
+
 	/// @brief Set the clear color for the attached renderer.
 	auto set_clear_color(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 0xff) -> void;
 
@@ -48,15 +97,28 @@ class Window {
 	/// @param angle The angle to rotate dstrect by clockwise (0.0 by default).
 	/// @param center The center of rotation, or nullptr for the center of dstrect (nullptr by default).
 	/// @param flip Which axes to flip dstrect around (none by default).
-	auto render(Texture &texture, const SDL_Rect *srcrect = nullptr, const SDL_Rect *dstrect = nullptr, double angle = 0.0, const SDL_Point *center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE) -> void;
+	auto render(const Texture &texture, const SDL_Rect *srcrect = nullptr, const SDL_Rect *dstrect = nullptr, double angle = 0.0, const SDL_Point *center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE) -> void;
+
+	/// @brief Draw a batch of triangles with a single call.
+	/// @param texture The texture to sample, or nullptr to only use vertex colors.
+	/// @param vertices The vertices.
+	/// @param indices Three indices into `vertices` per triangle.
+	auto render_geometry(const Texture *texture, std::span<const SDL_Vertex> vertices, std::span<const int> indices) -> void;
+
+	/// @brief Run a recorded frame's tasks, then clear the attached renderer and replay the frame on it.
+	/// @param list The frame to replay.
+	auto render(const RenderList &list) -> void;
 
 	/// @brief Update the window and swap the buffers.
 	auto present() -> void;
 
    private:
 	std::unique_ptr<SDL_Window, decltype(&SDL_DestroyWindow)> window;
+	std::unique_ptr<SDL_Surface, decltype(&SDL_FreeSurface)> surface;
+	Uint32 renderer_flags;
 	std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)> renderer;
 
 	static auto initialize_window(const WindowOptions &window_options) -> SDL_Window *;
-	static auto initialize_renderer(SDL_Window *window, Uint32 flags) -> SDL_Renderer *;
+	static auto initialize_surface(const WindowOptions &window_options) -> SDL_Surface *;
+	static auto initialize_renderer(SDL_Window *window, SDL_Surface *surface, Uint32 flags) -> SDL_Renderer *;
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "file_watcher.hpp"
+
+#include <fmt/core.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher() : fd{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)} {
+	if (fd < 0)
+		throw std::runtime_error{"Couldn't start watching files."};
+}
+
+FileWatcher::~FileWatcher() {
+	close(fd);
+}
+
+auto FileWatcher::watch(const std::filesystem::path &directory) -> void {
+	// Editors either write files in place or write a temporary file and move it over the original
+	auto wd = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if (wd < 0)
+		throw std::runtime_error{fmt::format("Couldn't watch {}.", directory.string())};
+
+	// Watching the same directory again returns the same descriptor
+	directories[wd] = directory;
+}
+
+auto FileWatcher::poll() -> std::vector<std::filesystem::path> {
+	std::vector<std::filesystem::path> changed{};
+	alignas(inotify_event) char buffer[4096];
+
+	while (true) {
+		auto n_read = read(fd, buffer, sizeof(buffer));
+		if (n_read <= 0) break;
+
+		for (auto offset = 0; offset < n_read;) {
+			auto event = reinterpret_cast<const inotify_event *>(buffer + offset);
+			offset += static_cast<int>(sizeof(inotify_event) + event->len);
+
+			auto directory = directories.find(event->wd);
+			if (event->len == 0 || directory == directories.end()) continue;
+
+			auto path = directory->second / event->name;
+			if (std::ranges::find(changed, path) == changed.end())
+				changed.push_back(std::move(path));
+		}
+	}
+
+	return changed;
+}
+
+#else
+
+FileWatcher::FileWatcher() = default;
+
+FileWatcher::~FileWatcher() = default;
+
+auto FileWatcher::watch(const std::filesystem::path &directory) -> void {
+	if (!std::filesystem::is_directory(directory))
+		throw std::runtime_error{fmt::format("Couldn't watch {}.", directory.string())};
+
+	if (!directories.contains(directory))
+		directories[directory] = scan(directory);
+}
+
+auto FileWatcher::poll() -> std::vector<std::filesystem::path> {
+	std::vector<std::filesystem::path> changed{};
+	for (auto &[directory, times] : directories) {
+		auto current = scan(directory);
+		for (auto &[path, time] : current) {
+			auto previous = times.find(path);
+			if (previous == times.end() || previous->second != time)
+				changed.push_back(path);
+		}
+		times = std::move(current);
+	}
+
+	return changed;
+}
+
+auto FileWatcher::scan(const std::filesystem::path &directory) -> std::map<std::filesystem::path, std::filesystem::file_time_type> {
+	std::map<std::filesystem::path, std::filesystem::file_time_type> times{};
+	std::error_code error{};
+	for (auto &entry : std::filesystem::directory_iterator{directory, error})
+		if (entry.is_regular_file(error))
+			times[entry.path()] = entry.last_write_time(error);
+	return times;
+}
+
+#endif
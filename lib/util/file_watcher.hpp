@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <vector>
+
+/// @brief Reports files that were written in a set of directories.
+///
+/// On Linux, this reads inotify events, so polling is a single non-blocking read.
+/// Elsewhere, polling compares the modification time of every file in the watched directories.
+class FileWatcher {
+   public:
+	/// @brief Create a watcher that isn't watching anything yet.
+	/// @throw std::runtime_error Throws if inotify isn't available.
+	FileWatcher();
+
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher &) = delete;
+	FileWatcher(FileWatcher &&) = delete;
+	auto operator=(const FileWatcher &) -> void = delete;
+
+	/// @brief Start watching a directory, but not its subdirectories. Watching a directory twice does nothing.
+	/// @param directory Path to the directory.
+	/// @throw std::runtime_error Throws if the directory can't be watched.
+	auto watch(const std::filesystem::path &directory) -> void;
+
+	/// @brief Get the files that were written or moved into a watched directory since the last poll.
+	///
+	/// This never blocks.
+	///
+	/// @return The paths of the changed files, each listed once.
+	auto poll() -> std::vector<std::filesystem::path>;
+
+   private:
+#ifdef __linux__
+	int fd;
+	std::map<int, std::filesystem::path> directories{};
+#else
+	std::map<std::filesystem::path, std::map<std::filesystem::path, std::filesystem::file_time_type>> directories{};
+
+	static auto scan(const std::filesystem::path &directory) -> std::map<std::filesystem::path, std::filesystem::file_time_type>;
+#endif
+};
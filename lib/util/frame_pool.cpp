@@ -0,0 +1,59 @@
+#include "frame_pool.hpp"
+
+#include <algorithm>
+#include <new>
+
+auto FramePool::allocate(size_t size) -> void * {
+	// Allocations are only counted once they succeed, so a throwing allocator doesn't leave the count behind
+	if (size > MAX_POOLED_SIZE) {
+		auto pointer = ::operator new(size);
+		n_live++;
+		return pointer;
+	}
+
+	auto size_class = get_size_class(size);
+	auto &free_list = free_lists[size_class];
+	if (free_list) {
+		auto node = free_list;
+		free_list = node->next;
+		n_live++;
+		return node;
+	}
+
+	// Whatever is left of the old block is too small, and is wasted until the pool is destroyed
+	auto rounded = (size_class + 1) * SIZE_CLASS;
+	if (remaining < rounded) {
+		cursor = blocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(BLOCK_SIZE)).get();
+		remaining = BLOCK_SIZE;
+	}
+
+	auto pointer = cursor;
+	cursor += rounded;
+	remaining -= rounded;
+	n_live++;
+	return pointer;
+}
+
+auto FramePool::deallocate(void *pointer, size_t size) -> void {
+	n_live--;
+	if (size > MAX_POOLED_SIZE) {
+		::operator delete(pointer);
+		return;
+	}
+
+	auto &free_list = free_lists[get_size_class(size)];
+	free_list = new (pointer) FreeNode{free_list};
+}
+
+auto FramePool::get_live_count() const -> size_t {
+	return n_live;
+}
+
+auto FramePool::get_reserved_size() const -> size_t {
+	return blocks.size() * BLOCK_SIZE;
+}
+
+auto FramePool::get_size_class(size_t size) -> size_t {
+	// Empty allocations still need a unique address, so they take the smallest class
+	return (std::max<size_t>(size, 1) + SIZE_CLASS - 1) / SIZE_CLASS - 1;
+}
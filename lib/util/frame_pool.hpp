@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/// @brief A pool for small allocations that come and go often, like coroutine frames.
+///
+/// Memory is carved out of large blocks and sorted into size classes, so a freed allocation is reused by the next one of a similar size
+/// without going back to the system allocator. Blocks are only released when the pool is destroyed.
+/// Large allocations go straight to the system allocator.
+/// A pool isn't thread-safe, so it must only be used by one thread at a time, like whatever owns it.
+class FramePool {
+   public:
+	FramePool() = default;
+
+	/// @brief Allocate memory, aligned for any standard type.
+	/// @param size The number of bytes to allocate, where 0 is treated as 1.
+	/// @return The memory.
+	/// @throw std::bad_alloc Throws if the system allocator fails.
+	auto allocate(size_t size) -> void *;
+
+	/// @brief Free memory from `allocate`.
+	/// @param pointer The memory to free.
+	/// @param size The size that was passed to `allocate`.
+	auto deallocate(void *pointer, size_t size) -> void;
+
+	/// @brief Get the number of allocations that haven't been freed.
+	/// @return The number of allocations.
+	auto get_live_count() const -> size_t;
+
+	/// @brief Get the number of bytes reserved from the system for pooled allocations.
+	/// @return The number of bytes.
+	auto get_reserved_size() const -> size_t;
+
+	FramePool(const FramePool &) = delete;
+	FramePool(FramePool &&) = delete;
+	auto operator=(const FramePool &) -> void = delete;
+
+   private:
+	static constexpr size_t SIZE_CLASS = 64;
+	static constexpr size_t MAX_POOLED_SIZE = 4096;
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+	struct FreeNode {
+		FreeNode *next;
+	};
+
+	std::array<FreeNode *, MAX_POOLED_SIZE / SIZE_CLASS> free_lists{};
+	std::vector<std::unique_ptr<std::byte[]>> blocks{};
+	std::byte *cursor = nullptr;
+	size_t remaining = 0;
+	size_t n_live = 0;
+
+	static auto get_size_class(size_t size) -> size_t;
+};
@@ -0,0 +1,48 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <fmt/core.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <utility>
+
+MappedFile::MappedFile(const std::filesystem::path &path) {
+	auto fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::runtime_error{fmt::format("Couldn't open {} for mapping.", path.string())};
+
+	size = static_cast<size_t>(lseek(fd, 0, SEEK_END));
+	void *mapping = nullptr;
+	if (size > 0)
+		mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping keeps its own reference to the file
+	close(fd);
+	if (mapping == MAP_FAILED)
+		throw std::runtime_error{fmt::format("Couldn't map {} into memory.", path.string())};
+
+	// Start reading the whole file in the background, since it's usually read front to back right away
+	if (mapping)
+		madvise(mapping, size, MADV_WILLNEED);
+	data = static_cast<const std::byte *>(mapping);
+}
+
+MappedFile::~MappedFile() {
+	if (data)
+		munmap(const_cast<std::byte *>(data), size);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+	: data{std::exchange(other.data, nullptr)}, size{std::exchange(other.size, 0)} {}
+
+auto MappedFile::operator=(MappedFile &&other) noexcept -> MappedFile & {
+	std::swap(data, other.data);
+	std::swap(size, other.size);
+	return *this;
+}
+
+auto MappedFile::get_data() const -> std::span<const std::byte> {
+	return {data, size};
+}
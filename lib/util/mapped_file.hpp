@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+/// @brief A read-only file mapped into memory.
+///
+/// Pages are only read from disk when they're first touched, and stay in the OS's page cache,
+/// so reading a mapped file doesn't copy it into a buffer first.
+class MappedFile {
+   public:
+	/// @brief Map a file.
+	/// @param path Path to the file.
+	/// @throw std::runtime_error Throws if the file can't be opened or mapped.
+	explicit MappedFile(const std::filesystem::path &path);
+
+	~MappedFile();
+
+	MappedFile(MappedFile &&other) noexcept;
+	auto operator=(MappedFile &&other) noexcept -> MappedFile &;
+
+	MappedFile(const MappedFile &) = delete;
+	auto operator=(const MappedFile &) -> MappedFile & = delete;
+
+	/// @brief Get the contents of the file.
+	/// @return The mapped bytes, which stay valid until the file is unmapped.
+	auto get_data() const -> std::span<const std::byte>;
+
+   private:
+	const std::byte *data = nullptr;
+	size_t size = 0;
+};
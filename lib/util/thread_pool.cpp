@@ -0,0 +1,106 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+ThreadPool::ThreadPool(size_t n_threads) {
+	for (size_t i = 1; i < std::max<size_t>(n_threads, 1); i++)
+		workers.emplace_back([this, i] { run_worker(i); });
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::scoped_lock lock{mutex};
+		stopping = true;
+	}
+	job_ready.notify_all();
+	workers.clear();
+}
+
+auto ThreadPool::get_thread_count() const -> size_t {
+	return workers.size() + 1;
+}
+
+auto ThreadPool::parallel_for(size_t count, const std::function<void(size_t)> &f) -> void {
+	if (count == 0) return;
+
+	if (workers.empty() || count == 1) {
+		for (size_t i = 0; i < count; i++)
+			f(i);
+		return;
+	}
+
+	run_job(f, count, false);
+}
+
+auto ThreadPool::run_on_each(const std::function<void(size_t)> &f) -> void {
+	if (workers.empty()) {
+		f(0);
+		return;
+	}
+
+	run_job(f, get_thread_count(), true);
+}
+
+auto ThreadPool::run_job(const std::function<void(size_t)> &f, size_t count, bool on_each) -> void {
+	{
+		std::scoped_lock lock{mutex};
+		job = &f;
+		job_count = count;
+		next_index = 0;
+		this->on_each = on_each;
+		active_workers = workers.size();
+		generation++;
+	}
+	job_ready.notify_all();
+
+	run_part(0);
+
+	std::unique_lock lock{mutex};
+	job_done.wait(lock, [this] { return active_workers == 0; });
+	job = nullptr;
+	if (exception)
+		std::rethrow_exception(std::exchange(exception, nullptr));
+}
+
+auto ThreadPool::run_worker(size_t index) -> void {
+	size_t seen_generation = 0;
+
+	while (true) {
+		{
+			std::unique_lock lock{mutex};
+			job_ready.wait(lock, [&] { return stopping || generation != seen_generation; });
+			if (stopping) return;
+			seen_generation = generation;
+		}
+
+		run_part(index);
+
+		{
+			std::scoped_lock lock{mutex};
+			active_workers--;
+		}
+		job_done.notify_one();
+	}
+}
+
+auto ThreadPool::run_part(size_t index) -> void {
+	try {
+		if (on_each)
+			(*job)(index);
+		else
+			run_iterations();
+	} catch (...) {
+		// Skip the iterations nobody has started yet, the job is failing anyway
+		next_index = job_count;
+
+		std::scoped_lock lock{mutex};
+		if (!exception)
+			exception = std::current_exception();
+	}
+}
+
+auto ThreadPool::run_iterations() -> void {
+	for (auto i = next_index++; i < job_count; i = next_index++)
+		(*job)(i);
+}
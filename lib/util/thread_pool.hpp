@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief A fixed set of worker threads for running data-parallel loops.
+class ThreadPool {
+   public:
+	/// @brief Start the worker threads.
+	/// @param n_threads The total number of threads to run loops on, including the calling thread (all hardware threads by default).
+	explicit ThreadPool(size_t n_threads = std::thread::hardware_concurrency());
+
+	~ThreadPool();
+
+	/// @brief Get the number of threads that loops run on, including the calling thread.
+	/// @return The number of threads.
+	auto get_thread_count() const -> size_t;
+
+	/// @brief Call a function for every index in a range, spread across the pool.
+	///
+	/// The calling thread also runs iterations, and this only returns once every iteration is done.
+	/// Iterations may run in any order, so they must not depend on each other.
+	///
+	/// @param count The number of iterations.
+	/// @param f The function to call with each index in `[0, count)`.
+	/// @throw Rethrows the first exception thrown by `f`, once every thread has stopped running it.
+	/// Iterations that haven't started by then are skipped.
+	auto parallel_for(size_t count, const std::function<void(size_t)> &f) -> void;
+
+	/// @brief Call a function once on every thread in the pool, including the calling thread.
+	///
+	/// Each thread always gets the same index, so work can be assigned to specific threads for cache locality.
+	/// This only returns once every call is done.
+	///
+	/// @param f The function to call with the index of each thread, where the calling thread is 0.
+	/// @throw Rethrows the first exception thrown by `f`, once every thread has returned from it.
+	auto run_on_each(const std::function<void(size_t)> &f) -> void;
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool(ThreadPool &&) = delete;
+	auto operator=(const ThreadPool &) -> void = delete;
+
+   private:
+	std::vector<std::jthread> workers{};
+	std::mutex mutex{};
+	std::condition_variable job_ready{};
+	std::condition_variable job_done{};
+
+	const std::function<void(size_t)> *job = nullptr;
+	size_t job_count = 0;
+	size_t generation = 0;
+	std::atomic<size_t> next_index = 0;
+	size_t active_workers = 0;
+	bool on_each = false;
+	bool stopping = false;
+	std::exception_ptr exception{};
+
+	auto run_worker(size_t index) -> void;
+	auto run_job(const std::function<void(size_t)> &f, size_t count, bool on_each) -> void;
+	auto run_part(size_t index) -> void;
+	auto run_iterations() -> void;
+};
@@ -1,7 +1,14 @@
 #include <SDL.h>
+#include <fmt/core.h>
 
 #include <cege.hpp>
-#include <cmath>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 constexpr auto WINDOW_TITLE = "Hello, SDL!";
 constexpr auto WINDOW_WIDTH = 640;
@@ -11,222 +18,290 @@ constexpr WindowOptions WINDOW_OPTIONS{WINDOW_TITLE, SDL_WINDOWPOS_CENTERED, SDL
 
 constexpr auto FIXED_TIMESTEP_MS = 1000 / 60;  // 60fps -> 1000 ms per 60 frames
 
-struct Vector2 {
-	float x, y;
-
-	auto operator+(const Vector2 &other) const -> Vector2 {
-		return Vector2{
-			x + other.x,
-			y + other.y,
-		};
-	}
-
-	auto operator-(const Vector2 &other) const -> Vector2 {
-		return Vector2{
-			x - other.x,
-			y - other.y,
-		};
-	}
-
-	auto operator*(float scalar) const -> Vector2 {
-		return Vector2{
-			x * scalar,
-			y * scalar,
-		};
-	}
-
-	auto operator+=(const Vector2 &other) -> Vector2 & {
-		x += other.x;
-		y += other.y;
-		return *this;
-	}
-
-	auto operator-=(const Vector2 &other) -> Vector2 & {
-		x -= other.x;
-		y -= other.y;
-		return *this;
-	}
-
-	auto operator*=(float scalar) -> Vector2 & {
-		x *= scalar;
-		y *= scalar;
-		return *this;
-	}
-
-	auto normalize() -> Vector2 & {
-		auto length = std::sqrt(x * x + y * y);
-		x /= length;
-		y /= length;
-		return *this;
-	}
-};
-
-struct Transform {
-	Vector2 position{0.0f, 0.0f};
-	Vector2 scale{100.0f, 100.0f};
-};
-
 struct Player {
 	float speed = 200.0f;
 	float scale_rate = 0.5f;
 	float angular_velocity = 90.0f;
 };
 
-struct Collider {
-	bool stationary = false;
-};
-
 class RenderSystem : public System {
    public:
-	auto render(Window &window) -> void {
-		window.set_clear_color(0xaa, 0xaa, 0xaa);
-		window.clear();
-
-		for (auto &entity : entities) {
-			auto &texture = entity->get_component_raw<Texture>();
-			auto &transform = entity->get_component_raw<Transform>();
-
-			SDL_Rect dstrect{
-				.x = static_cast<int>(transform.position.x),
-				.y = static_cast<int>(WINDOW_HEIGHT - transform.position.y - transform.scale.y),
-				.w = static_cast<int>(transform.scale.x),
-				.h = static_cast<int>(transform.scale.y),
-			};
-
-			window.render(texture, nullptr, &dstrect, 0.0, nullptr);
+	auto render(RenderList &list, Scene &scene) -> void {
+		auto &camera = scene.resource(camera_ref);
+		auto &animations = scene.resource(animations_ref);
+		list.set_clear_color(0xaa, 0xaa, 0xaa);
+
+		// Only visit entities that the camera can see
+		sprites.update(scene);
+		visible.clear();
+		sprites.query(camera.get_bounds(), visible);
+
+		for (auto id : visible) {
+			auto entity = scene.get_entity(id);
+			if (!entities.contains(entity)) continue;
+
+			auto &texture = entity->read_component<Texture>();
+			auto &transform = entity->read_component<GlobalTransform>();
+			auto dstrect = camera.to_screen(transform);
+
+			// Animated sprites only copy their current frame from the sprite sheet
+			const SDL_Rect *srcrect = nullptr;
+			if (entity->has_component<SpriteAnimation>())
+				srcrect = &animations.get_frame(entity->read_component<SpriteAnimation>().frame);
+
+			list.render(texture, srcrect, &dstrect, transform.rotation);
 		}
-
-		window.present();
 	}
+
+   private:
+	ResourceRef<Camera> camera_ref{};
+	ResourceRef<AnimationLibrary> animations_ref{};
+	SpatialIndex sprites{};
+	std::vector<EntityId> visible{};
 };
 
 class PlayerSystem : public System {
    public:
-	auto move(float delta) -> void {
+	auto move(Scene &scene) -> void {
+		auto &input = scene.resource(input_ref);
+
 		for (auto &entity : entities) {
-			auto &transform = entity->get_component_raw<Transform>();
+			auto &velocity = entity->get_component_raw<Velocity>();
 			auto &player = entity->get_component_raw<Player>();
 
-			const auto keyboard_states = SDL_GetKeyboardState(nullptr);
-
-			if (keyboard_states[SDL_SCANCODE_W])
-				transform.position.y += player.speed * delta;
-			if (keyboard_states[SDL_SCANCODE_A])
-				transform.position.x -= player.speed * delta;
-			if (keyboard_states[SDL_SCANCODE_S])
-				transform.position.y -= player.speed * delta;
-			if (keyboard_states[SDL_SCANCODE_D])
-				transform.position.x += player.speed * delta;
+			velocity.linear = {0.0f, 0.0f};
+			if (input.is_down(SDL_SCANCODE_W))
+				velocity.linear.y += player.speed;
+			if (input.is_down(SDL_SCANCODE_A))
+				velocity.linear.x -= player.speed;
+			if (input.is_down(SDL_SCANCODE_S))
+				velocity.linear.y -= player.speed;
+			if (input.is_down(SDL_SCANCODE_D))
+				velocity.linear.x += player.speed;
 		}
 	}
-};
 
-class CollisionSystem : public System {
-   public:
-	auto update() {
-		for (auto &entity : entities) {
-			auto &transform = entity->get_component_raw<Transform>();
-			auto &collider = entity->get_component_raw<Collider>();
-
-			auto left = transform.position.x;
-			auto right = transform.position.x + transform.scale.x;
-			auto top = transform.position.y + transform.scale.y;
-			auto bottom = transform.position.y;
-			Vector2 center{(left + right) / 2.0f, (top + bottom) / 2.0f};
-
-			// Walls
-			if (left < 0) {
-				transform.position.x = 0;
-			}
-			if (right > WINDOW_WIDTH) {
-				transform.position.x = WINDOW_WIDTH - transform.scale.x;
-			}
-			if (bottom < 0) {
-				transform.position.y = 0;
-			}
-			if (top > WINDOW_HEIGHT) {
-				transform.position.y = WINDOW_HEIGHT - transform.scale.y;
-			}
+   private:
+	ResourceRef<InputState> input_ref{};
+};
 
-			// Other entities
-			for (auto &other : entities) {
-				if (entity->get_id() == other->get_id()) continue;
-
-				auto &other_transform = other->get_component_raw<Transform>();
-				auto &other_collider = other->get_component_raw<Collider>();
-				auto other_left = other_transform.position.x;
-				auto other_right = other_transform.position.x + other_transform.scale.x;
-				auto other_top = other_transform.position.y + other_transform.scale.y;
-				auto other_bottom = other_transform.position.y;
-				Vector2 other_center{(other_left + other_right) / 2.0f, (other_top + other_bottom) / 2.0f};
-
-				if (top <= other_bottom || bottom >= other_top || right <= other_left || left >= other_right) continue;
-
-				// Points from other to this
-				auto normal_vector = (other_center - center).normalize();
-				constexpr auto NUDGE_STRENGTH = 1.0f;
-				if (!collider.stationary)
-					transform.position -= normal_vector * NUDGE_STRENGTH;
-				if (!other_collider.stationary)
-					other_transform.position += normal_vector * NUDGE_STRENGTH;
-			}
-		}
+int main(int argc, char *argv[]) {
+	// `--record <path>` logs every frame's input and timestep, and `--replay <path>` plays a log back headlessly, as fast as possible
+	// `--font <path>` shows a HUD with each system's timings, and `--pack <path>` loads images from a pack written by cege_pack
+	std::optional<InputRecorder> recorder{};
+	std::optional<InputReplay> replay{};
+	std::optional<std::filesystem::path> font_path{};
+	std::optional<AssetPack> pack{};
+	for (auto i = 1; i + 1 < argc; i += 2) {
+		std::string_view flag{argv[i]};
+		if (flag == "--record")
+			recorder.emplace(argv[i + 1]);
+		else if (flag == "--replay")
+			replay.emplace(argv[i + 1]);
+		else if (flag == "--font")
+			font_path.emplace(argv[i + 1]);
+		else if (flag == "--pack")
+			pack.emplace(argv[i + 1]);
 	}
-};
 
-int main() {
-	Context ctx{WINDOW_OPTIONS};
-	auto &window = ctx.get_window();
-	auto scene = ctx.create_scene();
+	auto window_options = WINDOW_OPTIONS;
+	window_options.offscreen = replay.has_value();
+	window_options.render_thread = true;
+
+	// The render thread owns the renderer, so it's created before, and destroyed after, anything that holds a texture
+	// Textures must also be destroyed on the render thread, so everything holding one is released there at the end
+	Context ctx{window_options};
+	RenderThread render_thread{ctx.get_window()};
+	std::optional<Scene> scene_storage{ctx.create_scene()};
+	auto &scene = *scene_storage;
+
+	// Loose images are reloaded whenever they're saved, unless a recording is being replayed
+	std::optional<TextureReloader> reloader{};
+	if (!pack && !replay)
+		reloader.emplace();
+
+	auto load_image = [&](const std::filesystem::path &path) {
+		if (pack) return render_thread.load_image(*pack, path.generic_string());
+
+		auto texture = render_thread.load_image(path);
+		if (reloader)
+			reloader->watch(texture, path);
+		return texture;
+	};
 
 	// Systems
-	auto &render_system = scene.create_system<RenderSystem, Transform, Texture>();
-	auto &player_system = scene.create_system<PlayerSystem, Transform, Player>();
-	auto &collision_system = scene.create_system<CollisionSystem, Transform, Collider>();
+	auto &render_system = scene.create_system<RenderSystem, GlobalTransform, Texture>();
+	auto &animation_system = scene.create_system<SpriteAnimationSystem, SpriteAnimation>();
+	auto &particle_system = scene.create_system<ParticleSystem, GlobalTransform, ParticleEmitter>();
+	auto &transform_propagation = scene.create_system<TransformPropagation, Transform, GlobalTransform>();
+	auto &player_system = scene.create_system<PlayerSystem, Velocity, Player>();
+	auto &physics = scene.create_system<PhysicsSystem, Transform, RigidBody, Velocity>();
+
+	scene.set_system_resources<RenderSystem, Read<Camera>, Read<AnimationLibrary>>();
+	scene.set_system_resources<SpriteAnimationSystem, Read<AnimationLibrary>>();
+	scene.set_system_resources<ParticleSystem, Read<Camera>>();
+	scene.set_system_resources<PlayerSystem, Read<InputState>>();
+
+	// Top-down, so nothing falls
+	PhysicsSettings physics_settings{};
+	physics_settings.gravity = {0.0f, 0.0f};
+	physics_settings.timestep = FIXED_TIMESTEP_MS / 1000.0f;
+	physics.set_settings(physics_settings);
+
+	// Resources
+	auto &camera = scene.create_resource<Camera>(Vector2{0.0f, 0.0f}, Vector2{WINDOW_WIDTH, WINDOW_HEIGHT});
+	scene.create_resource<AnimationLibrary>();
+	auto &input = scene.create_resource<InputState>();
+	auto &delta_time = scene.create_resource<DeltaTime>();
+
+	// Prefabs are read from a file, so they can be tweaked without recompiling
+	PrefabLoader prefab_loader{};
+	prefab_loader.register_component<Player>("Player", [](const PrefabFields &fields) {
+		Player defaults{};
+		return Player{
+			fields.get_float("speed", defaults.speed),
+			fields.get_float("scale_rate", defaults.scale_rate),
+			fields.get_float("angular_velocity", defaults.angular_velocity),
+		};
+	});
+	auto prefabs = prefab_loader.load("assets/prefabs.txt");
 
 	// Entities
-	auto rick = scene.create_entity();
-	rick->create_component<Transform>();
-	rick->create_component<Texture>(window.load_image("assets/rick_astley.png"));
-	rick->create_component<Player>();
-	rick->create_component<Collider>();
+	auto rick_prefab = prefabs.at("rick");
+	rick_prefab.set(load_image("assets/rick_astley.png"));
+	auto rick = scene.instantiate(rick_prefab);
 
 	auto ball = scene.create_entity();
 	auto &ball_transform = ball->create_component<Transform>();
 	ball_transform.position = {300.0f, 300.0f};
-	ball->create_component<Texture>(window.load_image("assets/ball.jpg"));
-	ball->create_component<Collider>();
-
-	SDL_Event e;
+	ball->create_component<GlobalTransform>();
+	ball->create_component<Texture>(load_image("assets/ball.jpg"));
+	ball->create_component<RigidBody>(1.0f, 0.8f);
+	ball->create_component<Velocity>();
+
+	// The ball leaves a trail of sparks
+	auto &sparks = ball->create_component<ParticleEmitter>();
+	sparks.settings = {.rate = 60.0f, .lifetime = 0.6f, .velocity = {0.0f, 0.0f}, .velocity_spread = {40.0f, 40.0f}, .size = 6.0f, .color = {0xff, 0xd0, 0x40, 0xff}};
+	sparks.offset = ball_transform.scale * 0.5f;
+
+	// Static bodies just outside the screen's edges keep everything on screen
+	constexpr auto WALL_THICKNESS = 100.0f;
+	auto walls = scene.instantiate(prefabs.at("wall"), 4);
+	auto place_wall = [&](size_t i, Vector2 position, Vector2 size) {
+		auto &transform = walls[i]->get_component_raw<Transform>();
+		transform.position = position;
+		transform.scale = size;
+	};
+	place_wall(0, camera.position - Vector2{WALL_THICKNESS, WALL_THICKNESS}, {WALL_THICKNESS, camera.size.y + WALL_THICKNESS * 2.0f});
+	place_wall(1, {camera.position.x + camera.size.x, camera.position.y - WALL_THICKNESS}, {WALL_THICKNESS, camera.size.y + WALL_THICKNESS * 2.0f});
+	place_wall(2, {camera.position.x, camera.position.y - WALL_THICKNESS}, {camera.size.x, WALL_THICKNESS});
+	place_wall(3, {camera.position.x, camera.position.y + camera.size.y}, {camera.size.x, WALL_THICKNESS});
+
+	std::optional<Font> font{};
+	if (font_path)
+		font.emplace(render_thread.load_font(*font_path, 14));
+
+	EventQueue events{};
 	bool quit = false;
 
+	// The simulation only advances by recorded timesteps, so replays take the same steps as the original run
+	Uint64 clock = 0;
+	auto prev_fixed = clock;
 	auto prev = SDL_GetTicks64();
-	auto prev_fixed = prev;
+
+	std::map<std::string_view, double> timings_ms{};
+	auto timed = [&](std::string_view name, auto &&f) {
+		auto start = std::chrono::steady_clock::now();
+		f();
+		timings_ms[name] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	// The HUD shows averages that are refreshed twice a second, so most frames only redraw cached text
+	constexpr auto HUD_REFRESH_FRAMES = 30;
+	std::map<std::string_view, TextRun> hud{};
+	auto hud_baseline_ms = timings_ms;
+	auto hud_frames = 0;
 
 	while (quit == false) {
 		// Events
-		while (SDL_PollEvent(&e)) {
-			if (e.type == SDL_QUIT) quit = true;
+		InputFrame frame{};
+		if (replay) {
+			auto next = replay->next();
+			if (!next) break;
+			frame = *next;
+		} else {
+			events.poll();
+			if (events.quit_requested()) quit = true;
+
+			auto now = SDL_GetTicks64();
+			frame = {events.get_input(), static_cast<Uint32>(now - prev)};
+			prev = now;
 		}
 
-		auto now = SDL_GetTicks64();
+		if (recorder) recorder->record(frame);
+		clock += frame.delta_ms;
+
+		input = frame.input;
+		delta_time.seconds = frame.delta_ms / 1000.0f;
+		timed("player", [&] { player_system.move(scene); });
 
 		// Fixed loop
-		while (now - prev_fixed >= FIXED_TIMESTEP_MS) {
-			// Fixed update
-			// fixed_update_system.update();
+		while (clock - prev_fixed >= FIXED_TIMESTEP_MS) {
+			timed("physics", [&] { physics.step(scene); });
 			prev_fixed += FIXED_TIMESTEP_MS;
 		}
 
 		// Variable loop/update
-		auto delta = now - prev;
-		prev = now;
-		auto delta_s = delta / 1000.0f;
-		// update_system.update(delta_s);
-		player_system.move(delta_s);
-		collision_system.update();
+		// update_system.update(scene);
+		timed("animation", [&] { animation_system.update(scene, delta_time.seconds); });
+		timed("particles", [&] { particle_system.update(scene, delta_time.seconds); });
+		timed("transform propagation", [&] { transform_propagation.update(scene); });
+
+		if (font && ++hud_frames == HUD_REFRESH_FRAMES) {
+			auto y = 8.0f;
+			for (auto &[name, ms] : timings_ms) {
+				auto &line = hud.try_emplace(name, *font).first->second;
+				line.set_text(fmt::format("{:<24}{:>8.3f} ms", name, (ms - hud_baseline_ms[name]) / hud_frames));
+				line.set_position(8.0f, y);
+				y += static_cast<float>(font->get_line_height());
+			}
+			hud_baseline_ms = timings_ms;
+			hud_frames = 0;
+		}
 
 		// Render
-		render_system.render(window);
+		// Presenting this frame overlaps with simulating the next one
+		timed("render", [&] {
+			auto &list = render_thread.begin_frame();
+			if (reloader)
+				reloader->update(list);
+			render_system.render(list, scene);
+			particle_system.render(list, scene);
+			for (auto &[name, line] : hud)
+				line.render(list);
+			render_thread.submit();
+		});
+
+		scene.advance_tick();
 	}
-}
\ No newline at end of file
+
+	if (replay) {
+		fmt::print("replayed {} frames\n", replay->get_frame_count());
+		for (auto &[name, ms] : timings_ms)
+			fmt::print("{:>24} {:>10.3f} ms total {:>10.4f} ms/frame\n", name, ms, ms / replay->get_frame_count());
+	}
+
+	// Entity handles point into the scene, so they go before it
+	render_thread.flush();
+	render_thread.invoke([&](SDL_Renderer *) {
+		hud.clear();
+		font.reset();
+		reloader.reset();
+		rick.reset();
+		ball.reset();
+		walls.clear();
+		rick_prefab = {};
+		prefabs.clear();
+		scene_storage.reset();
+	});
+}
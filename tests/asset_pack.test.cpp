@@ -0,0 +1,105 @@
+#include "sdl/asset_pack.hpp"
+
+#include <doctest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "context.hpp"
+#include "sdl/surface.hpp"
+#include "sdl/texture.hpp"
+#include "sdl/window.hpp"
+#include "test_types.hpp"
+
+static auto create_image(int width, int height, Uint8 seed) -> Surface {
+	Surface image{width, height};
+	for (auto y = 0; y < height; y++)
+		for (auto x = 0; x < width; x++)
+			image.set_pixel(x, y, {static_cast<Uint8>(x * 16), static_cast<Uint8>(y * 16), seed, 0xff});
+	return image;
+}
+
+TEST_CASE("asset packs work") {
+	auto path = std::filesystem::temp_directory_path() / "cege_assets.pack";
+
+	AssetPackWriter writer{};
+	writer.add_image("sprites/b.png", create_image(5, 3, 0x20));
+	writer.add_image("sprites/a.png", create_image(4, 4, 0x10));
+	writer.add_image("sprites/b.png", create_image(3, 2, 0x30));
+	CHECK(writer.size() == 2);
+	writer.write(path);
+
+	SUBCASE("images are indexed by name") {
+		AssetPack pack{path};
+		CHECK(pack.size() == 2);
+		CHECK(pack.contains("sprites/a.png"));
+		CHECK(!pack.contains("sprites/c.png"));
+		CHECK(pack.get_names() == std::vector<std::string_view>{"sprites/a.png", "sprites/b.png"});
+		CHECK_THROWS_AS(pack.load_surface("sprites/c.png"), std::runtime_error);
+	}
+
+	SUBCASE("images keep their pixels") {
+		AssetPack pack{path};
+		auto image = pack.load_surface("sprites/b.png");
+		CHECK(image.get_width() == 3);
+		CHECK(image.get_height() == 2);
+		CHECK(image.diff(create_image(3, 2, 0x30)).differing_pixels == 0);
+	}
+
+	SUBCASE("images are uploaded to textures") {
+		auto ctx = Context{TEST_OFFSCREEN_OPTIONS};
+		auto &window = ctx.get_window();
+		AssetPack pack{path};
+
+		auto texture = window.load_image(pack, "sprites/a.png");
+		CHECK(texture.get_width() == 4);
+		CHECK(texture.get_height() == 4);
+
+		window.set_clear_color(0, 0, 0);
+		window.clear();
+		SDL_Rect dstrect{0, 0, 4, 4};
+		window.render(texture, nullptr, &dstrect);
+		CHECK(window.capture().get_pixel(3, 1).r == 48);
+		CHECK(window.capture().get_pixel(3, 1).g == 16);
+		CHECK(window.capture().get_pixel(3, 1).b == 0x10);
+	}
+
+#ifdef CEGE_LZ4
+	SUBCASE("compressed images keep their pixels") {
+		writer.add_image("flat.png", Surface{64, 64});
+		writer.write(path, AssetCompression::lz4);
+		CHECK(std::filesystem::file_size(path) < 64 * 64 * 4);
+
+		AssetPack pack{path};
+		CHECK(pack.load_surface("flat.png").diff(Surface{64, 64}).differing_pixels == 0);
+		CHECK(pack.load_surface("sprites/a.png").diff(create_image(4, 4, 0x10)).differing_pixels == 0);
+	}
+#else
+	SUBCASE("compression needs LZ4") {
+		CHECK_THROWS_AS(writer.write(path, AssetCompression::lz4), std::runtime_error);
+	}
+#endif
+
+	SUBCASE("entries with impossible sizes are rejected") {
+		// The first entry's width follows the header, its name's length and its name
+		constexpr auto WIDTH_OFFSET = 8 + 4 + 4 + 4 + std::string_view{"sprites/a.png"}.size();
+		for (std::uint32_t width : {0u, 5u, 0x80000000u}) {
+			std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+			file.seekp(WIDTH_OFFSET);
+			for (auto i = 0; i < 4; i++)
+				file.put(static_cast<char>(width >> (i * 8)));
+			file.close();
+
+			CHECK_THROWS_AS(AssetPack{path}, std::runtime_error);
+		}
+	}
+
+	SUBCASE("other files aren't packs") {
+		std::ofstream{path, std::ios::binary | std::ios::trunc} << "not a pack";
+		CHECK_THROWS_AS(AssetPack{path}, std::runtime_error);
+	}
+}
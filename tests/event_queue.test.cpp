@@ -0,0 +1,105 @@
+#include "engine/event_queue.hpp"
+
+#include <SDL.h>
+#include <doctest.h>
+
+#include "context.hpp"
+#include "test_types.hpp"
+
+static auto key_event(Uint32 type, SDL_Scancode scancode, bool repeat = false) -> SDL_Event {
+	SDL_Event event{};
+	event.key.type = type;
+	event.key.repeat = repeat;
+	event.key.keysym.scancode = scancode;
+	return event;
+}
+
+TEST_CASE("event queues work") {
+	EventQueue events{};
+
+	SUBCASE("events are sorted by type") {
+		SDL_Event motion{};
+		motion.motion.type = SDL_MOUSEMOTION;
+		motion.motion.x = 12;
+		motion.motion.y = 34;
+
+		SDL_Event window{};
+		window.window.type = SDL_WINDOWEVENT;
+
+		SDL_Event user{};
+		user.user.type = SDL_USEREVENT + 1;
+		user.user.code = 7;
+
+		events.push(key_event(SDL_KEYDOWN, SDL_SCANCODE_W));
+		events.push(motion);
+		events.push(window);
+		events.push(user);
+
+		CHECK(events.get_keyboard_events().size() == 1);
+		CHECK(events.get_mouse_motion_events().size() == 1);
+		CHECK(events.get_mouse_button_events().empty());
+		CHECK(events.get_window_events().size() == 1);
+		REQUIRE(events.get_user_events().size() == 1);
+		CHECK(events.get_user_events()[0].code == 7);
+		CHECK(!events.quit_requested());
+
+		CHECK(events.get_input().mouse_x == 12);
+		CHECK(events.get_input().mouse_y == 34);
+	}
+
+	SUBCASE("quit events are reported") {
+		SDL_Event quit{};
+		quit.type = SDL_QUIT;
+		events.push(quit);
+		CHECK(events.quit_requested());
+
+		events.clear();
+		CHECK(!events.quit_requested());
+	}
+
+	SUBCASE("key state is tracked across frames") {
+		events.push(key_event(SDL_KEYDOWN, SDL_SCANCODE_A));
+		CHECK(events.get_input().is_down(SDL_SCANCODE_A));
+		CHECK(events.get_input().was_pressed(SDL_SCANCODE_A));
+
+		events.clear();
+		events.push(key_event(SDL_KEYDOWN, SDL_SCANCODE_A, true));
+		CHECK(events.get_input().is_down(SDL_SCANCODE_A));
+		CHECK(!events.get_input().was_pressed(SDL_SCANCODE_A));
+		CHECK(events.get_keyboard_events().size() == 1);
+
+		events.clear();
+		events.push(key_event(SDL_KEYUP, SDL_SCANCODE_A));
+		CHECK(!events.get_input().is_down(SDL_SCANCODE_A));
+		CHECK(events.get_input().was_released(SDL_SCANCODE_A));
+	}
+
+	SUBCASE("mouse buttons are tracked") {
+		SDL_Event button{};
+		button.button.type = SDL_MOUSEBUTTONDOWN;
+		button.button.button = 1;
+		events.push(button);
+		CHECK(events.get_input().mouse_buttons == SDL_BUTTON(1));
+
+		button.button.type = SDL_MOUSEBUTTONUP;
+		events.push(button);
+		CHECK(events.get_input().mouse_buttons == 0);
+		CHECK(events.get_mouse_button_events().size() == 2);
+	}
+
+	SUBCASE("polling starts a new frame") {
+		auto ctx = Context{TEST_WINDOW_OPTIONS};
+		events.push(key_event(SDL_KEYDOWN, SDL_SCANCODE_D));
+		events.poll();
+		CHECK(events.get_keyboard_events().empty());
+		CHECK(events.get_input().is_down(SDL_SCANCODE_D));
+	}
+
+	SUBCASE("polling without SDL's event queue only starts a new frame") {
+		REQUIRE(!SDL_WasInit(SDL_INIT_EVENTS));
+		events.push(key_event(SDL_KEYDOWN, SDL_SCANCODE_D));
+		CHECK_NOTHROW(events.poll());
+		CHECK(events.get_keyboard_events().empty());
+		CHECK(events.get_input().is_down(SDL_SCANCODE_D));
+	}
+}
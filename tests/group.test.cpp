@@ -0,0 +1,138 @@
+#include "ecs/group.hpp"
+
+#include <doctest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "test_types.hpp"
+
+struct Depth {
+	int z = 0;
+};
+
+struct Name {
+	char letter = 'a';
+};
+
+struct Layer {
+	int index = 0;
+};
+
+TEST_CASE("sorting components works") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+
+	std::vector<std::shared_ptr<Entity>> entities{};
+	for (auto z : {3, 1, 4, 1, 5}) {
+		entities.emplace_back(scene.create_entity());
+		entities.back()->create_component<Depth>(z);
+	}
+
+	scene.sort<Depth>([](const Depth &a, const Depth &b) { return a.z < b.z; });
+
+	SUBCASE("sorting keeps components attached to their entities") {
+		CHECK(entities[0]->read_component<Depth>().z == 3);
+		CHECK(entities[2]->read_component<Depth>().z == 4);
+		CHECK(entities[4]->read_component<Depth>().z == 5);
+	}
+
+	SUBCASE("sorted components can be iterated in order") {
+		auto &group = scene.group<Depth>();
+		auto depths = group.read<Depth>();
+
+		REQUIRE(depths.size() == 5);
+		for (size_t i = 1; i < depths.size(); i++)
+			CHECK(depths[i - 1].z <= depths[i].z);
+	}
+}
+
+TEST_CASE("groups work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+
+	auto only_depth = scene.create_entity();
+	only_depth->create_component<Depth>(7);
+
+	auto both1 = scene.create_entity();
+	both1->create_component<Name>('b');
+	both1->create_component<Depth>(2);
+
+	auto &group = scene.group<Depth, Name>();
+
+	auto both2 = scene.create_entity();
+	both2->create_component<Depth>(1);
+	both2->create_component<Name>('c');
+
+	auto only_name = scene.create_entity();
+	only_name->create_component<Name>('d');
+
+	SUBCASE("groups contain entities with every component") {
+		CHECK(group.size() == 2);
+	}
+
+	SUBCASE("group arrays are aligned") {
+		auto entities = group.get_entities();
+		auto depths = group.read<Depth>();
+		auto names = group.read<Name>();
+
+		for (size_t i = 0; i < group.size(); i++) {
+			auto &entity = entities[i] == both1->get_id() ? both1 : both2;
+			CHECK(depths[i].z == entity->read_component<Depth>().z);
+			CHECK(names[i].letter == entity->read_component<Name>().letter);
+		}
+	}
+
+	SUBCASE("groups can be sorted") {
+		group.sort<Depth>([](const Depth &a, const Depth &b) { return a.z < b.z; });
+
+		auto names = group.read<Name>();
+		CHECK(names[0].letter == 'c');
+		CHECK(names[1].letter == 'b');
+	}
+
+	SUBCASE("removing a component removes the entity from the group") {
+		both1->remove_component<Name>();
+
+		CHECK(group.size() == 1);
+		CHECK(group.get_entities()[0] == both2->get_id());
+		CHECK(group.read<Name>()[0].letter == 'c');
+	}
+
+	SUBCASE("destroying an entity removes it from the group") {
+		both2.reset();
+
+		CHECK(group.size() == 1);
+		CHECK(group.read<Depth>()[0].z == 2);
+	}
+
+	SUBCASE("owned component arrays can't be sorted on their own") {
+		CHECK_THROWS_AS(scene.sort<Depth>([](const Depth &a, const Depth &b) { return a.z < b.z; }), std::runtime_error);
+	}
+
+	SUBCASE("overlapping groups are rejected without taking any arrays") {
+		both1->create_component<Layer>(1);
+		CHECK_THROWS_AS((scene.group<Layer, Name>()), std::runtime_error);
+		CHECK_THROWS_AS((scene.group<Layer, Depth>()), std::runtime_error);
+
+		// The layer array is still free, so it can be sorted, and grouped on its own
+		CHECK_NOTHROW(scene.sort<Layer>([](const Layer &a, const Layer &b) { return a.index < b.index; }));
+		auto &layers = scene.group<Layer>();
+		CHECK(layers.size() == 1);
+		CHECK(group.size() == 2);
+
+		// Components added afterwards only reach the group that owns their array
+		both2->create_component<Layer>(2);
+		CHECK(layers.size() == 2);
+		CHECK(group.size() == 2);
+	}
+
+	SUBCASE("each visits every entity in the group") {
+		auto sum = 0;
+		group.each([&](EntityId, const Depth &depth, const Name &) { sum += depth.z; });
+		CHECK(sum == 3);
+	}
+}
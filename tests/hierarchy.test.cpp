@@ -0,0 +1,162 @@
+#include <doctest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "engine/transform.hpp"
+#include "engine/transform_propagation.hpp"
+#include "test_types.hpp"
+#include "util/thread_pool.hpp"
+
+TEST_CASE("transform propagation works") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+	auto &propagation = scene.create_system<TransformPropagation, Transform, GlobalTransform>();
+
+	auto create_node = [&](Vector2 position, std::shared_ptr<Entity> parent = nullptr) {
+		auto entity = scene.create_entity();
+		entity->create_component<Transform>(position);
+		entity->create_component<GlobalTransform>();
+		if (parent)
+			entity->create_component<Parent>(parent->get_id());
+		return entity;
+	};
+
+	auto root = create_node({10.0f, 20.0f});
+	auto child = create_node({1.0f, 2.0f}, root);
+	auto grandchild = create_node({5.0f, 5.0f}, child);
+	auto other_root = create_node({-1.0f, -1.0f});
+
+	propagation.update(scene);
+
+	SUBCASE("global transforms are computed from ancestors") {
+		CHECK(root->read_component<GlobalTransform>().position == Vector2{10.0f, 20.0f});
+		CHECK(child->read_component<GlobalTransform>().position == Vector2{11.0f, 22.0f});
+		CHECK(grandchild->read_component<GlobalTransform>().position == Vector2{16.0f, 27.0f});
+		CHECK(other_root->read_component<GlobalTransform>().position == Vector2{-1.0f, -1.0f});
+	}
+
+	SUBCASE("moving a parent moves its descendants") {
+		scene.advance_tick();
+		root->get_component_raw<Transform>().position = {0.0f, 0.0f};
+		propagation.update(scene);
+
+		CHECK(grandchild->read_component<GlobalTransform>().position == Vector2{6.0f, 7.0f});
+	}
+
+	SUBCASE("unchanged hierarchies are skipped") {
+		scene.advance_tick();
+		auto since = scene.get_tick();
+		scene.advance_tick();
+		child->get_component_raw<Transform>().position = {2.0f, 2.0f};
+		propagation.update(scene);
+
+		CHECK(scene.query<Changed<GlobalTransform>>(since).size() == 2);
+		CHECK(grandchild->read_component<GlobalTransform>().position == Vector2{17.0f, 27.0f});
+	}
+
+	SUBCASE("parents can be changed") {
+		scene.advance_tick();
+		grandchild->get_component_raw<Parent>().id = other_root->get_id();
+		propagation.update(scene);
+
+		CHECK(grandchild->read_component<GlobalTransform>().position == Vector2{4.0f, 4.0f});
+
+		SUBCASE("parents can be removed") {
+			scene.advance_tick();
+			grandchild->remove_component<Parent>();
+			propagation.update(scene);
+
+			CHECK(grandchild->read_component<GlobalTransform>().position == Vector2{5.0f, 5.0f});
+		}
+	}
+
+	SUBCASE("rotations are inherited") {
+		scene.advance_tick();
+		root->get_component_raw<Transform>().rotation = 90.0f;
+		propagation.update(scene);
+
+		auto position = child->read_component<GlobalTransform>().position;
+		CHECK(position.x == doctest::Approx(12.0f));
+		CHECK(position.y == doctest::Approx(19.0f));
+		CHECK(child->read_component<GlobalTransform>().rotation == doctest::Approx(90.0f));
+	}
+
+	SUBCASE("hierarchies can be computed in parallel") {
+		ThreadPool pool{4};
+		std::vector<std::shared_ptr<Entity>> extra_roots{}, extra_children{};
+		for (auto i = 0; i < 16; i++) {
+			extra_roots.push_back(create_node({static_cast<float>(i), 0.0f}));
+			extra_children.push_back(create_node({0.0f, 1.0f}, extra_roots.back()));
+		}
+		propagation.update(scene, &pool);
+
+		CHECK(grandchild->read_component<GlobalTransform>().position == Vector2{16.0f, 27.0f});
+		CHECK(propagation.entities.size() == 36);
+		for (auto i = 0; i < 16; i++) {
+			CHECK(extra_roots[i]->read_component<GlobalTransform>().position == Vector2{static_cast<float>(i), 0.0f});
+			CHECK(extra_children[i]->read_component<GlobalTransform>().position == Vector2{static_cast<float>(i), 1.0f});
+		}
+
+		// Moving every other root only recomputes their hierarchies
+		scene.advance_tick();
+		for (auto i = 0; i < 16; i += 2)
+			extra_roots[i]->get_component_raw<Transform>().position.y = 10.0f;
+		propagation.update(scene, &pool);
+
+		for (auto i = 0; i < 16; i++) {
+			auto y = i % 2 == 0 ? 10.0f : 0.0f;
+			CHECK(extra_children[i]->read_component<GlobalTransform>().position == Vector2{static_cast<float>(i), y + 1.0f});
+		}
+	}
+
+	SUBCASE("destroyed entities are dropped") {
+		scene.advance_tick();
+		scene.destroy_entity(*grandchild);
+		grandchild.reset();
+		root->get_component_raw<Transform>().position = {0.0f, 0.0f};
+		propagation.update(scene);
+
+		CHECK(propagation.entities.size() == 3);
+		CHECK(child->read_component<GlobalTransform>().position == Vector2{1.0f, 2.0f});
+
+		// Entities created after a destroy are still picked up
+		auto replacement = create_node({3.0f, 3.0f});
+		propagation.update(scene);
+		CHECK(replacement->read_component<GlobalTransform>().position == Vector2{3.0f, 3.0f});
+	}
+}
+
+TEST_CASE("thread pools work") {
+	ThreadPool pool{4};
+	CHECK(pool.get_thread_count() == 4);
+
+	std::vector<int> values(1000, 0);
+	pool.parallel_for(values.size(), [&](size_t i) { values[i] = static_cast<int>(i); });
+
+	for (size_t i = 0; i < values.size(); i++)
+		CHECK(values[i] == static_cast<int>(i));
+
+	SUBCASE("exceptions reach the caller") {
+		auto throw_at = [](size_t at) {
+			return [at](size_t i) {
+				if (i == at) throw std::runtime_error{"Iteration failed."};
+			};
+		};
+
+		// Thrown on the calling thread and on a worker
+		CHECK_THROWS_AS(pool.parallel_for(values.size(), throw_at(0)), std::runtime_error);
+		CHECK_THROWS_AS(pool.parallel_for(values.size(), throw_at(values.size() - 1)), std::runtime_error);
+		CHECK_THROWS_AS(pool.run_on_each(throw_at(0)), std::runtime_error);
+		CHECK_THROWS_AS(pool.run_on_each(throw_at(3)), std::runtime_error);
+
+		// The pool is still usable afterwards
+		std::atomic<int> calls = 0;
+		pool.parallel_for(values.size(), [&](size_t) { calls++; });
+		CHECK(calls == static_cast<int>(values.size()));
+	}
+}
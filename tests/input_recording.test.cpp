@@ -0,0 +1,59 @@
+#include "engine/input_recording.hpp"
+
+#include <SDL.h>
+#include <doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("input recordings work") {
+	auto path = std::filesystem::temp_directory_path() / "cege_input.log";
+
+	std::vector<InputFrame> frames{};
+	for (Uint32 i = 0; i < 100; i++) {
+		InputFrame frame{.delta_ms = 16 + i % 2};
+		frame.input.keys[SDL_SCANCODE_W] = i >= 10 && i < 50;
+		frame.input.pressed_keys[SDL_SCANCODE_W] = i == 10;
+		frame.input.released_keys[SDL_SCANCODE_W] = i == 50;
+		frame.input.mouse_x = static_cast<int>(i) - 20;
+		frame.input.mouse_y = 300;
+		frame.input.mouse_buttons = i % 30 == 0 ? SDL_BUTTON(1) : 0;
+		frames.push_back(frame);
+	}
+
+	{
+		InputRecorder recorder{path};
+		for (auto &frame : frames)
+			recorder.record(frame);
+		CHECK(recorder.get_frame_count() == frames.size());
+	}
+
+	SUBCASE("replays match the recording") {
+		InputReplay replay{path};
+		for (auto &frame : frames) {
+			auto replayed = replay.next();
+			REQUIRE(replayed.has_value());
+			CHECK(*replayed == frame);
+		}
+
+		CHECK(!replay.next().has_value());
+		CHECK(replay.get_frame_count() == frames.size());
+	}
+
+	SUBCASE("recordings are compact") {
+		// Most frames only change the mouse position and timestep
+		CHECK(std::filesystem::file_size(path) < frames.size() * 16);
+	}
+
+	SUBCASE("other files are rejected") {
+		{
+			std::ofstream file{path, std::ios::binary | std::ios::trunc};
+			file << "not an input log";
+		}
+		CHECK_THROWS_AS(InputReplay{path}, std::runtime_error);
+	}
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,131 @@
+#include "ecs/observer.hpp"
+
+#include <doctest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "context.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "ecs/system.hpp"
+#include "test_types.hpp"
+
+struct Waypoint {
+	float x = 0.0f, y = 0.0f;
+};
+
+struct Highlighted {};
+
+class WaypointSystem : public System {};
+
+// Each batch is written as its event name and IDs, like "add 0 1"
+static auto describe(std::string name, std::span<const EntityId> ids) -> std::string {
+	for (auto id : ids)
+		name += " " + std::to_string(id);
+	return name;
+}
+
+TEST_CASE("observers work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+
+	std::vector<std::string> batches{};
+	auto record = [&](std::string name) {
+		return [&batches, name](Scene &, std::span<const EntityId> ids) { batches.push_back(describe(name, ids)); };
+	};
+	scene.observe<OnAdd<Waypoint>>(record("add"));
+	scene.observe<OnRemove<Waypoint>>(record("remove"));
+	scene.observe<OnDestroy<Waypoint>>(record("destroy"));
+
+	auto a = scene.create_entity();
+	auto b = scene.create_entity();
+	auto a_id = std::to_string(a->get_id());
+	auto b_id = std::to_string(b->get_id());
+
+	SUBCASE("events are delivered in batches when flushed") {
+		a->create_component<Waypoint>();
+		b->create_component<Waypoint>();
+		CHECK(batches.empty());
+
+		CHECK(scene.flush_events() == 2);
+		CHECK(batches == std::vector<std::string>{"add " + a_id + " " + b_id});
+		CHECK(scene.flush_events() == 0);
+		CHECK(batches.size() == 1);
+	}
+
+	SUBCASE("events keep their order") {
+		a->create_component<Waypoint>();
+		a->remove_component<Waypoint>();
+		b->create_component<Waypoint>();
+		a->create_component<Waypoint>();
+		scene.destroy_entity(*a);
+		scene.flush_events();
+
+		CHECK(batches == std::vector<std::string>{"add " + a_id, "remove " + a_id, "add " + b_id + " " + a_id, "destroy " + a_id});
+	}
+
+	SUBCASE("entities destroyed by their last reference are reported") {
+		b->create_component<Waypoint>();
+		scene.flush_events();
+		batches.clear();
+
+		b.reset();
+		scene.flush_events();
+		CHECK(batches == std::vector<std::string>{"destroy " + b_id});
+	}
+
+	SUBCASE("unobserved events aren't recorded") {
+		a->create_component<Highlighted>();
+		CHECK(scene.flush_events() == 0);
+
+		auto id = scene.observe<OnAdd<Highlighted>>(record("select"));
+		b->create_component<Highlighted>();
+		scene.unobserve(id);
+		CHECK(scene.flush_events() == 0);
+		CHECK_THROWS_AS(scene.unobserve(id), std::runtime_error);
+	}
+
+	SUBCASE("events caused by observers are delivered by the next flush") {
+		scene.observe<OnAdd<Waypoint>>([&](Scene &scene, std::span<const EntityId> ids) {
+			for (auto id : ids)
+				if (!scene.has_component<Highlighted>(*scene.get_entity(id)))
+					scene.get_entity(id)->create_component<Highlighted>();
+		});
+		scene.observe<OnAdd<Highlighted>>(record("select"));
+
+		a->create_component<Waypoint>();
+		scene.flush_events();
+		CHECK(batches == std::vector<std::string>{"add " + a_id});
+		scene.flush_events();
+		CHECK(batches.back() == "select " + a_id);
+	}
+
+	SUBCASE("observers can't change while events are delivered") {
+		scene.observe<OnAdd<Waypoint>>([&](Scene &scene, std::span<const EntityId>) {
+			scene.observe<OnAdd<Highlighted>>(record("select"));
+		});
+		a->create_component<Waypoint>();
+		CHECK_THROWS_AS(scene.flush_events(), std::runtime_error);
+
+		// The scene is still usable afterwards
+		b->create_component<Waypoint>();
+		CHECK_NOTHROW(scene.observe<OnRemove<Highlighted>>(record("deselect")));
+	}
+}
+
+TEST_CASE("destroyed entities leave their systems") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+	auto &waypoints = scene.create_system<WaypointSystem, Waypoint>();
+
+	auto entity = scene.create_entity();
+	entity->create_component<Waypoint>();
+	CHECK(waypoints.entities.contains(entity));
+
+	scene.destroy_entity(*entity);
+	CHECK(!waypoints.entities.contains(entity));
+	CHECK(scene.get_entities<Waypoint>().empty());
+}
@@ -0,0 +1,117 @@
+#include <doctest.h>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "engine/camera.hpp"
+#include "engine/particles.hpp"
+#include "engine/transform.hpp"
+#include "sdl/render_list.hpp"
+#include "test_types.hpp"
+
+TEST_CASE("particle buffers work") {
+	ParticleBuffer particles{};
+	particles.set_capacity(3);
+
+	CHECK(particles.spawn({0.0f, 0.0f}, {1.0f, 0.0f}, 1.0f));
+	CHECK(particles.spawn({1.0f, 0.0f}, {0.0f, 1.0f}, 2.0f));
+	CHECK(particles.spawn({2.0f, 0.0f}, {0.0f, 0.0f}, 0.5f));
+
+	SUBCASE("full buffers don't spawn") {
+		CHECK(!particles.spawn({3.0f, 0.0f}, {0.0f, 0.0f}, 1.0f));
+		CHECK(particles.size() == 3);
+	}
+
+	SUBCASE("killing swaps in the last particle") {
+		particles.kill(0);
+		REQUIRE(particles.size() == 2);
+		CHECK(particles.get_x()[0] == 2.0f);
+		CHECK(particles.get_x()[1] == 1.0f);
+	}
+
+	SUBCASE("particles move and accelerate") {
+		particles.update(0.25f, {0.0f, -4.0f});
+		CHECK(particles.get_x()[0] == doctest::Approx(0.25f));
+		CHECK(particles.get_velocity_y()[1] == doctest::Approx(0.0f));
+		CHECK(particles.get_y()[1] == doctest::Approx(0.0f));
+		CHECK(particles.get_life(1) == doctest::Approx(0.875f));
+	}
+
+	SUBCASE("particles die when their lifetime runs out") {
+		particles.update(0.75f, {0.0f, 0.0f});
+		REQUIRE(particles.size() == 2);
+		CHECK(particles.get_x()[0] == doctest::Approx(0.75f));
+		CHECK(particles.get_x()[1] == doctest::Approx(1.0f));
+
+		particles.update(1.0f, {0.0f, 0.0f});
+		REQUIRE(particles.size() == 1);
+		CHECK(particles.get_life(0) == doctest::Approx(0.125f));
+	}
+
+	SUBCASE("shrinking kills the newest particles") {
+		particles.set_capacity(1);
+		REQUIRE(particles.size() == 1);
+		CHECK(particles.get_x()[0] == 0.0f);
+	}
+}
+
+TEST_CASE("particle emitters work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+	scene.create_resource<Camera>(Vector2{0.0f, 0.0f}, Vector2{100.0f, 100.0f});
+	auto &particle_system = scene.create_system<ParticleSystem, GlobalTransform, ParticleEmitter>();
+
+	auto entity = scene.create_entity();
+	entity->create_component<GlobalTransform>(Vector2{10.0f, 20.0f});
+	auto &emitter = entity->create_component<ParticleEmitter>();
+	emitter.settings.rate = 10.0f;
+	emitter.settings.lifetime = 1.0f;
+	emitter.settings.velocity_spread = {0.0f, 0.0f};
+	emitter.offset = {5.0f, 5.0f};
+
+	SUBCASE("emitters spawn at their rate") {
+		particle_system.update(scene, 0.25f);
+		CHECK(entity->read_component<ParticleEmitter>().particles.size() == 2);
+
+		particle_system.update(scene, 0.25f);
+		auto &particles = entity->read_component<ParticleEmitter>().particles;
+		REQUIRE(particles.size() == 5);
+		CHECK(particles.get_x()[4] == 15.0f);
+		CHECK(particles.get_y()[4] == 25.0f);
+		CHECK(particles.get_y()[0] == doctest::Approx(50.0f));
+	}
+
+	SUBCASE("emitters respect their capacity") {
+		emitter.settings.capacity = 4;
+		particle_system.update(scene, 1.0f);
+		CHECK(entity->read_component<ParticleEmitter>().particles.size() == 4);
+	}
+
+	SUBCASE("stopped emitters keep their particles") {
+		particle_system.update(scene, 0.5f);
+		entity->get_component_raw<ParticleEmitter>().emitting = false;
+		particle_system.update(scene, 0.25f);
+		CHECK(entity->read_component<ParticleEmitter>().particles.size() == 5);
+	}
+
+	SUBCASE("each emitter is drawn with one batch") {
+		particle_system.update(scene, 0.5f);
+
+		RenderList list{};
+		particle_system.render(list, scene);
+		REQUIRE(list.size() == 1);
+
+		auto &command = list.get_commands()[0];
+		CHECK(command.is_geometry);
+		CHECK(command.texture == nullptr);
+		CHECK(command.n_vertices == 20);
+		CHECK(command.n_indices == 30);
+		CHECK(list.get_vertices().size() == 20);
+		CHECK(list.get_indices()[5] == 3);
+		CHECK(list.get_indices()[29] == 19);
+
+		// The newest particle is centered on the emitter, with the y-axis flipped
+		auto &vertex = list.get_vertices()[16];
+		CHECK(vertex.position.x == 13.0f);
+		CHECK(vertex.position.y == 73.0f);
+	}
+}
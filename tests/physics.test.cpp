@@ -0,0 +1,159 @@
+#include <doctest.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "engine/physics.hpp"
+#include "engine/transform.hpp"
+#include "test_types.hpp"
+
+static auto create_body(Scene &scene, Vector2 position, Vector2 size, RigidBody body = {}, Vector2 velocity = {0.0f, 0.0f})
+	-> std::shared_ptr<Entity> {
+	auto entity = scene.create_entity();
+	entity->create_component<Transform>(position, size);
+	entity->create_component<RigidBody>(std::move(body));
+	entity->create_component<Velocity>(velocity);
+	return entity;
+}
+
+static auto run(Scene &scene, PhysicsSystem &physics, int steps) -> void {
+	for (auto i = 0; i < steps; i++) {
+		physics.step(scene);
+		scene.advance_tick();
+	}
+}
+
+TEST_CASE("physics works") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+	auto &physics = scene.create_system<PhysicsSystem, Transform, RigidBody, Velocity>();
+
+	SUBCASE("gravity accelerates dynamic bodies") {
+		auto body = create_body(scene, {0.0f, 0.0f}, {10.0f, 10.0f});
+		run(scene, physics, 60);
+
+		auto &velocity = body->read_component<Velocity>().linear;
+		CHECK(velocity.x == 0.0f);
+		CHECK(velocity.y == doctest::Approx(-980.0f).epsilon(0.001));
+		CHECK(body->read_component<Transform>().position.y < -450.0f);
+	}
+
+	SUBCASE("static bodies don't move") {
+		auto floor = create_body(scene, {0.0f, 0.0f}, {100.0f, 10.0f}, {.mass = 0.0f});
+		run(scene, physics, 10);
+		CHECK(floor->read_component<Transform>().position == Vector2{0.0f, 0.0f});
+	}
+
+	SUBCASE("bodies rest on static bodies") {
+		auto floor = create_body(scene, {-500.0f, -20.0f}, {1000.0f, 20.0f}, {.mass = 0.0f});
+		auto box = create_body(scene, {0.0f, 100.0f}, {10.0f, 10.0f});
+		run(scene, physics, 120);
+
+		auto &position = box->read_component<Transform>().position;
+		CHECK(position.y > -1.0f);
+		CHECK(position.y < 0.5f);
+		CHECK(position.x == 0.0f);
+	}
+
+	SUBCASE("stacked bodies come to rest and fall asleep") {
+		auto floor = create_body(scene, {-500.0f, -20.0f}, {1000.0f, 20.0f}, {.mass = 0.0f});
+		std::vector<std::shared_ptr<Entity>> boxes{};
+		for (auto i = 0; i < 3; i++)
+			boxes.push_back(create_body(scene, {0.0f, 12.0f * static_cast<float>(i)}, {10.0f, 10.0f}));
+
+		run(scene, physics, 300);
+
+		for (auto &box : boxes)
+			CHECK(physics.is_sleeping(box->get_id()));
+		CHECK(!physics.is_sleeping(floor->get_id()));
+		CHECK(physics.get_stats().awake_bodies == 0);
+		CHECK(boxes[2]->read_component<Transform>().position.y > 17.0f);
+
+		SUBCASE("sleeping bodies stay put") {
+			auto position = boxes[1]->read_component<Transform>().position;
+			run(scene, physics, 10);
+			CHECK(boxes[1]->read_component<Transform>().position == position);
+		}
+
+		SUBCASE("changing a body wakes its island") {
+			boxes[0]->get_component_raw<Velocity>().linear = {50.0f, 0.0f};
+			run(scene, physics, 1);
+			for (auto &box : boxes)
+				CHECK(!physics.is_sleeping(box->get_id()));
+		}
+
+		SUBCASE("awake bodies wake the bodies they hit") {
+			auto falling = create_body(scene, {0.0f, 40.0f}, {10.0f, 10.0f});
+			run(scene, physics, 30);
+			CHECK(!physics.is_sleeping(boxes[2]->get_id()));
+			CHECK(!physics.is_sleeping(falling->get_id()));
+		}
+
+		SUBCASE("bodies can be woken manually") {
+			physics.wake(boxes[1]->get_id());
+			for (auto &box : boxes)
+				CHECK(!physics.is_sleeping(box->get_id()));
+		}
+
+		SUBCASE("removing a body wakes its island") {
+			boxes[0]->remove_component<RigidBody>();
+			run(scene, physics, 1);
+			CHECK(!physics.is_sleeping(boxes[1]->get_id()));
+			CHECK(!physics.is_sleeping(boxes[2]->get_id()));
+			CHECK(physics.get_stats().bodies == 3);
+		}
+	}
+
+	SUBCASE("bodies bounce with restitution") {
+		auto floor = create_body(scene, {-500.0f, -20.0f}, {1000.0f, 20.0f}, {.mass = 0.0f});
+		auto ball = create_body(scene, {0.0f, -1.0f}, {10.0f, 10.0f}, {.restitution = 1.0f}, {0.0f, -100.0f});
+		run(scene, physics, 1);
+		CHECK(ball->read_component<Velocity>().linear.y > 90.0f);
+	}
+
+	SUBCASE("moving bodies collide with each other") {
+		PhysicsSettings settings{};
+		settings.gravity = {0.0f, 0.0f};
+		physics.set_settings(settings);
+
+		auto left = create_body(scene, {0.0f, 0.0f}, {10.0f, 10.0f}, {}, {100.0f, 0.0f});
+		auto right = create_body(scene, {11.0f, 0.0f}, {10.0f, 10.0f});
+		run(scene, physics, 10);
+
+		// Equal masses with no restitution share the momentum
+		CHECK(left->read_component<Velocity>().linear.x == doctest::Approx(50.0f));
+		CHECK(right->read_component<Velocity>().linear.x == doctest::Approx(50.0f));
+		CHECK(right->read_component<Transform>().position.x > 11.0f);
+	}
+}
+
+TEST_CASE("physics is deterministic") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+
+	auto simulate = [&] {
+		auto scene = ctx.create_scene();
+		auto &physics = scene.create_system<PhysicsSystem, Transform, RigidBody, Velocity>();
+
+		std::vector<std::shared_ptr<Entity>> bodies{};
+		bodies.push_back(create_body(scene, {-200.0f, -20.0f}, {400.0f, 20.0f}, {.mass = 0.0f}));
+		auto seed = 12345u;
+		for (auto i = 0; i < 50; i++) {
+			seed = seed * 1664525u + 1013904223u;
+			auto x = static_cast<float>(seed % 300) - 150.0f;
+			auto y = static_cast<float>(i) * 15.0f;
+			bodies.push_back(create_body(scene, {x, y}, {10.0f, 10.0f}, {.restitution = 0.3f}, {x * 0.1f, 0.0f}));
+		}
+
+		run(scene, physics, 200);
+
+		std::vector<Vector2> positions{};
+		for (auto &body : bodies)
+			positions.push_back(body->read_component<Transform>().position);
+		return positions;
+	};
+
+	CHECK(simulate() == simulate());
+}
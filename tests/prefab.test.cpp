@@ -0,0 +1,141 @@
+#include "ecs/prefab.hpp"
+
+#include <doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "context.hpp"
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "ecs/system.hpp"
+#include "engine/physics.hpp"
+#include "engine/prefab_loader.hpp"
+#include "engine/transform.hpp"
+#include "test_types.hpp"
+
+struct Hitpoints {
+	int value = 100;
+};
+
+struct Hostile {};
+
+class HostileSystem : public System {};
+class HitpointSystem : public System {};
+
+static auto parse_error(const PrefabLoader &loader, std::string_view source) -> std::string {
+	try {
+		loader.parse(source);
+	} catch (const std::runtime_error &e) {
+		return e.what();
+	}
+	return "";
+}
+
+TEST_CASE("prefabs work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+	auto &hostiles = scene.create_system<HostileSystem, Transform, Hitpoints, Hostile>();
+	auto &hitpoints = scene.create_system<HitpointSystem, Hitpoints>();
+
+	Prefab goblin{};
+	goblin.add<Transform>(Vector2{1.0f, 2.0f}).add<Hitpoints>(30).add<Hostile>();
+	CHECK(goblin.size() == 3);
+	CHECK(goblin.has<Hitpoints>());
+	CHECK(!goblin.has<Velocity>());
+
+	SUBCASE("instances get a copy of every component") {
+		auto entity = scene.instantiate(goblin);
+		CHECK(entity->read_component<Transform>().position == Vector2{1.0f, 2.0f});
+		CHECK(entity->read_component<Hitpoints>().value == 30);
+		CHECK(entity->has_component<Hostile>());
+		CHECK(hostiles.entities.contains(entity));
+		CHECK(hitpoints.entities.contains(entity));
+	}
+
+	SUBCASE("many instances are created at once") {
+		auto entities = scene.instantiate(goblin, 50);
+		CHECK(entities.size() == 50);
+		CHECK(hostiles.entities.size() == 50);
+		CHECK(scene.get_entities<Hitpoints>().size() == 50);
+
+		entities[0]->get_component_raw<Hitpoints>().value = 0;
+		CHECK(entities[1]->read_component<Hitpoints>().value == 30);
+	}
+
+	SUBCASE("instances are ordinary entities") {
+		auto entity = scene.instantiate(goblin);
+		entity->remove_component<Hostile>();
+		CHECK(!hostiles.entities.contains(entity));
+		CHECK(hitpoints.entities.contains(entity));
+	}
+
+	SUBCASE("setting a component replaces it") {
+		auto boss = goblin;
+		boss.set(Hitpoints{500});
+		CHECK(boss.size() == 3);
+
+		CHECK(scene.instantiate(boss)->read_component<Hitpoints>().value == 500);
+		CHECK(scene.instantiate(goblin)->read_component<Hitpoints>().value == 30);
+	}
+
+	SUBCASE("instances are marked as added") {
+		auto tick = scene.get_tick();
+		scene.advance_tick();
+		auto entity = scene.instantiate(goblin);
+		CHECK(scene.query<Added<Hitpoints>>(tick).size() == 1);
+	}
+}
+
+TEST_CASE("prefab files work") {
+	PrefabLoader loader{};
+	loader.register_component<Hitpoints>("Hitpoints", [](const PrefabFields &fields) {
+		return Hitpoints{static_cast<int>(fields.get_float("value", 100.0f))};
+	});
+
+	SUBCASE("prefabs are read by name") {
+		auto prefabs = loader.parse(R"(
+			# A comment
+			[crate]
+			Transform position=4,5 rotation=90   # Another comment
+			RigidBody mass=2.5
+			Velocity
+
+			[wisp]
+			Hitpoints value=5
+		)");
+		CHECK(prefabs.size() == 2);
+		CHECK(prefabs.at("crate").size() == 3);
+
+		auto ctx = Context{TEST_WINDOW_OPTIONS};
+		auto scene = ctx.create_scene();
+		auto crate = scene.instantiate(prefabs.at("crate"));
+		CHECK(crate->read_component<Transform>().position == Vector2{4.0f, 5.0f});
+		CHECK(crate->read_component<Transform>().scale == Transform{}.scale);
+		CHECK(crate->read_component<Transform>().rotation == 90.0f);
+		CHECK(crate->read_component<RigidBody>().mass == 2.5f);
+		CHECK(crate->read_component<RigidBody>().friction == RigidBody{}.friction);
+		CHECK(scene.instantiate(prefabs.at("wisp"))->read_component<Hitpoints>().value == 5);
+	}
+
+	SUBCASE("prefabs are loaded from files") {
+		auto path = std::filesystem::temp_directory_path() / "cege_prefabs.txt";
+		std::ofstream{path} << "[wisp]\nHitpoints value=5\n";
+		CHECK(loader.load(path).contains("wisp"));
+		CHECK_THROWS_AS(loader.load(path.parent_path() / "cege_missing_prefabs.txt"), std::runtime_error);
+	}
+
+	SUBCASE("mistakes are reported") {
+		CHECK(parse_error(loader, "[wisp]\nHitpoints valeu=5\n") == "prefabs:2: `Hitpoints` has no field `valeu`.");
+		CHECK(parse_error(loader, "[wisp]\nMana\n") == "prefabs:2: Unknown component `Mana`.");
+		CHECK(parse_error(loader, "[crate]\nTransform position=4\n") == "prefabs:2: `position` should be two numbers separated by a comma, but is `4`.");
+		CHECK_THROWS_AS(loader.parse("[crate]\nRigidBody mass=heavy\n"), std::runtime_error);
+		CHECK_THROWS_AS(loader.parse("Velocity\n"), std::runtime_error);
+		CHECK_THROWS_AS(loader.parse("[crate]\n[crate]\n"), std::runtime_error);
+		CHECK_THROWS_AS(loader.parse("[crate\n"), std::runtime_error);
+		CHECK_THROWS_AS(loader.parse("[crate]\nVelocity linear\n"), std::runtime_error);
+	}
+}
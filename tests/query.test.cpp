@@ -0,0 +1,122 @@
+#include "ecs/filters.hpp"
+
+#include <doctest.h>
+
+#include <memory>
+#include <vector>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "test_types.hpp"
+
+struct Velocity {
+	int x = 0, y = 0;
+};
+
+struct Sprite {
+	int frame = 0;
+};
+
+TEST_CASE("change detection queries work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+
+	auto entity1 = scene.create_entity();
+	auto entity2 = scene.create_entity();
+	entity1->create_component<Velocity>();
+	entity2->create_component<Velocity>();
+	entity2->create_component<Sprite>();
+
+	auto since = scene.get_tick();
+	scene.advance_tick();
+
+	SUBCASE("nothing matches when nothing happened") {
+		CHECK(scene.query<Added<Velocity>>(since).empty());
+		CHECK(scene.query<Changed<Velocity>>(since).empty());
+		CHECK(scene.query<Removed<Velocity>>(since).empty());
+	}
+
+	SUBCASE("added components are detected") {
+		entity1->create_component<Sprite>();
+
+		auto added = scene.query<Added<Sprite>>(since);
+		REQUIRE(added.size() == 1);
+		CHECK(added[0] == entity1);
+
+		CHECK(scene.query<Changed<Sprite>>(since).size() == 1);
+		CHECK(scene.query<Added<Velocity>>(since).empty());
+	}
+
+	SUBCASE("mutable access is detected as a change") {
+		entity2->get_component_raw<Velocity>().x = 5;
+		entity1->read_component<Velocity>();
+
+		auto changed = scene.query<Changed<Velocity>>(since);
+		REQUIRE(changed.size() == 1);
+		CHECK(changed[0] == entity2);
+
+		CHECK(scene.query<Added<Velocity>>(since).empty());
+	}
+
+	SUBCASE("removed components are detected") {
+		entity2->remove_component<Sprite>();
+
+		auto removed = scene.query<Removed<Sprite>>(since);
+		REQUIRE(removed.size() == 1);
+		CHECK(removed[0] == entity2->get_id());
+
+		SUBCASE("removals are forgotten after two ticks") {
+			scene.advance_tick();
+			CHECK(scene.query<Removed<Sprite>>(since).size() == 1);
+
+			scene.advance_tick();
+			CHECK(scene.query<Removed<Sprite>>(since).empty());
+		}
+	}
+
+	SUBCASE("queries stay exact as changes pile up over many ticks") {
+		std::vector<std::shared_ptr<Entity>> entities{};
+		for (auto i = 0; i < 100; i++) {
+			entities.push_back(scene.create_entity());
+			entities.back()->create_component<Velocity>();
+		}
+
+		// Touch a few entities each tick, sometimes the same one twice, and drop and re-add one on the same tick
+		auto created = scene.get_tick();
+		for (auto i = 0; i < 500; i++) {
+			scene.advance_tick();
+			entities[i % 100]->get_component_raw<Velocity>().x = i;
+			entities[(i * 7) % 100]->get_component_raw<Velocity>().y = i;
+			entities[(i * 7) % 100]->get_component_raw<Velocity>().y++;
+		}
+		auto last = scene.get_tick() - 1;
+		entities[3]->remove_component<Velocity>();
+		entities[3]->create_component<Velocity>();
+		entities[3]->get_component_raw<Velocity>();
+
+		auto changed = scene.query<Changed<Velocity>>(last);
+		REQUIRE(changed.size() == 3);
+		CHECK(scene.query<Added<Velocity>>(last).size() == 1);
+		CHECK(scene.query<Added<Velocity>>(created).size() == 1);
+		CHECK(scene.query<Added<Velocity>>(since).size() == 100);
+		CHECK(scene.query<Changed<Velocity>>(created).size() == 100);
+
+		// Results come back in storage order, with each entity once
+		std::vector<EntityId> expected{}, actual{};
+		for (auto id : scene.get_entities<Velocity>())
+			if (id != entity1->get_id() && id != entity2->get_id())
+				expected.push_back(id);
+		for (auto &entity : scene.query<Changed<Velocity>>(since))
+			actual.push_back(entity->get_id());
+		CHECK(actual == expected);
+	}
+
+	SUBCASE("destroyed entities are detected as removals") {
+		auto id = entity1->get_id();
+		entity1.reset();
+
+		auto removed = scene.query<Removed<Velocity>>(since);
+		REQUIRE(removed.size() == 1);
+		CHECK(removed[0] == id);
+	}
+}
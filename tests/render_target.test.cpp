@@ -0,0 +1,104 @@
+#include "sdl/render_target.hpp"
+
+#include <doctest.h>
+
+#include <filesystem>
+#include <stdexcept>
+
+#include "context.hpp"
+#include "sdl/surface.hpp"
+#include "sdl/window.hpp"
+#include "test_types.hpp"
+
+static auto same_color(SDL_Color a, SDL_Color b) -> bool {
+	return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+TEST_CASE("offscreen rendering works") {
+	auto ctx = Context{TEST_OFFSCREEN_OPTIONS};
+	auto &window = ctx.get_window();
+
+	SUBCASE("offscreen windows have no SDL window") {
+		CHECK(*window == nullptr);
+	}
+
+	SUBCASE("frames can be captured") {
+		window.set_clear_color(10, 20, 30);
+		window.clear();
+
+		auto frame = window.capture();
+		CHECK(frame.get_width() == TEST_OFFSCREEN_OPTIONS.w);
+		CHECK(frame.get_height() == TEST_OFFSCREEN_OPTIONS.h);
+		CHECK(same_color(frame.get_pixel(0, 0), {10, 20, 30, 0xff}));
+		CHECK(same_color(frame.get_pixel(63, 47), {10, 20, 30, 0xff}));
+	}
+
+	SUBCASE("render targets can be drawn into and copied") {
+		auto target = window.create_render_target(8, 8);
+		CHECK(target.get_width() == 8);
+		CHECK(target.get_height() == 8);
+
+		window.set_target(&target);
+		window.set_clear_color(0xff, 0, 0);
+		window.clear();
+		auto layer = window.capture();
+		CHECK(layer.get_width() == 8);
+		CHECK(same_color(layer.get_pixel(4, 4), {0xff, 0, 0, 0xff}));
+
+		window.set_target(nullptr);
+		window.set_clear_color(0, 0, 0);
+		window.clear();
+		SDL_Rect dstrect{16, 16, 8, 8};
+		window.render(target.get_texture(), nullptr, &dstrect);
+
+		auto frame = window.capture();
+		CHECK(same_color(frame.get_pixel(16, 16), {0xff, 0, 0, 0xff}));
+		CHECK(same_color(frame.get_pixel(23, 23), {0xff, 0, 0, 0xff}));
+		CHECK(same_color(frame.get_pixel(24, 24), {0, 0, 0, 0xff}));
+	}
+
+	SUBCASE("frames match golden images") {
+		window.set_clear_color(0x12, 0x34, 0x56);
+		window.clear();
+		auto path = std::filesystem::temp_directory_path() / "cege_golden.png";
+		window.capture().save_png(path);
+
+		window.clear();
+		auto diff = window.capture().diff(Surface{path});
+		CHECK(diff.differing_pixels == 0);
+		CHECK(diff.max_difference == 0);
+
+		std::filesystem::remove(path);
+	}
+}
+
+TEST_CASE("surfaces work") {
+	Surface a{4, 4};
+	Surface b{4, 4};
+
+	SUBCASE("identical surfaces have no differences") {
+		auto diff = a.diff(b);
+		CHECK(diff.differing_pixels == 0);
+		CHECK(diff.max_difference == 0);
+	}
+
+	SUBCASE("differences are counted") {
+		b.set_pixel(1, 2, {0, 5, 0, 0});
+		b.set_pixel(3, 3, {0, 0, 40, 0});
+
+		auto diff = a.diff(b);
+		CHECK(diff.differing_pixels == 2);
+		CHECK(diff.max_difference == 40);
+
+		CHECK(a.diff(b, 10).differing_pixels == 1);
+	}
+
+	SUBCASE("mismatched sizes throw") {
+		CHECK_THROWS_AS(a.diff(Surface{2, 2}), std::runtime_error);
+	}
+
+	SUBCASE("pixels outside the surface throw") {
+		CHECK_THROWS_AS(a.get_pixel(4, 0), std::out_of_range);
+		CHECK_THROWS_AS(a.set_pixel(0, -1, {}), std::out_of_range);
+	}
+}
@@ -0,0 +1,143 @@
+#include "sdl/render_thread.hpp"
+
+#include <doctest.h>
+
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+#include "context.hpp"
+#include "sdl/render_list.hpp"
+#include "sdl/surface.hpp"
+#include "sdl/texture.hpp"
+#include "sdl/window.hpp"
+#include "test_types.hpp"
+
+static auto get_render_thread_options() -> WindowOptions {
+	auto options = TEST_WINDOW_OPTIONS;
+	options.render_thread = true;
+	return options;
+}
+
+TEST_CASE("render lists work") {
+	RenderList list{};
+	Texture texture{};
+	SDL_Rect dstrect{10, 20, 30, 40};
+
+	list.set_clear_color(1, 2, 3);
+	list.render(texture);
+	list.render(texture, nullptr, &dstrect, 90.0, SDL_FLIP_HORIZONTAL);
+
+	SUBCASE("commands are recorded in order") {
+		REQUIRE(list.size() == 2);
+
+		auto &first = list.get_commands()[0];
+		CHECK(!first.has_srcrect);
+		CHECK(!first.has_dstrect);
+
+		auto &second = list.get_commands()[1];
+		CHECK(!second.has_srcrect);
+		CHECK(second.has_dstrect);
+		CHECK(second.dstrect.x == 10);
+		CHECK(second.dstrect.h == 40);
+		CHECK(second.angle == 90.0);
+		CHECK(second.flip == SDL_FLIP_HORIZONTAL);
+	}
+
+	SUBCASE("clear color is recorded") {
+		auto color = list.get_clear_color();
+		CHECK(color.r == 1);
+		CHECK(color.g == 2);
+		CHECK(color.b == 3);
+		CHECK(color.a == 0xff);
+	}
+
+	SUBCASE("lists can be cleared") {
+		list.clear();
+		CHECK(list.size() == 0);
+	}
+}
+
+TEST_CASE("render threads work") {
+	auto ctx = Context{get_render_thread_options()};
+	Texture texture{};
+	CHECK(ctx.get_window().get_renderer() == nullptr);
+
+	SUBCASE("submitted frames are presented") {
+		RenderThread render_thread{ctx.get_window()};
+
+		for (auto i = 0; i < 10; i++) {
+			auto &list = render_thread.begin_frame();
+			CHECK(list.size() == 0);
+			list.render(texture);
+			render_thread.submit();
+		}
+
+		render_thread.flush();
+		auto stats = render_thread.get_stats();
+		CHECK(stats.frames == 10);
+		CHECK(stats.max_latency_ms >= stats.mean_latency_ms);
+	}
+
+	SUBCASE("triple buffering works") {
+		RenderThread render_thread{ctx.get_window(), 3};
+
+		for (auto i = 0; i < 10; i++) {
+			render_thread.begin_frame().render(texture);
+			render_thread.submit();
+		}
+
+		render_thread.flush();
+		CHECK(render_thread.get_stats().frames == 10);
+	}
+
+	SUBCASE("pending frames are presented on destruction") {
+		auto presented = false;
+		{
+			RenderThread render_thread{ctx.get_window()};
+			render_thread.begin_frame().run([&](SDL_Renderer *) { presented = true; });
+			render_thread.submit();
+		}
+		CHECK(presented);
+		CHECK(ctx.get_window().get_renderer() == nullptr);
+	}
+
+	SUBCASE("the renderer is only used on the render thread") {
+		RenderThread render_thread{ctx.get_window()};
+		std::thread::id renderer_thread{};
+		SDL_Renderer *renderer = nullptr;
+		render_thread.invoke([&](SDL_Renderer *r) {
+			renderer_thread = std::this_thread::get_id();
+			renderer = r;
+		});
+		CHECK(renderer != nullptr);
+		CHECK(renderer_thread != std::this_thread::get_id());
+
+		auto frame_thread = renderer_thread;
+		render_thread.begin_frame().run([&](SDL_Renderer *) { frame_thread = std::this_thread::get_id(); });
+		render_thread.submit();
+		render_thread.flush();
+		CHECK(frame_thread == renderer_thread);
+	}
+
+	SUBCASE("textures are uploaded on the render thread") {
+		RenderThread render_thread{ctx.get_window()};
+		auto path = std::filesystem::temp_directory_path() / "cege_render_thread.png";
+		Surface{5, 3}.save_png(path);
+
+		auto image = render_thread.load_image(path);
+		CHECK(*image != nullptr);
+		CHECK(image.get_width() == 5);
+		CHECK(image.get_height() == 3);
+		std::filesystem::remove(path);
+
+		CHECK_THROWS_AS(render_thread.load_image(path), std::runtime_error);
+		CHECK_THROWS_AS(render_thread.invoke([](SDL_Renderer *) { throw std::runtime_error{"upload failed"}; }), std::runtime_error);
+	}
+
+	SUBCASE("windows that already have a renderer are rejected") {
+		ctx.get_window().create_renderer();
+		CHECK_THROWS_AS(RenderThread{ctx.get_window()}, std::runtime_error);
+		ctx.get_window().destroy_renderer();
+	}
+}
@@ -0,0 +1,112 @@
+#include "ecs/resource.hpp"
+
+#include <doctest.h>
+
+#include <stdexcept>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "ecs/system.hpp"
+#include "engine/time.hpp"
+#include "test_types.hpp"
+
+struct Gravity {
+	float strength = 9.8f;
+};
+
+struct PhysicsSystem : public System {};
+struct AudioSystem : public System {};
+struct DebugSystem : public System {};
+
+TEST_CASE("resources work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+
+	SUBCASE("resources can be created and accessed") {
+		CHECK(!scene.has_resource<DeltaTime>());
+
+		auto &delta_time = scene.create_resource<DeltaTime>(0.5f);
+		CHECK(scene.has_resource<DeltaTime>());
+		CHECK(scene.resource<DeltaTime>().seconds == 0.5f);
+
+		delta_time.seconds = 0.25f;
+		CHECK(scene.resource<DeltaTime>().seconds == 0.25f);
+		CHECK(&scene.resource<DeltaTime>() == &delta_time);
+	}
+
+	SUBCASE("references stay valid when other resources are created") {
+		auto &delta_time = scene.create_resource<DeltaTime>();
+		scene.create_resource<Gravity>();
+		CHECK(&scene.resource<DeltaTime>() == &delta_time);
+	}
+
+	SUBCASE("resources are only created once") {
+		scene.create_resource<Gravity>();
+		CHECK_THROWS_AS(scene.create_resource<Gravity>(), std::runtime_error);
+	}
+
+	SUBCASE("missing resources throw") {
+		CHECK_THROWS_AS(scene.resource<Gravity>(), std::runtime_error);
+	}
+
+	SUBCASE("resources can be removed") {
+		scene.create_resource<Gravity>(1.0f);
+
+		auto removed = scene.remove_resource<Gravity>();
+		REQUIRE(removed.has_value());
+		CHECK(removed->strength == 1.0f);
+		CHECK(!scene.has_resource<Gravity>());
+		CHECK(!scene.remove_resource<Gravity>().has_value());
+	}
+
+	SUBCASE("cached references skip the lookup until a resource is removed") {
+		ResourceRef<Gravity> gravity{};
+		CHECK_THROWS_AS(scene.resource(gravity), std::runtime_error);
+
+		auto &created = scene.create_resource<Gravity>(1.0f);
+		CHECK(&scene.resource(gravity) == &created);
+		scene.create_resource<DeltaTime>();
+		CHECK(&scene.resource(gravity) == &created);
+
+		scene.remove_resource<DeltaTime>();
+		CHECK(&scene.resource(gravity) == &created);
+
+		scene.remove_resource<Gravity>();
+		CHECK_THROWS_AS(scene.resource(gravity), std::runtime_error);
+		auto &recreated = scene.create_resource<Gravity>(2.0f);
+		CHECK(scene.resource(gravity).strength == 2.0f);
+		CHECK(&scene.resource(gravity) == &recreated);
+
+		// The same reference looks the resource up again in another scene
+		auto other_scene = ctx.create_scene();
+		other_scene.create_resource<Gravity>(3.0f);
+		CHECK(other_scene.resource(gravity).strength == 3.0f);
+		CHECK(scene.resource(gravity).strength == 2.0f);
+	}
+
+	SUBCASE("scenes have separate resources") {
+		auto other_scene = ctx.create_scene();
+		scene.create_resource<Gravity>(1.0f);
+		other_scene.create_resource<Gravity>(2.0f);
+
+		CHECK(scene.resource<Gravity>().strength == 1.0f);
+		CHECK(other_scene.resource<Gravity>().strength == 2.0f);
+	}
+
+	SUBCASE("system resource accesses can conflict") {
+		scene.set_system_resources<PhysicsSystem, Read<DeltaTime>, Write<Gravity>>();
+		scene.set_system_resources<AudioSystem, Read<DeltaTime>>();
+		scene.set_system_resources<DebugSystem, Read<Gravity>>();
+
+		auto &physics = scene.get_system_resources<PhysicsSystem>();
+		auto &audio = scene.get_system_resources<AudioSystem>();
+		auto &debug = scene.get_system_resources<DebugSystem>();
+
+		CHECK(physics.reads.size() == 1);
+		CHECK(physics.writes.size() == 1);
+		CHECK(!physics.conflicts_with(audio));
+		CHECK(physics.conflicts_with(debug));
+		CHECK(debug.conflicts_with(physics));
+		CHECK(!audio.conflicts_with(debug));
+	}
+}
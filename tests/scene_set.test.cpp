@@ -0,0 +1,129 @@
+#include "ecs/scene_set.hpp"
+
+#include <doctest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ecs/scene.hpp"
+#include "util/thread_pool.hpp"
+
+struct StepCount {
+	int value = 0;
+	bool had_pool = false;
+};
+
+static auto count_steps(Scene &scene, ThreadPool *pool) -> void {
+	auto &count = scene.resource<StepCount>();
+	count.value++;
+	count.had_pool = pool != nullptr;
+}
+
+TEST_CASE("scene sets work") {
+	ThreadPool pool{4};
+	SceneSet set{pool};
+
+	std::vector<Scene *> scenes{};
+	for (auto i = 0; i < 8; i++) {
+		auto &scene = set.create_scene(count_steps);
+		scene.create_resource<StepCount>();
+		scenes.push_back(&scene);
+	}
+	auto &parallel = set.create_scene(count_steps, true);
+	parallel.create_resource<StepCount>();
+	CHECK(set.size() == 9);
+
+	SUBCASE("every scene is stepped once per tick") {
+		for (auto i = 0; i < 3; i++)
+			set.step();
+
+		for (auto scene : scenes)
+			CHECK(scene->resource<StepCount>().value == 3);
+		CHECK(parallel.resource<StepCount>().value == 3);
+		CHECK(set.get_tick_stats().stepped == 9);
+		CHECK(set.get_tick_stats().skipped == 0);
+		CHECK(set.get_stats(*scenes[0]).ticks == 3);
+	}
+
+	SUBCASE("scenes are spread across threads") {
+		std::vector<int> n_scenes(pool.get_thread_count());
+		for (auto scene : scenes)
+			n_scenes[set.get_stats(*scene).home_thread]++;
+		CHECK(std::ranges::all_of(n_scenes, [](int n) { return n == 2; }));
+	}
+
+	SUBCASE("only parallel scenes get the pool") {
+		set.step();
+		CHECK(!scenes[0]->resource<StepCount>().had_pool);
+		CHECK(parallel.resource<StepCount>().had_pool);
+	}
+
+	SUBCASE("destroyed scenes aren't stepped") {
+		auto &survivor = *scenes[1];
+		set.destroy_scene(*scenes[0]);
+		CHECK(set.size() == 8);
+		set.step();
+
+		CHECK(survivor.resource<StepCount>().value == 1);
+		CHECK(set.get_stats(survivor).ticks == 1);
+		CHECK_THROWS_AS(set.get_stats(*scenes[0]), std::runtime_error);
+	}
+
+	SUBCASE("exceptions are rethrown after the tick") {
+		set.create_scene([](Scene &, ThreadPool *) { throw std::runtime_error{"step failed"}; });
+		CHECK_THROWS_AS(set.step(), std::runtime_error);
+		for (auto scene : scenes)
+			CHECK(scene->resource<StepCount>().value == 1);
+	}
+}
+
+TEST_CASE("scene sets share overloaded ticks fairly") {
+	ThreadPool pool{1};
+	SceneSet set{pool};
+
+	std::vector<Scene *> scenes{};
+	for (auto i = 0; i < 4; i++) {
+		auto &scene = set.create_scene([](Scene &scene, ThreadPool *pool) {
+			std::this_thread::sleep_for(std::chrono::milliseconds{2});
+			count_steps(scene, pool);
+		});
+		scene.create_resource<StepCount>();
+		scenes.push_back(&scene);
+	}
+
+	SUBCASE("scenes take turns") {
+		set.set_settings({.tick_budget_ms = 3.0, .max_skipped_ticks = 100});
+		for (auto i = 0; i < 12; i++)
+			set.step();
+
+		// Only one or two scenes fit in a tick, but none of them is left behind
+		for (auto scene : scenes) {
+			CHECK(scene->resource<StepCount>().value >= 2);
+			CHECK(set.get_stats(*scene).skipped_ticks > 0);
+			CHECK(set.get_stats(*scene).lag < 4);
+		}
+	}
+
+	SUBCASE("scenes don't wait too long") {
+		set.set_settings({.tick_budget_ms = 0.001, .max_skipped_ticks = 2});
+		for (auto i = 0; i < 9; i++) {
+			set.step();
+			CHECK(set.get_tick_stats().stepped >= 1);
+			for (auto scene : scenes)
+				CHECK(set.get_stats(*scene).lag <= 2);
+		}
+
+		for (auto scene : scenes)
+			CHECK(scene->resource<StepCount>().value >= 3);
+	}
+}
+
+TEST_CASE("thread pools run on every thread") {
+	ThreadPool pool{4};
+	std::vector<int> calls(pool.get_thread_count(), 0);
+	pool.run_on_each([&](size_t thread) { calls[thread]++; });
+	CHECK(std::ranges::all_of(calls, [](int n) { return n == 1; }));
+}
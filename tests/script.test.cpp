@@ -0,0 +1,260 @@
+#include "engine/script.hpp"
+
+#include <doctest.h>
+
+#include <future>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "util/frame_pool.hpp"
+
+static auto count_frames(int &count) -> Script {
+	while (true) {
+		count++;
+		co_await next_frame();
+	}
+}
+
+static auto count_frames_on(ScriptScheduler &, int &count) -> Script {
+	while (true) {
+		count++;
+		co_await next_frame();
+	}
+}
+
+static auto log_every(double interval, int repeats, std::string name, std::vector<std::string> &log) -> Script {
+	for (auto i = 0; i < repeats; i++) {
+		co_await seconds(interval);
+		log.push_back(name);
+	}
+}
+
+static auto count_sleeps(Delay delay, int &count) -> Script {
+	while (true) {
+		co_await delay;
+		count++;
+	}
+}
+
+static auto load(std::shared_future<int> future, int &out) -> Script {
+	out = co_await asset_loaded(future);
+}
+
+static auto fail_after(int frames) -> Script {
+	for (auto i = 0; i < frames; i++)
+		co_await next_frame();
+	throw std::runtime_error{"script failed"};
+}
+
+TEST_CASE("scripts work") {
+	ScriptScheduler scheduler{};
+
+	SUBCASE("scripts run until they first wait when started") {
+		auto count = 0;
+		scheduler.start(count_frames(count));
+		CHECK(count == 1);
+		CHECK(scheduler.size() == 1);
+
+		CHECK(scheduler.update(0.1) == 1);
+		CHECK(scheduler.update(0.1) == 1);
+		CHECK(count == 3);
+	}
+
+	SUBCASE("scripts sleep until their time is up") {
+		std::vector<std::string> log{};
+		scheduler.start(log_every(1.0, 2, "a", log));
+		scheduler.start(log_every(0.5, 3, "b", log));
+
+		CHECK(scheduler.update(0.25) == 0);
+		CHECK(scheduler.update(0.25) == 1);
+		CHECK(log == std::vector<std::string>{"b"});
+
+		// Scripts that are due together wake in the order they started waiting
+		CHECK(scheduler.update(0.5) == 2);
+		CHECK(log == std::vector<std::string>{"b", "a", "b"});
+
+		scheduler.update(10.0);
+		CHECK(log == std::vector<std::string>{"b", "a", "b", "b", "a"});
+		CHECK(scheduler.size() == 0);
+		CHECK(scheduler.get_time() == doctest::Approx(11.0));
+	}
+
+	SUBCASE("scripts don't wait for no time") {
+		std::vector<std::string> log{};
+		scheduler.start(log_every(0.0, 3, "a", log));
+		CHECK(log.size() == 3);
+		CHECK(scheduler.size() == 0);
+	}
+
+	SUBCASE("delays too short to move the clock wait for the next update") {
+		auto count = 0;
+		scheduler.start(count_sleeps(seconds(1e-300), count));
+		CHECK(scheduler.update(0.1) == 1);
+		CHECK(count == 1);
+		CHECK(scheduler.update(0.1) == 1);
+		CHECK(count == 2);
+	}
+
+	SUBCASE("delays must be finite") {
+		auto count = 0;
+		CHECK_THROWS_AS(seconds(std::numeric_limits<double>::quiet_NaN()), std::runtime_error);
+		CHECK_THROWS_AS(seconds(std::numeric_limits<double>::infinity()), std::runtime_error);
+		CHECK_THROWS_AS(scheduler.start(count_sleeps(Delay{std::numeric_limits<double>::quiet_NaN()}, count)), std::runtime_error);
+		CHECK(scheduler.size() == 0);
+
+		// Later timers still fire in order
+		std::vector<std::string> log{};
+		scheduler.start(log_every(0.5, 1, "a", log));
+		scheduler.update(1.0);
+		CHECK(log == std::vector<std::string>{"a"});
+	}
+
+	SUBCASE("sleeping scripts aren't resumed") {
+		std::vector<std::string> log{};
+		for (auto i = 0; i < 10000; i++)
+			scheduler.start(log_every(60.0, 1, "a", log));
+
+		for (auto frame = 0; frame < 100; frame++)
+			CHECK(scheduler.update(1.0 / 60.0) == 0);
+		CHECK(scheduler.update(60.0) == 10000);
+		CHECK(scheduler.size() == 0);
+	}
+
+	SUBCASE("scripts wait for assets") {
+		std::promise<int> promise{};
+		auto future = promise.get_future().share();
+		auto out = 0;
+		scheduler.start(load(future, out));
+
+		CHECK(scheduler.update(0.1) == 0);
+		promise.set_value(7);
+		CHECK(scheduler.update(0.1) == 1);
+		CHECK(out == 7);
+		CHECK(scheduler.size() == 0);
+
+		// Assets that are already loaded don't make scripts wait
+		scheduler.start(load(future, out));
+		CHECK(scheduler.size() == 0);
+	}
+
+	SUBCASE("assets that fail to load throw in the script") {
+		std::promise<int> promise{};
+		auto out = 0;
+		scheduler.start(load(promise.get_future().share(), out));
+
+		promise.set_exception(std::make_exception_ptr(std::runtime_error{"missing asset"}));
+		CHECK_THROWS_AS(scheduler.update(0.1), std::runtime_error);
+		CHECK(scheduler.size() == 0);
+	}
+
+	SUBCASE("scripts that throw are destroyed after the others are resumed") {
+		CHECK_THROWS_AS(scheduler.start(fail_after(0)), std::runtime_error);
+		CHECK(scheduler.size() == 0);
+
+		auto count = 0;
+		scheduler.start(fail_after(1));
+		scheduler.start(count_frames(count));
+		CHECK_THROWS_AS(scheduler.update(0.1), std::runtime_error);
+		CHECK(count == 2);
+		CHECK(scheduler.size() == 1);
+	}
+
+	SUBCASE("scripts stop with their entity") {
+		Scene scene{};
+		auto entity = scene.create_entity();
+		auto other = scene.create_entity();
+		auto count = 0, other_count = 0;
+		scheduler.start(entity, count_frames(count));
+		scheduler.start(entity, count_frames(count));
+		scheduler.start(other, count_frames(other_count));
+		CHECK(count == 2);
+
+		SUBCASE("when the entity is destroyed") {
+			entity.reset();
+			CHECK(scheduler.update(0.1) == 1);
+			CHECK(count == 2);
+			CHECK(other_count == 2);
+			CHECK(scheduler.size() == 1);
+		}
+
+		SUBCASE("when they're stopped") {
+			CHECK(scheduler.stop(entity) == 2);
+			CHECK(scheduler.stop(entity) == 0);
+			CHECK(scheduler.update(0.1) == 1);
+			CHECK(count == 2);
+			CHECK(scheduler.size() == 1);
+		}
+	}
+}
+
+TEST_CASE("script frames go back to their scheduler's pool") {
+	ScriptScheduler scheduler{};
+	auto &pool = scheduler.get_frame_pool();
+	auto count = 0;
+
+	SUBCASE("only scripts that take the scheduler use its pool") {
+		scheduler.start(count_frames_on(scheduler, count));
+		scheduler.start(count_frames(count));
+		CHECK(pool.get_live_count() == 1);
+
+		scheduler.update(0.1);
+		CHECK(count == 4);
+	}
+
+	SUBCASE("scripts can be destroyed on another thread") {
+		auto script = count_frames_on(scheduler, count);
+		auto other = count_frames(count);
+		CHECK(pool.get_live_count() == 1);
+
+		std::jthread{[&] {
+			auto destroyed = std::move(script);
+			auto other_destroyed = std::move(other);
+		}}.join();
+		CHECK(pool.get_live_count() == 0);
+
+		// The freed frame is still usable once the other thread has exited
+		scheduler.start(count_frames_on(scheduler, count));
+		CHECK(scheduler.update(0.1) == 1);
+		CHECK(count == 2);
+		CHECK(pool.get_live_count() == 1);
+	}
+}
+
+TEST_CASE("frame pools work") {
+	FramePool pool{};
+
+	auto a = pool.allocate(100);
+	auto b = pool.allocate(100);
+	CHECK(a != b);
+	CHECK(pool.get_live_count() == 2);
+	CHECK(pool.get_reserved_size() > 0);
+
+	// Freed memory is reused by allocations of the same size class
+	pool.deallocate(a, 100);
+	CHECK(pool.allocate(120) == a);
+
+	auto large = pool.allocate(1 << 20);
+	CHECK(pool.get_reserved_size() < 1 << 20);
+	pool.deallocate(large, 1 << 20);
+	CHECK(pool.get_live_count() == 2);
+
+	pool.deallocate(a, 120);
+	pool.deallocate(b, 100);
+	CHECK(pool.get_live_count() == 0);
+
+	SUBCASE("empty allocations get their own address") {
+		auto first = pool.allocate(0);
+		auto second = pool.allocate(0);
+		CHECK(first != second);
+		CHECK(pool.get_live_count() == 2);
+		pool.deallocate(first, 0);
+		pool.deallocate(second, 0);
+		CHECK(pool.get_live_count() == 0);
+	}
+}
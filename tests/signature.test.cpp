@@ -0,0 +1,88 @@
+#include "ecs/signature.hpp"
+
+#include <doctest.h>
+
+#include <stdexcept>
+#include <utility>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "ecs/system.hpp"
+#include "test_types.hpp"
+
+template <int I>
+struct Numbered {
+	int value = I;
+};
+
+class LastSystem : public System {};
+
+template <int... Is>
+static auto create_numbered(Entity &entity, std::integer_sequence<int, Is...>) -> void {
+	(entity.create_component<Numbered<Is>>(), ...);
+}
+
+TEST_CASE("signatures work") {
+	Signature signature{};
+
+	SUBCASE("signatures start empty") {
+		CHECK(signature.none());
+		CHECK(signature.count() == 0);
+	}
+
+	SUBCASE("bits can be set and reset") {
+		signature.set(3).set(MAX_COMPONENTS - 1);
+
+		CHECK(signature.test(3));
+		CHECK(signature.test(MAX_COMPONENTS - 1));
+		CHECK(!signature.test(4));
+		CHECK(signature.count() == 2);
+
+		signature.reset(MAX_COMPONENTS - 1);
+		signature.set(3, false);
+		CHECK(signature.none());
+		CHECK(signature == Signature{});
+	}
+
+	SUBCASE("signatures can contain each other") {
+		Signature required{};
+		required.set(1).set(MAX_COMPONENTS - 1);
+		signature.set(1).set(2);
+
+		CHECK(!signature.contains(required));
+		CHECK(signature.contains(required) == ((signature & required) == required));
+
+		signature.set(MAX_COMPONENTS - 1);
+		CHECK(signature.contains(required));
+		CHECK((signature & required) == required);
+		CHECK((signature | required) == signature);
+		CHECK(signature.contains(Signature{}));
+	}
+
+	SUBCASE("out of range bits throw") {
+		CHECK_THROWS_AS(signature.set(MAX_COMPONENTS), std::out_of_range);
+		CHECK_THROWS_AS(signature.reset(MAX_COMPONENTS), std::out_of_range);
+		CHECK_THROWS_AS(signature.test(MAX_COMPONENTS), std::out_of_range);
+
+		// Bits past the end of a partial last word are out of range too
+		BasicSignature<70> small{};
+		CHECK_THROWS_AS(small.set(70), std::out_of_range);
+		CHECK(small.none());
+	}
+}
+
+TEST_CASE("scenes can register more than 64 components") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+
+	auto &last_system = scene.create_system<LastSystem, Numbered<0>, Numbered<199>>();
+	auto entity = scene.create_entity();
+	create_numbered(*entity, std::make_integer_sequence<int, 200>{});
+
+	CHECK(entity->get_signature().count() == 200);
+	CHECK(entity->read_component<Numbered<199>>().value == 199);
+	CHECK(last_system.entities.size() == 1);
+
+	entity->remove_component<Numbered<199>>();
+	CHECK(last_system.entities.empty());
+}
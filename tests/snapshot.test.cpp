@@ -0,0 +1,148 @@
+#include "ecs/snapshot.hpp"
+
+#include <doctest.h>
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "test_types.hpp"
+
+struct Position {
+	int x, y;
+};
+
+struct Health {
+	int value = 100;
+};
+
+TEST_CASE("snapshots work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+
+	auto entity1 = scene.create_entity();
+	auto entity2 = scene.create_entity();
+	entity1->create_component<Position>(1, 2);
+	entity2->create_component<Position>(3, 4);
+	entity2->create_component<Health>();
+
+	auto baseline = scene.create_snapshot();
+
+	SUBCASE("snapshots contain every component") {
+		CHECK(baseline.components.size() == 2);
+
+		size_t n_components = 0;
+		for (auto &[_, component] : baseline.components)
+			n_components += component.present.count();
+		CHECK(n_components == 3);
+	}
+
+	SUBCASE("deltas are empty when nothing changed") {
+		entity1->read_component<Position>();
+		auto delta = scene.create_delta(baseline);
+
+		CHECK(delta.data.empty());
+	}
+
+	SUBCASE("deltas skip components that were accessed but not modified") {
+		entity1->get_component_raw<Position>();
+		auto delta = scene.create_delta(baseline);
+
+		CHECK(delta.data.empty());
+	}
+
+	SUBCASE("deltas can be applied to snapshots") {
+		entity1->get_component_raw<Position>().x = 10;
+		entity2->remove_component<Health>();
+		auto entity3 = scene.create_entity();
+		entity3->create_component<Health>(50);
+
+		auto delta = scene.create_delta(baseline);
+		auto expected = scene.create_snapshot();
+
+		auto next = baseline;
+		next.apply_delta(delta);
+
+		CHECK(next.tick == delta.tick);
+		for (auto &[id, component] : expected.components) {
+			CHECK(next.components.at(id).present == component.present);
+			CHECK(next.components.at(id).data == component.data);
+		}
+
+		SUBCASE("deltas can't be applied twice") {
+			CHECK_THROWS_AS(next.apply_delta(delta), std::runtime_error);
+		}
+	}
+
+	SUBCASE("snapshots can be restored") {
+		entity1->get_component_raw<Position>().x = 10;
+		entity1->create_component<Health>(5);
+		entity2->remove_component<Health>();
+
+		scene.restore_snapshot(baseline);
+
+		CHECK(entity1->read_component<Position>().x == 1);
+		CHECK(!entity1->get_component<Health>().has_value());
+		CHECK(entity2->read_component<Health>().value == 100);
+	}
+}
+
+TEST_CASE("xor run-length encoding round trips") {
+	std::vector<std::byte> previous(64, std::byte{7});
+	auto current = previous;
+	current[3] = std::byte{1};
+	current[40] = std::byte{2};
+	current[41] = std::byte{3};
+
+	std::vector<std::byte> encoded{};
+	CHECK(encode_xor_rle(current, previous, encoded));
+	CHECK(encoded.size() < current.size());
+
+	std::span<const std::byte> in{encoded};
+	decode_xor_rle(in, previous);
+
+	CHECK(in.empty());
+	CHECK(previous == current);
+}
+
+TEST_CASE("malformed deltas throw") {
+	Snapshot snapshot{};
+	Delta delta{.base_tick = 0, .tick = 1};
+
+	SUBCASE("varints longer than 64 bits") {
+		std::vector<std::byte> bytes(11, std::byte{0xff});
+		bytes.push_back(std::byte{0x01});
+		std::span<const std::byte> in{bytes};
+		CHECK_THROWS_AS(read_varint(in), std::runtime_error);
+	}
+
+	SUBCASE("component IDs out of range") {
+		write_varint(MAX_COMPONENTS, delta.data);
+		write_varint(sizeof(int), delta.data);
+		write_varint(0, delta.data);
+		CHECK_THROWS_AS(snapshot.apply_delta(delta), std::runtime_error);
+		CHECK(snapshot.components.empty());
+	}
+
+	SUBCASE("implausible strides") {
+		write_varint(0, delta.data);
+		write_varint(std::uint64_t{1} << 40, delta.data);
+		write_varint(0, delta.data);
+		CHECK_THROWS_AS(snapshot.apply_delta(delta), std::runtime_error);
+		CHECK(snapshot.components.empty());
+	}
+
+	SUBCASE("runs past the end of a component") {
+		std::vector<std::byte> encoded{};
+		write_varint(SIZE_MAX, encoded);
+		write_varint(1, encoded);
+		encoded.push_back(std::byte{1});
+
+		std::vector<std::byte> target(8);
+		std::span<const std::byte> in{encoded};
+		CHECK_THROWS_AS(decode_xor_rle(in, target), std::runtime_error);
+	}
+}
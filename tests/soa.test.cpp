@@ -0,0 +1,170 @@
+#include "ecs/soa.hpp"
+
+#include <doctest.h>
+
+#include <cstdint>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "test_types.hpp"
+
+struct Particle {
+	float x, y;
+	std::uint32_t color;
+};
+
+template <>
+struct SoaLayout<Particle> {
+	static constexpr auto fields = std::tuple{&Particle::x, &Particle::y, &Particle::color};
+};
+
+struct PaddedParticle {
+	std::uint8_t layer;
+	double depth;
+	std::uint16_t flags;
+};
+
+template <>
+struct SoaLayout<PaddedParticle> {
+	static constexpr auto fields = std::tuple{&PaddedParticle::layer, &PaddedParticle::depth, &PaddedParticle::flags};
+};
+
+struct PartialParticle {
+	float x, y;
+	std::uint32_t color;
+};
+
+template <>
+struct SoaLayout<PartialParticle> {
+	static constexpr auto fields = std::tuple{&PartialParticle::x, &PartialParticle::y};
+};
+
+struct ReorderedParticle {
+	std::uint8_t layer;
+	double depth;
+	std::uint16_t flags;
+};
+
+template <>
+struct SoaLayout<ReorderedParticle> {
+	static constexpr auto fields = std::tuple{&ReorderedParticle::depth, &ReorderedParticle::layer, &ReorderedParticle::flags};
+};
+
+// Leaving out a member that fits in the padding keeps the size the same
+struct TailPaddedParticle {
+	float x;
+	bool visible;
+	bool fading;
+};
+
+template <>
+struct SoaLayout<TailPaddedParticle> {
+	static constexpr auto fields = std::tuple{&TailPaddedParticle::x, &TailPaddedParticle::visible};
+};
+
+// Listing a member twice in place of another keeps the size the same
+struct DuplicatedParticle {
+	float x, y, z;
+};
+
+template <>
+struct SoaLayout<DuplicatedParticle> {
+	static constexpr auto fields = std::tuple{&DuplicatedParticle::x, &DuplicatedParticle::y, &DuplicatedParticle::y};
+};
+
+// Layouts that leave out a member, list one twice, or list members out of order, can't be stored
+static_assert(SOA_LAYOUT_IS_COMPLETE<Particle>);
+static_assert(SOA_LAYOUT_IS_COMPLETE<PaddedParticle>);
+static_assert(!SOA_LAYOUT_IS_COMPLETE<PartialParticle>);
+static_assert(!SOA_LAYOUT_IS_COMPLETE<ReorderedParticle>);
+static_assert(!SOA_LAYOUT_IS_COMPLETE<TailPaddedParticle>);
+static_assert(!SOA_LAYOUT_IS_COMPLETE<DuplicatedParticle>);
+
+TEST_CASE("struct-of-arrays components work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+
+	auto entity1 = scene.create_entity();
+	auto entity2 = scene.create_entity();
+	auto entity3 = scene.create_entity();
+	entity1->create_component<Particle>(1.0f, 2.0f, 0xff0000ffu);
+	entity2->create_component<Particle>(3.0f, 4.0f, 0x00ff00ffu);
+	entity3->create_component<Particle>(5.0f, 6.0f, 0x0000ffffu);
+
+	SUBCASE("components can be read whole") {
+		auto particle = entity2->read_component<Particle>();
+
+		CHECK(particle.x == 3.0f);
+		CHECK(particle.y == 4.0f);
+		CHECK(particle.color == 0x00ff00ff);
+	}
+
+	SUBCASE("components can be modified through references") {
+		auto particle = entity1->get_component_raw<Particle>();
+		particle.get<&Particle::x>() = 7.0f;
+		CHECK(entity1->read_component<Particle>().x == 7.0f);
+
+		particle = Particle{8.0f, 9.0f, 0xffffffff};
+		CHECK(entity1->read_component<Particle>().color == 0xffffffff);
+		CHECK(entity1->read_component<Particle>().y == 9.0f);
+	}
+
+	SUBCASE("fields are contiguous and aligned") {
+		auto xs = scene.get_field<&Particle::x>();
+		auto colors = scene.read_field<&Particle::color>();
+		auto entities = scene.get_entities<Particle>();
+
+		REQUIRE(xs.size() == 3);
+		CHECK(colors.size() == 3);
+		CHECK(reinterpret_cast<std::uintptr_t>(xs.data()) % SOA_ALIGNMENT == 0);
+		CHECK(reinterpret_cast<std::uintptr_t>(colors.data()) % SOA_ALIGNMENT == 0);
+
+		for (size_t i = 0; i < xs.size(); i++)
+			xs[i] += 1.0f;
+		for (size_t i = 0; i < entities.size(); i++)
+			CHECK(scene.get_entity(entities[i])->read_component<Particle>().x == xs[i]);
+	}
+
+	SUBCASE("field access marks components as changed") {
+		auto since = scene.get_tick();
+		scene.advance_tick();
+
+		CHECK(scene.query<Changed<Particle>>(since).empty());
+		scene.read_field<&Particle::y>();
+		CHECK(scene.query<Changed<Particle>>(since).empty());
+		scene.get_field<&Particle::y>();
+		CHECK(scene.query<Changed<Particle>>(since).size() == 3);
+	}
+
+	SUBCASE("removing a component keeps the fields packed") {
+		auto removed = entity1->remove_component<Particle>();
+		REQUIRE(removed.has_value());
+		CHECK(removed->x == 1.0f);
+
+		auto xs = scene.read_field<&Particle::x>();
+		auto entities = scene.get_entities<Particle>();
+		REQUIRE(xs.size() == 2);
+		for (size_t i = 0; i < entities.size(); i++)
+			CHECK(scene.get_entity(entities[i])->read_component<Particle>().x == xs[i]);
+	}
+
+	SUBCASE("components survive snapshots") {
+		auto baseline = scene.create_snapshot();
+
+		entity2->get_component_raw<Particle>().get<&Particle::y>() = 100.0f;
+		entity3->remove_component<Particle>();
+
+		auto delta = scene.create_delta(baseline);
+		auto expected = scene.create_snapshot();
+		auto next = baseline;
+		next.apply_delta(delta);
+		for (auto &[id, component] : expected.components) {
+			CHECK(next.components.at(id).present == component.present);
+			CHECK(next.components.at(id).data == component.data);
+		}
+
+		scene.restore_snapshot(baseline);
+		CHECK(entity2->read_component<Particle>().y == 4.0f);
+		CHECK(entity3->read_component<Particle>().color == 0x0000ffff);
+	}
+}
@@ -0,0 +1,110 @@
+#include "engine/spatial_index.hpp"
+
+#include <doctest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "engine/camera.hpp"
+#include "engine/transform.hpp"
+#include "test_types.hpp"
+
+TEST_CASE("spatial indexes work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+	SpatialIndex index{100.0f};
+
+	auto create_sprite = [&](Vector2 position) {
+		auto entity = scene.create_entity();
+		entity->create_component<GlobalTransform>(position, Vector2{10.0f, 10.0f});
+		return entity;
+	};
+
+	auto visible = create_sprite({50.0f, 50.0f});
+	auto edge = create_sprite({-5.0f, 100.0f});
+	auto far_away = create_sprite({5000.0f, -3000.0f});
+
+	index.update(scene);
+	Camera camera{.position = {0.0f, 0.0f}, .size = {640.0f, 480.0f}};
+
+	auto query = [&](const Bounds &bounds) {
+		std::vector<EntityId> ids{};
+		index.query(bounds, ids);
+		std::ranges::sort(ids);
+		return ids;
+	};
+
+	SUBCASE("entities are indexed") {
+		CHECK(index.size() == 3);
+	}
+
+	SUBCASE("queries only find overlapping entities") {
+		auto ids = query(camera.get_bounds());
+		CHECK(ids == std::vector<EntityId>{visible->get_id(), edge->get_id()});
+	}
+
+	SUBCASE("moved entities are re-indexed") {
+		scene.advance_tick();
+		far_away->get_component_raw<GlobalTransform>().position = {600.0f, 400.0f};
+		visible->get_component_raw<GlobalTransform>().position = {-500.0f, 0.0f};
+		index.update(scene);
+
+		auto ids = query(camera.get_bounds());
+		CHECK(ids == std::vector<EntityId>{edge->get_id(), far_away->get_id()});
+	}
+
+	SUBCASE("removed entities are unindexed") {
+		scene.advance_tick();
+		visible->remove_component<GlobalTransform>();
+		edge.reset();
+		index.update(scene);
+
+		CHECK(index.size() == 1);
+		CHECK(query(camera.get_bounds()).empty());
+	}
+
+	SUBCASE("query widening follows the largest entity") {
+		CHECK(index.get_max_half_extent() == doctest::Approx(5.0f));
+
+		scene.advance_tick();
+		auto huge = create_sprite({0.0f, 0.0f});
+		huge->get_component_raw<GlobalTransform>().scale = {2000.0f, 400.0f};
+		index.update(scene);
+		CHECK(index.get_max_half_extent() == doctest::Approx(1000.0f));
+
+		scene.advance_tick();
+		huge->get_component_raw<GlobalTransform>().scale = {20.0f, 40.0f};
+		index.update(scene);
+		CHECK(index.get_max_half_extent() == doctest::Approx(20.0f));
+
+		// Resizing without leaving its cell
+		scene.advance_tick();
+		huge->get_component_raw<GlobalTransform>().scale = {16.0f, 30.0f};
+		index.update(scene);
+		CHECK(index.get_max_half_extent() == doctest::Approx(15.0f));
+
+		scene.advance_tick();
+		huge.reset();
+		index.update(scene);
+		CHECK(index.get_max_half_extent() == doctest::Approx(5.0f));
+		CHECK(query(camera.get_bounds()) == std::vector<EntityId>{visible->get_id(), edge->get_id()});
+	}
+
+	SUBCASE("queries work when zoomed far out") {
+		auto ids = query(Bounds{{-1e6f, -1e6f}, {1e6f, 1e6f}});
+		CHECK(ids.size() == 3);
+	}
+}
+
+TEST_CASE("cameras work") {
+	Camera camera{.position = {100.0f, 100.0f}, .size = {640.0f, 480.0f}};
+	GlobalTransform transform{.position = {110.0f, 120.0f}, .scale = {10.0f, 20.0f}};
+
+	auto rect = camera.to_screen(transform);
+	CHECK(rect.x == 10);
+	CHECK(rect.y == 480 - 20 - 20);
+	CHECK(rect.w == 10);
+	CHECK(rect.h == 20);
+}
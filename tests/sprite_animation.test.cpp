@@ -0,0 +1,121 @@
+#include <doctest.h>
+
+#include <stdexcept>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "engine/sprite_animation.hpp"
+#include "sdl/render_target.hpp"
+#include "sdl/window.hpp"
+#include "test_types.hpp"
+
+TEST_CASE("sprite animation works") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto &window = ctx.get_window();
+	auto scene = ctx.create_scene();
+
+	// A 4x2 grid of 16x16 frames
+	auto sheet = window.create_render_target(64, 32);
+	auto &library = scene.create_resource<AnimationLibrary>();
+	auto walk = library.add_clip(AnimationClip::from_grid(sheet.get_texture(), 16, 16, 2, 4, 10.0f));
+	auto die = library.add_clip(AnimationClip::from_grid(sheet.get_texture(), 16, 16, 0, 2, 10.0f, false));
+
+	auto &animation_system = scene.create_system<SpriteAnimationSystem, SpriteAnimation>();
+
+	SUBCASE("clips can be made from grids") {
+		auto &frames = library.get_clip(walk).frames;
+		REQUIRE(frames.size() == 4);
+		CHECK(frames[0].x == 32);
+		CHECK(frames[0].y == 0);
+		CHECK(frames[2].x == 0);
+		CHECK(frames[2].y == 16);
+		CHECK(frames[3].w == 16);
+		CHECK(frames[3].h == 16);
+
+		CHECK_THROWS_AS(AnimationClip::from_grid(sheet.get_texture(), 16, 16, 6, 3), std::runtime_error);
+		CHECK_THROWS_AS(AnimationClip::from_grid(sheet.get_texture(), 0, 16, 0, 1), std::runtime_error);
+	}
+
+	SUBCASE("invalid clips are rejected") {
+		CHECK_THROWS_AS(library.add_clip({}), std::runtime_error);
+		CHECK_THROWS_AS(library.add_clip({.frames = {{0, 0, 1, 1}}, .frames_per_second = 0.0f}), std::runtime_error);
+		CHECK_THROWS_AS(library.get_clip(5), std::runtime_error);
+	}
+
+	SUBCASE("animations advance through their frames") {
+		auto entity = scene.create_entity();
+		entity->create_component<SpriteAnimation>(walk);
+
+		animation_system.update(scene, 0.05f);
+		SpriteAnimation animation = entity->read_component<SpriteAnimation>();
+		CHECK(library.get_frame(animation.frame).x == 32);
+
+		animation_system.update(scene, 0.1f);
+		animation = entity->read_component<SpriteAnimation>();
+		CHECK(library.get_frame(animation.frame).x == 48);
+
+		animation_system.update(scene, 0.1f);
+		animation = entity->read_component<SpriteAnimation>();
+		CHECK(library.get_frame(animation.frame).y == 16);
+	}
+
+	SUBCASE("looping animations wrap around") {
+		auto entity = scene.create_entity();
+		entity->create_component<SpriteAnimation>(walk);
+
+		animation_system.update(scene, 0.45f);
+		SpriteAnimation animation = entity->read_component<SpriteAnimation>();
+		CHECK(animation.time == doctest::Approx(0.05f));
+		CHECK(library.get_frame(animation.frame).x == 32);
+		CHECK(!library.is_finished(animation));
+	}
+
+	SUBCASE("other animations hold their last frame") {
+		auto entity = scene.create_entity();
+		entity->create_component<SpriteAnimation>(die);
+
+		animation_system.update(scene, 10.0f);
+		SpriteAnimation animation = entity->read_component<SpriteAnimation>();
+		CHECK(animation.time == doctest::Approx(0.2f));
+		CHECK(library.get_frame(animation.frame).x == 16);
+		CHECK(library.is_finished(animation));
+	}
+
+	SUBCASE("playing a clip starts on its first frame") {
+		auto entity = scene.create_entity();
+		entity->create_component<SpriteAnimation>(library.play(walk));
+		SpriteAnimation animation = entity->read_component<SpriteAnimation>();
+		CHECK(library.get_frame(animation.frame).x == 32);
+
+		entity->get_component_raw<SpriteAnimation>() = library.play(die, 2.0f);
+		animation = entity->read_component<SpriteAnimation>();
+		CHECK(animation.clip == die);
+		CHECK(animation.speed == 2.0f);
+		CHECK(library.get_frame(animation.frame).x == 0);
+
+		CHECK_THROWS_AS(library.play(5), std::runtime_error);
+	}
+
+	SUBCASE("animations with missing clips are rejected") {
+		auto entity = scene.create_entity();
+		entity->create_component<SpriteAnimation>(walk, 0.5f);
+		auto missing = scene.create_entity();
+		missing->create_component<SpriteAnimation>(AnimationId{5});
+
+		CHECK_THROWS_AS(animation_system.update(scene, 0.1f), std::runtime_error);
+		CHECK(entity->read_component<SpriteAnimation>().time == 0.5f);
+	}
+
+	SUBCASE("animations can play at different speeds") {
+		auto slow = scene.create_entity();
+		auto fast = scene.create_entity();
+		slow->create_component<SpriteAnimation>(walk, 0.0f, 0.5f);
+		fast->create_component<SpriteAnimation>(walk, 0.0f, 2.0f);
+
+		animation_system.update(scene, 0.1f);
+		SpriteAnimation slow_animation = slow->read_component<SpriteAnimation>();
+		SpriteAnimation fast_animation = fast->read_component<SpriteAnimation>();
+		CHECK(slow_animation.frame == library.get_timings()[walk].first);
+		CHECK(fast_animation.frame == library.get_timings()[walk].first + 2);
+	}
+}
@@ -0,0 +1,94 @@
+#include <doctest.h>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "ecs/system.hpp"
+#include "test_types.hpp"
+
+struct Enemy {};
+
+struct Frozen {};
+
+struct Health {
+	int value = 100;
+};
+
+class EnemySystem : public System {};
+
+TEST_CASE("tags work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto scene = ctx.create_scene();
+
+	auto entity1 = scene.create_entity();
+	auto entity2 = scene.create_entity();
+	entity1->create_component<Enemy>();
+	entity2->create_component<Health>();
+
+	SUBCASE("tags can be checked") {
+		CHECK(entity1->has_component<Enemy>());
+		CHECK(!entity2->has_component<Enemy>());
+		CHECK(entity2->has_component<Health>());
+		CHECK(entity1->get_component<Enemy>().has_value());
+		CHECK(!entity2->get_component<Enemy>().has_value());
+	}
+
+	SUBCASE("tags can't be added twice") {
+		CHECK_THROWS_AS(entity1->create_component<Enemy>(), std::runtime_error);
+	}
+
+	SUBCASE("tags can be removed") {
+		CHECK(entity1->remove_component<Enemy>().has_value());
+		CHECK(!entity1->has_component<Enemy>());
+		CHECK(!entity1->remove_component<Enemy>().has_value());
+	}
+
+	SUBCASE("tags match system signatures") {
+		auto &enemy_system = scene.create_system<EnemySystem, Enemy>();
+		entity2->create_component<Enemy>();
+		auto entity3 = scene.create_entity();
+		entity3->create_component<Enemy>();
+		CHECK(enemy_system.entities.size() == 2);
+
+		entity3->remove_component<Enemy>();
+		entity2->remove_component<Enemy>();
+		entity2->create_component<Enemy>();
+		CHECK(enemy_system.entities.size() == 1);
+	}
+
+	SUBCASE("tags are reported by change detection") {
+		auto since = scene.get_tick();
+		scene.advance_tick();
+
+		entity2->create_component<Frozen>();
+		entity1->remove_component<Enemy>();
+
+		auto added = scene.query<Added<Frozen>>(since);
+		REQUIRE(added.size() == 1);
+		CHECK(added[0]->get_id() == entity2->get_id());
+		CHECK(scene.query<Changed<Frozen>>(since).size() == 1);
+
+		auto removed = scene.query<Removed<Enemy>>(since);
+		REQUIRE(removed.size() == 1);
+		CHECK(removed[0] == entity1->get_id());
+	}
+
+	SUBCASE("tags survive snapshots and deltas") {
+		auto baseline = scene.create_snapshot();
+
+		entity1->remove_component<Enemy>();
+		entity2->create_component<Enemy>();
+		entity2->create_component<Frozen>();
+
+		auto delta = scene.create_delta(baseline);
+		auto expected = scene.create_snapshot();
+
+		auto next = baseline;
+		next.apply_delta(delta);
+		for (auto &[id, component] : expected.components)
+			CHECK(next.components.at(id).present == component.present);
+
+		scene.restore_snapshot(baseline);
+		CHECK(entity1->has_component<Enemy>());
+		CHECK(!entity2->has_component<Enemy>());
+	}
+}
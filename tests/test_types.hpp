@@ -13,3 +13,12 @@ constexpr WindowOptions TEST_WINDOW_OPTIONS{
 	.window_flags = SDL_WINDOW_SHOWN,
 	.renderer_flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC,
 };
+
+constexpr WindowOptions TEST_OFFSCREEN_OPTIONS{
+	.title = "Hello, SDL!",
+	.x = SDL_WINDOWPOS_UNDEFINED,
+	.y = SDL_WINDOWPOS_UNDEFINED,
+	.w = 64,
+	.h = 48,
+	.offscreen = true,
+};
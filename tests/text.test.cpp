@@ -0,0 +1,156 @@
+#include <doctest.h>
+
+#include <array>
+#include <stdexcept>
+
+#include "context.hpp"
+#include "sdl/font.hpp"
+#include "sdl/render_list.hpp"
+#include "sdl/render_target.hpp"
+#include "sdl/surface.hpp"
+#include "sdl/text.hpp"
+#include "sdl/window.hpp"
+#include "test_types.hpp"
+
+TEST_CASE("text rendering works") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto &window = ctx.get_window();
+
+	// Every glyph is 4x8 and advances the pen by 5, in a 16-column atlas
+	auto atlas = window.create_render_target(64, 48);
+	std::array<Glyph, Font::N_GLYPHS> glyphs{};
+	for (size_t index = 0; index < glyphs.size(); index++)
+		glyphs[index] = {{static_cast<int>(index % 16) * 4, static_cast<int>(index / 16) * 8, 4, 8}, 5};
+	Font font{atlas.get_texture(), glyphs, 10};
+
+	TextRun run{font};
+	REQUIRE(run.set_text("Hi there"));
+
+	SUBCASE("text is laid out as quads") {
+		CHECK(run.get_quad_count() == 7);
+		CHECK(run.get_width() == 40);
+		CHECK(run.get_height() == 10);
+
+		RenderList list{};
+		run.render(list);
+		REQUIRE(list.size() == 1);
+
+		auto &command = list.get_commands()[0];
+		CHECK(command.is_geometry);
+		CHECK(command.texture == *atlas.get_texture());
+		CHECK(command.n_vertices == 28);
+		CHECK(command.n_indices == 42);
+
+		// The second quad is the `i`, one advance to the right
+		auto &i = list.get_vertices()[4];
+		auto &i_glyph = font.get_glyph('i');
+		CHECK(i.position.x == 5.0f);
+		CHECK(i.position.y == 0.0f);
+		CHECK(i.tex_coord.x == doctest::Approx(i_glyph.source.x / 64.0f));
+		CHECK(i.tex_coord.y == doctest::Approx(i_glyph.source.y / 48.0f));
+	}
+
+	SUBCASE("unchanged text isn't laid out again") {
+		CHECK(!run.set_text("Hi there"));
+		CHECK(run.set_text("Hi there!"));
+		CHECK(run.get_quad_count() == 8);
+		CHECK(run.get_text() == "Hi there!");
+	}
+
+	SUBCASE("text can span several lines") {
+		run.set_text("ab\nlonger\nc");
+		CHECK(run.get_width() == 30);
+		CHECK(run.get_height() == 30);
+
+		RenderList list{};
+		run.render(list);
+		CHECK(list.get_vertices()[8].position.y == 10.0f);
+		CHECK(list.get_vertices()[32].position.y == 20.0f);
+	}
+
+	SUBCASE("moving and recoloring text keeps its layout") {
+		run.set_position(100.0f, 50.0f);
+		run.set_color({0xff, 0x00, 0x00, 0x80});
+
+		RenderList list{};
+		run.render(list);
+		auto &vertex = list.get_vertices()[4];
+		CHECK(vertex.position.x == 105.0f);
+		CHECK(vertex.position.y == 50.0f);
+		CHECK(vertex.color.g == 0x00);
+		CHECK(vertex.color.a == 0x80);
+
+		run.set_text("moved");
+		list.clear();
+		run.render(list);
+		CHECK(list.get_vertices()[0].position.x == 100.0f);
+		CHECK(list.get_vertices()[0].color.r == 0xff);
+	}
+
+	SUBCASE("characters outside the atlas are drawn as question marks") {
+		auto &unknown = font.get_glyph('\x7f');
+		auto &question = font.get_glyph('?');
+		CHECK(unknown.source.x == question.source.x);
+		CHECK(unknown.source.y == question.source.y);
+	}
+
+	SUBCASE("empty text draws nothing") {
+		run.set_text("");
+		CHECK(run.get_width() == 0);
+		CHECK(run.get_height() == 0);
+
+		RenderList list{};
+		run.render(list);
+		CHECK(list.size() == 0);
+	}
+}
+
+TEST_CASE("fonts load from TTF files") {
+	auto ctx = Context{TEST_OFFSCREEN_OPTIONS};
+	auto &window = ctx.get_window();
+
+	Font font{"assets/Lato-Regular.ttf", 16, window.get_renderer()};
+	CHECK(font.get_line_height() > 16);
+
+	SUBCASE("every printable glyph is in the atlas") {
+		auto &atlas = font.get_atlas();
+		CHECK(atlas.get_width() == 512);
+		for (auto character = ' '; character <= '~'; character++) {
+			auto &glyph = font.get_glyph(character);
+			CHECK(glyph.advance > 0);
+			CHECK(glyph.source.x + glyph.source.w <= atlas.get_width());
+			CHECK(glyph.source.y + glyph.source.h <= atlas.get_height());
+		}
+
+		// The font is proportional, so the rasterized metrics differ per glyph
+		CHECK(font.get_glyph('W').advance > font.get_glyph('i').advance);
+	}
+
+	SUBCASE("glyphs are rasterized into the atlas") {
+		auto &glyph = font.get_glyph('A');
+		window.set_clear_color(0, 0, 0);
+		window.clear();
+		SDL_Rect dstrect{0, 0, glyph.source.w, glyph.source.h};
+		window.render(font.get_atlas(), &glyph.source, &dstrect);
+
+		auto frame = window.capture();
+		auto n_lit = 0;
+		for (auto y = 0; y < glyph.source.h; y++)
+			for (auto x = 0; x < glyph.source.w; x++)
+				if (frame.get_pixel(x, y).r > 0x80)
+					n_lit++;
+		CHECK(n_lit > 10);
+		CHECK(n_lit < glyph.source.w * glyph.source.h);
+	}
+
+	SUBCASE("text is laid out with the font's advances") {
+		TextRun run{font};
+		run.set_text("Wi\nW");
+		CHECK(run.get_width() == font.get_glyph('W').advance + font.get_glyph('i').advance);
+		CHECK(run.get_height() == font.get_line_height() * 2);
+	}
+
+	SUBCASE("missing font files throw") {
+		CHECK_THROWS_AS(Font("assets/missing.ttf", 16, window.get_renderer()), std::runtime_error);
+	}
+}
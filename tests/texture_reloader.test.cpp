@@ -0,0 +1,110 @@
+#include "sdl/texture_reloader.hpp"
+
+#include <doctest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include "context.hpp"
+#include "sdl/render_list.hpp"
+#include "sdl/render_target.hpp"
+#include "sdl/surface.hpp"
+#include "sdl/texture.hpp"
+#include "sdl/window.hpp"
+#include "test_types.hpp"
+
+static auto create_image(int width, int height, SDL_Color color) -> Surface {
+	Surface image{width, height};
+	for (auto y = 0; y < height; y++)
+		for (auto x = 0; x < width; x++)
+			image.set_pixel(x, y, color);
+	return image;
+}
+
+// Reloads happen on other threads, so tests poll until they finish or time out
+template <typename F>
+static auto wait_until(F &&done) -> bool {
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+	while (!done()) {
+		if (std::chrono::steady_clock::now() > deadline) return false;
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	}
+	return true;
+}
+
+TEST_CASE("textures can swap their images") {
+	auto ctx = Context{TEST_OFFSCREEN_OPTIONS};
+	auto &window = ctx.get_window();
+	auto first_target = window.create_render_target(4, 4);
+	auto second_target = window.create_render_target(8, 2);
+
+	Texture first = first_target.get_texture();
+	Texture second = second_target.get_texture();
+	auto first_pointer = *first;
+	auto second_pointer = *second;
+	first.swap_texture(second);
+
+	// Copies share their image, so the render targets' textures are swapped too
+	CHECK(*first_target.get_texture() == second_pointer);
+	CHECK(*second_target.get_texture() == first_pointer);
+	CHECK(first_target.get_texture().get_width() == 8);
+	CHECK(second_target.get_texture().get_height() == 4);
+}
+
+TEST_CASE("texture reloading works") {
+	auto directory = std::filesystem::temp_directory_path() / "cege_reload";
+	std::filesystem::create_directories(directory);
+	auto path = directory / "sprite.png";
+	create_image(4, 4, {0xff, 0x00, 0x00, 0xff}).save_png(path);
+
+	auto ctx = Context{TEST_OFFSCREEN_OPTIONS};
+	auto &window = ctx.get_window();
+	auto texture = window.load_image(path);
+	auto component = texture;
+
+	TextureReloader reloader{};
+	reloader.watch(texture, path);
+
+	auto check_reloaded = [&] {
+		CHECK(component.get_width() == 8);
+		CHECK(component.get_height() == 2);
+		CHECK(reloader.get_stats().reloaded == 1);
+		CHECK(reloader.get_stats().pending == 0);
+
+		window.set_clear_color(0, 0, 0);
+		window.clear();
+		window.render(component);
+		CHECK(window.capture().get_pixel(0, 0).g == 0xff);
+	};
+
+	SUBCASE("changed images are uploaded by the frame and swapped in") {
+		create_image(8, 2, {0x00, 0xff, 0x00, 0xff}).save_png(path);
+
+		RenderList list{};
+		size_t n_swapped = 0;
+		CHECK(wait_until([&] {
+			list.clear();
+			n_swapped += reloader.update(list);
+			window.render(list);
+			return n_swapped > 0;
+		}));
+		check_reloaded();
+	}
+
+	SUBCASE("changed images can be swapped in straight away") {
+		create_image(8, 2, {0x00, 0xff, 0x00, 0xff}).save_png(path);
+		CHECK(wait_until([&] { return reloader.update(window) > 0; }));
+		check_reloaded();
+	}
+
+	SUBCASE("other files are ignored") {
+		create_image(8, 2, {0x00, 0xff, 0x00, 0xff}).save_png(directory / "other.png");
+		std::this_thread::sleep_for(std::chrono::milliseconds{50});
+		CHECK(reloader.update(window) == 0);
+		CHECK(reloader.get_stats().pending == 0);
+		CHECK(component.get_width() != 8);
+	}
+
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,110 @@
+#include <doctest.h>
+
+#include <stdexcept>
+
+#include "context.hpp"
+#include "ecs/scene.hpp"
+#include "engine/camera.hpp"
+#include "engine/tilemap.hpp"
+#include "engine/transform.hpp"
+#include "sdl/render_list.hpp"
+#include "sdl/render_target.hpp"
+#include "sdl/window.hpp"
+#include "test_types.hpp"
+
+TEST_CASE("tilemaps work") {
+	auto ctx = Context{TEST_WINDOW_OPTIONS};
+	auto &window = ctx.get_window();
+	auto scene = ctx.create_scene();
+	auto &camera = scene.create_resource<Camera>(Vector2{0.0f, 0.0f}, Vector2{100.0f, 100.0f});
+	auto &tilemap_system = scene.create_system<TilemapSystem, GlobalTransform, Tilemap>();
+
+	// A 4x2 tileset of 16px tiles, and a map that is 4x3 chunks
+	auto tileset = window.create_render_target(64, 32);
+	auto entity = scene.create_entity();
+	entity->create_component<GlobalTransform>();
+	auto &tilemap = entity->create_component<Tilemap>(tileset.get_texture(), 16, 100, 70);
+
+	SUBCASE("tiles start empty and can be set") {
+		CHECK(tilemap.get_chunk_columns() == 4);
+		CHECK(tilemap.get_chunk_rows() == 3);
+		CHECK(tilemap.get_tile(99, 69) == Tilemap::EMPTY);
+
+		tilemap.set_tile(99, 69, 3);
+		CHECK(tilemap.get_tile(99, 69) == 3);
+		CHECK_THROWS_AS(tilemap.set_tile(100, 0, 3), std::runtime_error);
+		CHECK_THROWS_AS(tilemap.get_tile(0, -1), std::runtime_error);
+	}
+
+	tilemap.fill(5);
+
+	SUBCASE("only visible chunks are drawn, in one batch") {
+		RenderList list{};
+		tilemap_system.render(list, scene);
+		auto &stats = tilemap_system.get_stats();
+		CHECK(stats.visible_chunks == 1);
+		CHECK(stats.rebuilt_chunks == 1);
+		CHECK(stats.tiles == Tilemap::CHUNK_SIZE * Tilemap::CHUNK_SIZE);
+
+		REQUIRE(list.size() == 1);
+		auto &command = list.get_commands()[0];
+		CHECK(command.is_geometry);
+		CHECK(command.texture == *tileset.get_texture());
+
+		// The bottom-left tile is at the bottom-left of the screen, and tile 5 is the second tile of the second row
+		auto &vertex = list.get_vertices()[0];
+		CHECK(vertex.position.x == 0.0f);
+		CHECK(vertex.position.y == 84.0f);
+		CHECK(vertex.tex_coord.x == doctest::Approx(0.25f));
+		CHECK(vertex.tex_coord.y == doctest::Approx(0.5f));
+	}
+
+	SUBCASE("chunks are culled against the camera") {
+		RenderList list{};
+		camera.position = {600.0f, 600.0f};
+		tilemap_system.render(list, scene);
+		CHECK(tilemap_system.get_stats().visible_chunks == 1);
+
+		// Straddling a chunk boundary
+		camera.position = {500.0f, 0.0f};
+		tilemap_system.render(list, scene);
+		CHECK(tilemap_system.get_stats().visible_chunks == 2);
+
+		list.clear();
+		camera.position = {5000.0f, 5000.0f};
+		tilemap_system.render(list, scene);
+		CHECK(tilemap_system.get_stats().visible_chunks == 0);
+		CHECK(list.size() == 0);
+	}
+
+	SUBCASE("chunks are only laid out again when their tiles change") {
+		RenderList list{};
+		tilemap_system.render(list, scene);
+		tilemap_system.render(list, scene);
+		CHECK(tilemap_system.get_stats().rebuilt_chunks == 0);
+
+		// Setting a tile to its current value doesn't count as a change
+		entity->get_component_raw<Tilemap>().set_tile(0, 0, 5);
+		CHECK(!tilemap.is_dirty(0, 0));
+
+		entity->get_component_raw<Tilemap>().set_tile(0, 0, Tilemap::EMPTY);
+		tilemap_system.render(list, scene);
+		CHECK(tilemap_system.get_stats().rebuilt_chunks == 1);
+		CHECK(tilemap_system.get_stats().tiles == Tilemap::CHUNK_SIZE * Tilemap::CHUNK_SIZE - 1);
+	}
+
+	SUBCASE("offscreen edits wait until their chunk is visible") {
+		RenderList list{};
+		tilemap_system.render(list, scene);
+
+		entity->get_component_raw<Tilemap>().set_tile(90, 60, 1);
+		tilemap_system.render(list, scene);
+		CHECK(tilemap_system.get_stats().rebuilt_chunks == 0);
+		CHECK(tilemap.is_dirty(2, 1));
+
+		camera.position = {1400.0f, 1000.0f};
+		tilemap_system.render(list, scene);
+		CHECK(tilemap_system.get_stats().rebuilt_chunks > 0);
+		CHECK(!tilemap.is_dirty(2, 1));
+	}
+}
@@ -0,0 +1,239 @@
+#include "ecs/timer.hpp"
+
+#include <doctest.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "ecs/entity.hpp"
+#include "ecs/scene.hpp"
+#include "ecs/system.hpp"
+
+struct CooldownEnded {};
+
+struct Despawn {};
+
+struct Fuse {
+	int length = 0;
+};
+
+class FuseSystem : public System {};
+
+TEST_CASE("timers work") {
+	Scene scene{};
+	std::vector<int> fired{};
+	auto record = [&](int value) {
+		return [&fired, value](Scene &) { fired.push_back(value); };
+	};
+
+	SUBCASE("callbacks run after their delay") {
+		scene.schedule(3, record(3));
+		scene.schedule(1, record(1));
+		scene.schedule(0, record(0));
+		CHECK(scene.get_timer_count() == 3);
+
+		scene.advance_tick();
+		CHECK(fired.size() == 2);
+		scene.advance_tick();
+		CHECK(fired.size() == 2);
+		scene.advance_tick();
+		CHECK(fired.size() == 3);
+		CHECK(fired.back() == 3);
+		CHECK(scene.get_timer_count() == 0);
+	}
+
+	SUBCASE("long delays fire on the right tick") {
+		// Start off a slot boundary, so timers move down levels partway through their delay
+		for (auto i = 0; i < 100; i++)
+			scene.advance_tick();
+
+		std::vector<int> delays{1, 255, 256, 257, 511, 65535, 65536, 65537, 70000};
+		auto tick = 0;
+		std::vector<int> fired_at{};
+		for (auto delay : delays)
+			scene.schedule(static_cast<Tick>(delay), [&, delay](Scene &) {
+				CHECK(tick == delay);
+				fired_at.push_back(delay);
+			});
+
+		while (tick < 70000) {
+			tick++;
+			scene.advance_tick();
+		}
+		CHECK(fired_at == delays);
+	}
+
+	SUBCASE("timers can be cancelled") {
+		auto a = scene.schedule(2, record(1));
+		auto b = scene.schedule(2, record(2));
+		CHECK(scene.cancel_timer(a));
+		CHECK(!scene.cancel_timer(a));
+		CHECK(scene.get_timer_count() == 1);
+
+		scene.advance_tick();
+		scene.advance_tick();
+		CHECK(fired == std::vector<int>{2});
+		CHECK(!scene.cancel_timer(b));
+
+		// The cancelled timer's storage is reused, but its old ID stays stale
+		auto c = scene.schedule(1, record(3));
+		CHECK(!scene.cancel_timer(a));
+		CHECK(scene.cancel_timer(c));
+	}
+
+	SUBCASE("callbacks can schedule and cancel timers") {
+		TimerId other = 0;
+		std::function<void(Scene &)> repeat = [&](Scene &scene) {
+			fired.push_back(1);
+			if (fired.size() < 3)
+				scene.schedule(2, repeat);
+		};
+		scene.schedule(2, repeat);
+		scene.schedule(1, [&](Scene &scene) { scene.cancel_timer(other); });
+		other = scene.schedule(2, record(2));
+
+		for (auto i = 0; i < 10; i++)
+			scene.advance_tick();
+		CHECK(fired == std::vector<int>{1, 1, 1});
+	}
+
+	SUBCASE("entity events are delivered in batches") {
+		std::vector<std::vector<EntityId>> cooldowns{}, despawns{};
+		scene.on_timer<CooldownEnded>([&](Scene &, std::span<const EntityId> ids) {
+			cooldowns.emplace_back(ids.begin(), ids.end());
+		});
+		scene.on_timer<Despawn>([&](Scene &, std::span<const EntityId> ids) {
+			despawns.emplace_back(ids.begin(), ids.end());
+		});
+
+		auto a = scene.create_entity();
+		auto b = scene.create_entity();
+		scene.schedule<CooldownEnded>(*a, 2);
+		scene.schedule<CooldownEnded>(*b, 2);
+		scene.schedule<Despawn>(*b, 2);
+		scene.schedule<CooldownEnded>(*a, 5);
+
+		scene.advance_tick();
+		scene.advance_tick();
+		REQUIRE(cooldowns.size() == 1);
+		CHECK(cooldowns[0].size() == 2);
+		CHECK(despawns == std::vector<std::vector<EntityId>>{{b->get_id()}});
+
+		// Destroying an entity cancels its timers
+		a.reset();
+		CHECK(scene.get_timer_count() == 0);
+		for (auto i = 0; i < 5; i++)
+			scene.advance_tick();
+		CHECK(cooldowns.size() == 1);
+	}
+
+	SUBCASE("callbacks that throw don't stop other timers") {
+		scene.schedule(1, [](Scene &) { throw std::runtime_error{"timer failed"}; });
+		scene.schedule(1, record(1));
+		CHECK_THROWS_AS(scene.advance_tick(), std::runtime_error);
+		CHECK(fired == std::vector<int>{1});
+	}
+
+	SUBCASE("ticks can't advance while timers fire") {
+		scene.schedule(1, [](Scene &scene) { scene.advance_tick(); });
+		CHECK_THROWS_AS(scene.advance_tick(), std::runtime_error);
+	}
+}
+
+TEST_CASE("scenes can be destroyed while systems and timers hold entities") {
+	std::weak_ptr<Entity> held{}, captured{};
+	{
+		Scene scene{};
+		scene.create_system<FuseSystem, Fuse>();
+
+		auto entity = scene.create_entity();
+		entity->create_component<Fuse>(3);
+		scene.schedule<Despawn>(*entity, 3);
+		held = entity;
+
+		auto other = scene.create_entity();
+		scene.schedule<Despawn>(*other, 5);
+		scene.schedule(5, [other](Scene &) {});
+		captured = other;
+		CHECK(scene.get_timer_count() == 3);
+	}
+	CHECK(held.expired());
+	CHECK(captured.expired());
+}
+
+TEST_CASE("timer wheels match a sorted reference") {
+	// Run past 2^24 ticks, so timers move down from every level of the wheel
+	constexpr std::uint64_t N_TICKS = (std::uint64_t{1} << 24) + (std::uint64_t{1} << 21);
+	constexpr std::uint64_t N_OP_TICKS = std::uint64_t{1} << 20;
+
+	Scene scene{};
+	TimerManager timers{};
+	std::mt19937_64 random{5};
+	std::uint64_t now = 0;
+	size_t n_wrong_tick = 0, n_wrong_cancel = 0, n_wrong_size = 0, n_fired = 0, n_ops = 0;
+
+	std::map<TimerId, std::uint64_t> live{};
+	std::multimap<std::uint64_t, TimerId> by_expiry{};
+	std::vector<TimerId> ids{};
+
+	auto random_delay = [&]() -> Tick {
+		switch (random() % 6) {
+			case 0: return static_cast<Tick>(random() % 8);
+			case 1: return static_cast<Tick>(random() % 300);
+			case 2: return static_cast<Tick>(random() % 70000);
+			case 3: return static_cast<Tick>((std::uint64_t{1} << 16) - 4 + random() % 8);
+			case 4: return static_cast<Tick>(random() % (std::uint64_t{1} << 24));
+			default: return static_cast<Tick>((std::uint64_t{1} << 24) - N_OP_TICKS + random() % (2 * N_OP_TICKS));
+		}
+	};
+
+	while (now < N_TICKS) {
+		if (now < N_OP_TICKS && random() % 8 < 3) {
+			n_ops++;
+			if (random() % 4 != 0 || ids.empty()) {
+				auto delay = random_delay();
+				auto expiry = now + std::max<Tick>(delay, 1);
+				auto id = timers.schedule(delay, [&, expiry](Scene &) {
+					n_fired++;
+					if (expiry != now) n_wrong_tick++;
+				});
+				live.emplace(id, expiry);
+				by_expiry.emplace(expiry, id);
+				ids.push_back(id);
+			} else {
+				auto id = ids[random() % ids.size()];
+				auto it = live.find(id);
+				if (timers.cancel(id) != (it != live.end())) n_wrong_cancel++;
+				if (it != live.end()) {
+					auto [first, last] = by_expiry.equal_range(it->second);
+					for (; first != last; ++first) {
+						if (first->second != id) continue;
+						by_expiry.erase(first);
+						break;
+					}
+					live.erase(it);
+				}
+			}
+		}
+
+		now++;
+		timers.advance(scene);
+		while (!by_expiry.empty() && by_expiry.begin()->first <= now) {
+			live.erase(by_expiry.begin()->second);
+			by_expiry.erase(by_expiry.begin());
+		}
+		if (timers.size() != live.size()) n_wrong_size++;
+	}
+
+	CHECK(n_ops > 350000);
+	CHECK(n_fired > 100000);
+	CHECK(n_wrong_tick == 0);
+	CHECK(n_wrong_cancel == 0);
+	CHECK(n_wrong_size == 0);
+}
@@ -0,0 +1,51 @@
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "sdl/asset_pack.hpp"
+
+// Other files in asset directories, like prefabs, are left out of packs
+constexpr std::string_view IMAGE_EXTENSIONS[] = {".bmp", ".gif", ".jpeg", ".jpg", ".png", ".tga", ".webp"};
+
+// Usage: cege_pack [--lz4] <output> <image or directory>...
+// Directories are searched recursively, and images are named by the path they were given as, like `assets/ball.jpg`.
+int main(int argc, char *argv[]) {
+	auto compression = AssetCompression::none;
+	std::vector<std::filesystem::path> paths{};
+	for (auto i = 1; i < argc; i++) {
+		std::string_view arg{argv[i]};
+		if (arg == "--lz4")
+			compression = AssetCompression::lz4;
+		else
+			paths.emplace_back(arg);
+	}
+
+	if (paths.size() < 2) {
+		fmt::print(stderr, "Usage: {} [--lz4] <output> <image or directory>...\n", argv[0]);
+		return 1;
+	}
+
+	try {
+		AssetPackWriter writer{};
+		for (auto it = paths.begin() + 1; it != paths.end(); it++) {
+			if (!std::filesystem::is_directory(*it)) {
+				writer.add_image(*it);
+				continue;
+			}
+
+			for (auto &entry : std::filesystem::recursive_directory_iterator{*it})
+				if (entry.is_regular_file() && std::ranges::find(IMAGE_EXTENSIONS, entry.path().extension().string()) != std::end(IMAGE_EXTENSIONS))
+					writer.add_image(entry.path());
+		}
+
+		writer.write(paths[0], compression);
+		fmt::print("Packed {} images into {}\n", writer.size(), paths[0].string());
+	} catch (const std::exception &e) {
+		fmt::print(stderr, "{}\n", e.what());
+		return 1;
+	}
+}